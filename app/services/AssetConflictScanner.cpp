@@ -0,0 +1,98 @@
+// UTF-8
+#include "app/services/AssetConflictScanner.h"
+
+#include <QString>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+std::vector<ModRow> AssetConflictScanner::staleMods() const {
+  std::unordered_map<int, std::string> scannedHashes;
+  for (const auto& scan : repo_.listAssetScans()) {
+    scannedHashes.emplace(scan.mod_id, scan.file_hash);
+  }
+
+  std::vector<ModRow> stale;
+  for (auto& mod : repo_.listVisible()) {
+    const QString path = QString::fromStdString(mod.file_path);
+    if (!path.endsWith(QStringLiteral(".vpk"), Qt::CaseInsensitive)) {
+      continue;
+    }
+    const auto it = scannedHashes.find(mod.id);
+    if (it == scannedHashes.end() || it->second != mod.file_hash) {
+      stale.push_back(std::move(mod));
+    }
+  }
+  return stale;
+}
+
+std::vector<ModAssetList> AssetConflictScanner::listAssets(const std::vector<ModRow>& mods,
+                                                           const std::atomic<bool>* cancelled,
+                                                           const std::function<void(std::size_t)>& onProgress) {
+  // 每个文件只解析目录树，耗时主要在打开文件上，按核数并行
+  std::vector<std::optional<std::vector<std::string>>> results(mods.size());
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::size_t> done{0};
+  const auto worker = [&]() {
+    for (std::size_t i = next++; i < mods.size(); i = next++) {
+      if (cancelled && cancelled->load()) {
+        return;
+      }
+      std::error_code ec;
+      results[i] = readConflictAssetPaths(
+          std::filesystem::path(QString::fromStdString(mods[i].file_path).toStdU16String()), ec);
+      const std::size_t finished = ++done;
+      if (onProgress) {
+        onProgress(finished);
+      }
+    }
+  };
+  const int threads = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+  std::vector<std::thread> pool;
+  for (int t = 1; t < threads && static_cast<std::size_t>(t) < mods.size(); ++t) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  std::vector<ModAssetList> lists;
+  for (std::size_t i = 0; i < mods.size(); ++i) {
+    // 无法读取或因取消未处理的文件不记录扫描结果，下次仍会重试
+    if (results[i]) {
+      lists.push_back({mods[i].id, mods[i].file_hash, std::move(*results[i])});
+    }
+  }
+  return lists;
+}
+
+void AssetConflictScanner::storeScans(const std::vector<ModAssetList>& lists) {
+  repo_.indexModAssets(lists);
+  spdlog::info("Asset index refreshed for {} stale mods", lists.size());
+}
+
+std::vector<AssetConflict> AssetConflictScanner::suggestions(const std::vector<int>& modIds) const {
+  const AssetIndex index = repo_.loadAssetIndex();
+  if (modIds.empty()) {
+    return repo_.suggestConflicts(index);
+  }
+  // 多个新 MOD 之间的冲突会被各自检查到一次，按 MOD 对去重
+  std::set<std::pair<int, int>> seen;
+  std::vector<AssetConflict> result;
+  for (const int modId : modIds) {
+    for (auto& conflict : repo_.suggestConflicts(index, modId)) {
+      if (seen.emplace(conflict.a_mod_id, conflict.b_mod_id).second) {
+        result.push_back(std::move(conflict));
+      }
+    }
+  }
+  return result;
+}
@@ -0,0 +1,49 @@
+// UTF-8
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "core/repo/RepositoryService.h"
+
+/**
+ * 资源冲突检测：维护 VPK 资源路径索引，并据此给出建议的 conflicts 关系。
+ * - 导入流水线与游戏目录同步会增量写入索引；这里负责补扫索引缺失或文件已变化（哈希不一致）的 MOD。
+ * - 补扫分三步：staleMods() 与 storeScans() 访问数据库，须在数据库连接所属线程调用；
+ *   中间耗时的 listAssets() 只解析 VPK 目录树、不访问数据库，可放到工作线程中执行并随时取消。
+ */
+class AssetConflictScanner {
+public:
+  explicit AssetConflictScanner(RepositoryService& repo) : repo_(repo) {}
+
+  /**
+   * 资源索引缺失或过期（哈希不一致）的 VPK MOD。
+   */
+  std::vector<ModRow> staleMods() const;
+
+  /**
+   * 多线程列出 mods 中各 VPK 参与冲突检测的资源路径，不访问数据库。
+   * @param cancelled 可选的取消标志，置位后尽快返回已完成的部分。
+   * @param onProgress 每处理完一个文件回调一次（参数为已处理数），在工作线程中调用。
+   * @return 成功读取的文件的资源列表；无法读取的文件不在其中，下次补扫时重试。
+   */
+  static std::vector<ModAssetList> listAssets(const std::vector<ModRow>& mods,
+                                              const std::atomic<bool>* cancelled = nullptr,
+                                              const std::function<void(std::size_t)>& onProgress = {});
+
+  /**
+   * 把 listAssets() 的结果写入资源索引。
+   */
+  void storeScans(const std::vector<ModAssetList>& lists);
+
+  /**
+   * 建议的冲突关系（已存在任何关系的 MOD 对除外）。
+   * @param modIds 为空时检查整个仓库，否则只检查与这些 MOD 相关的冲突。
+   */
+  std::vector<AssetConflict> suggestions(const std::vector<int>& modIds = {}) const;
+
+private:
+  RepositoryService& repo_;
+};
@@ -0,0 +1,188 @@
+// UTF-8
+#include "app/services/CoverIndex.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <list>
+#include <mutex>
+#include <utility>
+
+namespace {
+
+// 进程内最多缓存的目录数，超出时淘汰最久未使用的目录
+constexpr std::size_t kMaxCachedDirectories = 64;
+
+const QStringList& imageSuffixes() {
+  static const QStringList suffixes = {QStringLiteral("png"), QStringLiteral("jpg"), QStringLiteral("jpeg"),
+                                       QStringLiteral("bmp"), QStringLiteral("webp")};
+  return suffixes;
+}
+
+inline quint64 trigramKey(const QChar* text) {
+  return (static_cast<quint64>(text[0].unicode()) << 32) | (static_cast<quint64>(text[1].unicode()) << 16) |
+         static_cast<quint64>(text[2].unicode());
+}
+
+struct CacheEntry {
+  QString directory;
+  std::shared_ptr<const CoverIndex> index;
+};
+
+std::mutex& cacheMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+// 链表头部为最近使用的目录
+std::list<CacheEntry>& cacheEntries() {
+  static std::list<CacheEntry> entries;
+  return entries;
+}
+
+}  // namespace
+
+CoverIndex::CoverIndex(const QString& directory) : directory_(QDir::cleanPath(directory)) {
+  const QFileInfo dirInfo(directory_);
+  directoryModified_ = dirInfo.lastModified();
+  if (!dirInfo.isDir()) {
+    return;
+  }
+
+  QStringList filters;
+  for (const QString& suffix : imageSuffixes()) {
+    filters << QStringLiteral("*.%1").arg(suffix);
+  }
+  const QFileInfoList images = QDir(directory_).entryInfoList(filters, QDir::Files | QDir::Readable, QDir::Name);
+  paths_.reserve(images.size());
+  normalizedNames_.reserve(images.size());
+  for (const QFileInfo& image : images) {
+    const int index = static_cast<int>(paths_.size());
+    const QString normalized = normalizeName(image.completeBaseName());
+    paths_.push_back(image.absoluteFilePath());
+    normalizedNames_.push_back(normalized);
+    if (normalized.isEmpty()) {
+      continue;
+    }
+
+    const auto existing = exact_.constFind(normalized);
+    if (existing == exact_.cend()) {
+      exact_.insert(normalized, index);
+    } else {
+      // 同名图片按后缀优先级取舍
+      const auto currentRank = imageSuffixes().indexOf(image.suffix().toLower());
+      const auto existingRank = imageSuffixes().indexOf(QFileInfo(paths_[*existing]).suffix().toLower());
+      if (currentRank >= 0 && (existingRank < 0 || currentRank < existingRank)) {
+        exact_.insert(normalized, index);
+      }
+    }
+
+    for (int i = 0; i + 3 <= normalized.size(); ++i) {
+      QVector<int>& postings = trigrams_[trigramKey(normalized.constData() + i)];
+      if (postings.isEmpty() || postings.back() != index) {
+        postings.push_back(index);
+      }
+    }
+  }
+}
+
+std::shared_ptr<const CoverIndex> CoverIndex::forDirectory(const QString& directory) {
+  const QString key = QDir::cleanPath(directory);
+  const QDateTime modified = QFileInfo(key).lastModified();
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex());
+    auto& entries = cacheEntries();
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+      if (it->directory == key) {
+        if (it->index->directoryModified() == modified) {
+          entries.splice(entries.begin(), entries, it);
+          return entries.front().index;
+        }
+        entries.erase(it);
+        break;
+      }
+    }
+  }
+
+  // 在锁外列目录，避免阻塞其它目录的查找
+  auto index = std::make_shared<const CoverIndex>(key);
+  std::lock_guard<std::mutex> lock(cacheMutex());
+  auto& entries = cacheEntries();
+  for (auto it = entries.begin(); it != entries.end(); ++it) {
+    if (it->directory == key) {
+      entries.erase(it);
+      break;
+    }
+  }
+  entries.push_front(CacheEntry{key, index});
+  while (entries.size() > kMaxCachedDirectories) {
+    entries.pop_back();
+  }
+  return index;
+}
+
+void CoverIndex::clearCache() {
+  std::lock_guard<std::mutex> lock(cacheMutex());
+  cacheEntries().clear();
+}
+
+QString CoverIndex::normalizeName(const QString& text) {
+  QString normalized;
+  normalized.reserve(text.size());
+  for (const QChar& ch : text) {
+    if (ch.isLetterOrNumber()) {
+      normalized.append(ch.toLower());
+    }
+  }
+  return normalized;
+}
+
+QString CoverIndex::locate(const QString& modBaseName, const QString& displayName) const {
+  const QString exact = findExact(normalizeName(modBaseName));
+  if (!exact.isEmpty()) {
+    return exact;
+  }
+  return findContaining(normalizeName(displayName));
+}
+
+QString CoverIndex::findExact(const QString& normalizedName) const {
+  if (normalizedName.isEmpty()) {
+    return {};
+  }
+  const auto it = exact_.constFind(normalizedName);
+  return it == exact_.cend() ? QString() : paths_[*it];
+}
+
+QString CoverIndex::findContaining(const QString& normalizedText) const {
+  if (normalizedText.isEmpty()) {
+    return {};
+  }
+  if (normalizedText.size() < 3) {
+    // 过短的名称无法生成三元组，直接扫描已规范化的名称
+    for (int i = 0; i < normalizedNames_.size(); ++i) {
+      if (normalizedNames_[i].contains(normalizedText)) {
+        return paths_[i];
+      }
+    }
+    return {};
+  }
+
+  // 取最短的倒排列表作为候选集，再逐个确认完整包含关系
+  const QVector<int>* candidates = nullptr;
+  for (int i = 0; i + 3 <= normalizedText.size(); ++i) {
+    const auto it = trigrams_.constFind(trigramKey(normalizedText.constData() + i));
+    if (it == trigrams_.cend()) {
+      return {};
+    }
+    if (!candidates || it->size() < candidates->size()) {
+      candidates = &*it;
+    }
+  }
+  for (const int index : *candidates) {
+    if (normalizedNames_[index].contains(normalizedText)) {
+      return paths_[index];
+    }
+  }
+  return {};
+}
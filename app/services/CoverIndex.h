@@ -0,0 +1,58 @@
+// UTF-8
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include <memory>
+
+/**
+ * 单个目录的封面图片索引：一次列出目录中的图片，按规范化文件名建立精确索引与三元组倒排索引。
+ * - 规范化：仅保留字母与数字并转为小写，与早期逐文件匹配的规则一致。
+ * - 精确匹配：规范化后的 MOD 文件名与图片文件名相同；同名多张图片时按 png/jpg/jpeg/bmp/webp 的顺序优先。
+ * - 包含匹配：图片名包含规范化后的显示名称；先用三元组缩小候选，再逐个确认，返回按文件名排序的第一张。
+ * 通过 forDirectory() 获取的索引在进程内共享，导入、编辑器与游戏目录监听复用同一份结果。
+ */
+class CoverIndex {
+public:
+  /// 列出 directory 中的图片并建立索引（目录不存在时为空索引）。
+  explicit CoverIndex(const QString& directory);
+
+  /**
+   * 获取目录的共享索引；目录修改时间变化后自动重建。
+   * 线程安全，可在导入流水线的工作线程中调用。
+   */
+  static std::shared_ptr<const CoverIndex> forDirectory(const QString& directory);
+
+  /// 丢弃所有缓存的目录索引（例如在批量复制封面之后）。
+  static void clearCache();
+
+  /// 封面匹配使用的规范化规则：仅保留字母与数字并转为小写。
+  static QString normalizeName(const QString& text);
+
+  /**
+   * 为 MOD 文件查找封面：先按文件名精确匹配，再查找名称包含 displayName 的图片。
+   * @return 图片的绝对路径，未找到时返回空字符串。
+   */
+  QString locate(const QString& modBaseName, const QString& displayName) const;
+
+  /// 规范化名称精确匹配，未找到时返回空字符串。
+  QString findExact(const QString& normalizedName) const;
+
+  /// 规范化名称包含 normalizedText 的第一张图片，未找到时返回空字符串。
+  QString findContaining(const QString& normalizedText) const;
+
+  const QString& directory() const { return directory_; }
+  const QDateTime& directoryModified() const { return directoryModified_; }
+  int size() const { return static_cast<int>(paths_.size()); }
+
+private:
+  QString directory_;
+  QDateTime directoryModified_;
+  QVector<QString> paths_;           ///< 图片绝对路径，按文件名排序
+  QVector<QString> normalizedNames_; ///< 与 paths_ 一一对应的规范化名称
+  QHash<QString, int> exact_;        ///< 规范化名称 -> 下标
+  QHash<quint64, QVector<int>> trigrams_; ///< 三元组 -> 升序下标列表
+};
@@ -0,0 +1,178 @@
+// UTF-8
+#include "app/services/CoverLoader.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+#include "core/hash/Xxh64.h"
+#include "core/io/MappedFile.h"
+
+namespace {
+
+/// 解码线程数上限：封面解码主要受 CPU 与磁盘限制，再多线程收益很小。
+constexpr int kMaxDecodeThreads = 4;
+
+} // namespace
+
+CoverLoader::CoverLoader(const QString& directory, std::size_t memoryBudget, QObject* parent)
+    : QObject(parent), directory_(directory.isEmpty() ? defaultDirectory() : directory), memory_(memoryBudget) {
+  const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+  pool_.setMaxThreadCount(std::clamp(hardware / 2, 1, kMaxDecodeThreads));
+}
+
+CoverLoader::~CoverLoader() {
+  {
+    std::lock_guard lock(mutex_);
+    ++generation_;
+    pending_.clear();
+  }
+  pool_.clear();
+  pool_.waitForDone();
+}
+
+QString CoverLoader::defaultDirectory() {
+  return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(QStringLiteral("covers"));
+}
+
+QString CoverLoader::memoryKey(const QString& path, const QSize& size) {
+  return QStringLiteral("%1|%2x%3").arg(path).arg(size.width()).arg(size.height());
+}
+
+QString CoverLoader::thumbnailPath(const QString& hash, const QSize& size) const {
+  return QDir(directory_).filePath(hash.left(2) + QLatin1Char('/') +
+                                   QStringLiteral("%1_%2x%3.png").arg(hash).arg(size.width()).arg(size.height()));
+}
+
+QImage CoverLoader::cached(const QString& path, const QSize& size) {
+  std::lock_guard lock(mutex_);
+  const QImage* image = memory_.find(memoryKey(path, size));
+  return image ? *image : QImage();
+}
+
+void CoverLoader::request(const QString& path, const QSize& size, bool prefetch) {
+  if (path.isEmpty() || size.isEmpty()) {
+    return;
+  }
+  const QString key = memoryKey(path, size);
+  std::uint64_t generation = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (pending_.contains(key) || (prefetch && memory_.contains(key))) {
+      return;
+    }
+    pending_.insert(key);
+    generation = generation_;
+  }
+
+  pool_.start(
+      [this, path, size, key, generation]() {
+        const QImage image = produce(path, size);
+        {
+          std::lock_guard lock(mutex_);
+          if (!image.isNull()) {
+            memory_.insert(key, image, static_cast<std::size_t>(image.sizeInBytes()));
+          }
+          if (generation != generation_) {
+            return;
+          }
+          pending_.remove(key);
+        }
+        QMetaObject::invokeMethod(
+            this, [this, path, size, image]() { emit coverReady(path, size, image); }, Qt::QueuedConnection);
+      },
+      prefetch ? -1 : 1);
+}
+
+void CoverLoader::cancelPending() {
+  {
+    std::lock_guard lock(mutex_);
+    ++generation_;
+    pending_.clear();
+  }
+  pool_.clear();
+}
+
+void CoverLoader::forget(const QString& path) {
+  std::lock_guard lock(mutex_);
+  hashes_.remove(path);
+  // 内存缓存按路径与尺寸为键，这里不知道用过哪些尺寸，直接清空
+  memory_.clear();
+}
+
+QString CoverLoader::contentHash(const QString& path) {
+  const QFileInfo info(path);
+  if (!info.isFile()) {
+    return {};
+  }
+  const qint64 size = info.size();
+  const qint64 modified = info.lastModified().toMSecsSinceEpoch();
+  {
+    std::lock_guard lock(mutex_);
+    const auto it = hashes_.constFind(path);
+    if (it != hashes_.constEnd() && it->size == size && it->modified == modified) {
+      return it->hash;
+    }
+  }
+
+  std::error_code ec;
+  MappedFile file;
+  if (!file.open(std::filesystem::path(path.toStdU16String()), ec)) {
+    spdlog::debug("Cover hash skipped for {}: {}", path.toStdString(), ec.message());
+    return {};
+  }
+  const QString hash =
+      QStringLiteral("%1").arg(static_cast<qulonglong>(Xxh64::hash(file.data(), file.size())), 16, 16, QLatin1Char('0'));
+  std::lock_guard lock(mutex_);
+  hashes_.insert(path, FileStamp{size, modified, hash});
+  return hash;
+}
+
+QImage CoverLoader::produce(const QString& path, const QSize& size) {
+  const QString hash = contentHash(path);
+  if (hash.isEmpty()) {
+    return {};
+  }
+  const QString target = thumbnailPath(hash, size);
+  if (QFileInfo::exists(target)) {
+    QImage image(target);
+    if (!image.isNull()) {
+      return image;
+    }
+  }
+
+  QImageReader reader(path);
+  reader.setAutoTransform(true);
+  const QSize source = reader.size();
+  if (source.isValid() && (source.width() > size.width() || source.height() > size.height())) {
+    // 由解码器直接输出缩小后的图像，JPEG 等格式在解码阶段即可跳过大部分像素
+    reader.setScaledSize(source.scaled(size, Qt::KeepAspectRatio));
+  }
+  QImage image = reader.read();
+  if (image.isNull()) {
+    spdlog::debug("Cover decode failed for {}: {}", path.toStdString(), reader.errorString().toStdString());
+    return {};
+  }
+  if (image.width() > size.width() || image.height() > size.height()) {
+    // 读不到原始尺寸的格式仍按完整尺寸解码，在工作线程中补一次缩放
+    image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  }
+
+  // QSaveFile 写入唯一命名的临时文件再原子替换：内容相同的两张封面可能同时在不同线程写同一缓存文件，
+  // 其它线程也不会读到写了一半的缓存
+  QDir().mkpath(QFileInfo(target).absolutePath());
+  QSaveFile file(target);
+  if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+    spdlog::warn("Failed to write cover thumbnail {}: {}", target.toStdString(), file.errorString().toStdString());
+  }
+  return image;
+}
@@ -0,0 +1,82 @@
+// UTF-8
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QSize>
+#include <QString>
+#include <QThreadPool>
+
+#include <cstdint>
+#include <mutex>
+
+#include "core/util/LruCache.h"
+
+/**
+ * 封面图片的异步解码与缓存。
+ * - 解码在专用线程池中进行，使用 QImageReader::setScaledSize 直接按显示尺寸解码，不生成全尺寸位图。
+ * - 缩放结果写入磁盘缓存 <缓存目录>/<前两位>/<内容哈希>_<宽>x<高>.png，内容哈希为图片文件的 XXH64；
+ *   同一进程内按路径、大小与修改时间记住哈希，避免重复读取。
+ * - 解码结果同时放入按字节数限制大小的内存 LRU；cached() 只查内存，UI 线程切换选中行时不访问磁盘。
+ * - prefetch 请求以较低优先级排队，用于预先解码相邻行的封面。
+ */
+class CoverLoader : public QObject {
+  Q_OBJECT
+
+public:
+  static constexpr std::size_t kDefaultMemoryBudget = 64ull * 1024 * 1024; ///< 内存缓存上限（字节）
+
+  /// @param directory 磁盘缓存目录，为空时使用 defaultDirectory()。
+  explicit CoverLoader(const QString& directory = {},
+                       std::size_t memoryBudget = kDefaultMemoryBudget,
+                       QObject* parent = nullptr);
+  ~CoverLoader() override;
+
+  /// 系统缓存目录下的 covers 子目录。
+  static QString defaultDirectory();
+
+  /**
+   * 查询内存缓存，不访问磁盘。
+   * @return 已解码的图片；不在内存中时返回空图片。
+   */
+  QImage cached(const QString& path, const QSize& size);
+
+  /**
+   * 排队解码封面（同一路径与尺寸已在队列中时忽略）。完成后发出 coverReady，失败时 image 为空。
+   * @param prefetch 为 true 时以较低优先级排队。
+   */
+  void request(const QString& path, const QSize& size, bool prefetch = false);
+
+  /// 丢弃尚未开始的请求（详情区切换到其它 MOD 时）；已开始的解码完成后仍会写入缓存，但不再发出信号。
+  void cancelPending();
+
+  /// 从内存缓存与哈希记录中移除某个路径（封面文件被原地替换时调用）。
+  void forget(const QString& path);
+
+signals:
+  void coverReady(const QString& path, const QSize& size, const QImage& image);
+
+private:
+  struct FileStamp {
+    qint64 size{0};
+    qint64 modified{0};
+    QString hash;
+  };
+
+  static QString memoryKey(const QString& path, const QSize& size);
+  /// 在工作线程中解码，优先读取磁盘缓存。
+  QImage produce(const QString& path, const QSize& size);
+  QString contentHash(const QString& path);
+  QString thumbnailPath(const QString& hash, const QSize& size) const;
+
+  QString directory_;
+  QThreadPool pool_;
+
+  std::mutex mutex_;
+  LruCache<QString, QImage> memory_;
+  QSet<QString> pending_;           ///< 排队或解码中的 memoryKey
+  QHash<QString, FileStamp> hashes_; ///< 文件路径 -> 内容哈希
+  std::uint64_t generation_{0};     ///< cancelPending 时递增，旧请求完成后不再通知
+};
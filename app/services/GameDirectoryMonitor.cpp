@@ -1,18 +1,24 @@
 #include "app/services/GameDirectoryMonitor.h"
 
-#include <QCryptographicHash>
 #include <QDate>
 #include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileInfo>
+#include <QMetaObject>
 #include <QRegularExpression>
 #include <spdlog/spdlog.h>
 
+#include "app/services/CoverIndex.h"
 #include "app/services/ImportService.h"
+#include "core/io/FileLinker.h"
 #include "core/repo/GameModDao.h"
+#include "core/store/ObjectStore.h"
 
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
 #include <utility>
 
 namespace {
@@ -35,12 +41,45 @@ inline std::uint64_t mbToBytes(double mb) {
   return static_cast<std::uint64_t>(std::llround(mb * 1024.0 * 1024.0));
 }
 
+// 游戏目录中的文件与仓库 MOD 的大小是否一致：普通 VPK 与仓库文件相同；
+// ZIP/7z 中的 VPK 部署后是解压出的文件，其大小记录在 size_mb 中（见 ImportService::buildModFromFile）
+inline bool deployedSizeMatches(const ModRow& mod, std::uint64_t repoFileBytes, std::uint64_t deployedBytes) {
+  return (repoFileBytes > 0 && deployedBytes == repoFileBytes) || deployedBytes == mbToBytes(mod.size_mb);
+}
+
+// 按 0.01 MiB 取整的大小分桶：size_mb 可能经编辑器按两位小数保存，精确值与取整值落在同一桶中
+inline std::int64_t sizeBucket(double mb) {
+  return std::llround(mb * 100.0);
+}
+
+// 计算指纹时实际读取的字节数：小文件整体读取，大文件仅读首尾窗口
+inline std::uint64_t fingerprintReadBytes(std::uint64_t sizeBytes) {
+  return std::min<std::uint64_t>(sizeBytes, 2 * kFingerprintWindowBytes);
+}
+
+// 监听事件合并窗口
+constexpr int kRescanDebounceMs = 300;
+
+inline std::filesystem::path toFsPath(const QString& path) {
+  return std::filesystem::path(path.toStdU16String());
+}
+
 }  // namespace
 
 GameDirectoryMonitor::GameDirectoryMonitor(QObject* parent)
     : QObject(parent) {
   connect(&watcher_, &QFileSystemWatcher::directoryChanged, this, &GameDirectoryMonitor::onDirectoryChanged);
   connect(&watcher_, &QFileSystemWatcher::fileChanged, this, &GameDirectoryMonitor::onFileChanged);
+  rescanTimer_.setSingleShot(true);
+  rescanTimer_.setInterval(kRescanDebounceMs);
+  connect(&rescanTimer_, &QTimer::timeout, this, &GameDirectoryMonitor::rescanAll);
+  hashPool_.setMaxThreadCount(1);
+}
+
+GameDirectoryMonitor::~GameDirectoryMonitor() {
+  stopping_ = true;
+  hashPool_.clear();
+  hashPool_.waitForDone();
 }
 
 void GameDirectoryMonitor::configure(const Settings& settings,
@@ -61,17 +100,24 @@ void GameDirectoryMonitor::configure(const Settings& settings,
   }
   updateDirectoryWatches(directories);
   initialScanCompleted_ = false;
+  rescanTimer_.stop();
   rescanAll();
 }
 
 void GameDirectoryMonitor::onDirectoryChanged(const QString& path) {
   Q_UNUSED(path);
-  rescanAll();
+  scheduleRescan();
 }
 
 void GameDirectoryMonitor::onFileChanged(const QString& path) {
   Q_UNUSED(path);
-  rescanAll();
+  scheduleRescan();
+}
+
+void GameDirectoryMonitor::scheduleRescan() {
+  // 复制大文件时会连续触发大量事件，合并后只扫描一次
+  ++pendingWatcherEvents_;
+  rescanTimer_.start();
 }
 
 void GameDirectoryMonitor::rescanAll() {
@@ -79,7 +125,23 @@ void GameDirectoryMonitor::rescanAll() {
     return;
   }
   const bool isInitial = !initialScanCompleted_;
+  QElapsedTimer totalTimer;
+  totalTimer.start();
+  currentReport_ = ScanReport{};
+  currentReport_.startedAt = QDateTime::currentDateTimeUtc();
+  currentReport_.initialScan = isInitial;
+  currentReport_.watcherEventsCoalesced = pendingWatcherEvents_;
+  currentReport_.bytesHashed = std::exchange(backgroundBytesHashed_, 0);
+  pendingWatcherEvents_ = 0;
+
+  QElapsedTimer phaseTimer;
+  phaseTimer.start();
   RepoInventory inventory = buildInventory();
+  for (auto& row : repoService_->listGameMods()) {
+    std::string key = row.file_path;
+    inventory.previousScan.emplace(std::move(key), std::move(row));
+  }
+  currentReport_.inventoryMs = phaseTimer.elapsed();
   QSet<QString> files;
   QStringList updatedMods;
 
@@ -94,14 +156,35 @@ void GameDirectoryMonitor::rescanAll() {
   } else {
     repoService_->replaceGameModsForSource("workshop", {});
   }
+  // 先写回补算的指纹，本轮同步过的 MOD 随后由 flushWorkshopSync 写入新文件的指纹
+  phaseTimer.restart();
+  persistBackfill(inventory);
+  currentReport_.dbWriteMs += phaseTimer.restart();
+  flushWorkshopSync(updatedMods, inventory);
+  currentReport_.workshopSyncMs += phaseTimer.elapsed();
+  currentReport_.syncedMods = static_cast<int>(updatedMods.size());
 
+  phaseTimer.restart();
   updateFileWatches(files);
-  emit gameModsUpdated(updatedMods, isInitial);
+  currentReport_.watchUpdateMs = phaseTimer.elapsed();
+  currentReport_.totalMs = totalTimer.elapsed();
+
+  ScanReport report = currentReport_;
+  recordScanReport(report);
+  emit gameModsUpdated(updatedMods, isInitial, report);
   if (isInitial) {
     initialScanCompleted_ = true;
   }
 }
 
+void GameDirectoryMonitor::recordScanReport(ScanReport report) {
+  spdlog::debug("Game directory {}", report.summary().toStdString());
+  recentReports_.push_back(std::move(report));
+  while (recentReports_.size() > kMaxScanReports) {
+    recentReports_.pop_front();
+  }
+}
+
 void GameDirectoryMonitor::rescanSource(const QString& sourceKey,
                                         const QString& directory,
                                         RepoInventory& inventory,
@@ -111,14 +194,19 @@ void GameDirectoryMonitor::rescanSource(const QString& sourceKey,
     return;
   }
 
+  QElapsedTimer phaseTimer;
+  phaseTimer.start();
   QDir dir(directory);
   if (!dir.exists()) {
+    currentReport_.enumerationMs += phaseTimer.restart();
     repoService_->replaceGameModsForSource(sourceKey.toStdString(), {});
+    currentReport_.dbWriteMs += phaseTimer.elapsed();
     return;
   }
 
   dir.setFilter(QDir::Files | QDir::NoDotAndDotDot | QDir::Readable);
   QFileInfoList entries = dir.entryInfoList();
+  currentReport_.enumerationMs += phaseTimer.restart();
   std::vector<GameModRow> rows;
   rows.reserve(entries.size());
 
@@ -127,23 +215,32 @@ void GameDirectoryMonitor::rescanSource(const QString& sourceKey,
   const QRegularExpression numericPattern(QStringLiteral("^\\d+$"));
 
   for (const QFileInfo& info : entries) {
+    phaseTimer.restart();
     if (!info.isFile()) {
+      currentReport_.enumerationMs += phaseTimer.elapsed();
       continue;
     }
     const QString suffix = info.suffix().toLower();
     if (!kModExtensions.contains(suffix)) {
+      currentReport_.enumerationMs += phaseTimer.elapsed();
       continue;
     }
 
     watchedFiles.insert(info.absoluteFilePath());
+    currentReport_.enumerationMs += phaseTimer.restart();
 
     const QString normalizedName = normalizeKey(info.completeBaseName());
     const std::uint64_t sizeBytes = static_cast<std::uint64_t>(info.size());
+    const std::optional<FileFingerprint> fingerprint = fingerprintForFile(info, inventory);
     int matchedIndex = -1;
     ModRow* matchedMod = nullptr;
 
     if (sourceKey == QStringLiteral("addons")) {
       const ModRow* mod = findAddonMatch(normalizedName, sizeBytes, inventory, matchedIndex);
+      if (!mod && fingerprint) {
+        // 名称不一致时尝试按内容指纹识别被重命名的文件
+        mod = findFingerprintMatch(info, *fingerprint, inventory, matchedIndex);
+      }
       matchedMod = mod ? &inventory.mods[matchedIndex] : nullptr;
     } else {
       QString numericId;
@@ -153,9 +250,15 @@ void GameDirectoryMonitor::rescanSource(const QString& sourceKey,
       const ModRow* mod = findWorkshopMatch(normalizedName, numericId, inventory, matchedIndex);
       matchedMod = mod ? &inventory.mods[matchedIndex] : nullptr;
       if (matchedMod) {
+        currentReport_.matchingMs += phaseTimer.restart();
         if (auto updatedName = synchronizeWorkshopIfNeeded(info, inventory.mods[matchedIndex], numericId)) {
           updatedMods.append(*updatedName);
         }
+        currentReport_.workshopSyncMs += phaseTimer.restart();
+      } else if (fingerprint) {
+        // 指纹命中说明内容与仓库一致，无需同步
+        mod = findFingerprintMatch(info, *fingerprint, inventory, matchedIndex);
+        matchedMod = mod ? &inventory.mods[matchedIndex] : nullptr;
       }
     }
 
@@ -166,6 +269,9 @@ void GameDirectoryMonitor::rescanSource(const QString& sourceKey,
     row.file_size = sizeBytes;
     row.modified_at = info.lastModified().toUTC().toString(Qt::ISODateWithMs).toStdString();
     row.last_scanned_at = nowIso.toStdString();
+    if (fingerprint) {
+      row.fingerprint = fingerprint->head_tail_hash;
+    }
 
     if (matchedMod) {
       row.repo_mod_id = matchedMod->id;
@@ -174,14 +280,19 @@ void GameDirectoryMonitor::rescanSource(const QString& sourceKey,
       row.repo_mod_id.reset();
       row.status = tr("未入库").toStdString();
     }
+    ++currentReport_.filesScanned;
+    ++currentReport_.statusCounts[QString::fromStdString(row.status)];
+    currentReport_.matchingMs += phaseTimer.elapsed();
 
     rows.push_back(std::move(row));
   }
 
+  phaseTimer.restart();
   repoService_->replaceGameModsForSource(sourceKey.toStdString(), rows);
+  currentReport_.dbWriteMs += phaseTimer.elapsed();
 }
 
-GameDirectoryMonitor::RepoInventory GameDirectoryMonitor::buildInventory() const {
+GameDirectoryMonitor::RepoInventory GameDirectoryMonitor::buildInventory() {
   RepoInventory inventory;
   if (!repoService_) {
     return inventory;
@@ -189,21 +300,85 @@ GameDirectoryMonitor::RepoInventory GameDirectoryMonitor::buildInventory() const
   inventory.mods = repoService_->listAll(true);
   inventory.nameIndex.clear();
   inventory.steamIdIndex.clear();
+  inventory.fingerprints.assign(inventory.mods.size(), std::nullopt);
+  inventory.fileSizes.assign(inventory.mods.size(), std::nullopt);
+
+  std::unordered_map<int, FileFingerprint> storedFingerprints;
+  for (const auto& row : repoService_->listModFingerprints()) {
+    storedFingerprints.emplace(row.mod_id, FileFingerprint{row.size_bytes, row.head_tail_hash});
+  }
 
   for (size_t i = 0; i < inventory.mods.size(); ++i) {
     const ModRow& mod = inventory.mods[i];
+    // 名称可能取自 addoninfo.txt 的标题，游戏目录中的文件仍按文件名匹配，两者都要建索引
     const QString normalized = normalizeKey(QString::fromStdString(mod.name));
     if (!normalized.isEmpty()) {
       inventory.nameIndex.emplace(normalized.toStdString(), static_cast<int>(i));
     }
+    const QString normalizedStem = normalizeKey(QString::fromStdString(modFileStem(mod)));
+    if (!normalizedStem.isEmpty() && normalizedStem != normalized) {
+      inventory.nameIndex.emplace(normalizedStem.toStdString(), static_cast<int>(i));
+    }
     const QString workshopId = extractWorkshopId(mod.source_url);
     if (!workshopId.isEmpty()) {
       inventory.steamIdIndex.emplace(workshopId.toStdString(), static_cast<int>(i));
     }
+
+    // 已有的指纹记录直接采用，不访问仓库文件：过期的指纹即使命中也会被全量哈希确认排除。
+    // 没有记录的 MOD 按 size_mb 分桶，只有游戏目录中出现同桶大小的文件时才读取仓库文件补算
+    if (const auto stored = storedFingerprints.find(mod.id); stored != storedFingerprints.end()) {
+      inventory.fingerprints[i] = stored->second;
+      inventory.fileSizes[i] = stored->second.size_bytes;
+      inventory.fingerprintIndex.emplace(fingerprintKey(stored->second), static_cast<int>(i));
+    } else if (!mod.file_path.empty()) {
+      inventory.unfingerprinted.emplace(sizeBucket(mod.size_mb), static_cast<int>(i));
+    }
   }
   return inventory;
 }
 
+std::uint64_t GameDirectoryMonitor::repoFileSize(RepoInventory& inventory, int index) const {
+  auto& size = inventory.fileSizes[static_cast<std::size_t>(index)];
+  if (!size) {
+    const ModRow& mod = inventory.mods[static_cast<std::size_t>(index)];
+    const QFileInfo repoFile(cleanPath(mod.file_path));
+    size = !mod.file_path.empty() && repoFile.exists() ? static_cast<std::uint64_t>(repoFile.size()) : 0;
+  }
+  return *size;
+}
+
+void GameDirectoryMonitor::backfillFingerprints(std::uint64_t sizeBytes, RepoInventory& inventory) {
+  // size_mb 对压缩包记录的是解压后的大小，与部署到游戏目录的 VPK 一致；每个 MOD 每轮扫描至多补算一次
+  const auto range = inventory.unfingerprinted.equal_range(sizeBucket(bytesToMb(sizeBytes)));
+  for (auto it = range.first; it != range.second; ++it) {
+    const auto index = static_cast<std::size_t>(it->second);
+    const ModRow& mod = inventory.mods[index];
+    const auto fingerprint = computeFileFingerprint(toFsPath(cleanPath(mod.file_path)));
+    if (!fingerprint) {
+      continue;
+    }
+    currentReport_.bytesHashed += fingerprintReadBytes(fingerprint->size_bytes);
+    inventory.fileSizes[index] = fingerprint->size_bytes;
+    inventory.fingerprints[index] = fingerprint;
+    inventory.fingerprintIndex.emplace(fingerprintKey(*fingerprint), it->second);
+    inventory.backfill.push_back({mod.id, fingerprint->size_bytes, fingerprint->head_tail_hash});
+  }
+  inventory.unfingerprinted.erase(range.first, range.second);
+}
+
+void GameDirectoryMonitor::persistBackfill(RepoInventory& inventory) {
+  if (inventory.backfill.empty()) {
+    return;
+  }
+  try {
+    repoService_->upsertModFingerprints(inventory.backfill);
+    spdlog::info("Backfilled {} repository fingerprints.", inventory.backfill.size());
+  } catch (const std::exception& ex) {
+    spdlog::warn("Failed to persist repository fingerprints: {}", ex.what());
+  }
+  inventory.backfill.clear();
+}
+
 QString GameDirectoryMonitor::normalizeKey(const QString& text) const {
   QString normalized;
   normalized.reserve(text.size());
@@ -236,7 +411,7 @@ const ModRow* GameDirectoryMonitor::findAddonMatch(const QString& normalizedName
   for (auto it = range.first; it != range.second; ++it) {
     const int index = it->second;
     const ModRow& candidate = inventory.mods[index];
-    if (mbToBytes(candidate.size_mb) == fileSize) {
+    if (deployedSizeMatches(candidate, repoFileSize(inventory, index), fileSize)) {
       matchedIndex = index;
       return &candidate;
     }
@@ -265,6 +440,83 @@ const ModRow* GameDirectoryMonitor::findWorkshopMatch(const QString& normalizedN
   return nullptr;
 }
 
+std::optional<FileFingerprint> GameDirectoryMonitor::fingerprintForFile(const QFileInfo& info,
+                                                                       const RepoInventory& inventory) {
+  const std::string nativePath = QDir::toNativeSeparators(info.absoluteFilePath()).toStdString();
+  const auto previous = inventory.previousScan.find(nativePath);
+  if (previous != inventory.previousScan.end() && previous->second.fingerprint.has_value()) {
+    const GameModRow& cached = previous->second;
+    const std::string modifiedAt = info.lastModified().toUTC().toString(Qt::ISODateWithMs).toStdString();
+    if (cached.file_size == static_cast<std::uint64_t>(info.size()) && cached.modified_at == modifiedAt) {
+      return FileFingerprint{cached.file_size, *cached.fingerprint};
+    }
+  }
+  auto fingerprint = computeFileFingerprint(toFsPath(info.absoluteFilePath()));
+  if (fingerprint) {
+    currentReport_.bytesHashed += fingerprintReadBytes(fingerprint->size_bytes);
+  }
+  return fingerprint;
+}
+
+const ModRow* GameDirectoryMonitor::findFingerprintMatch(const QFileInfo& info,
+                                                         const FileFingerprint& fingerprint,
+                                                         RepoInventory& inventory,
+                                                         int& matchedIndex) {
+  backfillFingerprints(fingerprint.size_bytes, inventory);
+  auto range = inventory.fingerprintIndex.equal_range(fingerprintKey(fingerprint));
+  for (auto it = range.first; it != range.second; ++it) {
+    const int index = it->second;
+    const auto& candidateFingerprint = inventory.fingerprints[index];
+    if (!candidateFingerprint || *candidateFingerprint != fingerprint) {
+      continue;
+    }
+    const ModRow& candidate = inventory.mods[index];
+    // 指纹仅覆盖首尾数据，命中后以全量哈希确认；仓库记录缺少哈希或算法未知时以指纹为准。
+    // 全量哈希尚未算出时本轮暂不匹配，后台算完后会重新扫描
+    const auto algorithm = hashAlgorithmFromName(candidate.hash_algo);
+    if (!candidate.file_hash.empty() && algorithm) {
+      const auto fullHash = fullHashForFile(info, *algorithm);
+      if (!fullHash || fullHash->compare(QString::fromStdString(candidate.file_hash), Qt::CaseInsensitive) != 0) {
+        continue;
+      }
+    }
+    matchedIndex = index;
+    return &candidate;
+  }
+  return nullptr;
+}
+
+std::optional<QString> GameDirectoryMonitor::fullHashForFile(const QFileInfo& info, HashAlgorithm algorithm) {
+  const QString path = info.absoluteFilePath();
+  const std::uint64_t size = static_cast<std::uint64_t>(info.size());
+  const QDateTime modified = info.lastModified();
+  const CachedFileHash* cached = fullHashCache_.find(path);
+  if (cached && cached->size == size && cached->modified == modified && cached->algorithm == algorithm) {
+    return cached->hash;
+  }
+  if (hashingPaths_.contains(path)) {
+    return std::nullopt;
+  }
+  // 大文件的全量哈希可能耗时数秒，不在 GUI 线程中计算
+  hashingPaths_.insert(path);
+  hashPool_.start([this, path, size, modified, algorithm]() {
+    const QString hash = stopping_ ? QString() : QString::fromStdString(hashFile(toFsPath(path), algorithm));
+    QMetaObject::invokeMethod(
+        this,
+        [this, path, size, modified, algorithm, hash]() {
+          hashingPaths_.remove(path);
+          if (hash.isEmpty()) {
+            return; // 读取失败时保持未匹配，下一轮扫描再试
+          }
+          backgroundBytesHashed_ += size;
+          fullHashCache_.insert(path, CachedFileHash{size, modified, algorithm, hash}, 1);
+          rescanTimer_.start(); // 多个文件相继算完时合并为一次扫描
+        },
+        Qt::QueuedConnection);
+  });
+  return std::nullopt;
+}
+
 QString GameDirectoryMonitor::resolveStatus(const ModRow* mod,
                                             std::uint64_t fileSizeBytes,
                                             const QString& sourceKey) const {
@@ -272,12 +524,13 @@ QString GameDirectoryMonitor::resolveStatus(const ModRow* mod,
     return tr("未入库");
   }
   const QString repoFile = cleanPath(mod->file_path);
-  const bool repoExists = !repoFile.isEmpty() && QFileInfo::exists(repoFile);
+  const QFileInfo repoInfo(repoFile);
+  const bool repoExists = !repoFile.isEmpty() && repoInfo.exists();
   if (mod->is_deleted || !repoExists) {
     return tr("仓库无vpk文件");
   }
   if (sourceKey == QStringLiteral("addons")) {
-    if (mbToBytes(mod->size_mb) != fileSizeBytes) {
+    if (!deployedSizeMatches(*mod, static_cast<std::uint64_t>(repoInfo.size()), fileSizeBytes)) {
       return tr("未入库");
     }
   }
@@ -333,7 +586,10 @@ std::optional<QString> GameDirectoryMonitor::synchronizeWorkshopIfNeeded(const Q
     return QDir::cleanPath(base.filePath(fileName));
   };
 
-  if (targetPath.isEmpty()) {
+  // 内容寻址的对象以内容命名，不能原地覆盖：先复制到仓库根目录，哈希后再存为新对象
+  const ObjectStore objectStore(toFsPath(repoRoot));
+  const bool replacesObject = !targetPath.isEmpty() && objectStore.isObjectPath(toFsPath(targetPath));
+  if (targetPath.isEmpty() || replacesObject) {
     targetPath = allocateTarget(repoRoot, fileInfo.fileName());
   }
   ensureDirectory(targetPath);
@@ -341,6 +597,7 @@ std::optional<QString> GameDirectoryMonitor::synchronizeWorkshopIfNeeded(const Q
     spdlog::warn("Failed to copy workshop file {} -> {}", sourcePath.toStdString(), targetPath.toStdString());
     return std::nullopt;
   }
+  currentReport_.bytesCopied += static_cast<std::uint64_t>(fileInfo.size());
 
   QString coverSource = locateWorkshopCover(fileInfo);
   QString coverTarget = cleanPath(modRecord.cover_path);
@@ -350,52 +607,155 @@ std::optional<QString> GameDirectoryMonitor::synchronizeWorkshopIfNeeded(const Q
     }
     ensureDirectory(coverTarget);
     if (copyReplacing(coverSource, coverTarget)) {
+      currentReport_.bytesCopied += static_cast<std::uint64_t>(QFileInfo(coverSource).size());
       modRecord.cover_path = QDir::toNativeSeparators(coverTarget).toStdString();
     }
   }
 
-  QFile repoFile(targetPath);
-  if (!repoFile.open(QIODevice::ReadOnly)) {
+  const QString fileHash = QString::fromStdString(hashFile(toFsPath(targetPath), kDefaultHashAlgorithm));
+  if (fileHash.isEmpty()) {
     spdlog::warn("Failed to open copied workshop file for hashing: {}", targetPath.toStdString());
     return std::nullopt;
   }
-  QCryptographicHash hash(QCryptographicHash::Sha256);
-  while (!repoFile.atEnd()) {
-    hash.addData(repoFile.read(1 << 20));
+  currentReport_.bytesHashed += static_cast<std::uint64_t>(fileInfo.size());
+
+  if (settings_.contentAddressedStore || replacesObject) {
+    std::error_code ec;
+    const auto put = objectStore.put(toFsPath(targetPath), fileHash.toStdString(), ObjectStore::PutMode::Move, ec);
+    if (put) {
+      // by-name 条目与旧对象在记录写回后由 settlePendingObjects 整理，写回失败时旧对象仍被记录引用
+      const QString objectPath = QString::fromStdU16String(put->object.u16string());
+      pendingObjects_.push_back({put->object, replacesObject ? toFsPath(recordedRepoPath) : std::filesystem::path(),
+                                 modRecord.file_hash, fileInfo.fileName().toStdString()});
+      targetPath = QDir::cleanPath(objectPath);
+    } else {
+      // 保留仓库根目录中的副本，下次导入时仍可整理进对象库
+      spdlog::warn("Failed to store workshop file {} by content: {}", targetPath.toStdString(), ec.message());
+    }
   }
 
-  modRecord.file_hash = QString::fromLatin1(hash.result().toHex()).toStdString();
+  modRecord.file_hash = fileHash.toStdString();
+  modRecord.hash_algo = std::string(hashAlgorithmName(kDefaultHashAlgorithm));
   modRecord.file_path = QDir::toNativeSeparators(targetPath).toStdString();
   modRecord.size_mb = bytesToMb(static_cast<std::uint64_t>(fileInfo.size()));
   const QString dateText = workshopMtime.date().toString(QStringLiteral("yyyy-MM-dd"));
   modRecord.last_saved_at = dateText.toStdString();
   modRecord.last_published_at = dateText.toStdString();
 
-  auto tagDescriptors = tagsForMod(modRecord.id);
+  // 仅记录文件列的变化，扫描结束后由 flushWorkshopSync 统一写回
+  ModFileMetadataRow metadata;
+  metadata.mod_id = modRecord.id;
+  metadata.file_path = modRecord.file_path;
+  metadata.file_hash = modRecord.file_hash;
+  metadata.hash_algo = modRecord.hash_algo;
+  metadata.size_mb = modRecord.size_mb;
+  metadata.last_published_at = modRecord.last_published_at;
+  metadata.last_saved_at = modRecord.last_saved_at;
+  metadata.cover_path = modRecord.cover_path;
+  metadata.storage_method = std::string(storageMethodName(StorageMethod::Copy)); // 覆盖复制会替换原有链接
+  pendingFileMetadata_.push_back(std::move(metadata));
+  if (const auto fingerprint = computeFileFingerprint(toFsPath(targetPath))) {
+    currentReport_.bytesHashed += fingerprintReadBytes(fingerprint->size_bytes);
+    pendingFingerprints_.push_back({modRecord.id, fingerprint->size_bytes, fingerprint->head_tail_hash});
+  }
+  const QString name = QString::fromStdString(modRecord.name);
+  pendingSyncedNames_.append(name);
+  return name;
+}
+
+void GameDirectoryMonitor::flushWorkshopSync(QStringList& updatedMods, const RepoInventory& inventory) {
+  if (pendingFileMetadata_.empty()) {
+    return;
+  }
+  bool metadataSaved = true;
   try {
-    repoService_->updateModWithTags(modRecord, tagDescriptors);
-    spdlog::info("Workshop mod {} synchronized to repository.", modRecord.name);
-    return QString::fromStdString(modRecord.name);
+    repoService_->updateModFileMetadata(pendingFileMetadata_);
+    spdlog::info("{} workshop mods synchronized to repository.", pendingFileMetadata_.size());
   } catch (const std::exception& ex) {
-    spdlog::error("Failed to update repository record for {}: {}", modRecord.name, ex.what());
-    return std::nullopt;
+    spdlog::error("Failed to update repository records for synchronized workshop mods: {}", ex.what());
+    for (const QString& name : pendingSyncedNames_) {
+      updatedMods.removeAll(name);
+    }
+    pendingFingerprints_.clear();
+    pendingObjects_.clear();
+    metadataSaved = false;
+  }
+  if (!pendingFingerprints_.empty()) {
+    try {
+      repoService_->upsertModFingerprints(pendingFingerprints_);
+    } catch (const std::exception& ex) {
+      spdlog::warn("Failed to persist fingerprints for synchronized workshop mods: {}", ex.what());
+    }
+  }
+  if (metadataSaved) {
+    // 同步后的文件内容已变化，增量刷新其资源路径索引
+    std::vector<ModAssetList> assets;
+    for (const auto& row : pendingFileMetadata_) {
+      const QString path = QString::fromStdString(row.file_path);
+      if (!path.endsWith(QStringLiteral(".vpk"), Qt::CaseInsensitive)) {
+        continue;
+      }
+      std::error_code ec;
+      if (auto paths = readConflictAssetPaths(std::filesystem::path(path.toStdU16String()), ec)) {
+        assets.push_back({row.mod_id, row.file_hash, std::move(*paths)});
+      }
+    }
+    try {
+      repoService_->indexModAssets(assets);
+    } catch (const std::exception& ex) {
+      spdlog::warn("Failed to index assets for synchronized workshop mods: {}", ex.what());
+    }
+    settlePendingObjects(inventory);
   }
+  pendingFileMetadata_.clear();
+  pendingFingerprints_.clear();
+  pendingSyncedNames_.clear();
 }
 
-QString GameDirectoryMonitor::locateWorkshopCover(const QFileInfo& fileInfo) const {
-  static const QStringList kImageExt = {"png", "jpg", "jpeg", "bmp", "webp"};
-  const QString base = fileInfo.completeBaseName();
-  if (base.isEmpty()) {
-    return {};
+void GameDirectoryMonitor::settlePendingObjects(const RepoInventory& inventory) {
+  const QString repoRoot = cleanPath(settings_.repoDir);
+  if (pendingObjects_.empty() || repoRoot.isEmpty()) {
+    pendingObjects_.clear();
+    return;
   }
-  const QDir dir = fileInfo.dir();
-  for (const QString& ext : kImageExt) {
-    const QString candidate = dir.filePath(QStringLiteral("%1.%2").arg(base, ext));
-    if (QFileInfo::exists(candidate)) {
-      return candidate;
+  // 同步过的记录已在 inventory 中改为新路径与新哈希，仍引用旧对象的只可能是其它 MOD（含已逻辑删除的）；
+  // 对象以哈希命名，同哈希的记录也视为引用，宁可保留也不误删
+  QSet<QString> referencedPaths;
+  QSet<QString> referencedHashes;
+  for (const auto& mod : inventory.mods) {
+    if (!mod.file_path.empty()) {
+      referencedPaths.insert(cleanPath(mod.file_path));
+    }
+    if (!mod.file_hash.empty()) {
+      referencedHashes.insert(QString::fromStdString(mod.file_hash).toLower());
     }
   }
-  return {};
+
+  const ObjectStore objectStore(toFsPath(repoRoot));
+  for (const auto& pending : pendingObjects_) {
+    const QString replaced = QDir::cleanPath(QString::fromStdU16String(pending.replaced.u16string()));
+    const QString object = QDir::cleanPath(QString::fromStdU16String(pending.object.u16string()));
+    const bool stillReferenced = referencedPaths.contains(replaced) ||
+                                 referencedHashes.contains(QString::fromStdString(pending.replacedHash).toLower());
+    if (!pending.replaced.empty() && replaced != object && !stillReferenced) {
+      // 旧对象的 by-name 条目改指向新对象，随后按同名建立索引时直接复用，不会追加 _1 后缀
+      std::error_code ec;
+      if (objectStore.release(pending.replaced, pending.object, ec)) {
+        spdlog::info("Released replaced workshop object {}", replaced.toStdString());
+      } else {
+        spdlog::warn("Failed to release replaced workshop object {}: {}", replaced.toStdString(), ec.message());
+      }
+    }
+    std::error_code indexEc;
+    objectStore.linkName(pending.object, pending.name, indexEc);
+  }
+  pendingObjects_.clear();
+}
+
+QString GameDirectoryMonitor::locateWorkshopCover(const QFileInfo& fileInfo) const {
+  // workshop 目录中封面与 vpk 同名（Steam 数字 ID），只接受精确匹配
+  const auto index = CoverIndex::forDirectory(fileInfo.absolutePath());
+  return index->findExact(CoverIndex::normalizeName(fileInfo.completeBaseName()));
 }
 
 bool GameDirectoryMonitor::copyReplacing(const QString& src, const QString& dst) const {
@@ -413,22 +773,6 @@ bool GameDirectoryMonitor::copyReplacing(const QString& src, const QString& dst)
   return QFile::copy(src, dst);
 }
 
-std::vector<TagDescriptor> GameDirectoryMonitor::tagsForMod(int modId) const {
-  std::vector<TagDescriptor> tags;
-  if (!repoService_) {
-    return tags;
-  }
-  auto rows = repoService_->listTagsForMod(modId);
-  tags.reserve(rows.size());
-  for (const auto& row : rows) {
-    TagDescriptor descriptor;
-    descriptor.group = row.group_name;
-    descriptor.tag = row.name;
-    tags.push_back(std::move(descriptor));
-  }
-  return tags;
-}
-
 void GameDirectoryMonitor::updateDirectoryWatches(const QStringList& directories) {
   for (const QString& dir : watchedDirectories_) {
     watcher_.removePath(dir);
@@ -1,18 +1,28 @@
 #pragma once
 
+#include <QDateTime>
 #include <QFileSystemWatcher>
 #include <QFileInfo>
 #include <QObject>
 #include <QSet>
 #include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <atomic>
 #include <cstdint>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
+#include <deque>
 #include <unordered_map>
 
+#include "app/services/ScanReport.h"
 #include "core/config/Settings.h"
+#include "core/hash/FileHasher.h"
+#include "core/hash/Fingerprint.h"
 #include "core/repo/RepositoryService.h"
+#include "core/util/LruCache.h"
 
 class ImportService;
 
@@ -22,11 +32,15 @@ class ImportService;
  * - 首次配置时立即进行一次全量扫描，仅采集基础元数据并写入 gamemods 缓存表。
  * - 后续通过 QFileSystemWatcher 监听目录/文件变动，触发增量刷新。
  * - 同时负责检测 workshop 中的 MOD 是否较仓库版本更新，如有则执行文件同步与仓库记录更新。
+ * - 名称匹配失败时，按“文件大小 + 首尾 64 KiB 哈希”的内容指纹识别被重命名/移动的文件，
+ *   指纹命中后再以全量哈希确认；全量哈希在后台线程计算，算完后重新扫描一次以采用结果。
+ * - 监听事件在短时间内合并为一次扫描；每次扫描生成 ScanReport，保留最近若干份供诊断查看。
  */
 class GameDirectoryMonitor : public QObject {
   Q_OBJECT
 public:
   explicit GameDirectoryMonitor(QObject* parent = nullptr);
+  ~GameDirectoryMonitor() override;
 
   /**
    * @brief 配置扫描所需的依赖并开始监听。
@@ -38,11 +52,17 @@ public:
                  RepositoryService* repoService,
                  ImportService* importService);
 
+  /// 最近若干次扫描的报告（按时间先后排列，最多 kMaxScanReports 份）。
+  const std::deque<ScanReport>& recentScanReports() const { return recentReports_; }
+
+  static constexpr std::size_t kMaxScanReports = 16;
+
 signals:
   /// 缓存内容更新后发射，提示 UI 重新加载游戏目录列表。
   /// @param updatedMods 本次扫描期间同步到仓库的 MOD 名称列表。
   /// @param initialScan true 表示这是应用启动后的首次全量扫描。
-  void gameModsUpdated(const QStringList& updatedMods, bool initialScan);
+  /// @param report 本次扫描的耗时与计数报告。
+  void gameModsUpdated(const QStringList& updatedMods, bool initialScan, const ScanReport& report);
 
 private slots:
   void onDirectoryChanged(const QString& path);
@@ -53,6 +73,32 @@ private:
     std::vector<ModRow> mods;
     std::unordered_multimap<std::string, int> nameIndex;
     std::unordered_multimap<std::string, int> steamIdIndex;
+    std::vector<std::optional<FileFingerprint>> fingerprints; ///< 与 mods 下标一一对应
+    /// 仓库文件的字节数（文件不存在时为 0），与 mods 下标一一对应；有指纹记录时取记录中的大小，否则由 repoFileSize 按需读取
+    std::vector<std::optional<std::uint64_t>> fileSizes;
+    std::unordered_multimap<std::uint64_t, int> fingerprintIndex; ///< fingerprintKey -> mods 下标
+    std::unordered_multimap<std::int64_t, int> unfingerprinted; ///< 尚无指纹记录的 MOD：sizeBucket(size_mb) -> mods 下标
+    std::vector<ModFingerprintRow> backfill; ///< 本轮扫描中补算的仓库指纹，扫描结束后写回
+    std::unordered_map<std::string, GameModRow> previousScan; ///< 上一轮扫描结果，用于复用未变化文件的指纹
+  };
+
+  /// 同步时新存入对象库的文件，写回仓库记录后再整理 by-name 条目与被替换的旧对象。
+  struct PendingObject {
+    std::filesystem::path object;   ///< 新对象
+    std::filesystem::path replaced; ///< 记录原先引用的对象，不是对象时为空
+    std::string replacedHash;       ///< 记录原先的文件哈希（即旧对象名）
+    std::string name;               ///< by-name 条目名（workshop 中的文件名）
+  };
+
+  /// 全量哈希缓存最多记住的文件数，超出后淘汰最久未用到的文件。
+  static constexpr std::size_t kMaxCachedFullHashes = 4096;
+
+  /// 全量哈希缓存项，按文件大小、修改时间与算法判断是否仍然有效。
+  struct CachedFileHash {
+    std::uint64_t size{0};
+    QDateTime modified;
+    HashAlgorithm algorithm{kDefaultHashAlgorithm};
+    QString hash;
   };
 
   void rescanAll();
@@ -61,17 +107,29 @@ private:
                     RepoInventory& inventory,
                     QSet<QString>& watchedFiles,
                     QStringList& updatedMods);
-  RepoInventory buildInventory() const;
+  RepoInventory buildInventory();
   QString normalizeKey(const QString& text) const;
   QString extractWorkshopId(const std::string& url) const;
   const ModRow* findAddonMatch(const QString& normalizedName,
                                std::uint64_t fileSize,
                                RepoInventory& inventory,
                                int& matchedIndex) const;
+  std::uint64_t repoFileSize(RepoInventory& inventory, int index) const;
+  void backfillFingerprints(std::uint64_t sizeBytes, RepoInventory& inventory);
+  void persistBackfill(RepoInventory& inventory);
   const ModRow* findWorkshopMatch(const QString& normalizedName,
                                   const QString& numericId,
                                   RepoInventory& inventory,
                                   int& matchedIndex) const;
+  std::optional<FileFingerprint> fingerprintForFile(const QFileInfo& info, const RepoInventory& inventory);
+  void scheduleRescan();
+  void recordScanReport(ScanReport report);
+  const ModRow* findFingerprintMatch(const QFileInfo& info,
+                                     const FileFingerprint& fingerprint,
+                                     RepoInventory& inventory,
+                                     int& matchedIndex);
+  /// 缓存中仍然有效的全量哈希；没有时交给 hashPool_ 计算并返回 std::nullopt。
+  std::optional<QString> fullHashForFile(const QFileInfo& info, HashAlgorithm algorithm);
   QString resolveStatus(const ModRow* mod,
                         std::uint64_t fileSizeBytes,
                         const QString& sourceKey) const;
@@ -80,7 +138,8 @@ private:
                                                      const QString& numericId);
   QString locateWorkshopCover(const QFileInfo& fileInfo) const;
   bool copyReplacing(const QString& src, const QString& dst) const;
-  std::vector<TagDescriptor> tagsForMod(int modId) const;
+  void flushWorkshopSync(QStringList& updatedMods, const RepoInventory& inventory);
+  void settlePendingObjects(const RepoInventory& inventory);
   void updateDirectoryWatches(const QStringList& directories);
   void updateFileWatches(const QSet<QString>& newFiles);
 
@@ -92,5 +151,18 @@ private:
   QFileSystemWatcher watcher_;
   QStringList watchedDirectories_;
   QSet<QString> watchedFiles_;
+  QTimer rescanTimer_; ///< 合并短时间内的多次监听事件
+  int pendingWatcherEvents_{0};
+  ScanReport currentReport_; ///< 正在进行的扫描的统计
+  std::deque<ScanReport> recentReports_;
+  LruCache<QString, CachedFileHash> fullHashCache_{kMaxCachedFullHashes}; ///< 文件路径 -> 全量哈希，每项开销计 1
+  QSet<QString> hashingPaths_; ///< 已交给 hashPool_、结果尚未写回 fullHashCache_ 的文件
+  std::uint64_t backgroundBytesHashed_{0}; ///< 后台全量哈希读取的字节数，计入下一次扫描报告
+  std::vector<ModFileMetadataRow> pendingFileMetadata_; ///< 本轮扫描中待写回仓库的同步结果
+  std::vector<ModFingerprintRow> pendingFingerprints_; ///< 与 pendingFileMetadata_ 对应的新指纹
+  QStringList pendingSyncedNames_; ///< 与 pendingFileMetadata_ 对应的 MOD 名称
+  std::vector<PendingObject> pendingObjects_; ///< 本轮同步中新存入对象库的文件
   bool initialScanCompleted_{false};
+  std::atomic<bool> stopping_{false}; ///< 析构时置位，排队中的哈希任务不再读取文件
+  QThreadPool hashPool_; ///< 计算确认指纹命中的全量哈希，结果回到 GUI 线程写入缓存
 };
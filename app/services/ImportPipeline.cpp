@@ -0,0 +1,679 @@
+// UTF-8
+#include "app/services/ImportPipeline.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QMetaObject>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <future>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#include "app/services/ImportService.h"
+#include "core/db/Db.h"
+#include "core/hash/FileHasher.h"
+
+namespace {
+
+inline std::filesystem::path toFsPath(const QString& path) {
+  return std::filesystem::path(path.toStdU16String());
+}
+
+// 导入日志与仓库路径比较时使用的规范化路径
+inline std::string journalKey(const QString& path) {
+  return QDir::cleanPath(QDir::fromNativeSeparators(path)).toStdString();
+}
+
+// size_mb 换算回的字节数；编辑器按两位小数保存，误差不超过 kSizeMbSlackBytes
+inline std::uint64_t mbToBytes(double mb) {
+  return static_cast<std::uint64_t>(std::llround(mb * 1024.0 * 1024.0));
+}
+constexpr std::uint64_t kSizeMbSlackBytes = 5243; // 0.005 MiB，向上取整
+
+// 已完成（无需再处理）的日志阶段
+inline bool isFinishedStage(ImportStage stage) {
+  return stage == ImportStage::Inserted || stage == ImportStage::Duplicate || stage == ImportStage::Transferred;
+}
+
+std::string importActionName(ImportAction action) {
+  switch (action) {
+    case ImportAction::Cut: return "Cut";
+    case ImportAction::Copy: return "Copy";
+    case ImportAction::Link: return "Link";
+  }
+  return "Cut";
+}
+
+// 由已转移到仓库目录的文件与日志记录重建待入库的 MOD
+ModRow modFromJournal(const ImportJournalRow& row) {
+  const QFileInfo target(QDir::fromNativeSeparators(QString::fromStdString(row.target_path)));
+  ModRow mod = ImportService::buildModFromFile(target, false);
+  if (!row.mod_name.empty()) {
+    mod.name = row.mod_name;
+  }
+  mod.file_hash = row.file_hash;
+  mod.hash_algo = row.hash_algo;
+  mod.storage_method = row.storage_method;
+  mod.cover_path = row.cover_path; // 仓库目录中按名称匹配到的图片未必属于该 MOD，以日志为准
+  if (!mod.cover_path.empty() && !QFileInfo::exists(QDir::fromNativeSeparators(QString::fromStdString(mod.cover_path)))) {
+    mod.cover_path.clear(); // 封面的传输可能在中断前尚未完成
+  }
+  return mod;
+}
+
+// 仓库中已登记的文件路径（含已逻辑删除的记录），续传时判断已转移的文件是否已经入库
+std::unordered_set<std::string> registeredFilePaths(const RepositoryService& repo) {
+  std::unordered_set<std::string> paths;
+  for (const auto& mod : repo.listAll(true)) {
+    if (!mod.file_path.empty()) {
+      paths.insert(journalKey(QString::fromStdString(mod.file_path)));
+    }
+  }
+  return paths;
+}
+
+}  // namespace
+
+ImportPipeline::ImportPipeline(RepositoryService& repo,
+                               const ImportService& importService,
+                               const Settings& settings,
+                               QObject* parent)
+    : QObject(parent), repo_(repo), importService_(importService), settings_(settings) {}
+
+ImportPipeline::~ImportPipeline() {
+  cancel();
+  joinThreads();
+}
+
+void ImportPipeline::start(const Options& options) {
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  result_ = Result{};
+  cancelled_ = false;
+  enumerationDone_ = false;
+  discovered_ = 0;
+  processed_ = 0;
+  resumed_ = 0;
+
+  // 仓库中的哈希、大小与指纹由枚举线程载入（见 loadRepositoryIndex），界面线程不读取整个仓库与文件大小
+  knownHashes_.clear();
+  knownFiles_.clear();
+  candidates_.clear();
+  decisions_.clear();
+
+  openJournal(options);
+
+  pathQueue_ = std::make_unique<BoundedQueue<std::size_t>>(options.queueCapacity);
+  hashedQueue_ = std::make_unique<BoundedQueue<HashedItem>>(options.queueCapacity);
+
+  int workers = options.hashWorkers;
+  if (workers <= 0) {
+    workers = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 2, 8);
+  }
+  workers_ = workers;
+  activeHashers_ = workers;
+
+  enumerator_ = std::thread(&ImportPipeline::enumerateStage, this, options);
+  for (int i = 0; i < workers; ++i) {
+    hashers_.emplace_back(&ImportPipeline::hashStage, this);
+  }
+  TransferOptions transferOptions;
+  transferOptions.queueDepth = options.transferQueueDepth;
+  transferOptions.maxBytesPerSecond = options.maxTransferBytesPerSecond;
+  // 取消时正在复制的文件在下一块处中止，不必等整批传输结束
+  transferOptions.cancelled = &cancelled_;
+  transferOptions.onProgress = [this](std::uint64_t doneBytes, std::uint64_t totalBytes) {
+    // 每传输一块都会回调，只在千分比变化时通知界面，避免事件队列堆积
+    const int permille = totalBytes > 0 ? static_cast<int>(doneBytes * 1000 / totalBytes) : 1000;
+    if (transferPermille_.exchange(permille) != permille) {
+      emit transferProgress(static_cast<qint64>(doneBytes), static_cast<qint64>(totalBytes));
+    }
+  };
+  transfer_ = std::thread(&ImportPipeline::transferStage, this, transferOptions,
+                          std::max<std::size_t>(1, options.commitBatchSize));
+}
+
+void ImportPipeline::cancel() {
+  if (cancelled_.exchange(true)) {
+    return;
+  }
+  // 丢弃尚未处理的路径与哈希结果，唤醒所有阻塞中的阶段
+  if (pathQueue_) {
+    pathQueue_->abort();
+  }
+  if (hashedQueue_) {
+    hashedQueue_->abort();
+  }
+}
+
+void ImportPipeline::loadRepositoryIndex() {
+  auto rows = std::make_shared<std::pair<std::vector<ModFingerprintRow>, std::vector<ModRow>>>();
+  bool loaded = false;
+  if (!settings_.repoDbPath.empty()) {
+    try {
+      // 与 ModStore::reloadAsync 相同，后台线程使用独立的数据库连接
+      const RepositoryService service(std::make_shared<Db>(settings_.repoDbPath));
+      rows->first = service.listModFingerprints();
+      rows->second = service.listAll(true);
+      loaded = true;
+    } catch (const std::exception& e) {
+      spdlog::warn("Background repository index load failed, reading on the GUI thread: {}", e.what());
+    }
+  }
+  if (!loaded) {
+    // 退回到界面线程读取共享连接，等待期间可被取消
+    auto done = std::make_shared<std::promise<void>>();
+    auto ready = done->get_future();
+    QMetaObject::invokeMethod(
+        this,
+        [this, rows, done]() {
+          try {
+            rows->first = repo_.listModFingerprints();
+            rows->second = repo_.listAll(true);
+          } catch (const std::exception& e) {
+            spdlog::warn("Failed to load repository index for import: {}", e.what());
+          }
+          done->set_value();
+        },
+        Qt::QueuedConnection);
+    while (ready.wait_for(std::chrono::milliseconds(50)) != std::future_status::ready) {
+      if (cancelled_) {
+        return;
+      }
+    }
+  }
+
+  std::unordered_map<int, std::uint64_t> storedFingerprints;
+  std::unordered_map<int, std::uint64_t> storedSizes;
+  for (const auto& row : rows->first) {
+    storedFingerprints.emplace(row.mod_id, row.head_tail_hash);
+    storedSizes.emplace(row.mod_id, row.size_bytes);
+  }
+  for (const auto& mod : rows->second) {
+    if (cancelled_) {
+      return;
+    }
+    if (!mod.file_hash.empty()) {
+      knownHashes_.insert(mod.file_hash);
+    }
+    KnownFile known;
+    known.id = mod.id;
+    // 早期以 SHA-256 记录的哈希由检测器在哈希线程中按 SHA-256 计算同大小的待导入文件来比较
+    const auto algorithm = hashAlgorithmFromName(mod.hash_algo);
+    if (algorithm == kDefaultHashAlgorithm) {
+      known.full_hash = mod.file_hash;
+    } else if (algorithm == HashAlgorithm::Sha256) {
+      known.legacy_hash = mod.file_hash;
+    }
+    known.path = toFsPath(QDir::fromNativeSeparators(QString::fromStdString(mod.file_path)));
+    if (const auto size = storedSizes.find(mod.id); size != storedSizes.end()) {
+      known.size_bytes = size->second;
+      known.head_tail_hash = storedFingerprints[mod.id];
+    } else {
+      // 没有指纹记录时以文件实际大小为准，size_mb 经过换算无法精确还原字节数
+      std::error_code ec;
+      const auto size = mod.file_path.empty() ? 0 : std::filesystem::file_size(known.path, ec);
+      if (!mod.file_path.empty() && !ec) {
+        known.size_bytes = static_cast<std::uint64_t>(size);
+      } else if (!known.legacy_hash.empty() && mod.size_mb > 0.0) {
+        // 文件已丢失的早期记录没有 BLAKE3 哈希，knownHashes_ 无法识别，按 size_mb 的近似范围比较 SHA-256
+        known.size_bytes = mbToBytes(mod.size_mb);
+        known.size_slack_bytes = kSizeMbSlackBytes;
+      } else {
+        continue;
+      }
+    }
+    knownFiles_.push_back(std::move(known));
+  }
+}
+
+void ImportPipeline::openJournal(const Options& options) {
+  journal_.clear();
+  jobId_ = 0;
+  const std::string sourceDir = journalKey(QFileInfo(options.directory).absoluteFilePath());
+  try {
+    // 此前中断的复制只会留下临时文件（含对象存储子目录中的），导入开始前统一清理
+    const QString repoDir = QDir::cleanPath(QDir::fromNativeSeparators(QString::fromStdString(settings_.repoDir)));
+    if (!repoDir.isEmpty()) {
+      if (const auto removed = TransferEngine::removeStalePartials(toFsPath(repoDir)); removed > 0) {
+        spdlog::info("Removed {} partial files left by an interrupted import", removed);
+      }
+    }
+
+    const auto job = options.resume ? repo_.findResumableImportJob(sourceDir) : std::nullopt;
+    if (!job) {
+      jobId_ = repo_.beginImportJob(sourceDir, options.recursive, importActionName(settings_.importAction));
+      return;
+    }
+    jobId_ = job->id;
+
+    CommitBatch recovered;
+    std::vector<ImportJournalRow> corrected;
+    std::optional<std::unordered_set<std::string>> repoFilePaths; // 仅在有已落盘的记录需要核对时载入
+    for (auto& row : repo_.listImportJournal(jobId_)) {
+      // “已哈希”且带目标路径的记录在传输开始前写入，目标文件可能已经完整落盘
+      const bool planned = row.stage == ImportStage::Hashed && !row.target_path.empty();
+      if (row.stage == ImportStage::Transferred || planned) {
+        const QString target = QDir::fromNativeSeparators(QString::fromStdString(row.target_path));
+        const QFileInfo targetInfo(target);
+        // 传输先写临时文件、落盘后再改名，目标文件存在即为完整文件；仍核对大小，
+        // 排除同名的无关文件以及在改名之后被截断或替换的文件
+        const bool landed = !target.isEmpty() && targetInfo.exists() &&
+                            static_cast<std::uint64_t>(targetInfo.size()) == row.size_bytes;
+        if (!repoFilePaths) {
+          repoFilePaths = registeredFilePaths(repo_);
+        }
+        if (repoFilePaths->count(journalKey(target)) > 0) {
+          // 已转移的文件：入库已提交，仅日志未跟上；规划中的目标已被登记（同内容对象）：按重复处理
+          row.stage = planned ? ImportStage::Duplicate : ImportStage::Inserted;
+          corrected.push_back(row);
+        } else if (landed) {
+          // 文件已在仓库目录中但尚未入库：不再转移，直接补登
+          row.stage = ImportStage::Transferred;
+          recovered.mods.push_back(modFromJournal(row));
+          recovered.fingerprints.push_back(row.head_tail_hash
+                                               ? std::optional<FileFingerprint>(
+                                                     FileFingerprint{row.size_bytes, *row.head_tail_hash})
+                                               : std::nullopt);
+          recovered.modJournal.push_back(row);
+          recovered.assetPaths.push_back(std::nullopt); // 由冲突检测时的补扫处理
+          recovered.names << QFileInfo(target).fileName();
+        } else {
+          // 目标文件已丢失，退回到转移之前的阶段重新处理
+          row.stage = row.file_hash.empty() ? ImportStage::Pending : ImportStage::Hashed;
+          row.target_path.clear();
+          corrected.push_back(row);
+        }
+      }
+      const std::string key = row.source_path;
+      journal_.emplace(key, std::move(row));
+    }
+    repo_.recordImportJournal(corrected);
+    if (!recovered.mods.empty()) {
+      resumed_ += static_cast<int>(recovered.mods.size());
+      commitBatch(recovered);
+    }
+    spdlog::info("Resuming folder import job {} with {} journal entries", jobId_, journal_.size());
+  } catch (const std::exception& e) {
+    // 日志不可用时照常导入，只是失去续传能力
+    spdlog::warn("Import journal unavailable: {}", e.what());
+    jobId_ = 0;
+    journal_.clear();
+  }
+}
+
+const ImportJournalRow* ImportPipeline::journalEntryFor(const QFileInfo& info) const {
+  const auto it = journal_.find(journalKey(info.absoluteFilePath()));
+  if (it == journal_.end()) {
+    return nullptr;
+  }
+  // 源文件在两次导入之间被修改过时，日志不再可信
+  const ImportJournalRow& row = it->second;
+  if (row.size_bytes != static_cast<std::uint64_t>(info.size()) ||
+      row.modified_at != info.lastModified().toMSecsSinceEpoch()) {
+    return nullptr;
+  }
+  return &row;
+}
+
+ImportJournalRow ImportPipeline::makeJournalRow(const QFileInfo& info, ImportStage stage) const {
+  ImportJournalRow row;
+  row.job_id = jobId_;
+  row.source_path = journalKey(info.absoluteFilePath());
+  row.size_bytes = static_cast<std::uint64_t>(info.size());
+  row.modified_at = info.lastModified().toMSecsSinceEpoch();
+  row.stage = stage;
+  return row;
+}
+
+void ImportPipeline::enumerateStage(Options options) {
+  QDirIterator::IteratorFlags flags = options.recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags;
+  QDirIterator iterator(options.directory, QStringList(), QDir::Files | QDir::Readable, flags);
+  std::vector<std::filesystem::path> paths;
+  std::vector<std::uint64_t> sizes;
+  while (iterator.hasNext() && !cancelled_) {
+    iterator.next();
+    const QFileInfo info = iterator.fileInfo();
+    if (!ImportService::isSupportedModFile(info)) {
+      continue;
+    }
+    ++discovered_;
+    if (const ImportJournalRow* entry = journalEntryFor(info); entry && isFinishedStage(entry->stage)) {
+      // 上次导入已处理完该文件
+      ++resumed_;
+      ++processed_;
+      continue;
+    }
+    candidates_.push_back(info);
+    paths.push_back(toFsPath(info.absoluteFilePath()));
+    sizes.push_back(static_cast<std::uint64_t>(info.size()));
+  }
+  enumerationDone_ = true;
+  emit progress(processed_, discovered_, true);
+
+  loadRepositoryIndex();
+
+  // 枚举结束后统一做大小分桶去重，保证重复文件在任何移动发生之前就已确定
+  // 检测器已按文件并行，单个文件的哈希不再拆分线程
+  DuplicateDetector detector(
+      std::move(knownFiles_),
+      [](const std::filesystem::path& path) { return hashFile(path, kDefaultHashAlgorithm, 1); },
+      [](const std::filesystem::path& path) { return hashFile(path, HashAlgorithm::Sha256, 1); });
+  decisions_ = detector.resolve(paths, sizes, workers_, &cancelled_);
+  spdlog::debug("Import duplicate analysis read {} bytes for {} files", detector.bytesHashed(), paths.size());
+
+  CommitBatch duplicateBatch;
+  for (std::size_t i = 0; i < decisions_.size(); ++i) {
+    if (decisions_[i].isDuplicate()) {
+      duplicateBatch.duplicates << candidates_[i].fileName();
+      duplicateBatch.journal.push_back(makeJournalRow(candidates_[i], ImportStage::Duplicate));
+      ++processed_;
+    }
+  }
+  if (!duplicateBatch.duplicates.isEmpty()) {
+    emit duplicatesDetected(duplicateBatch.duplicates);
+    emit progress(processed_, discovered_, true);
+    postBatch(std::move(duplicateBatch));
+  }
+
+  for (std::size_t i = 0; i < decisions_.size() && !cancelled_; ++i) {
+    if (decisions_[i].isDuplicate()) {
+      continue;
+    }
+    if (!pathQueue_->push(i)) {
+      break;
+    }
+  }
+  pathQueue_->close();
+}
+
+void ImportPipeline::hashStage() {
+  while (auto index = pathQueue_->pop()) {
+    const DuplicateDecision& decision = decisions_[*index];
+    HashedItem item;
+    item.info = candidates_[*index];
+    item.mod = ImportService::buildModFromFile(item.info, false, &item.archive);
+    const ImportJournalRow* previous = journalEntryFor(item.info);
+    item.fingerprint = decision.fingerprint;
+    if (!item.fingerprint && previous && previous->head_tail_hash) {
+      item.fingerprint = FileFingerprint{previous->size_bytes, *previous->head_tail_hash};
+    }
+    if (!item.fingerprint) {
+      item.fingerprint = computeFileFingerprint(toFsPath(item.info.absoluteFilePath()));
+    }
+
+    // 去重阶段或上次导入已算出的全量哈希直接复用；其余文件已确认不会重复，但入库记录仍需要哈希
+    QString hash = QString::fromStdString(decision.full_hash);
+    if (hash.isEmpty() && previous && !previous->file_hash.empty() &&
+        hashAlgorithmFromName(previous->hash_algo) == kDefaultHashAlgorithm) {
+      hash = QString::fromStdString(previous->file_hash);
+    }
+    if (hash.isEmpty()) {
+      hash = ImportService::computeFileHash(item.info.absoluteFilePath());
+      if (hash.isEmpty()) {
+        item.error = tr("无法读取文件");
+      }
+    }
+    if (!item.fingerprint && item.error.isEmpty()) {
+      item.error = tr("无法读取文件");
+    }
+    item.mod.file_hash = hash.toStdString();
+    if (!hash.isEmpty()) {
+      item.mod.hash_algo = std::string(hashAlgorithmName(kDefaultHashAlgorithm));
+    }
+
+    item.journal = makeJournalRow(item.info, item.error.isEmpty() ? ImportStage::Hashed : ImportStage::Failed);
+    item.journal.file_hash = item.mod.file_hash;
+    item.journal.hash_algo = item.mod.hash_algo;
+    if (item.fingerprint) {
+      item.journal.head_tail_hash = item.fingerprint->head_tail_hash;
+    }
+    item.journal.mod_name = item.mod.name;
+    item.journal.error = item.error.toStdString();
+    if (item.error.isEmpty() && item.info.suffix().compare(QStringLiteral("vpk"), Qt::CaseInsensitive) == 0) {
+      std::error_code ec;
+      item.assetPaths = readConflictAssetPaths(toFsPath(item.info.absoluteFilePath()), ec);
+    }
+    if (!hashedQueue_->push(std::move(item))) {
+      break;
+    }
+  }
+  // 最后一个退出的哈希线程负责关闭下游队列
+  if (--activeHashers_ == 0) {
+    hashedQueue_->close();
+  }
+}
+
+void ImportPipeline::transferStage(TransferOptions transferOptions, std::size_t commitBatchSize) {
+  std::unordered_set<std::string> batchHashes;
+  CommitBatch batch;
+  // 每次凑够若干文件一起交给传输引擎，让多个文件的读写相互重叠
+  const std::size_t groupSize = static_cast<std::size_t>(std::max(1, transferOptions.queueDepth)) * 2;
+
+  while (auto first = hashedQueue_->pop()) {
+    std::vector<HashedItem> group;
+    group.push_back(std::move(*first));
+    while (group.size() < groupSize) {
+      auto next = hashedQueue_->tryPop();
+      if (!next) {
+        break;
+      }
+      group.push_back(std::move(*next));
+    }
+
+    std::vector<ModRow> toTransfer;
+    std::vector<std::size_t> transferIndex;
+    CommitBatch hashedCheckpoint;
+    for (std::size_t n = 0; n < group.size(); ++n) {
+      HashedItem& item = group[n];
+      const QString fileName = item.info.fileName();
+      if (!item.error.isEmpty()) {
+        batch.failures << tr("%1：%2").arg(fileName, item.error);
+        batch.journal.push_back(item.journal);
+        ++processed_;
+      } else if (!item.mod.file_hash.empty() &&
+                 (knownHashes_.count(item.mod.file_hash) > 0 || !batchHashes.insert(item.mod.file_hash).second)) {
+        batch.duplicates << fileName;
+        item.journal.stage = ImportStage::Duplicate;
+        batch.journal.push_back(item.journal);
+        ++processed_;
+      } else {
+        toTransfer.push_back(std::move(item.mod));
+        transferIndex.push_back(n);
+        hashedCheckpoint.journal.push_back(item.journal);
+      }
+    }
+    // 转移前先记下哈希检查点，中断后无需重新哈希
+    postBatch(std::move(hashedCheckpoint));
+
+    // 目标路径确定后、第一个字节传输前同步写入日志
+    const auto recordTargets = [this, &group, &transferIndex](const std::vector<ModRow>& planned) {
+      std::vector<ImportJournalRow> rows;
+      for (std::size_t t = 0; t < planned.size(); ++t) {
+        if (planned[t].file_path.empty()) {
+          continue;
+        }
+        ImportJournalRow row = group[transferIndex[t]].journal;
+        row.target_path = planned[t].file_path;
+        row.cover_path = planned[t].cover_path;
+        row.storage_method = planned[t].storage_method;
+        rows.push_back(std::move(row));
+      }
+      return recordCheckpoint(std::move(rows));
+    };
+    const auto transferErrors = importService_.ensureModFilesInRepositoryBatch(settings_, toTransfer, transferOptions,
+                                                                               recordTargets, &batch.warnings);
+    CommitBatch transferredCheckpoint;
+    for (std::size_t t = 0; t < toTransfer.size(); ++t) {
+      HashedItem& item = group[transferIndex[t]];
+      const QString fileName = item.info.fileName();
+      if (transferErrors[t].isEmpty()) {
+        item.journal.stage = ImportStage::Transferred;
+        item.journal.target_path = toTransfer[t].file_path;
+        item.journal.cover_path = toTransfer[t].cover_path;
+        item.journal.storage_method = toTransfer[t].storage_method;
+        transferredCheckpoint.journal.push_back(item.journal);
+        if (item.archive && item.archive->vpkEntries().size() > 1) {
+          // 多 VPK 压缩包按包内 VPK 拆分；指纹只随保留文件哈希的第一条记录写入
+          auto parts = ImportService::splitArchiveMod(toTransfer[t], *item.archive);
+          for (std::size_t p = 0; p < parts.size(); ++p) {
+            batch.mods.push_back(std::move(parts[p]));
+            batch.fingerprints.push_back(p == 0 ? item.fingerprint : std::nullopt);
+            batch.modJournal.push_back(item.journal);
+            batch.assetPaths.emplace_back();
+            batch.names << fileName;
+          }
+        } else {
+          batch.mods.push_back(std::move(toTransfer[t]));
+          batch.fingerprints.push_back(item.fingerprint);
+          batch.modJournal.push_back(item.journal);
+          batch.assetPaths.push_back(std::move(item.assetPaths));
+          batch.names << fileName;
+        }
+      } else if (cancelled_) {
+        // 因取消而中止的文件保持“已哈希”阶段，下次导入同一文件夹时继续
+      } else {
+        const QString detail = transferErrors[t].join(QStringLiteral("；"));
+        batch.failures << tr("%1：%2").arg(fileName, detail.isEmpty() ? tr("文件转移失败") : detail);
+        item.journal.stage = ImportStage::Failed;
+        item.journal.error = detail.toStdString();
+        batch.journal.push_back(item.journal);
+      }
+      ++processed_;
+    }
+    // 文件已进入仓库目录：记录目标路径，中断后可直接补登而不必再次转移
+    postBatch(std::move(transferredCheckpoint));
+    emit progress(processed_, discovered_, enumerationDone_);
+
+    if (batch.mods.size() >= commitBatchSize) {
+      postBatch(std::move(batch));
+      batch = CommitBatch{};
+    }
+  }
+
+  postBatch(std::move(batch));
+  QMetaObject::invokeMethod(this, [this]() { complete(); }, Qt::QueuedConnection);
+}
+
+bool ImportPipeline::recordCheckpoint(std::vector<ImportJournalRow> rows) {
+  if (jobId_ <= 0 || rows.empty()) {
+    return !cancelled_;
+  }
+  auto done = std::make_shared<std::promise<void>>();
+  auto written = done->get_future();
+  QMetaObject::invokeMethod(
+      this,
+      [this, rows = std::move(rows), done]() {
+        CommitBatch checkpoint;
+        checkpoint.journal = rows;
+        commitBatch(checkpoint);
+        done->set_value();
+      },
+      Qt::QueuedConnection);
+  // 不用 BlockingQueuedConnection：析构时 UI 线程会先取消再等待本线程退出
+  while (written.wait_for(std::chrono::milliseconds(50)) != std::future_status::ready) {
+    if (cancelled_) {
+      return false;
+    }
+  }
+  return !cancelled_;
+}
+
+void ImportPipeline::postBatch(CommitBatch batch) {
+  if (batch.mods.empty() && batch.journal.empty() && batch.duplicates.isEmpty() && batch.failures.isEmpty() &&
+      batch.warnings.isEmpty()) {
+    return;
+  }
+  QMetaObject::invokeMethod(
+      this, [this, batch = std::move(batch)]() { commitBatch(batch); }, Qt::QueuedConnection);
+}
+
+void ImportPipeline::commitBatch(const CommitBatch& batch) {
+  result_.duplicates << batch.duplicates;
+  result_.failures << batch.failures;
+  result_.warnings << batch.warnings;
+  if (jobId_ > 0 && !batch.journal.empty()) {
+    try {
+      repo_.recordImportJournal(batch.journal);
+    } catch (const std::exception& e) {
+      spdlog::warn("Failed to record import journal checkpoint: {}", e.what());
+    }
+  }
+  if (batch.mods.empty()) {
+    return;
+  }
+  try {
+    // 入库与日志的“已入库”标记在同一事务中提交
+    std::vector<ImportJournalRow> modJournal = batch.modJournal;
+    const bool journaled = jobId_ > 0 && modJournal.size() == batch.mods.size();
+    const auto ids = repo_.createModsBatch(batch.mods, journaled ? &modJournal : nullptr);
+    std::vector<ModFingerprintRow> fingerprints;
+    std::vector<ModAssetList> assets;
+    for (size_t i = 0; i < ids.size(); ++i) {
+      if (ids[i] > 0) {
+        ++result_.imported;
+        result_.importedIds.push_back(ids[i]);
+        if (const auto& fingerprint = batch.fingerprints[i]) {
+          fingerprints.push_back({ids[i], fingerprint->size_bytes, fingerprint->head_tail_hash});
+        }
+        if (i < batch.assetPaths.size() && batch.assetPaths[i]) {
+          assets.push_back({ids[i], batch.mods[i].file_hash, *batch.assetPaths[i]});
+        }
+      } else {
+        result_.duplicates << batch.names.value(static_cast<int>(i));
+      }
+    }
+    // 新入库文件的指纹写入索引，后续导入与游戏目录扫描可直接按大小/指纹比对
+    repo_.upsertModFingerprints(fingerprints);
+    // 资源路径增量写入冲突检测索引
+    repo_.indexModAssets(assets);
+  } catch (const std::exception& e) {
+    spdlog::error("Failed to commit import batch: {}", e.what());
+    for (const QString& name : batch.names) {
+      result_.failures << tr("%1：%2").arg(name, QString::fromUtf8(e.what()));
+    }
+  }
+}
+
+void ImportPipeline::complete() {
+  joinThreads();
+  result_.discovered = discovered_;
+  result_.cancelled = cancelled_;
+  result_.resumed = resumed_;
+  if (jobId_ > 0) {
+    // 全部成功时丢弃日志；取消或有失败项时保留，下次导入同一文件夹即可续传
+    try {
+      repo_.finishImportJob(jobId_, !result_.cancelled && result_.failures.isEmpty());
+    } catch (const std::exception& e) {
+      spdlog::warn("Failed to finish import journal job {}: {}", jobId_, e.what());
+    }
+  }
+  running_ = false;
+  spdlog::info("Folder import finished: {} discovered, {} imported, {} duplicates, {} failures, {} resumed{}",
+               result_.discovered, result_.imported, result_.duplicates.size(), result_.failures.size(),
+               result_.resumed, result_.cancelled ? " (cancelled)" : "");
+  emit finished();
+}
+
+void ImportPipeline::joinThreads() {
+  if (enumerator_.joinable()) {
+    enumerator_.join();
+  }
+  for (auto& worker : hashers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  hashers_.clear();
+  if (transfer_.joinable()) {
+    transfer_.join();
+  }
+}
@@ -0,0 +1,156 @@
+// UTF-8
+#pragma once
+
+#include <QFileInfo>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
+#include <vector>
+
+#include "core/config/Settings.h"
+#include "core/hash/DuplicateDetector.h"
+#include "core/io/TransferEngine.h"
+#include "core/repo/RepositoryService.h"
+#include "core/util/BoundedQueue.h"
+
+class ImportService;
+
+/**
+ * 文件夹批量导入流水线：枚举 → 按大小去重 → 多线程哈希 → 并发文件转移 → 批量入库。
+ * - 枚举完成后先按文件大小分桶：只有与仓库或本批其它文件同大小的文件才读取指纹/全量哈希，
+ *   本批内部与仓库的重复文件在任何文件被移动之前即确定并通过 duplicatesDetected() 报告。
+ *   大小唯一的文件不参与比较，但仍由哈希线程补算全量哈希后入库，供对象存储、后续导入去重与游戏目录匹配使用。
+ * - 各阶段运行在独立线程上，通过 BoundedQueue 连接；下游变慢时上游自动阻塞，内存占用有上限。
+ * - 数据库写入按批次投递回流水线所属线程（UI 线程）执行，SQLite 连接始终只在单线程中使用。
+ * - cancel() 后不再接收新文件，正在传输的文件中止并删除临时文件；已经转移到仓库目录的文件仍会入库，避免留下未登记的文件。
+ * - 每个文件的阶段（已哈希/已转移/已入库）写入导入日志；中断后再次导入同一文件夹时
+ *   跳过已完成的文件、复用已算出的哈希，并为已转移但未入库的文件直接补登记录。
+ *   目标路径在开始传输前同步写入日志，传输中途崩溃时也能按目标文件是否完整落盘识别已转移的文件。
+ * - 哈希线程顺带列出 VPK 的资源路径，随入库写入资源索引，供自动冲突检测使用。
+ * - 包含多个 VPK 的 ZIP/7z 压缩包只转移一次，入库时按包内 VPK 拆分为多条记录。
+ */
+class ImportPipeline : public QObject {
+  Q_OBJECT
+public:
+  struct Options {
+    QString directory;                ///< 待导入的文件夹
+    bool recursive{true};             ///< 是否包含子目录
+    int hashWorkers{0};               ///< 哈希线程数，0 表示按 CPU 核数自动选择
+    std::size_t queueCapacity{64};    ///< 各阶段之间队列的容量
+    std::size_t commitBatchSize{64};  ///< 每个数据库事务写入的 MOD 数量
+    int transferQueueDepth{4};        ///< 同时传输的文件数
+    std::uint64_t maxTransferBytesPerSecond{0}; ///< 传输限速，0 表示不限
+    bool resume{true};                ///< 存在同一文件夹未完成的导入日志时是否续传
+  };
+
+  struct Result {
+    int discovered{0};       ///< 枚举到的 MOD 文件数
+    int imported{0};         ///< 成功入库的数量
+    QStringList duplicates;  ///< 与仓库或本批其它文件重复而跳过的文件名
+    QStringList failures;    ///< 失败明细（"文件名：原因"）
+    QStringList warnings;    ///< 已入库但需要提示的情况（如剪切后源文件无法删除）
+    bool cancelled{false};   ///< 是否被用户取消
+    int resumed{0};          ///< 依据导入日志跳过或直接补登的文件数
+    std::vector<int> importedIds; ///< 本次新入库的 MOD ID，用于后续检查资源冲突
+  };
+
+  ImportPipeline(RepositoryService& repo,
+                 const ImportService& importService,
+                 const Settings& settings,
+                 QObject* parent = nullptr);
+  ~ImportPipeline() override;
+
+  /// 启动流水线，立即返回；完成后发射 finished()。
+  void start(const Options& options);
+  /// 请求取消，可在任意线程调用。
+  void cancel();
+  bool isRunning() const { return running_; }
+  /// 仅在 finished() 之后读取。
+  const Result& result() const { return result_; }
+
+signals:
+  /// @param processed 已完成（入库、跳过或失败）的文件数
+  /// @param discovered 已枚举到的文件数
+  /// @param enumerationDone 枚举是否已结束（结束后 discovered 即为总数）
+  void progress(int processed, int discovered, bool enumerationDone);
+  /// 去重分析完成、尚未移动任何文件时发射。
+  /// @param duplicates 与仓库或本批其它文件重复、将被跳过的文件名
+  void duplicatesDetected(const QStringList& duplicates);
+  /// 当前传输批次的字节进度（按千分比节流，可能在传输线程中发射）。
+  void transferProgress(qint64 doneBytes, qint64 totalBytes);
+  void finished();
+
+private:
+  struct HashedItem {
+    QFileInfo info;
+    ModRow mod;
+    std::optional<FileFingerprint> fingerprint;
+    QString error;
+    ImportJournalRow journal; ///< 该文件的日志记录
+    std::optional<std::vector<std::string>> assetPaths; ///< VPK 中参与冲突检测的资源路径
+    std::optional<ArchiveListing> archive; ///< ZIP/7z 压缩包的目录列表
+  };
+
+  struct CommitBatch {
+    std::vector<ModRow> mods;
+    std::vector<std::optional<FileFingerprint>> fingerprints;
+    std::vector<ImportJournalRow> modJournal; ///< 与 mods 一一对应，随入库在同一事务中更新
+    std::vector<ImportJournalRow> journal;    ///< 其它日志检查点（哈希、转移、重复、失败）
+    std::vector<std::optional<std::vector<std::string>>> assetPaths; ///< 与 mods 一一对应
+    QStringList names;
+    QStringList duplicates;
+    QStringList failures;
+    QStringList warnings;
+  };
+
+  void openJournal(const Options& options);
+  /// 载入仓库中的哈希、大小与指纹（含已逻辑删除的记录），在枚举线程中、去重之前调用。
+  void loadRepositoryIndex();
+  const ImportJournalRow* journalEntryFor(const QFileInfo& info) const;
+  ImportJournalRow makeJournalRow(const QFileInfo& info, ImportStage stage) const;
+  void enumerateStage(Options options);
+  void hashStage();
+  void transferStage(TransferOptions transferOptions, std::size_t commitBatchSize);
+  void postBatch(CommitBatch batch);
+  /// 在流水线所属线程写入日志检查点并等待完成；等待期间被取消时返回 false。
+  bool recordCheckpoint(std::vector<ImportJournalRow> rows);
+  void commitBatch(const CommitBatch& batch);
+  void complete();
+  void joinThreads();
+
+  RepositoryService& repo_;
+  const ImportService& importService_;
+  Settings settings_;
+
+  std::unique_ptr<BoundedQueue<std::size_t>> pathQueue_; ///< candidates_ 的下标
+  std::unique_ptr<BoundedQueue<HashedItem>> hashedQueue_;
+
+  std::thread enumerator_;
+  std::vector<std::thread> hashers_;
+  std::thread transfer_;
+
+  std::unordered_set<std::string> knownHashes_; ///< 仓库中已有的文件哈希，枚举线程写入、去重后仅转移线程读取
+  std::vector<KnownFile> knownFiles_;           ///< 仓库文件的大小/指纹索引来源，仅枚举线程使用
+  std::vector<QFileInfo> candidates_;           ///< 枚举结果，下标入队前写入完毕
+  std::vector<DuplicateDecision> decisions_;    ///< 与 candidates_ 一一对应的去重结果
+  int jobId_{0};                                ///< 当前导入日志任务
+  std::unordered_map<std::string, ImportJournalRow> journal_; ///< 续传时载入的日志，启动后只读
+  std::atomic<int> resumed_{0};
+  int workers_{1};
+  std::atomic<bool> cancelled_{false};
+  std::atomic<int> transferPermille_{-1}; ///< 上次报告的传输进度，用于节流
+  std::atomic<bool> enumerationDone_{false};
+  std::atomic<int> discovered_{0};
+  std::atomic<int> processed_{0};
+  std::atomic<int> activeHashers_{0};
+  bool running_{false};
+  Result result_;
+};
@@ -1,30 +1,66 @@
 // UTF-8
 #include "app/services/ImportService.h"
 
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
+#include <QSet>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <optional>
+#include <system_error>
+
+#include "app/services/CoverIndex.h"
+#include "core/hash/FileHasher.h"
+#include "core/io/FileLinker.h"
+#include "core/io/TransferEngine.h"
+#include "core/store/ObjectStore.h"
+#include "core/vpk/AddonInfo.h"
 
 /**
- * 该实现与原 MainWindow::ensureModFilesInRepository 逻辑等价，
- * 仅将界面无关的文件处理职责迁移到 ImportService 中，便于复用与测试。
+ * 单个 MOD 的导入处理，委托给批量实现，保证单个导入与批量导入行为一致。
  */
 bool ImportService::ensureModFilesInRepository(const Settings& settings, ModRow& mod, QStringList& errors) const {
-  const ImportAction action = settings.importAction;
-  if (action == ImportAction::Link) {
-    return true; // 不做导入处理
+  std::vector<ModRow> mods{mod};
+  QStringList warnings;
+  auto results = ensureModFilesInRepositoryBatch(settings, mods, {}, {}, &warnings);
+  for (const QString& warning : warnings) {
+    spdlog::warn("{}", warning.toStdString());
   }
+  mod = std::move(mods.front());
+  errors << results.front();
+  return results.front().isEmpty();
+}
+
+std::vector<QStringList> ImportService::ensureModFilesInRepositoryBatch(const Settings& settings,
+                                                                        std::vector<ModRow>& mods,
+                                                                        const TransferOptions& transferOptions,
+                                                                        const BeforeTransfer& beforeTransfer,
+                                                                        QStringList* warnings) const {
+  std::vector<QStringList> errors(mods.size());
+  if (mods.empty()) {
+    return errors;
+  }
+  const ImportAction action = settings.importAction;
 
   const QString repoDir = QDir::cleanPath(QDir::fromNativeSeparators(QString::fromStdString(settings.repoDir)));
   if (repoDir.isEmpty()) {
-    errors << QObject::tr("仓库目录未配置，无法执行导入处理");
-    return false;
+    for (auto& list : errors) {
+      list << QObject::tr("仓库目录未配置，无法执行导入处理");
+    }
+    return errors;
   }
 
   QDir repoDirObj(repoDir);
   if (!repoDirObj.exists() && !repoDirObj.mkpath(QStringLiteral("."))) {
-    errors << QObject::tr("无法创建仓库目录：%1").arg(repoDir);
-    return false;
+    for (auto& list : errors) {
+      list << QObject::tr("无法创建仓库目录：%1").arg(repoDir);
+    }
+    return errors;
   }
 
   const auto repoPrefix = [repoDirObj]() {
@@ -35,7 +71,9 @@ bool ImportService::ensureModFilesInRepository(const Settings& settings, ModRow&
     return prefix;
   }();
 
-  const auto allocateTargetPath = [&repoDirObj](const QFileInfo& sourceInfo) {
+  // 同一批次中尚未落盘的目标路径也要参与去重
+  QSet<QString> reservedTargets;
+  const auto allocateTargetPath = [&repoDirObj, &reservedTargets](const QFileInfo& sourceInfo) {
     const QString originalName = sourceInfo.fileName().isEmpty() ? QStringLiteral("mod") : sourceInfo.fileName();
     QString baseName = sourceInfo.completeBaseName();
     if (baseName.isEmpty()) {
@@ -44,18 +82,19 @@ bool ImportService::ensureModFilesInRepository(const Settings& settings, ModRow&
     const QString suffix = sourceInfo.completeSuffix();
 
     QString candidateName = originalName;
-    QString candidatePath = repoDirObj.filePath(candidateName);
+    QString candidatePath = QDir::cleanPath(repoDirObj.filePath(candidateName));
     int counter = 1;
-    while (QFileInfo::exists(candidatePath)) {
+    while (QFileInfo::exists(candidatePath) || reservedTargets.contains(candidatePath)) {
       if (suffix.isEmpty()) {
         candidateName = QStringLiteral("%1_%2").arg(baseName).arg(counter);
       } else {
         candidateName = QStringLiteral("%1_%2.%3").arg(baseName).arg(counter).arg(suffix);
       }
-      candidatePath = repoDirObj.filePath(candidateName);
+      candidatePath = QDir::cleanPath(repoDirObj.filePath(candidateName));
       ++counter;
     }
-    return QDir::cleanPath(candidatePath);
+    reservedTargets.insert(candidatePath);
+    return candidatePath;
   };
 
   const auto inRepo = [&repoPrefix](const QFileInfo& info) {
@@ -63,84 +102,372 @@ bool ImportService::ensureModFilesInRepository(const Settings& settings, ModRow&
     return normalizedFile.startsWith(repoPrefix, Qt::CaseInsensitive);
   };
 
-  const auto performTransfer = [action, &errors](const QString& src, const QString& dst, const QString& label) {
-    auto actionVerb = [action]() {
-      switch (action) {
-        case ImportAction::Cut: return QObject::tr("剪切");
-        case ImportAction::Copy: return QObject::tr("复制");
-        case ImportAction::Link: return QObject::tr("建立链接");
-      }
-      return QObject::tr("处理");
-    };
+  const auto actionVerb = [action]() {
+    switch (action) {
+      case ImportAction::Cut: return QObject::tr("剪切");
+      case ImportAction::Copy: return QObject::tr("复制");
+      case ImportAction::Link: return QObject::tr("建立链接");
+    }
+    return QObject::tr("处理");
+  };
 
-    auto emitFailure = [&]() {
-      errors << QObject::tr("无法%1 %2 到仓库目录：%3")
-                    .arg(actionVerb(), label, dst);
-      return false;
-    };
+  const auto toFsPath = [](const QString& path) { return std::filesystem::path(path.toStdU16String()); };
+  const auto fromFsPath = [](const std::filesystem::path& path) {
+    return QDir::toNativeSeparators(QString::fromStdU16String(path.u16string()));
+  };
 
-    switch (action) {
-      case ImportAction::Copy:
-        if (!QFile::copy(src, dst)) {
-          return emitFailure();
-        }
-        return true;
-      case ImportAction::Cut:
-        if (QFile::rename(src, dst)) {
-          return true;
-        }
-        if (QFile::copy(src, dst)) {
-          QFile::remove(src);
-          return true;
-        }
-        return emitFailure();
-      case ImportAction::Link:
-        return true;
+  // 按内容寻址时，已知哈希的 MOD 文件存入 objects/，相同内容只保留一份
+  std::optional<ObjectStore> objectStore;
+  if (settings.contentAddressedStore) {
+    objectStore.emplace(toFsPath(repoDirObj.absolutePath()));
+  }
+  const auto addNameIndex = [&](const QString& objectPath, const QString& originalName) {
+    std::error_code ec;
+    if (!objectStore->linkName(toFsPath(objectPath), originalName.toStdString(), ec)) {
+      // 名称索引仅供浏览，失败不影响导入
+      spdlog::warn("Failed to index {} as {}: {}", objectPath.toStdString(), originalName.toStdString(), ec.message());
+    }
+  };
+
+  // Copy/Cut 的文件先收集为传输任务，最后交给 TransferEngine 并发执行
+  struct PendingTransfer {
+    std::size_t modIndex;
+    bool isModFile;
+    QString label;
+    QString targetPath;
+    QString originalName; ///< 非空表示目标是内容寻址对象，完成后据此建立名称索引
+  };
+  std::vector<TransferJob> jobs;
+  std::vector<PendingTransfer> pending;
+  // 与同批次其它文件内容相同的 MOD，等对象落盘后再确认（剪切时随后删除源文件）
+  struct DeferredDuplicate {
+    std::size_t modIndex;
+    QString source;
+    QString objectPath;
+  };
+  std::vector<DeferredDuplicate> deferredDuplicates;
+
+  const auto handleObject = [&](std::size_t index, const QFileInfo& sourceInfo, const QString& label) {
+    ModRow& mod = mods[index];
+    const auto object = objectStore->objectPath(mod.file_hash, sourceInfo.suffix().toStdString());
+    const QString objectPath = QDir::cleanPath(QString::fromStdU16String(object.u16string()));
+
+    if (reservedTargets.contains(objectPath)) {
+      // 同批次已有相同内容的文件正在写入该对象
+      deferredDuplicates.push_back({index, sourceInfo.absoluteFilePath(), objectPath});
+      return;
     }
-    return true;
+    reservedTargets.insert(objectPath);
+
+    std::error_code ec;
+    const bool exists = std::filesystem::exists(object, ec);
+    if (action == ImportAction::Link || exists) {
+      // 链接进对象库时以 reflink 克隆（不支持时复制），对象已存在时只需按需删除源文件，二者都不进入传输队列
+      const auto mode = action == ImportAction::Cut    ? ObjectStore::PutMode::Move
+                        : action == ImportAction::Copy ? ObjectStore::PutMode::Copy
+                                                       : ObjectStore::PutMode::Link;
+      const auto put = objectStore->put(toFsPath(sourceInfo.absoluteFilePath()), mod.file_hash, mode, ec);
+      if (!put) {
+        errors[index] << QObject::tr("无法%1 %2 到仓库目录：%3（%4）")
+                             .arg(actionVerb(), label, objectPath, QString::fromLocal8Bit(ec.message().c_str()));
+        return;
+      }
+      mod.file_path = fromFsPath(put->object).toStdString();
+      if (put->method) {
+        mod.storage_method = std::string(storageMethodName(*put->method));
+      }
+      addNameIndex(objectPath, sourceInfo.fileName());
+      return;
+    }
+
+    if (!objectStore->prepare(object, ec)) {
+      errors[index] << QObject::tr("无法创建目录：%1（%2）")
+                           .arg(QFileInfo(objectPath).absolutePath(), QString::fromLocal8Bit(ec.message().c_str()));
+      return;
+    }
+    TransferJob job;
+    job.source = toFsPath(sourceInfo.absoluteFilePath());
+    job.destination = object;
+    job.mode = action == ImportAction::Cut ? TransferJob::Mode::Move : TransferJob::Mode::Copy;
+    jobs.push_back(std::move(job));
+    pending.push_back({index, true, label, objectPath, sourceInfo.fileName()});
   };
 
-  const auto handlePath = [&](std::string& pathRef, const QString& label, bool required) {
+  const auto handlePath = [&](std::size_t index, std::string& pathRef, const QString& label, bool required) {
     if (pathRef.empty()) {
       if (required) {
-        errors << QObject::tr("%1路径为空，无法执行导入处理").arg(label);
-        return false;
+        errors[index] << QObject::tr("%1路径为空，无法执行导入处理").arg(label);
       }
-      return true;
+      return;
     }
 
     QString sourcePath = QDir::cleanPath(QDir::fromNativeSeparators(QString::fromStdString(pathRef)));
     QFileInfo sourceInfo(sourcePath);
     if (!sourceInfo.exists()) {
       if (required) {
-        errors << QObject::tr("找不到%1：%2").arg(label, sourcePath);
-        return false;
+        errors[index] << QObject::tr("找不到%1：%2").arg(label, sourcePath);
       }
-      return true;
+      return;
     }
 
     if (inRepo(sourceInfo)) {
       // 已在仓库中，仅标准化存储
       pathRef = QDir::toNativeSeparators(sourceInfo.absoluteFilePath()).toStdString();
-      return true;
+      return;
     }
 
-    const QString targetPath = allocateTargetPath(sourceInfo);
-    QFileInfo targetInfo(targetPath);
-    if (!targetInfo.dir().exists() && !targetInfo.dir().mkpath(QStringLiteral("."))) {
-      errors << QObject::tr("无法创建目标目录：%1").arg(targetInfo.dir().absolutePath());
-      return false;
+    if (required && objectStore && ObjectStore::isValidHash(mods[index].file_hash)) {
+      handleObject(index, sourceInfo, label);
+      return;
     }
 
-    if (!performTransfer(sourceInfo.absoluteFilePath(), targetPath, label)) {
-      return false;
+    const QString targetPath = allocateTargetPath(sourceInfo);
+    if (action == ImportAction::Link) {
+      // reflink → 硬链接 → 符号链接 → 复制，依次降级；链接本身几乎瞬时完成，无需进入传输队列
+      std::error_code ec;
+      const auto method = linkFile(toFsPath(sourceInfo.absoluteFilePath()), toFsPath(targetPath), ec);
+      if (!method) {
+        errors[index] << QObject::tr("无法建立链接 %1 到仓库目录：%2（%3）")
+                             .arg(label, targetPath, QString::fromLocal8Bit(ec.message().c_str()));
+        return;
+      }
+      pathRef = QDir::toNativeSeparators(targetPath).toStdString();
+      if (required) {
+        mods[index].storage_method = std::string(storageMethodName(*method));
+      }
+      return;
     }
 
-    pathRef = QDir::toNativeSeparators(targetPath).toStdString();
-    return true;
+    TransferJob job;
+    job.source = toFsPath(sourceInfo.absoluteFilePath());
+    job.destination = toFsPath(targetPath);
+    job.mode = action == ImportAction::Cut ? TransferJob::Mode::Move : TransferJob::Mode::Copy;
+    jobs.push_back(std::move(job));
+    pending.push_back({index, required, label, targetPath, {}});
   };
 
-  const bool fileOk = handlePath(mod.file_path, QObject::tr("MOD 文件"), true);
-  const bool coverOk = handlePath(mod.cover_path, QObject::tr("封面文件"), false);
-  return fileOk && coverOk;
+  for (std::size_t i = 0; i < mods.size(); ++i) {
+    handlePath(i, mods[i].file_path, QObject::tr("MOD 文件"), true);
+    handlePath(i, mods[i].cover_path, QObject::tr("封面文件"), false);
+  }
+
+  if (beforeTransfer) {
+    std::vector<ModRow> planned = mods;
+    for (const PendingTransfer& item : pending) {
+      ModRow& mod = planned[item.modIndex];
+      const std::string nativeTarget = QDir::toNativeSeparators(item.targetPath).toStdString();
+      if (item.isModFile) {
+        mod.file_path = nativeTarget;
+        mod.storage_method = std::string(
+            storageMethodName(action == ImportAction::Cut ? StorageMethod::Move : StorageMethod::Copy));
+      } else {
+        mod.cover_path = nativeTarget;
+      }
+    }
+    for (const DeferredDuplicate& duplicate : deferredDuplicates) {
+      planned[duplicate.modIndex].file_path = QDir::toNativeSeparators(duplicate.objectPath).toStdString();
+    }
+    for (std::size_t i = 0; i < planned.size(); ++i) {
+      if (!errors[i].isEmpty()) {
+        planned[i].file_path.clear();
+      }
+    }
+    if (!beforeTransfer(planned)) {
+      const auto cancel = [&errors](std::size_t index) {
+        if (errors[index].isEmpty()) {
+          errors[index] << QObject::tr("导入已取消");
+        }
+      };
+      for (const PendingTransfer& item : pending) {
+        cancel(item.modIndex);
+      }
+      for (const DeferredDuplicate& duplicate : deferredDuplicates) {
+        cancel(duplicate.modIndex);
+      }
+      return errors;
+    }
+  }
+
+  if (!jobs.empty()) {
+    TransferEngine engine(transferOptions);
+    const auto results = engine.run(jobs);
+    for (std::size_t n = 0; n < results.size(); ++n) {
+      const PendingTransfer& item = pending[n];
+      ModRow& mod = mods[item.modIndex];
+      const bool isObject = !item.originalName.isEmpty();
+      if (isObject && results[n].error == std::errc::file_exists) {
+        // 其它导入抢先写入了同一内容的对象：视为去重成功，剪切时补删源文件
+        deferredDuplicates.push_back(
+            {item.modIndex, QString::fromStdU16String(jobs[n].source.u16string()), item.targetPath});
+        continue;
+      }
+      if (!results[n].ok()) {
+        errors[item.modIndex] << QObject::tr("无法%1 %2 到仓库目录：%3（%4）")
+                                     .arg(actionVerb(), item.label, item.targetPath,
+                                          QString::fromLocal8Bit(results[n].error.message().c_str()));
+        continue;
+      }
+      if (results[n].sourceError && warnings) {
+        // 目标已完整写入，按成功处理，只提示源文件残留
+        *warnings << QObject::tr("已复制 %1 到仓库目录，但无法删除源文件 %2（%3）")
+                         .arg(item.label, QString::fromStdU16String(jobs[n].source.u16string()),
+                              QString::fromLocal8Bit(results[n].sourceError.message().c_str()));
+      }
+      const std::string nativeTarget = QDir::toNativeSeparators(item.targetPath).toStdString();
+      if (item.isModFile) {
+        mod.file_path = nativeTarget;
+        mod.storage_method = std::string(
+            storageMethodName(action == ImportAction::Cut ? StorageMethod::Move : StorageMethod::Copy));
+        if (isObject) {
+          addNameIndex(item.targetPath, item.originalName);
+        }
+      } else {
+        mod.cover_path = nativeTarget;
+      }
+    }
+  }
+
+  for (const DeferredDuplicate& duplicate : deferredDuplicates) {
+    if (!QFileInfo::exists(duplicate.objectPath)) {
+      // 写入该对象的文件失败，保留源文件以便重试
+      errors[duplicate.modIndex] << QObject::tr("无法%1 %2 到仓库目录：%3")
+                                        .arg(actionVerb(), QObject::tr("MOD 文件"), duplicate.objectPath);
+      continue;
+    }
+    mods[duplicate.modIndex].file_path = QDir::toNativeSeparators(duplicate.objectPath).toStdString();
+    addNameIndex(duplicate.objectPath, QFileInfo(duplicate.source).fileName());
+    if (action == ImportAction::Cut && !QFile::remove(duplicate.source) && warnings) {
+      *warnings << QObject::tr("仓库中已有相同内容，但无法删除源文件 %1").arg(duplicate.source);
+    }
+  }
+  return errors;
+}
+
+bool ImportService::isSupportedModFile(const QFileInfo& info) {
+  if (!info.isFile()) {
+    return false;
+  }
+  const QString suffix = info.suffix().toLower();
+  if (suffix.isEmpty()) {
+    return false;
+  }
+  static const std::array<QString, 4> kAllowedExt = {QStringLiteral("vpk"),
+                                                     QStringLiteral("zip"),
+                                                     QStringLiteral("7z"),
+                                                     QStringLiteral("rar")};
+  return std::any_of(kAllowedExt.begin(), kAllowedExt.end(), [&](const QString& ext) { return suffix == ext; });
+}
+
+QString ImportService::locateCoverCandidate(const QFileInfo& fileInfo, const QString& displayName) {
+  // 同一目录的图片只列一次，批量导入时各文件共享该目录的索引
+  return CoverIndex::forDirectory(fileInfo.absolutePath())->locate(fileInfo.completeBaseName(), displayName);
+}
+
+QString ImportService::computeFileHash(const QString& path) {
+  return QString::fromStdString(hashFile(std::filesystem::path(path.toStdU16String()), kDefaultHashAlgorithm));
+}
+
+std::optional<ArchiveListing> ImportService::inspectModArchive(const QFileInfo& info) {
+  const QString suffix = info.suffix().toLower();
+  if (suffix != QStringLiteral("zip") && suffix != QStringLiteral("7z")) {
+    return std::nullopt;
+  }
+  std::error_code ec;
+  return inspectArchive(std::filesystem::path(info.absoluteFilePath().toStdU16String()), ec);
+}
+
+std::vector<ModRow> ImportService::splitArchiveMod(const ModRow& archiveMod, const ArchiveListing& listing) {
+  const auto vpks = listing.vpkEntries();
+  if (vpks.size() < 2) {
+    return {archiveMod};
+  }
+  std::vector<ModRow> mods;
+  mods.reserve(vpks.size());
+  for (const ArchiveEntry* entry : vpks) {
+    ModRow mod = archiveMod;
+    const QString member = QString::fromStdString(entry->path);
+    mod.name = QStringLiteral("%1 / %2")
+                   .arg(QString::fromStdString(archiveMod.name), QFileInfo(member).completeBaseName())
+                   .toStdString();
+    mod.archive_member = entry->path;
+    mod.size_mb = static_cast<double>(entry->uncompressed_size) / (1024.0 * 1024.0);
+    if (!mods.empty()) {
+      mod.file_hash.clear();
+      mod.hash_algo.clear();
+    }
+    mods.push_back(std::move(mod));
+  }
+  return mods;
+}
+
+ModRow ImportService::buildModFromFile(const QFileInfo& info,
+                                       bool computeHash,
+                                       std::optional<ArchiveListing>* archiveListing) {
+  ModRow mod;
+  const QString baseName = info.completeBaseName().trimmed();
+  const QString fileName = info.fileName().trimmed();
+  const QString chosenName = baseName.isEmpty() ? fileName : baseName;
+  mod.name = chosenName.toStdString();
+  mod.file_path = QDir::toNativeSeparators(info.absoluteFilePath()).toStdString();
+  mod.size_mb = static_cast<double>(info.size()) / (1024.0 * 1024.0);
+
+  if (computeHash) {
+    mod.file_hash = computeFileHash(info.absoluteFilePath()).toStdString();
+    if (!mod.file_hash.empty()) {
+      mod.hash_algo = std::string(hashAlgorithmName(kDefaultHashAlgorithm));
+    }
+  }
+
+  const QDateTime lastModified = info.lastModified();
+  if (lastModified.isValid()) {
+    const QString dateText = lastModified.date().toString(QStringLiteral("yyyy-MM-dd"));
+    mod.last_published_at = dateText.toStdString();
+    mod.last_saved_at = dateText.toStdString();
+  }
+
+  const QString coverPath = locateCoverCandidate(info, chosenName);
+  if (!coverPath.isEmpty()) {
+    mod.cover_path = QDir::toNativeSeparators(coverPath).toStdString();
+  }
+
+  const bool isNumericId =
+      !baseName.isEmpty() && std::all_of(baseName.cbegin(), baseName.cend(), [](const QChar& ch) { return ch.isDigit(); });
+  if (isNumericId) {
+    const QString steamUrl =
+        QStringLiteral("https://steamcommunity.com/sharedfiles/filedetails/?id=") + baseName;
+    mod.source_url = steamUrl.toStdString();
+    mod.source_platform = QStringLiteral("steam").toStdString();
+  }
+
+  // VPK 自带的 addoninfo.txt 比文件名更可靠；只解析目录树，不解包其它文件
+  if (info.suffix().compare(QStringLiteral("vpk"), Qt::CaseInsensitive) == 0) {
+    std::error_code ec;
+    if (const auto addon = readAddonInfo(std::filesystem::path(info.absoluteFilePath().toStdU16String()), ec)) {
+      if (!addon->title.empty()) {
+        mod.name = addon->title;
+      }
+      mod.author = addon->author;
+      std::string note = addon->description.empty() ? addon->tagline : addon->description;
+      if (!addon->version.empty()) {
+        note = QObject::tr("版本：%1").arg(QString::fromStdString(addon->version)).toStdString() +
+               (note.empty() ? std::string() : "\n" + note);
+      }
+      mod.note = note;
+      if (mod.source_url.empty()) {
+        mod.source_url = addon->url;
+      }
+    }
+  }
+
+  // 压缩包按包内 VPK 的解压后大小计入预算，而不是压缩后的文件大小
+  auto listing = inspectModArchive(info);
+  if (listing) {
+    if (const std::uint64_t deployed = listing->vpkUncompressedBytes(); deployed > 0) {
+      mod.size_mb = static_cast<double>(deployed) / (1024.0 * 1024.0);
+    }
+  }
+  if (archiveListing) {
+    *archiveListing = std::move(listing);
+  }
+  return mod;
 }
@@ -1,9 +1,17 @@
 // UTF-8
 #pragma once
 
+#include <QFileInfo>
+#include <QString>
 #include <QStringList>
 
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "core/archive/ArchiveInspector.h"
 #include "core/config/Settings.h"
+#include "core/io/TransferEngine.h"
 #include "core/repo/RepositoryService.h"
 
 /**
@@ -12,13 +20,65 @@
  */
 class ImportService {
 public:
+  /**
+   * 批量导入在开始传输之前的回调，参数与 mods 一一对应：file_path / cover_path / storage_method 为规划好的目标
+   * （链接与已存在的内容对象此时已处理完毕；处理失败的项 file_path 为空）。返回 false 时放弃本批传输。
+   */
+  using BeforeTransfer = std::function<bool(const std::vector<ModRow>& planned)>;
+
   ImportService() = default;
 
   /**
    * 按 Settings 的导入策略，确保 MOD 文件与封面位于仓库目录中；必要时执行复制/剪切与重命名。
    * - mod.file_path / mod.cover_path 可能被此方法更新为目标仓库内的新路径（使用系统本地分隔符）。
    * - errors 输出详细的人类可读错误信息（中文）。
+   * - Link 策略依次尝试 reflink、硬链接、符号链接与复制；启用内容寻址存储时 MOD 文件只克隆或复制进对象库。
+   *   实际使用的方式写入 mod.storage_method。
    */
   bool ensureModFilesInRepository(const Settings& settings, ModRow& mod, QStringList& errors) const;
+
+  /**
+   * 批量版本：一次规划所有 MOD 文件与封面的目标路径（批内同名自动加后缀），
+   * Copy/Cut 通过 TransferEngine 并发传输，Link 逐个即时建立链接。
+   * - 返回值与 mods 一一对应，某项为空表示该 MOD 的文件与封面均处理成功。
+   * - transferOptions 控制并发数、限速与进度回调（回调可能在工作线程中调用）。
+   * - beforeTransfer 供调用方在任何文件开始传输前持久化目标路径，中断后据此识别已落盘的文件。
+   * - warnings 非空时输出不影响导入结果的提示，例如跨设备剪切已复制进仓库、但源文件无法删除。
+   */
+  std::vector<QStringList> ensureModFilesInRepositoryBatch(const Settings& settings,
+                                                           std::vector<ModRow>& mods,
+                                                           const TransferOptions& transferOptions = {},
+                                                           const BeforeTransfer& beforeTransfer = {},
+                                                           QStringList* warnings = nullptr) const;
+
+  /// 仅允许识别为 MOD 文件的后缀（vpk/zip/7z/rar）。
+  static bool isSupportedModFile(const QFileInfo& info);
+
+  /// 在同级目录中匹配可能的封面文件，未找到时返回空字符串。
+  static QString locateCoverCandidate(const QFileInfo& fileInfo, const QString& displayName);
+
+  /// 以默认算法（kDefaultHashAlgorithm）计算文件哈希（十六进制小写），读取失败时返回空字符串。
+  static QString computeFileHash(const QString& path);
+
+  /**
+   * 根据文件生成初始的 ModRow 元数据（名称、大小、日期、封面、Steam 来源）。
+   * - VPK 文件会读取其中的 addoninfo.txt，预填标题、作者与描述（含版本）。
+   * - ZIP/7z 只读取文件尾部的目录；包含 VPK 时 size_mb 取其解压后的总大小，即部署到游戏目录后的实际占用。
+   * - computeHash 为 false 时不计算 file_hash/hash_algo，由调用方（如导入流水线的哈希阶段）另行填充。
+   * - archiveListing 非空时输出压缩包的目录列表（无法列出时为 std::nullopt），供调用方拆分多 VPK 压缩包。
+   */
+  static ModRow buildModFromFile(const QFileInfo& info,
+                                 bool computeHash = true,
+                                 std::optional<ArchiveListing>* archiveListing = nullptr);
+
+  /// 列出 ZIP/7z 压缩包的内容（不解压）；其它文件或无法列出时返回 std::nullopt。
+  static std::optional<ArchiveListing> inspectModArchive(const QFileInfo& info);
+
+  /**
+   * 将包含多个 VPK 的压缩包拆分为每个 VPK 一条记录，archive_member 记录包内路径，size_mb 为该 VPK 的大小。
+   * - mods.file_hash 唯一，只有第一条保留整个压缩包的哈希，代表该压缩包参与去重。
+   * - 包内 VPK 少于两个时原样返回 archiveMod。
+   */
+  static std::vector<ModRow> splitArchiveMod(const ModRow& archiveMod, const ArchiveListing& listing);
 };
 
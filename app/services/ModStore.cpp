@@ -0,0 +1,375 @@
+// UTF-8
+#include "app/services/ModStore.h"
+
+#include <QMap>
+#include <QStringList>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "core/db/Db.h"
+#include "core/log/Log.h"
+#include "core/repo/CatalogSnapshot.h"
+
+ModStore::ModStore(QObject* parent) : QObject(parent) {
+  loadPool_.setMaxThreadCount(1);
+}
+
+void ModStore::reload() {
+  ++loadGeneration_;
+  loading_ = false;
+  deferredPatch_.clear();
+  if (!repo_) {
+    install(Catalog{});
+    return;
+  }
+  auto catalog = loadCatalog(*repo_, categoryParent_);
+  install(std::move(*catalog));
+}
+
+void ModStore::reloadAsync(const std::string& dbPath) {
+  if (!repo_ || dbPath.empty()) {
+    reload();
+    return;
+  }
+
+  const std::uint64_t generation = ++loadGeneration_;
+  loading_ = true;
+  const std::filesystem::path cachePath(QString::fromStdString(dbPath + ".catalog").toStdU16String());
+  loadPool_.start([this, dbPath, cachePath, generation, categoryParent = categoryParent_]() {
+    std::shared_ptr<Catalog> catalog;
+    try {
+      const RepositoryService service(std::make_shared<Db>(dbPath));
+      catalog = loadCatalog(service, categoryParent, cachePath);
+    } catch (const std::exception& ex) {
+      spdlog::warn("Background mod load failed, falling back to GUI thread: {}", ex.what());
+    }
+    QMetaObject::invokeMethod(
+        this,
+        [this, catalog, generation]() {
+          if (generation != loadGeneration_) {
+            return;
+          }
+          if (!catalog) {
+            reload();
+            return;
+          }
+          loading_ = false;
+          install(std::move(*catalog));
+          if (!deferredPatch_.empty()) {
+            applyPatch(std::exchange(deferredPatch_, {}));
+          }
+        },
+        Qt::QueuedConnection);
+  });
+}
+
+std::shared_ptr<ModStore::Catalog> ModStore::loadCatalog(const RepositoryService& repo,
+                                                         const std::unordered_map<int, int>& categoryParent,
+                                                         const std::filesystem::path& cachePath) {
+  auto catalog = std::make_shared<Catalog>();
+  ModPageFilter everything;
+  everything.include_deleted = true;
+  if (repo.countMods(everything) > kPagedThreshold) {
+    catalog->paged = true;
+    return catalog;
+  }
+
+  // 先读版本再读数据：加载期间若有写入，快照记下的是旧版本，下次启动会重新生成
+  const CatalogSnapshotKey key = repo.catalogSnapshotKey();
+  const bool useCache = !cachePath.empty() && !key.catalog_id.empty();
+
+  bool fromCache = false;
+  if (useCache) {
+    CatalogSnapshot cached;
+    std::error_code ec;
+    if (cached.open(cachePath, key, ec)) {
+      catalog->mods.reserve(cached.modCount());
+      for (std::size_t i = 0; i < cached.modCount(); ++i) {
+        catalog->mods.push_back(cached.mod(i));
+        auto rows = cached.tags(i);
+        if (!rows.empty()) {
+          catalog->tags[catalog->mods.back().id] = std::move(rows);
+        }
+      }
+      fromCache = true;
+    } else if (ec != std::errc::no_such_file_or_directory) {
+      spdlog::info("Catalog snapshot not used: {}", ec.message());
+    }
+  }
+
+  if (!fromCache) {
+    catalog->mods = repo.listAll(true);
+    catalog->tags.reserve(catalog->mods.size());
+    for (const auto& mod : catalog->mods) {
+      auto rows = repo.listTagsForMod(mod.id);
+      if (!rows.empty()) {
+        catalog->tags[mod.id] = std::move(rows);
+      }
+    }
+    if (useCache) {
+      std::error_code ec;
+      if (!CatalogSnapshot::write(cachePath, key, catalog->mods, catalog->tags, ec)) {
+        spdlog::warn("Failed to write catalog snapshot: {}", ec.message());
+      }
+    }
+  }
+
+  std::unordered_map<int, std::vector<int>> tagIdsByMod;
+  tagIdsByMod.reserve(catalog->tags.size());
+  for (const auto& [modId, rows] : catalog->tags) {
+    tagIdsByMod[modId] = tagIdsOf(rows);
+  }
+  for (std::size_t i = 0; i < catalog->mods.size(); ++i) {
+    catalog->nameIndex.upsert(static_cast<int>(i), catalog->mods[i].name, catalog->mods[i].author);
+  }
+  catalog->facets.build(catalog->mods, tagIdsByMod, categoryParent);
+  return catalog;
+}
+
+void ModStore::install(Catalog&& catalog) {
+  mods_ = std::move(catalog.mods);
+  live_.assign(mods_.size(), 1);
+  indexById_.clear();
+  indexById_.reserve(mods_.size());
+  for (std::size_t i = 0; i < mods_.size(); ++i) {
+    indexById_[mods_[i].id] = static_cast<int>(i);
+  }
+  clearTags();
+  for (auto& [modId, rows] : catalog.tags) {
+    storeTags(modId, std::move(rows));
+  }
+  facets_ = std::move(catalog.facets);
+  nameIndex_ = std::move(catalog.nameIndex);
+  paged_ = catalog.paged;
+  pagedSummaries_.clear();
+
+  ++version_;
+  emit reset();
+}
+
+void ModStore::applyPatch(const std::vector<int>& changedIds) {
+  if (!repo_ || changedIds.empty()) {
+    return;
+  }
+  if (loading_) {
+    deferredPatch_.insert(deferredPatch_.end(), changedIds.begin(), changedIds.end());
+    return;
+  }
+  if (paged_) {
+    ++version_;
+    pagedSummaries_.clear();
+    emit pagesInvalidated();
+    return;
+  }
+
+  std::vector<int> changed;
+  std::vector<int> inserted;
+  std::vector<int> removed;
+  std::unordered_set<int> seen;
+  for (const int modId : changedIds) {
+    if (modId <= 0 || !seen.insert(modId).second) {
+      continue;
+    }
+    const int existing = indexOf(modId);
+    const auto modOpt = repo_->findMod(modId);
+    if (!modOpt) {
+      if (existing >= 0) {
+        // 保留下标，只从索引中移除，避免其它行的下标整体移动
+        live_[static_cast<std::size_t>(existing)] = 0;
+        indexById_.erase(modId);
+        tags_.erase(modId);
+        tagSignatures_.erase(modId);
+        facets_.erase(static_cast<std::size_t>(existing));
+        nameIndex_.remove(existing);
+        removed.push_back(existing);
+      }
+      continue;
+    }
+
+    int index = existing;
+    if (index >= 0) {
+      mods_[static_cast<std::size_t>(index)] = *modOpt;
+      changed.push_back(index);
+    } else {
+      index = static_cast<int>(mods_.size());
+      mods_.push_back(*modOpt);
+      live_.push_back(1);
+      indexById_[modId] = index;
+      inserted.push_back(index);
+    }
+
+    auto rows = repo_->listTagsForMod(modId);
+    const ModRow& mod = mods_[static_cast<std::size_t>(index)];
+    facets_.update(static_cast<std::size_t>(index), mod, tagIdsOf(rows), categoryParent_);
+    nameIndex_.upsert(index, mod.name, mod.author);
+    storeTags(modId, std::move(rows));
+  }
+
+  if (changed.empty() && inserted.empty() && removed.empty()) {
+    return;
+  }
+  ++version_;
+  if (!removed.empty()) {
+    emit rowsRemoved(removed);
+  }
+  if (!inserted.empty()) {
+    emit rowsInserted(inserted);
+  }
+  if (!changed.empty()) {
+    emit rowsChanged(changed);
+  }
+}
+
+void ModStore::setCategoryParents(const std::unordered_map<int, int>& categoryParent) {
+  categoryParent_ = categoryParent;
+  if (facets_.size() == 0) {
+    return;
+  }
+  // 子树倒排表依赖整棵分类树，逐行更新并不比重建便宜
+  std::unordered_map<int, std::vector<int>> tagIdsByMod;
+  tagIdsByMod.reserve(tags_.size());
+  for (const auto& [modId, rows] : tags_) {
+    tagIdsByMod[modId] = tagIdsOf(rows);
+  }
+  facets_.build(mods_, tagIdsByMod, categoryParent_);
+  for (std::size_t i = 0; i < live_.size(); ++i) {
+    if (!live_[i]) {
+      facets_.erase(i);
+    }
+  }
+  ++version_;
+}
+
+bool ModStore::isLive(int index) const {
+  return index >= 0 && static_cast<std::size_t>(index) < live_.size() && live_[static_cast<std::size_t>(index)];
+}
+
+int ModStore::indexOf(int modId) const {
+  const auto it = indexById_.find(modId);
+  return it != indexById_.end() ? it->second : -1;
+}
+
+const std::vector<TagWithGroupRow>& ModStore::tagsFor(int modId) const {
+  static const std::vector<TagWithGroupRow> kEmptyTags;
+  const auto it = tags_.find(modId);
+  return it != tags_.end() ? it->second : kEmptyTags;
+}
+
+QString ModStore::tagSummary(int modId) const {
+  if (paged_) {
+    if (const QString* cached = pagedSummaries_.find(modId)) {
+      return *cached;
+    }
+    QString summary = repo_ ? formatTagSummary(repo_->listTagsForMod(modId), QStringLiteral("  |  "), QStringLiteral(" / "))
+                            : QString();
+    pagedSummaries_.insert(modId, summary, 1);
+    return summary;
+  }
+
+  const auto signature = tagSignatures_.find(modId);
+  if (signature == tagSignatures_.end()) {
+    return {};
+  }
+  const auto cached = summaryCache_.find(signature->second);
+  if (cached != summaryCache_.end()) {
+    return cached->second;
+  }
+
+  // 排序键在 storeTags 中已为每个标签生成，这里只做字节比较
+  const auto byKey = [this](const TagWithGroupRow& a, const TagWithGroupRow& b) {
+    return tagSortKeys_.at(a.id).compare(tagSortKeys_.at(b.id)) < 0;
+  };
+  QString summary = summarize(tagsFor(modId), QStringLiteral("  |  "), QStringLiteral(" / "), byKey);
+  summaryCache_.emplace(signature->second, summary);
+  return summary;
+}
+
+std::vector<int> ModStore::tagIdsOf(const std::vector<TagWithGroupRow>& rows) {
+  std::vector<int> ids;
+  ids.reserve(rows.size());
+  for (const auto& row : rows) {
+    ids.push_back(row.id);
+  }
+  return ids;
+}
+
+void ModStore::storeTags(int modId, std::vector<TagWithGroupRow> rows) {
+  if (rows.empty()) {
+    tagSignatures_.erase(modId);
+    tags_.erase(modId);
+    return;
+  }
+
+  std::vector<int> ids = tagIdsOf(rows);
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  std::string signature;
+  for (const int id : ids) {
+    signature += std::to_string(id);
+    signature += ',';
+  }
+  tagSignatures_[modId] = std::move(signature);
+
+  for (const auto& row : rows) {
+    if (tagSortKeys_.find(row.id) == tagSortKeys_.end()) {
+      tagSortKeys_.emplace(row.id, collator_.sortKey(QString::fromStdString(row.name)));
+    }
+  }
+  tags_[modId] = std::move(rows);
+}
+
+void ModStore::clearTags() {
+  // 标签可能在 reload 之间被改名，签名对应的摘要与排序键一并作废
+  tags_.clear();
+  tagSignatures_.clear();
+  summaryCache_.clear();
+  tagSortKeys_.clear();
+}
+
+QString ModStore::formatTagSummary(const std::vector<TagWithGroupRow>& rows,
+                                   const QString& groupSeparator,
+                                   const QString& tagSeparator) {
+  return summarize(rows, groupSeparator, tagSeparator,
+                   [](const TagWithGroupRow& a, const TagWithGroupRow& b) {
+                     return QString::fromStdString(a.name).localeAwareCompare(QString::fromStdString(b.name)) < 0;
+                   });
+}
+
+QString ModStore::summarize(const std::vector<TagWithGroupRow>& rows,
+                            const QString& groupSeparator,
+                            const QString& tagSeparator,
+                            const TagLess& tagLess) {
+  if (rows.empty()) {
+    return {};
+  }
+
+  QMap<QString, std::vector<const TagWithGroupRow*>> grouped;
+  for (const auto& row : rows) {
+    auto& list = grouped[QString::fromStdString(row.group_name)];
+    const bool duplicate = std::any_of(list.begin(), list.end(), [&row](const TagWithGroupRow* existing) {
+      return existing->name == row.name;
+    });
+    if (!duplicate) {
+      list.push_back(&row);
+    }
+  }
+
+  QStringList sections;
+  for (auto it = grouped.begin(); it != grouped.end(); ++it) {
+    auto& tags = it.value();
+    std::sort(tags.begin(), tags.end(), [&tagLess](const TagWithGroupRow* a, const TagWithGroupRow* b) {
+      return tagLess(*a, *b);
+    });
+    QStringList names;
+    names.reserve(static_cast<int>(tags.size()));
+    for (const TagWithGroupRow* tag : tags) {
+      names << QString::fromStdString(tag->name);
+    }
+    sections << QString("%1: %2").arg(it.key(), names.join(tagSeparator));
+  }
+  return sections.join(groupSeparator);
+}
@@ -0,0 +1,155 @@
+// UTF-8
+#pragma once
+
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/index/FacetIndex.h"
+#include "core/index/NameSearchIndex.h"
+#include "core/repo/RepositoryService.h"
+#include "core/util/LruCache.h"
+
+/**
+ * 仓库 MOD 的内存副本：MOD 行、标签、标签摘要以及筛选用的倒排索引与名称索引。
+ * - reload() 从数据库全量加载并发出 reset；applyPatch() 只重新读取变化的 MOD，
+ *   就地更新对应行与索引，并按行发出 rowsChanged / rowsInserted / rowsRemoved。
+ * - 行下标在两次 reload 之间保持稳定：新 MOD 追加到末尾，数据库中已不存在的 MOD 只标记为已移除，
+ *   其下标保留到下次 reload，已移除的行不再出现在索引与筛选结果中。
+ * - reloadAsync() 在后台线程用独立的数据库连接读取并建好索引，完成后回到 GUI 线程替换数据并发出 reset；
+ *   加载期间收到的 applyPatch 会在替换完成后再执行一次。
+ * - 后台加载优先读取数据库旁的目录快照（<数据库>.catalog），快照与数据库的目录版本一致时不再逐条查询；
+ *   否则从数据库加载后重写快照。
+ * - 每次 reload 或 applyPatch 都会递增 version()，调用方据此判断缓存的派生数据是否过期。
+ * - 标签摘要在首次显示时才生成，并按标签集合（排序后的标签 id）缓存：标签相同的 MOD 共用同一份摘要。
+ *   标签名的排序键在读入标签时一次生成，排序时不再逐次做本地化比较。
+ * - MOD 总数超过 kPagedThreshold 时进入分页模式：不在内存中保存行与索引（mods() 为空），
+ *   表格改由 ModPageSource 按需查询数据库；applyPatch 只发出 pagesInvalidated，标签摘要按 MOD 逐个查询并缓存最近使用的部分。
+ */
+class ModStore : public QObject {
+  Q_OBJECT
+
+public:
+  /// 超过该数量的仓库不整体载入内存，改为分页查询。
+  static constexpr int kPagedThreshold = 50000;
+
+  explicit ModStore(QObject* parent = nullptr);
+
+  void setRepositoryService(RepositoryService* repo) { repo_ = repo; }
+
+  /// 从数据库重新加载全部 MOD（含已标记删除的）及其标签。
+  void reload();
+
+  /**
+   * 在后台线程重新加载，完成后发出 reset。
+   * @param dbPath 数据库路径，后台线程为其单独打开连接（SQLite 连接不跨线程共享）
+   * 再次调用 reload() 或 reloadAsync() 会使尚未完成的加载作废。
+   */
+  void reloadAsync(const std::string& dbPath);
+  /// 是否有尚未完成的 reloadAsync()。
+  bool isLoading() const { return loading_; }
+
+  /**
+   * 重新读取指定 MOD 并就地更新：已有的行原位替换，新 MOD 追加到末尾，数据库中已不存在的行标记为移除。
+   * 重复的 id 只处理一次。
+   */
+  void applyPatch(const std::vector<int>& changedIds);
+
+  /// 分类树变化后更新父分类表，并重建分类子树倒排表。
+  void setCategoryParents(const std::unordered_map<int, int>& categoryParent);
+
+  std::uint64_t version() const { return version_; }
+  /// 是否处于分页模式（见类说明）。
+  bool paged() const { return paged_; }
+
+  /// 全部行（下标即索引与筛选结果中的下标），包括已移除的行。
+  const std::vector<ModRow>& mods() const { return mods_; }
+  /// 行是否仍然有效（未被 applyPatch 移除）。
+  bool isLive(int index) const;
+  /// MOD id 对应的下标，不存在或已移除时返回 -1。
+  int indexOf(int modId) const;
+
+  const std::vector<TagWithGroupRow>& tagsFor(int modId) const;
+  /// 表格中显示的标签摘要（分组之间以“ | ”分隔），首次请求时生成。
+  QString tagSummary(int modId) const;
+
+  const FacetIndex& facets() const { return facets_; }
+  /// 条目 id 为 mods() 下标。
+  const NameSearchIndex& nameIndex() const { return nameIndex_; }
+
+  /// 按分组汇总标签：组内按本地化顺序排序，格式为“组名: 标签1<tagSeparator>标签2”。
+  static QString formatTagSummary(const std::vector<TagWithGroupRow>& rows,
+                                  const QString& groupSeparator,
+                                  const QString& tagSeparator);
+
+signals:
+  void reset();
+  void rowsChanged(const std::vector<int>& indices);
+  void rowsInserted(const std::vector<int>& indices);
+  void rowsRemoved(const std::vector<int>& indices);
+  /// 分页模式下数据库发生写入，已查询的分页需要重新读取。
+  void pagesInvalidated();
+
+private:
+  /// 一次全量加载的结果，可在后台线程生成。
+  struct Catalog {
+    std::vector<ModRow> mods;
+    std::unordered_map<int, std::vector<TagWithGroupRow>> tags;
+    FacetIndex facets;
+    NameSearchIndex nameIndex;
+    bool paged{false};
+  };
+
+  /**
+   * @param cachePath 目录快照路径，为空时直接查询数据库
+   */
+  static std::shared_ptr<Catalog> loadCatalog(const RepositoryService& repo,
+                                              const std::unordered_map<int, int>& categoryParent,
+                                              const std::filesystem::path& cachePath = {});
+  void install(Catalog&& catalog);
+
+  using TagLess = std::function<bool(const TagWithGroupRow&, const TagWithGroupRow&)>;
+
+  static std::vector<int> tagIdsOf(const std::vector<TagWithGroupRow>& rows);
+  static QString summarize(const std::vector<TagWithGroupRow>& rows,
+                           const QString& groupSeparator,
+                           const QString& tagSeparator,
+                           const TagLess& tagLess);
+  void storeTags(int modId, std::vector<TagWithGroupRow> rows);
+  void clearTags();
+
+  RepositoryService* repo_{};
+  std::uint64_t version_{0};
+  bool paged_{false};
+  std::vector<ModRow> mods_;
+  std::vector<char> live_;
+  std::unordered_map<int, int> indexById_;
+  std::unordered_map<int, std::vector<TagWithGroupRow>> tags_;
+  /// MOD id -> 标签集合签名（排序去重后的标签 id，以逗号连接）；无标签的 MOD 不记录。
+  std::unordered_map<int, std::string> tagSignatures_;
+  /// 标签集合签名 -> 已生成的摘要。
+  mutable std::unordered_map<std::string, QString> summaryCache_;
+  QCollator collator_;
+  /// 标签 id -> 标签名的排序键。
+  std::unordered_map<int, QCollatorSortKey> tagSortKeys_;
+  /// 分页模式下 MOD id -> 标签摘要，只保留最近显示过的。
+  mutable LruCache<int, QString> pagedSummaries_{4096};
+  std::unordered_map<int, int> categoryParent_;
+  FacetIndex facets_;
+  NameSearchIndex nameIndex_;
+
+  QThreadPool loadPool_;
+  std::uint64_t loadGeneration_{0}; ///< reload 时递增，过期的后台结果直接丢弃
+  bool loading_{false};
+  std::vector<int> deferredPatch_;  ///< 后台加载期间收到的 applyPatch
+};
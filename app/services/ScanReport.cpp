@@ -0,0 +1,26 @@
+// UTF-8
+#include "app/services/ScanReport.h"
+
+#include <QStringList>
+
+QString ScanReport::summary() const {
+  QStringList statuses;
+  for (auto it = statusCounts.cbegin(); it != statusCounts.cend(); ++it) {
+    statuses << QStringLiteral("%1=%2").arg(it.key()).arg(it.value());
+  }
+  return QStringLiteral("scan %1ms (inventory %2, enumerate %3, match %4, sync %5, db %6, watch %7); "
+                        "files %8 [%9], synced %10, copied %11 B, hashed %12 B, coalesced events %13")
+      .arg(totalMs)
+      .arg(inventoryMs)
+      .arg(enumerationMs)
+      .arg(matchingMs)
+      .arg(workshopSyncMs)
+      .arg(dbWriteMs)
+      .arg(watchUpdateMs)
+      .arg(filesScanned)
+      .arg(statuses.join(QStringLiteral(", ")))
+      .arg(syncedMods)
+      .arg(static_cast<qulonglong>(bytesCopied))
+      .arg(static_cast<qulonglong>(bytesHashed))
+      .arg(watcherEventsCoalesced);
+}
@@ -0,0 +1,39 @@
+// UTF-8
+#pragma once
+
+#include <QDateTime>
+#include <QMap>
+#include <QMetaType>
+#include <QString>
+
+#include <cstdint>
+
+/**
+ * 游戏目录扫描报告：记录一次 rescanAll 的分阶段耗时与计数，便于定位扫描缓慢的原因。
+ * - 各阶段耗时均为墙钟时间（毫秒）；枚举、匹配、同步在逐文件循环中交替进行，按阶段累加。
+ * - 由 GameDirectoryMonitor 随 gameModsUpdated 一并发出，并保存在最近若干次的环形缓冲中。
+ */
+struct ScanReport {
+  QDateTime startedAt;          ///< 扫描开始时间（UTC）
+  bool initialScan{false};      ///< 是否为首次全量扫描
+
+  qint64 inventoryMs{0};        ///< 构建仓库索引
+  qint64 enumerationMs{0};      ///< 列举目录与过滤文件
+  qint64 matchingMs{0};         ///< 指纹计算（含按需补算仓库指纹）与仓库匹配
+  qint64 workshopSyncMs{0};     ///< workshop 文件同步（复制、哈希、批量写回）
+  qint64 dbWriteMs{0};          ///< 写入 gamemods 缓存表
+  qint64 watchUpdateMs{0};      ///< 刷新文件监听列表
+  qint64 totalMs{0};            ///< 总耗时
+
+  int filesScanned{0};          ///< 参与匹配的 MOD 文件数
+  QMap<QString, int> statusCounts; ///< 按状态统计的文件数
+  int syncedMods{0};            ///< 同步到仓库的 MOD 数量
+  std::uint64_t bytesCopied{0}; ///< 复制的字节数（MOD 文件与封面）
+  std::uint64_t bytesHashed{0}; ///< 读取用于哈希的字节数（指纹窗口与全量哈希）
+  int watcherEventsCoalesced{0}; ///< 合并进本次扫描的文件监听事件数
+
+  /// 生成单行摘要，用于日志与诊断视图。
+  QString summary() const;
+};
+
+Q_DECLARE_METATYPE(ScanReport)
@@ -0,0 +1,212 @@
+// UTF-8
+#include "app/services/ThumbnailCache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QMetaObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <string>
+
+#include "core/vpk/AddonInfo.h"
+#include "core/vpk/VpkArchive.h"
+#include "core/vpk/VtfImage.h"
+
+namespace {
+
+/// 预览图条目超过该长度视为损坏（创意工坊预览图通常不到 1 MiB）。
+constexpr std::uint64_t kMaxImageBytes = 16ull * 1024 * 1024;
+
+bool isVtf(std::string_view extension) {
+  return extension.size() == 3 && (extension[0] | 0x20) == 'v' && (extension[1] | 0x20) == 't' &&
+         (extension[2] | 0x20) == 'f';
+}
+
+QImage decodeImage(const VpkEntry& entry, std::string_view bytes) {
+  const auto* data = reinterpret_cast<const std::uint8_t*>(bytes.data());
+  if (isVtf(entry.extension)) {
+    const auto rgba = decodeVtf(data, bytes.size(), ThumbnailCache::kThumbnailEdge);
+    if (!rgba) {
+      return {};
+    }
+    return QImage(rgba->pixels.data(), rgba->width, rgba->height, rgba->width * 4, QImage::Format_RGBA8888).copy();
+  }
+  QImage image;
+  image.loadFromData(data, static_cast<int>(bytes.size()));
+  return image;
+}
+
+} // namespace
+
+ThumbnailCache::ThumbnailCache(const QString& directory, QObject* parent)
+    : QObject(parent), directory_(directory.isEmpty() ? defaultDirectory() : directory) {
+  worker_ = std::thread([this]() { workerLoop(); });
+}
+
+ThumbnailCache::~ThumbnailCache() {
+  {
+    std::lock_guard lock(mutex_);
+    stopping_ = true;
+    queue_.clear();
+  }
+  wake_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+QString ThumbnailCache::defaultDirectory() {
+  return QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(QStringLiteral("thumbnails"));
+}
+
+QString ThumbnailCache::thumbnailPath(const QString& key) const {
+  return QDir(directory_).filePath(key.left(2) + QLatin1Char('/') + key + QStringLiteral(".png"));
+}
+
+QString ThumbnailCache::missingMarkerPath(const QString& key) const {
+  return QDir(directory_).filePath(key.left(2) + QLatin1Char('/') + key + QStringLiteral(".none"));
+}
+
+void ThumbnailCache::request(int modId, const QString& filePath, const QString& fileHash) {
+  if (modId <= 0 || !filePath.endsWith(QStringLiteral(".vpk"), Qt::CaseInsensitive)) {
+    return;
+  }
+  {
+    std::lock_guard lock(mutex_);
+    const auto queued = queuedFiles_.constFind(modId);
+    if (queued != queuedFiles_.constEnd() && queued.value() == filePath) {
+      return;
+    }
+    queuedFiles_.insert(modId, filePath);
+    queue_.push_back({modId, filePath, fileHash});
+  }
+  wake_.notify_one();
+}
+
+void ThumbnailCache::cancelPending() {
+  std::lock_guard lock(mutex_);
+  queue_.clear();
+  queuedFiles_.clear();
+}
+
+void ThumbnailCache::workerLoop() {
+  for (;;) {
+    Request request;
+    {
+      std::unique_lock lock(mutex_);
+      wake_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      request = std::move(queue_.front());
+      queue_.pop_front();
+    }
+
+    const QString path = produce(request);
+    {
+      std::lock_guard lock(mutex_);
+      // 等待期间同一 MOD 可能以新路径重新排队，只移除与本次请求对应的记录
+      const auto queued = queuedFiles_.constFind(request.modId);
+      if (queued != queuedFiles_.constEnd() && queued.value() == request.filePath) {
+        queuedFiles_.erase(queued);
+      }
+    }
+    const int modId = request.modId;
+    QMetaObject::invokeMethod(
+        this, [this, modId, path]() { emit thumbnailReady(modId, path); }, Qt::QueuedConnection);
+  }
+}
+
+QString ThumbnailCache::produce(const Request& request) {
+  QString key = request.fileHash;
+  if (!key.isEmpty()) {
+    const QString cached = thumbnailPath(key);
+    if (QFileInfo::exists(cached)) {
+      return cached;
+    }
+    if (QFileInfo::exists(missingMarkerPath(key))) {
+      return {};
+    }
+  }
+
+  const auto markMissing = [this](const QString& missingKey) {
+    const QString marker = missingMarkerPath(missingKey);
+    QDir().mkpath(QFileInfo(marker).absolutePath());
+    QFile file(marker);
+    if (file.open(QIODevice::WriteOnly)) {
+      file.close();
+    }
+  };
+
+  std::error_code ec;
+  VpkArchive archive;
+  if (!archive.open(std::filesystem::path(request.filePath.toStdU16String()), ec)) {
+    // 打不开的文件（可能暂时被占用）不写标记，下次选中时重试
+    spdlog::debug("Thumbnail skipped for {}: {}", request.filePath.toStdString(), ec.message());
+    return {};
+  }
+
+  const VpkEntry* entry = findAddonImage(archive);
+  if (!entry) {
+    if (!key.isEmpty()) {
+      markMissing(key);
+    }
+    return {};
+  }
+
+  if (key.isEmpty()) {
+    // 目录树中的 CRC32 与长度即可标识预览图内容，无需读取图片数据
+    key = QStringLiteral("%1%2")
+              .arg(entry->crc, 8, 16, QLatin1Char('0'))
+              .arg(static_cast<qulonglong>(entry->size()), 8, 16, QLatin1Char('0'));
+    const QString cached = thumbnailPath(key);
+    if (QFileInfo::exists(cached)) {
+      return cached;
+    }
+  }
+
+  // 长度在目录树中即可得知，先拒绝超限条目，避免映射视图绕过上限后在解码时溢出
+  if (entry->size() > kMaxImageBytes) {
+    spdlog::debug("Thumbnail entry too large in {} ({}, {} bytes)", request.filePath.toStdString(), entry->path(),
+                  entry->size());
+    markMissing(key);
+    return {};
+  }
+
+  // 位于目录文件内的条目直接在映射上解码，VTF 只会触及所选 mip 的数据页
+  std::string owned;
+  std::string_view bytes;
+  if (const auto view = archive.view(*entry)) {
+    bytes = *view;
+  } else if (archive.read(*entry, owned, ec, kMaxImageBytes)) {
+    bytes = owned;
+  } else {
+    spdlog::debug("Thumbnail read failed for {}: {}", request.filePath.toStdString(), ec.message());
+    return {};
+  }
+
+  QImage image = decodeImage(*entry, bytes);
+  if (image.isNull()) {
+    spdlog::debug("Thumbnail decode failed for {} ({})", request.filePath.toStdString(), entry->path());
+    markMissing(key);
+    return {};
+  }
+  if (image.width() > kThumbnailEdge || image.height() > kThumbnailEdge) {
+    image = image.scaled(kThumbnailEdge, kThumbnailEdge, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+  }
+
+  // QSaveFile 先写唯一的临时文件再原子替换，避免 UI 线程读到写了一半的缩略图
+  const QString target = thumbnailPath(key);
+  QDir().mkpath(QFileInfo(target).absolutePath());
+  QSaveFile file(target);
+  if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+    spdlog::warn("Failed to write thumbnail {}: {}", target.toStdString(), file.errorString().toStdString());
+    return {};
+  }
+  return target;
+}
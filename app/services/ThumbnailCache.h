@@ -0,0 +1,67 @@
+// UTF-8
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * VPK 内嵌预览图的磁盘缩略图缓存。
+ * - 直接在 VPK 目录文件的映射上定位 addonimage.* 条目，只读取该条目（VTF 只读取所需的一级 mip），不解包整个文件。
+ * - 缩略图按内容哈希命名：优先使用 MOD 文件哈希，未计算哈希时使用 VPK 目录树为预览图记录的 CRC32 与长度，
+ *   无需读取图片本身即可命中缓存；存放为 <缓存目录>/<前两位>/<键>.png（保留透明通道），
+ *   没有预览图的文件写入 .none 标记，避免重复打开。
+ * - 请求在单个后台线程中按先进先出处理并去重；结果通过 thumbnailReady 信号在 UI 线程送达，仓库页面从不等待解码。
+ */
+class ThumbnailCache : public QObject {
+  Q_OBJECT
+
+public:
+  static constexpr int kThumbnailEdge = 256; ///< 缩略图最长边像素数
+
+  /// @param directory 缓存目录，为空时使用 defaultDirectory()。
+  explicit ThumbnailCache(const QString& directory = {}, QObject* parent = nullptr);
+  ~ThumbnailCache() override;
+
+  /// 系统缓存目录下的 thumbnails 子目录。
+  static QString defaultDirectory();
+
+  /**
+   * 排队生成缩略图；同一 MOD 已在队列中时忽略。非 VPK 文件直接忽略。
+   * 完成后发出 thumbnailReady（没有预览图时 path 为空）。
+   */
+  void request(int modId, const QString& filePath, const QString& fileHash);
+
+  /// 丢弃尚未开始的请求（详情区切换到其它 MOD 时）。
+  void cancelPending();
+
+signals:
+  void thumbnailReady(int modId, const QString& path);
+
+private:
+  struct Request {
+    int modId{0};
+    QString filePath;
+    QString fileHash;
+  };
+
+  void workerLoop();
+  /// 在后台线程中生成缩略图，返回缩略图路径（没有预览图时为空）。
+  QString produce(const Request& request);
+  QString thumbnailPath(const QString& key) const;
+  QString missingMarkerPath(const QString& key) const;
+
+  QString directory_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<Request> queue_;
+  QHash<int, QString> queuedFiles_; ///< 队列中的 MOD -> 文件路径，用于去重
+  bool stopping_{false};
+  std::thread worker_;
+};
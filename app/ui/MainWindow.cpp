@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <functional>
+#include <optional>
+#include <utility>
 
 #include <QAbstractItemView>
 #include <QCheckBox>
@@ -62,9 +64,17 @@ QString toDisplay(const std::string& value, const QString& fallback = {}) {
 MainWindow::~MainWindow() = default;
 
 MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
+  initLogging();
+  const std::size_t uiPhase = startupTrace_.begin("ui");
   setupUi();
+  startupTrace_.end(uiPhase);
 
-  initLogging();
+  // 窗口与空表格先显示出来，其余启动工作在事件循环开始后分阶段执行
+  QTimer::singleShot(0, this, &MainWindow::runStartup);
+}
+
+void MainWindow::runStartup() {
+  const std::size_t settingsPhase = startupTrace_.begin("settings");
   settings_ = Settings::loadOrCreate();
 
   const QString appDirPath = QCoreApplication::applicationDirPath();
@@ -134,16 +144,13 @@ MainWindow::MainWindow(QWidget* parent) : QMainWindow(parent) {
   if (settingsChanged) {
     settings_.save();
   }
+  startupTrace_.end(settingsPhase);
 
+  // 设置页的各个界面在 switchToSettings 时刷新，启动时无需提前构建
+  startupModsPhase_ = startupTrace_.begin("mods");
+  const std::size_t repositoryPhase = startupTrace_.begin("repository");
   reinitializeRepository(settings_);
-  refreshBasicSettingsUi();
-  refreshCategoryManagementUi();
-  refreshTagManagementUi();
-  refreshDeletionSettingsUi();
-
-  QTimer::singleShot(0, this, [this]() {
-    scheduleGameDirectoryScan(true);
-  });
+  startupTrace_.end(repositoryPhase);
 }
 
 void MainWindow::setupUi() {
@@ -558,7 +565,8 @@ void MainWindow::reinitializeRepository(const Settings& settings) {
   repositoryPresenter_->setRepositoryService(repo_.get());
   repositoryPresenter_->setImportService(importService_.get());
   repositoryPresenter_->setRepositoryDirectory(repoDir_);
-  repositoryPresenter_->reloadAll();
+  // MOD 与标签在后台加载，完成后经 modsReloaded 刷新选择器
+  repositoryPresenter_->reloadAllAsync();
 
   if (selectorPresenter_) {
     selectorPresenter_->setRepositoryPresenter(repositoryPresenter_.get());
@@ -721,11 +729,15 @@ void MainWindow::reloadRepoSelectorData() {
   }
 }
 
-void MainWindow::onGameModsUpdated(const QStringList& updatedMods, bool /*initialScan*/) {
+void MainWindow::onGameModsUpdated(const QStringList& updatedMods, bool /*initialScan*/, const ScanReport& /*report*/) {
   if (selectorPage_) {
     selectorPage_->hideLoadingOverlay();
   }
   isGameModsLoading_ = false;
+  if (startupScanPhase_) {
+    startupTrace_.end(*std::exchange(startupScanPhase_, std::nullopt));
+    spdlog::info("Startup trace: {}", startupTrace_.summary());
+  }
 
   if (selectorPresenter_) {
     selectorPresenter_->refreshGameDirectory();
@@ -1576,5 +1588,17 @@ bool MainWindow::ensureModFilesInRepository(ModRow& mod, QStringList& errors) co
 }
 void MainWindow::onRepositoryModsReloaded() {
   reloadRepoSelectorData();
+  if (!startupModsPhase_) {
+    return;
+  }
+  startupTrace_.end(*std::exchange(startupModsPhase_, std::nullopt));
+  startupTrace_.mark("interactive");
+  spdlog::info("Interactive after {} ms", startupTrace_.elapsed().count() / 1000);
+
+  // 仓库数据已可操作，游戏目录扫描推迟到事件队列空闲时再开始
+  QTimer::singleShot(0, this, [this]() {
+    startupScanPhase_ = startupTrace_.begin("scan");
+    scheduleGameDirectoryScan(true);
+  });
 }
 
@@ -3,12 +3,15 @@
 #include <QMainWindow>
 #include <QString>
 #include <QStringList>
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
 #include "core/config/Settings.h"
 #include "core/repo/RepositoryService.h"
+#include "core/util/StartupTrace.h"
 // 界面瘦身：引入应用服务/控制器头文件
 #include "app/services/GameDirectoryMonitor.h"
 #include "app/services/ImportService.h"
@@ -86,10 +89,12 @@ private slots:
   void onRenameTag();
   void onDeleteTag();
   void onTagSelectionChanged(int row);
-  void onGameModsUpdated(const QStringList& updatedMods, bool initialScan);
+  void onGameModsUpdated(const QStringList& updatedMods, bool initialScan, const ScanReport& report);
 
 private:
   void setupUi();
+  /// 窗口显示后执行的启动阶段：读取设置、打开数据库，并在后台加载仓库数据。
+  void runStartup();
   void onRepositoryModsReloaded();
   void reloadRepoSelectorData();
   void applySelectorFilter();
@@ -192,6 +197,10 @@ private:
   Settings settings_{};
   bool suppressCategoryItemSignals_ = false;
   bool isGameModsLoading_ = false;
+
+  StartupTrace startupTrace_;
+  std::optional<std::size_t> startupModsPhase_; ///< 仓库数据首次加载完成前有效
+  std::optional<std::size_t> startupScanPhase_; ///< 首次游戏目录扫描完成前有效
 };
 
 
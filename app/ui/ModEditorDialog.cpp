@@ -3,11 +3,9 @@
 #include <QAbstractSpinBox>
 #include <QComboBox>
 #include <QCompleter>
-#include <QCryptographicHash>
 #include <QDialogButtonBox>
 #include <QDir>
 #include <QDoubleSpinBox>
-#include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
 #include <QFormLayout>
@@ -27,6 +25,9 @@
 #include <QVBoxLayout>
 #include <algorithm>
 
+#include "app/services/CoverIndex.h"
+#include "core/hash/FileHasher.h"
+
 namespace {
 
 QString trimmed(const QString& text) {
@@ -37,17 +38,6 @@ QString joinTagDescriptor(const TagDescriptor& desc) {
   return QString::fromStdString(desc.group) + u":" + QString::fromStdString(desc.tag);
 }
 
-QString normalizeName(const QString& text) {
-  QString normalized;
-  normalized.reserve(text.size());
-  for (const QChar& ch : text) {
-    if (ch.isLetterOrNumber()) {
-      normalized.append(ch.toLower());
-    }
-  }
-  return normalized;
-}
-
 void ensureComboSelection(QComboBox* combo, const QString& value) {
   if (!combo) {
     return;
@@ -1017,6 +1007,7 @@ void ModEditorDialog::setMod(const ModRow& mod, const std::vector<TagDescriptor>
   sourceUrlEdit_->setText(QString::fromStdString(mod.source_url));
   noteEdit_->setPlainText(QString::fromStdString(mod.note));
   hashEdit_->setText(QString::fromStdString(mod.file_hash));
+  hashAlgo_ = mod.hash_algo;
 
   int primarySelection = 0;
   int secondarySelection = 0;
@@ -1159,6 +1150,7 @@ ModRow ModEditorDialog::modData() const {
   mod.cover_path = trimmed(coverPathEdit_->text()).toStdString();
   mod.file_path = trimmed(filePathEdit_->text()).toStdString();
   mod.file_hash = trimmed(hashEdit_->text()).toStdString();
+  mod.hash_algo = mod.file_hash.empty() ? std::string() : hashAlgo_;
   mod.size_mb = sizeSpin_->value();
   return mod;
 }
@@ -1311,13 +1303,11 @@ void ModEditorDialog::applyFileMetadata(const QString& path) {
   const double sizeMb = static_cast<double>(info.size()) / (1024.0 * 1024.0);
   sizeSpin_->setValue(sizeMb);
 
-  QFile file(info.absoluteFilePath());
-  if (file.open(QIODevice::ReadOnly)) {
-    QCryptographicHash hash(QCryptographicHash::Sha256);
-    while (!file.atEnd()) {
-      hash.addData(file.read(1 << 16));
-    }
-    hashEdit_->setText(QString::fromLatin1(hash.result().toHex()));
+  const std::string fileHash =
+      hashFile(std::filesystem::path(info.absoluteFilePath().toStdU16String()), kDefaultHashAlgorithm);
+  if (!fileHash.empty()) {
+    hashEdit_->setText(QString::fromStdString(fileHash));
+    hashAlgo_ = std::string(hashAlgorithmName(kDefaultHashAlgorithm));
   }
 
   const QDateTime lastModified = info.lastModified();
@@ -1340,32 +1330,8 @@ void ModEditorDialog::applyFileMetadata(const QString& path) {
 }
 
 QString ModEditorDialog::locateCoverSibling(const QFileInfo& fileInfo) const {
-  static const QStringList filters = {"*.png", "*.jpg", "*.jpeg", "*.bmp", "*.webp"};
-
-  const QDir dir = fileInfo.dir();
-  const QString base = fileInfo.completeBaseName();
-  const QString modName = trimmed(nameEdit_->text());
-
-  const QString normalizedBase = normalizeName(base);
-  const QString normalizedModName = normalizeName(modName);
-
-  QFileInfoList images = dir.entryInfoList(filters, QDir::Files | QDir::Readable);
-
-  for (const QFileInfo& image : images) {
-    if (normalizeName(image.completeBaseName()) == normalizedBase && !normalizedBase.isEmpty()) {
-      return image.absoluteFilePath();
-    }
-  }
-
-  if (!normalizedModName.isEmpty()) {
-    for (const QFileInfo& image : images) {
-      if (normalizeName(image.completeBaseName()).contains(normalizedModName)) {
-        return image.absoluteFilePath();
-      }
-    }
-  }
-
-  return {};
+  return CoverIndex::forDirectory(fileInfo.absolutePath())
+      ->locate(fileInfo.completeBaseName(), trimmed(nameEdit_->text()));
 }
 
 void ModEditorDialog::maybeAutoFillPlatform(const QString& url) {
@@ -139,6 +139,7 @@ private:
   bool suppressFileSignal_{false};
   bool platformEditedManually_{false};
   QString lastAutoPlatform_;
+  std::string hashAlgo_; ///< hashEdit_ 中哈希所用算法
 
   QLineEdit* nameEdit_{};
   QLineEdit* authorEdit_{};
@@ -0,0 +1,222 @@
+#include "app/ui/components/ModTableModel.h"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+ModTableModel::ModTableModel(QObject* parent) : QAbstractTableModel(parent) {}
+
+void ModTableModel::setHeaders(const QStringList& headers) {
+  beginResetModel();
+  headers_ = headers;
+  endResetModel();
+}
+
+void ModTableModel::setColumns(std::vector<ColumnText> columns) {
+  columns_ = std::move(columns);
+  if (rowCount() > 0 && !headers_.isEmpty()) {
+    emit dataChanged(index(0, 0), index(rowCount() - 1, headers_.size() - 1));
+  }
+}
+
+void ModTableModel::setRows(const std::vector<ModRow>* mods, std::vector<int> rows) {
+  beginResetModel();
+  mods_ = mods;
+  rows_ = std::move(rows);
+  pages_.reset();
+  endResetModel();
+}
+
+void ModTableModel::setPageSource(std::shared_ptr<ModPageSource> source) {
+  beginResetModel();
+  mods_ = nullptr;
+  rows_.clear();
+  pages_ = std::move(source);
+  endResetModel();
+}
+
+void ModTableModel::reloadPageSource() {
+  if (!pages_) {
+    return;
+  }
+  beginResetModel();
+  pages_->invalidate();
+  endResetModel();
+}
+
+void ModTableModel::updateRows(std::vector<int> rows, const std::vector<int>& changedSources) {
+  if (rows != rows_) {
+    // 两边都展示的行分别按旧、新顺序排列，据此区分纯重排、纯增删与混合变化
+    const std::unordered_set<int> current(rows_.begin(), rows_.end());
+    const std::unordered_set<int> next(rows.begin(), rows.end());
+    std::vector<int> keptInOldOrder;
+    for (const int source : rows_) {
+      if (next.count(source) != 0) {
+        keptInOldOrder.push_back(source);
+      }
+    }
+    std::vector<int> keptInNewOrder;
+    for (const int source : rows) {
+      if (current.count(source) != 0) {
+        keptInNewOrder.push_back(source);
+      }
+    }
+
+    if (keptInOldOrder.size() == rows_.size() && keptInNewOrder.size() == rows.size()) {
+      reorderRows(std::move(rows));
+    } else if (keptInOldOrder == keptInNewOrder) {
+      removeAndInsertRows(std::move(rows), current, next);
+    } else {
+      beginResetModel();
+      rows_ = std::move(rows);
+      endResetModel();
+    }
+  }
+
+  if (changedSources.empty() || rows_.empty() || headers_.isEmpty()) {
+    return;
+  }
+  const std::unordered_set<int> changed(changedSources.begin(), changedSources.end());
+  const int lastColumn = headers_.size() - 1;
+  for (std::size_t row = 0; row < rows_.size(); ++row) {
+    if (changed.count(rows_[row]) != 0) {
+      const int r = static_cast<int>(row);
+      emit dataChanged(index(r, 0), index(r, lastColumn));
+    }
+  }
+}
+
+void ModTableModel::reorderRows(std::vector<int> rows) {
+  emit layoutAboutToBeChanged();
+  // 按源下标把选中项、当前项等持久索引映射到新行
+  const QModelIndexList from = persistentIndexList();
+  std::vector<int> sources;
+  sources.reserve(static_cast<std::size_t>(from.size()));
+  for (const QModelIndex& persistent : from) {
+    const auto row = static_cast<std::size_t>(persistent.row());
+    sources.push_back(row < rows_.size() ? rows_[row] : -1);
+  }
+  std::unordered_map<int, int> rowBySource;
+  rowBySource.reserve(rows.size());
+  for (std::size_t row = 0; row < rows.size(); ++row) {
+    rowBySource.emplace(rows[row], static_cast<int>(row));
+  }
+  rows_ = std::move(rows);
+
+  QModelIndexList to;
+  to.reserve(from.size());
+  for (int i = 0; i < from.size(); ++i) {
+    const auto it = rowBySource.find(sources[static_cast<std::size_t>(i)]);
+    to.append(it != rowBySource.end() ? index(it->second, from[i].column()) : QModelIndex());
+  }
+  changePersistentIndexList(from, to);
+  emit layoutChanged();
+}
+
+void ModTableModel::removeAndInsertRows(std::vector<int> rows, const std::unordered_set<int>& current,
+                                        const std::unordered_set<int>& next) {
+  // 从末尾开始按连续区段移除，前面的行号不受影响
+  for (int last = static_cast<int>(rows_.size()) - 1; last >= 0;) {
+    if (next.count(rows_[static_cast<std::size_t>(last)]) != 0) {
+      --last;
+      continue;
+    }
+    int first = last;
+    while (first > 0 && next.count(rows_[static_cast<std::size_t>(first - 1)]) == 0) {
+      --first;
+    }
+    beginRemoveRows(QModelIndex(), first, last);
+    rows_.erase(rows_.begin() + first, rows_.begin() + last + 1);
+    endRemoveRows();
+    last = first - 1;
+  }
+
+  // 剩下的行与新顺序中的保留行一致，按连续区段插入新增的行
+  for (std::size_t row = 0; row < rows.size();) {
+    if (current.count(rows[row]) != 0) {
+      ++row;
+      continue;
+    }
+    std::size_t end = row;
+    while (end < rows.size() && current.count(rows[end]) == 0) {
+      ++end;
+    }
+    beginInsertRows(QModelIndex(), static_cast<int>(row), static_cast<int>(end) - 1);
+    rows_.insert(rows_.begin() + static_cast<std::ptrdiff_t>(row), rows.begin() + static_cast<std::ptrdiff_t>(row),
+                 rows.begin() + static_cast<std::ptrdiff_t>(end));
+    endInsertRows();
+    row = end;
+  }
+}
+
+const ModRow* ModTableModel::modAt(int row) const {
+  if (pages_) {
+    return row >= 0 ? pages_->rowAt(static_cast<std::size_t>(row)) : nullptr;
+  }
+  if (!mods_ || row < 0 || row >= static_cast<int>(rows_.size())) {
+    return nullptr;
+  }
+  const int source = rows_[static_cast<std::size_t>(row)];
+  if (source < 0 || source >= static_cast<int>(mods_->size())) {
+    return nullptr;
+  }
+  return &(*mods_)[static_cast<std::size_t>(source)];
+}
+
+int ModTableModel::modIdAt(int row) const {
+  const ModRow* mod = modAt(row);
+  return mod ? mod->id : 0;
+}
+
+int ModTableModel::rowForModId(int modId) const {
+  if (pages_) {
+    return pages_->indexOf(modId);
+  }
+  for (int row = 0; row < static_cast<int>(rows_.size()); ++row) {
+    if (modIdAt(row) == modId) {
+      return row;
+    }
+  }
+  return -1;
+}
+
+int ModTableModel::rowCount(const QModelIndex& parent) const {
+  if (parent.isValid()) {
+    return 0;
+  }
+  return pages_ ? static_cast<int>(pages_->count()) : static_cast<int>(rows_.size());
+}
+
+int ModTableModel::columnCount(const QModelIndex& parent) const {
+  return parent.isValid() ? 0 : headers_.size();
+}
+
+QVariant ModTableModel::data(const QModelIndex& index, int role) const {
+  if (!index.isValid()) {
+    return {};
+  }
+  const ModRow* mod = modAt(index.row());
+  if (!mod) {
+    return {};
+  }
+  switch (role) {
+    case Qt::DisplayRole: {
+      const auto column = static_cast<std::size_t>(index.column());
+      if (column >= columns_.size() || !columns_[column]) {
+        return {};
+      }
+      return columns_[column](*mod);
+    }
+    case Qt::UserRole:
+      return mod->id;
+    default:
+      return {};
+  }
+}
+
+QVariant ModTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+  if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < headers_.size()) {
+    return headers_.at(section);
+  }
+  return QAbstractTableModel::headerData(section, orientation, role);
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "core/repo/ModPageSource.h"
+#include "core/repo/RepositoryService.h"
+
+/**
+ * @brief 基于共享 MOD 列表的只读表格模型。
+ *
+ * - 不复制 MOD 数据：只引用调用方持有的 std::vector<ModRow>，并保存通过筛选的行下标。
+ * - 单元格文本在 data() 中按需生成，视图只为可见行请求数据，开销与可见行数成正比。
+ * - 筛选结果通过 setRows 整体替换；源列表被重新赋值后必须再次调用 setRows。
+ * - 源列表就地修改或追加时改用 updateRows：按增删或重排发出对应的行信号与 dataChanged，视图保留选中项与滚动位置。
+ * - 超大仓库改用 setPageSource：行按需从 ModPageSource 分页读取，行数来自聚合查询。
+ * - Qt::UserRole 在任意列返回 MOD id。
+ */
+class ModTableModel : public QAbstractTableModel {
+  Q_OBJECT
+public:
+  /// 单列的显示文本。
+  using ColumnText = std::function<QString(const ModRow&)>;
+
+  explicit ModTableModel(QObject* parent = nullptr);
+
+  void setHeaders(const QStringList& headers);
+  const QStringList& headers() const { return headers_; }
+
+  /// 各列文本的生成函数，下标与表头对应；缺少生成函数的列显示为空。
+  void setColumns(std::vector<ColumnText> columns);
+
+  /**
+   * @brief 替换展示的行。
+   * @param mods 源列表，由调用方持有且须在下次 setRows 之前保持有效
+   * @param rows 源列表中需要展示的下标，按展示顺序排列
+   */
+  void setRows(const std::vector<ModRow>* mods, std::vector<int> rows);
+
+  /**
+   * @brief 源列表被就地修改后更新展示的行，不重置模型。
+   * @param rows 新的展示下标；与当前相同时不发出行信号。只增删行时发出行插入/移除信号，
+   *             只调整顺序时发出布局变化，两者兼有时重置模型
+   * @param changedSources 内容发生变化的源下标，仍在展示中的行会发出 dataChanged
+   */
+  void updateRows(std::vector<int> rows, const std::vector<int>& changedSources);
+
+  /**
+   * @brief 改为从分页数据源读取行，替代 setRows 设置的源列表；再次调用 setRows 时退出分页模式。
+   */
+  void setPageSource(std::shared_ptr<ModPageSource> source);
+  /// 数据库写入后丢弃已读取的分页并重置模型；调用方负责恢复选中项。
+  void reloadPageSource();
+
+  /// 第 row 行对应的 MOD，越界时返回 nullptr。
+  const ModRow* modAt(int row) const;
+  /// 第 row 行对应的 MOD id，越界时返回 0。
+  int modIdAt(int row) const;
+  /// MOD id 所在的行，未展示时返回 -1。
+  int rowForModId(int modId) const;
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+  /// 行集合不变、只调整顺序时按源下标迁移持久索引。
+  void reorderRows(std::vector<int> rows);
+  /// 保留行的相对顺序不变时，先移除不再展示的行，再插入新增的行。
+  void removeAndInsertRows(std::vector<int> rows, const std::unordered_set<int>& current,
+                           const std::unordered_set<int>& next);
+
+  QStringList headers_;
+  std::vector<ColumnText> columns_;
+  const std::vector<ModRow>* mods_{};
+  std::vector<int> rows_;
+  std::shared_ptr<ModPageSource> pages_;
+};
@@ -2,28 +2,68 @@
 
 #include <QAbstractItemView>
 #include <QHeaderView>
+#include <QItemSelectionModel>
 
-ModTableWidget::ModTableWidget(QWidget* parent) : QTableWidget(parent) {
+#include "app/ui/components/ModTableModel.h"
+
+ModTableWidget::ModTableWidget(QWidget* parent) : QTableView(parent) {
   setSelectionBehavior(QAbstractItemView::SelectRows);
   setSelectionMode(QAbstractItemView::SingleSelection);
   setEditTriggers(QAbstractItemView::NoEditTriggers);
   setAlternatingRowColors(true);
+  setWordWrap(false);
   verticalHeader()->setVisible(false);
+  // 固定行高，滚动时无需逐行测量内容
+  verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
   setStyleSheet(
-      "QTableWidget::item:selected {"
+      "QTableView::item:selected {"
       " background-color: #D6EBFF;"
       " color: #1f3556;"
       " }"
-      "QTableWidget::item:selected:!active {"
+      "QTableView::item:selected:!active {"
       " background-color: #E6F3FF;"
       " }");
+
+  modModel_ = new ModTableModel(this);
+  setModel(modModel_);
 }
 
 void ModTableWidget::configureColumns(const QStringList& headers) {
-  setColumnCount(headers.size());
-  setHorizontalHeaderLabels(headers);
+  headers_ = headers;
+  modModel_->setHeaders(headers);
   if (auto* header = horizontalHeader()) {
     header->setStretchLastSection(true);
     header->setSectionResizeMode(QHeaderView::Stretch);
   }
 }
+
+void ModTableWidget::setModel(QAbstractItemModel* model) {
+  QTableView::setModel(model);
+  if (auto* selection = selectionModel()) {
+    connect(selection, &QItemSelectionModel::currentChanged, this,
+            [this](const QModelIndex& current, const QModelIndex& previous) {
+              emit currentCellChanged(current.row(), current.column(), previous.row(), previous.column());
+            });
+  }
+}
+
+int ModTableWidget::currentRow() const {
+  const QModelIndex current = currentIndex();
+  return current.isValid() ? current.row() : -1;
+}
+
+int ModTableWidget::currentModId() const {
+  const QModelIndex current = currentIndex();
+  if (!current.isValid() || !model()) {
+    return 0;
+  }
+  return model()->index(current.row(), 0).data(Qt::UserRole).toInt();
+}
+
+void ModTableWidget::setCurrentRow(int row) {
+  if (!model() || row < 0 || row >= model()->rowCount()) {
+    setCurrentIndex(QModelIndex());
+    return;
+  }
+  setCurrentIndex(model()->index(row, 0));
+}
@@ -1,12 +1,39 @@
 #pragma once
 
-#include <QTableWidget>
+#include <QTableView>
 
-class ModTableWidget : public QTableWidget {
+class ModTableModel;
+
+/**
+ * @brief MOD 列表视图，默认使用 ModTableModel 作为数据模型。
+ *
+ * 视图只为可见行请求数据；需要逐项装饰的小型列表也可以通过 setModel 换用其它模型，
+ * 表头沿用 configureColumns 设置的文本。
+ */
+class ModTableWidget : public QTableView {
   Q_OBJECT
 public:
   explicit ModTableWidget(QWidget* parent = nullptr);
 
   void configureColumns(const QStringList& headers);
-};
+  const QStringList& columnHeaders() const { return headers_; }
+
+  void setModel(QAbstractItemModel* model) override;
+
+  /// 默认的 MOD 模型；换用其它模型后仍然可用，但不再显示。
+  ModTableModel* modModel() const { return modModel_; }
 
+  /// 当前行，没有当前行时返回 -1。
+  int currentRow() const;
+  /// 当前行第一列 Qt::UserRole 中的 MOD id，没有当前行时返回 0。
+  int currentModId() const;
+  void setCurrentRow(int row);
+
+signals:
+  /// 与 QTableWidget::currentCellChanged 含义相同，行列为 -1 表示没有当前单元格。
+  void currentCellChanged(int currentRow, int currentColumn, int previousRow, int previousColumn);
+
+private:
+  QStringList headers_;
+  ModTableModel* modModel_{};
+};
@@ -67,9 +67,12 @@ void RepositoryPage::buildUi() {
   editBtn_ = new QPushButton(tr("编辑"), leftPanel);
   deleteBtn_ = new QPushButton(tr("删除"), leftPanel);
   refreshBtn_ = new QPushButton(tr("刷新"), leftPanel);
+  conflictScanBtn_ = new QPushButton(tr("检测冲突"), leftPanel);
+  conflictScanBtn_->setToolTip(tr("根据 VPK 中覆盖的相同资源文件，建议 MOD 之间的冲突关系"));
   actionRow->addWidget(editBtn_);
   actionRow->addWidget(deleteBtn_);
   actionRow->addStretch();
+  actionRow->addWidget(conflictScanBtn_);
   actionRow->addWidget(refreshBtn_);
   leftLayout->addLayout(actionRow);
 
@@ -131,6 +134,9 @@ void RepositoryPage::wireSignals() {
   if (refreshBtn_) {
     connect(refreshBtn_, &QPushButton::clicked, this, &RepositoryPage::refreshRequested);
   }
+  if (conflictScanBtn_) {
+    connect(conflictScanBtn_, &QPushButton::clicked, this, &RepositoryPage::conflictScanRequested);
+  }
   if (showDeletedCheckBox_) {
     connect(showDeletedCheckBox_, &QCheckBox::toggled, this, &RepositoryPage::showDeletedToggled);
   }
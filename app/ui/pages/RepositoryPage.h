@@ -23,6 +23,7 @@ public:
   QPushButton* editButton() const { return editBtn_; }
   QPushButton* deleteButton() const { return deleteBtn_; }
   QPushButton* refreshButton() const { return refreshBtn_; }
+  QPushButton* conflictScanButton() const { return conflictScanBtn_; }
   QLabel* coverLabel() const { return coverLabel_; }
   QLabel* metaLabel() const { return metaLabel_; }
   QTextEdit* noteView() const { return noteView_; }
@@ -36,6 +37,7 @@ signals:
   void editRequested();
   void deleteRequested();
   void refreshRequested();
+  void conflictScanRequested();
   void showDeletedToggled(bool checked);
   void currentCellChanged(int currentRow, int currentColumn, int previousRow, int previousColumn);
 
@@ -51,6 +53,7 @@ private:
   QPushButton* editBtn_{};
   QPushButton* deleteBtn_{};
   QPushButton* refreshBtn_{};
+  QPushButton* conflictScanBtn_{}; // 按 VPK 资源检测冲突
   QLabel* coverLabel_{};
   QLabel* metaLabel_{};
   QTextEdit* noteView_{};
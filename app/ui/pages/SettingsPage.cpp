@@ -99,6 +99,10 @@ QWidget* SettingsPage::buildBasicSettingsPane() {
   importModeCombo_->addItem(tr("仅链接"), static_cast<int>(ImportAction::Link));
   form->addRow(tr("入库方式"), importModeCombo_);
 
+  contentStoreCheckbox_ = new QCheckBox(tr("按内容存放（相同文件只保存一份）"), container);
+  contentStoreCheckbox_->setToolTip(tr("文件以哈希命名存放在仓库的 objects 目录，by-name 目录保留原文件名以便浏览"));
+  form->addRow(QString(), contentStoreCheckbox_);
+
   autoImportCheckbox_ = new QCheckBox(tr("自动整理游戏目录下的 addons"), container);
   form->addRow(QString(), autoImportCheckbox_);
 
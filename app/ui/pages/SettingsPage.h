@@ -31,6 +31,7 @@ public:
   QLineEdit* addonsDisplay() const { return settingsAddonsPathDisplay_; }
   QLineEdit* workshopDisplay() const { return settingsWorkshopPathDisplay_; }
   QComboBox* importModeCombo() const { return importModeCombo_; }
+  QCheckBox* contentStoreCheck() const { return contentStoreCheckbox_; }
   QCheckBox* autoImportCheck() const { return autoImportCheckbox_; }
   QComboBox* autoImportModeCombo() const { return autoImportModeCombo_; }
   QPushButton* saveSettingsButton() const { return saveSettingsBtn_; }
@@ -76,6 +77,7 @@ private:
   QLineEdit* settingsAddonsPathDisplay_{};
   QLineEdit* settingsWorkshopPathDisplay_{};
   QComboBox* importModeCombo_{};
+  QCheckBox* contentStoreCheckbox_{};
   QCheckBox* autoImportCheckbox_{};
   QComboBox* autoImportModeCombo_{};
   QPushButton* saveSettingsBtn_{};
@@ -1,39 +1,50 @@
 #include "app/ui/presenters/RepositoryPresenter.h"
 
 #include <algorithm>
-#include <array>
+#include <atomic>
 #include <optional>
 #include <set>
+#include <thread>
 #include <tuple>
+#include <utility>
 
+#include <QApplication>
 #include <QCheckBox>
 #include <QComboBox>
-#include <QCryptographicHash>
 #include <QDateTime>
 #include <QDir>
-#include <QDirIterator>
+#include <QEventLoop>
 #include <QFile>
 #include <QFileInfo>
+#include <QImage>
 #include <QLabel>
 #include <QLineEdit>
 #include <QMap>
 #include <QMessageBox>
 #include <QPixmap>
+#include <QProgressDialog>
 #include <QSortFilterProxyModel>
 #include <QStandardItem>
 #include <QStandardItemModel>
 #include <QStringList>
-#include <QTableWidgetItem>
 #include <QTextEdit>
 #include <QRegularExpression>
+#include <spdlog/spdlog.h>
 
+#include "app/services/AssetConflictScanner.h"
+#include "app/services/CoverLoader.h"
+#include "app/services/ImportPipeline.h"
 #include "app/services/ImportService.h"
+#include "app/services/ModStore.h"
+#include "app/services/ThumbnailCache.h"
 #include "app/ui/ImportFolderDialog.h"
 #include "app/ui/ModEditorDialog.h"
 #include "app/ui/components/ModFilterPanel.h"
+#include "app/ui/components/ModTableModel.h"
 #include "app/ui/components/ModTableWidget.h"
 #include "app/ui/pages/RepositoryPage.h"
 #include "core/config/Settings.h"
+#include "core/repo/ModPageSource.h"
 #include "core/repo/RepositoryService.h"
 #include "core/repo/TagDao.h"
 
@@ -50,98 +61,6 @@ QWidget* resolveParent(QWidget* preferred, QWidget* fallback) {
   return preferred ? preferred : fallback;
 }
 
-// 仅允许识别为 MOD 文件的后缀
-bool isSupportedModFile(const QFileInfo& info) {
-  if (!info.isFile()) {
-    return false;
-  }
-  const QString suffix = info.suffix().toLower();
-  if (suffix.isEmpty()) {
-    return false;
-  }
-  static const std::array<QString, 4> kAllowedExt = {QStringLiteral("vpk"),
-                                                     QStringLiteral("zip"),
-                                                     QStringLiteral("7z"),
-                                                     QStringLiteral("rar")};
-  return std::any_of(kAllowedExt.begin(), kAllowedExt.end(), [&](const QString& ext) { return suffix == ext; });
-}
-
-// 规范化名称以便匹配封面
-QString normalizeName(const QString& text) {
-  QString normalized;
-  normalized.reserve(text.size());
-  for (const QChar& ch : text) {
-    if (ch.isLetterOrNumber()) {
-      normalized.append(ch.toLower());
-    }
-  }
-  return normalized;
-}
-
-// 在同级目录匹配可能的封面文件
-QString locateCoverCandidate(const QFileInfo& fileInfo, const QString& displayName) {
-  static const QStringList filters = {"*.png", "*.jpg", "*.jpeg", "*.bmp", "*.webp"};
-  const QDir dir = fileInfo.dir();
-  const QString normalizedBase = normalizeName(fileInfo.completeBaseName());
-  const QString normalizedDisplay = normalizeName(displayName);
-  const QFileInfoList images = dir.entryInfoList(filters, QDir::Files | QDir::Readable);
-  for (const QFileInfo& image : images) {
-    if (!normalizedBase.isEmpty() && normalizeName(image.completeBaseName()) == normalizedBase) {
-      return image.absoluteFilePath();
-    }
-  }
-  if (!normalizedDisplay.isEmpty()) {
-    for (const QFileInfo& image : images) {
-      if (normalizeName(image.completeBaseName()).contains(normalizedDisplay)) {
-        return image.absoluteFilePath();
-      }
-    }
-  }
-  return {};
-}
-
-// 根据文件生成初始的 ModRow 元数据
-ModRow buildModFromFile(const QFileInfo& info) {
-  ModRow mod;
-  const QString baseName = info.completeBaseName().trimmed();
-  const QString fileName = info.fileName().trimmed();
-  const QString chosenName = baseName.isEmpty() ? fileName : baseName;
-  mod.name = chosenName.toStdString();
-  mod.file_path = QDir::toNativeSeparators(info.absoluteFilePath()).toStdString();
-  mod.size_mb = static_cast<double>(info.size()) / (1024.0 * 1024.0);
-
-  QFile file(info.absoluteFilePath());
-  if (file.open(QIODevice::ReadOnly)) {
-    QCryptographicHash hash(QCryptographicHash::Sha256);
-    while (!file.atEnd()) {
-      hash.addData(file.read(1 << 16));
-    }
-    mod.file_hash = QString::fromLatin1(hash.result().toHex()).toStdString();
-  }
-
-  const QDateTime lastModified = info.lastModified();
-  if (lastModified.isValid()) {
-    const QString dateText = lastModified.date().toString(QStringLiteral("yyyy-MM-dd"));
-    mod.last_published_at = dateText.toStdString();
-    mod.last_saved_at = dateText.toStdString();
-  }
-
-  const QString coverPath = locateCoverCandidate(info, chosenName);
-  if (!coverPath.isEmpty()) {
-    mod.cover_path = QDir::toNativeSeparators(coverPath).toStdString();
-  }
-
-  const bool isNumericId =
-      !baseName.isEmpty() && std::all_of(baseName.cbegin(), baseName.cend(), [](const QChar& ch) { return ch.isDigit(); });
-  if (isNumericId) {
-    const QString steamUrl =
-        QStringLiteral("https://steamcommunity.com/sharedfiles/filedetails/?id=") + baseName;
-    mod.source_url = steamUrl.toStdString();
-    mod.source_platform = QStringLiteral("steam").toStdString();
-  }
-  return mod;
-}
-
 QString relationKindLabel(ModEditorDialog::RelationKind kind) {
   switch (kind) {
     case ModEditorDialog::RelationKind::Conflict: return RepositoryPresenter::tr("冲突");
@@ -303,7 +222,14 @@ RepositoryPresenter::RepositoryPresenter(RepositoryPage* page,
     : QObject(parent),
       page_(page),
       settings_(&settings),
-      dialogParent_(dialogParent) {
+      dialogParent_(dialogParent),
+      store_(new ModStore(this)) {
+  // 单个 MOD 的增删改只更新受影响的行，保留表格的选中项与滚动位置
+  connect(store_, &ModStore::rowsChanged, this, &RepositoryPresenter::handleModsPatched);
+  connect(store_, &ModStore::rowsInserted, this, &RepositoryPresenter::handleModsPatched);
+  connect(store_, &ModStore::rowsRemoved, this, &RepositoryPresenter::handleModsPatched);
+  connect(store_, &ModStore::reset, this, &RepositoryPresenter::handleModsReset);
+  connect(store_, &ModStore::pagesInvalidated, this, &RepositoryPresenter::handleModsInvalidated);
   if (page_) {
     filterPanel_ = page_->filterPanel();
     if (filterPanel_) {
@@ -317,6 +243,33 @@ RepositoryPresenter::RepositoryPresenter(RepositoryPage* page,
     noteView_ = page_->noteView();
   }
 
+  if (modTable_) {
+    const auto orDash = [](const std::string& value) { return toDisplay(value, tr("-")); };
+    modTable_->modModel()->setColumns({
+        [](const ModRow& mod) { return QString::fromStdString(mod.name); },
+        [this](const ModRow& mod) { return categoryNameFor(mod.category_id); },
+        [this](const ModRow& mod) { return tagsTextForMod(mod.id); },
+        [](const ModRow& mod) { return toDisplay(mod.author); },
+        [](const ModRow& mod) { return mod.rating > 0 ? QString::number(mod.rating) : QStringLiteral("-"); },
+        [](const ModRow& mod) { return toDisplay(mod.status, tr("未知")); },
+        [orDash](const ModRow& mod) { return orDash(mod.last_published_at); },
+        [orDash](const ModRow& mod) { return orDash(mod.last_saved_at); },
+        [](const ModRow& mod) { return toDisplay(mod.source_platform); },
+        [](const ModRow& mod) { return toDisplay(mod.source_url); },
+        [orDash](const ModRow& mod) { return orDash(mod.integrity); },
+        [orDash](const ModRow& mod) { return orDash(mod.stability); },
+        [orDash](const ModRow& mod) { return orDash(mod.acquisition_method); },
+        [](const ModRow& mod) { return toDisplay(mod.note); },
+    });
+  }
+
+  // 内嵌预览图在后台线程提取，结果到达时若仍选中同一 MOD 再刷新封面
+  thumbnails_ = new ThumbnailCache(QString(), this);
+  connect(thumbnails_, &ThumbnailCache::thumbnailReady, this, &RepositoryPresenter::handleThumbnailReady);
+  // 封面按显示尺寸在线程池中解码，切换选中行时只查内存缓存
+  covers_ = new CoverLoader(QString(), CoverLoader::kDefaultMemoryBudget, this);
+  connect(covers_, &CoverLoader::coverReady, this, &RepositoryPresenter::handleCoverReady);
+
   filterModel_ = new QStandardItemModel(this);
   filterProxy_ = new QSortFilterProxyModel(this);
   filterProxy_->setFilterCaseSensitivity(Qt::CaseInsensitive);
@@ -335,6 +288,7 @@ RepositoryPresenter::RepositoryPresenter(RepositoryPage* page,
     connect(page_, &RepositoryPage::editRequested, this, &RepositoryPresenter::handleEditRequested);
     connect(page_, &RepositoryPage::deleteRequested, this, &RepositoryPresenter::handleDeleteRequested);
     connect(page_, &RepositoryPage::refreshRequested, this, &RepositoryPresenter::handleRefreshRequested);
+    connect(page_, &RepositoryPage::conflictScanRequested, this, &RepositoryPresenter::handleConflictScanRequested);
     connect(page_, &RepositoryPage::showDeletedToggled, this, &RepositoryPresenter::handleShowDeletedToggled);
     connect(page_, &RepositoryPage::currentCellChanged, this, &RepositoryPresenter::handleCurrentCellChanged);
   }
@@ -342,6 +296,7 @@ RepositoryPresenter::RepositoryPresenter(RepositoryPage* page,
 
 void RepositoryPresenter::setRepositoryService(RepositoryService* repo) {
   repo_ = repo;
+  store_->setRepositoryService(repo);
 }
 
 void RepositoryPresenter::setImportService(ImportService* service) {
@@ -375,9 +330,36 @@ void RepositoryPresenter::reloadAll() {
   }
 }
 
+void RepositoryPresenter::reloadAllAsync() {
+  reloadCategories();
+  if (filterAttribute_) {
+    handleFilterAttributeChanged(filterAttribute_->currentText());
+  }
+  if (!repo_ || !settings_) {
+    // 无法后台加载时仍要发出 modsReloaded：启动流程依赖它结束 mods 阶段并开始游戏目录扫描。
+    // 与后台加载一样在事件循环中完成，调用方此时已连接好选择器页
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+          if (repo_) {
+            loadData();
+          } else {
+            emit modsReloaded();
+          }
+        },
+        Qt::QueuedConnection);
+    return;
+  }
+  refreshFiltersOnReset_ = true;
+  store_->reloadAsync(settings_->repoDbPath);
+}
+
+const std::vector<ModRow>& RepositoryPresenter::mods() const {
+  return store_->mods();
+}
+
 QString RepositoryPresenter::tagsTextForMod(int modId) const {
-  const auto it = modTagsText_.find(modId);
-  return it != modTagsText_.end() ? it->second : QString();
+  return store_->tagSummary(modId);
 }
 
 std::vector<TagDescriptor> RepositoryPresenter::tagsForMod(int modId) const {
@@ -427,9 +409,7 @@ bool RepositoryPresenter::modMatchesFilter(const ModRow& mod,
   }
 
   if (attribute == tr("标签")) {
-    const auto tagsIt = modTagsCache_.find(mod.id);
-    static const std::vector<TagWithGroupRow> kEmptyTags;
-    const auto& modTags = tagsIt != modTagsCache_.end() ? tagsIt->second : kEmptyTags;
+    const auto& modTags = store_->tagsFor(mod.id);
 
     if (filterId == kUntaggedTagId) {
       return modTags.empty();
@@ -464,6 +444,169 @@ bool RepositoryPresenter::modMatchesFilter(const ModRow& mod,
   return true;
 }
 
+std::shared_ptr<const FilterBitset> RepositoryPresenter::filterResult(const QString& attribute,
+                                                                     int filterId,
+                                                                     const QString& filterValue) const {
+  constexpr std::size_t kMaxCachedFilters = 4;
+  if (filterCacheVersion_ != store_->version()) {
+    // MOD 或分类树变化后，缓存的结果指向旧的数据
+    filterCache_.clear();
+    filterCacheVersion_ = store_->version();
+  }
+  for (auto it = filterCache_.begin(); it != filterCache_.end(); ++it) {
+    if (it->filterId == filterId && it->attribute == attribute && it->value == filterValue) {
+      // 命中的条目移到末尾，淘汰时从最久未用的开头移除
+      std::rotate(it, it + 1, filterCache_.end());
+      return filterCache_.back().result;
+    }
+  }
+  auto result = std::make_shared<const FilterBitset>(computeFilter(attribute, filterId, filterValue));
+  if (filterCache_.size() >= kMaxCachedFilters) {
+    filterCache_.erase(filterCache_.begin());
+  }
+  filterCache_.push_back({attribute, filterId, filterValue, result});
+  return result;
+}
+
+std::vector<int> RepositoryPresenter::filteredRows(const FilterBitset& result, bool includeDeleted) const {
+  const auto& mods = store_->mods();
+  std::vector<int> rows;
+  const auto append = [&](int index) {
+    if (store_->isLive(index) && (includeDeleted || !mods[static_cast<std::size_t>(index)].is_deleted)) {
+      rows.push_back(index);
+    }
+  };
+  if (result.universe() != mods.size()) {
+    return rows;
+  }
+  rows.reserve(result.count());
+  if (result.matchesAll()) {
+    for (std::size_t i = 0; i < mods.size(); ++i) {
+      append(static_cast<int>(i));
+    }
+  } else {
+    for (const int index : result.ordered()) {
+      append(index);
+    }
+  }
+  return rows;
+}
+
+FilterBitset RepositoryPresenter::computeFilter(const QString& attribute,
+                                                int filterId,
+                                                const QString& filterValue) const {
+  const auto& mods = store_->mods();
+  const FacetIndex& facets = store_->facets();
+  const NameSearchIndex& nameIndex = store_->nameIndex();
+  std::vector<int> matched;
+  if (facets.size() != mods.size()) {
+    // 索引尚未建立时退回逐个判断
+    for (std::size_t i = 0; i < mods.size(); ++i) {
+      if (store_->isLive(static_cast<int>(i)) && modMatchesFilter(mods[i], attribute, filterId, filterValue)) {
+        matched.push_back(static_cast<int>(i));
+      }
+    }
+    return FilterBitset(mods.size(), std::move(matched));
+  }
+
+  const FacetIndex::Postings* postings = nullptr;
+  if (attribute == tr("分类")) {
+    if (filterId == kUncategorizedCategoryId) {
+      postings = &facets.uncategorized();
+    } else if (filterId > 0) {
+      postings = &facets.categorySubtree(filterId);
+    }
+  } else if (attribute == tr("标签")) {
+    if (filterId == kUntaggedTagId) {
+      postings = &facets.untagged();
+    } else if (filterId > 0) {
+      postings = &facets.tag(filterId);
+    }
+  } else if (attribute == tr("作者")) {
+    const QString authorFilter = filterValue.trimmed();
+    if (!authorFilter.isEmpty()) {
+      postings = &facets.author(authorFilter.toStdString());
+    }
+  } else if (attribute == tr("评分")) {
+    if (filterId != 0) {
+      postings = &facets.rating(filterId);
+    }
+  }
+  if (postings) {
+    return FilterBitset(mods.size(), *postings);
+  }
+
+  if (attribute == tr("名称") && !filterValue.isEmpty()) {
+    if (nameIndex.size() == 0 && !mods.empty()) {
+      // 名称索引未建立时退回子串比较
+      for (std::size_t i = 0; i < mods.size(); ++i) {
+        if (store_->isLive(static_cast<int>(i)) && modMatchesFilter(mods[i], attribute, filterId, filterValue)) {
+          matched.push_back(static_cast<int>(i));
+        }
+      }
+      return FilterBitset(mods.size(), std::move(matched));
+    }
+    const std::string nameQuery = filterValue.toStdString();
+    // 只含空白或标点的输入规范化后为空，按未筛选处理
+    if (!NameSearchIndex::normalize(nameQuery).empty()) {
+      for (const auto& match : nameIndex.search(nameQuery, 0)) {
+        matched.push_back(match.id);
+      }
+      return FilterBitset(mods.size(), std::move(matched));
+    }
+  }
+
+  return FilterBitset::all(mods.size());
+}
+
+int RepositoryPresenter::modIndexForId(int modId) const {
+  return store_->indexOf(modId);
+}
+
+ModPageFilter RepositoryPresenter::pageFilter(const QString& attribute,
+                                              int filterId,
+                                              const QString& filterValue,
+                                              bool includeDeleted) const {
+  ModPageFilter filter;
+  filter.include_deleted = includeDeleted;
+  if (attribute == tr("分类")) {
+    if (filterId == kUncategorizedCategoryId) {
+      filter.category_id = 0;
+    } else if (filterId > 0) {
+      filter.category_id = filterId;
+    }
+  } else if (attribute == tr("标签")) {
+    if (filterId == kUntaggedTagId) {
+      filter.tag_id = 0;
+    } else if (filterId > 0) {
+      filter.tag_id = filterId;
+    }
+  } else if (attribute == tr("作者")) {
+    const QString authorFilter = filterValue.trimmed();
+    if (!authorFilter.isEmpty()) {
+      filter.author = authorFilter.toStdString();
+    }
+  } else if (attribute == tr("评分")) {
+    if (filterId != 0) {
+      filter.rating = std::max(filterId, 0);
+    }
+  } else if (attribute == tr("名称")) {
+    // 三元组模糊索引只在内存模式下建立，SQL 中只能借助名称索引做前缀匹配（ASCII 不区分大小写）
+    filter.name_prefix = filterValue.trimmed().toStdString();
+  }
+  return filter;
+}
+
+std::shared_ptr<ModPageSource> RepositoryPresenter::pageSource(const QString& attribute,
+                                                               int filterId,
+                                                               const QString& filterValue,
+                                                               bool includeDeleted) const {
+  if (!repo_) {
+    return nullptr;
+  }
+  return std::make_shared<ModPageSource>(*repo_, pageFilter(attribute, filterId, filterValue, includeDeleted));
+}
+
 void RepositoryPresenter::populateCategoryFilterModel(QStandardItemModel* model, bool updateCache) {
   if (!repo_) {
     return;
@@ -591,8 +734,18 @@ void RepositoryPresenter::populateAuthorFilterModel(QStandardItemModel* model) c
   model->clear();
 
   QStringList authors;
-  authors.reserve(static_cast<int>(mods_.size()));
-  for (const auto& mod : mods_) {
+  if (store_->paged() && repo_) {
+    for (const auto& author : repo_->listAuthors()) {
+      authors.append(QString::fromStdString(author));
+    }
+  }
+  const auto& mods = store_->mods();
+  authors.reserve(static_cast<int>(mods.size()));
+  for (std::size_t i = 0; i < mods.size(); ++i) {
+    const ModRow& mod = mods[i];
+    if (!store_->isLive(static_cast<int>(i))) {
+      continue;
+    }
     if (!mod.author.empty()) {
       const QString author = QString::fromStdString(mod.author);
       if (!authors.contains(author)) {
@@ -626,11 +779,106 @@ void RepositoryPresenter::populateRatingFilterModel(QStandardItemModel* model) c
   }
 }
 
+void RepositoryPresenter::handleThumbnailReady(int modId, const QString& path) {
+  if (modId != detailModId_ || path.isEmpty() || !coverLabel_) {
+    return;
+  }
+  showCover(path);
+}
+
+void RepositoryPresenter::handleCoverReady(const QString& path, const QSize& size, const QImage& image) {
+  if (!coverLabel_ || path != detailCoverPath_ || size != coverLabel_->size()) {
+    return;
+  }
+  if (!image.isNull()) {
+    coverLabel_->setText(QString());
+    coverLabel_->setPixmap(QPixmap::fromImage(image));
+    return;
+  }
+
+  // 封面文件缺失或无法解码时退回 VPK 内嵌预览图；预览图本身失败则显示“无预览”
+  const int index = modIndexForId(detailModId_);
+  if (index >= 0 && coverPathFor(store_->mods()[static_cast<std::size_t>(index)]) == path) {
+    requestEmbeddedPreview(store_->mods()[static_cast<std::size_t>(index)]);
+    return;
+  }
+  if (store_->paged() && repo_ && detailModId_ > 0) {
+    const auto mod = repo_->findMod(detailModId_);
+    if (mod && coverPathFor(*mod) == path) {
+      requestEmbeddedPreview(*mod);
+      return;
+    }
+  }
+  detailCoverPath_.clear();
+  coverLabel_->setPixmap(QPixmap());
+  coverLabel_->setText(tr("无预览"));
+}
+
+QString RepositoryPresenter::coverPathFor(const ModRow& mod) const {
+  const QString path = QString::fromStdString(mod.cover_path);
+  if (path.isEmpty() || repoDir_.isEmpty() || !QFileInfo(path).isRelative()) {
+    return path;
+  }
+  return QDir(repoDir_).absoluteFilePath(path);
+}
+
+void RepositoryPresenter::showCover(const QString& path) {
+  detailCoverPath_ = path;
+  const QSize size = coverLabel_->size();
+  const QImage image = covers_->cached(path, size);
+  if (!image.isNull()) {
+    coverLabel_->setText(QString());
+    coverLabel_->setPixmap(QPixmap::fromImage(image));
+    return;
+  }
+  coverLabel_->setPixmap(QPixmap());
+  coverLabel_->setText(tr("加载中…"));
+  covers_->request(path, size);
+}
+
+void RepositoryPresenter::requestEmbeddedPreview(const ModRow& mod) {
+  detailCoverPath_.clear();
+  coverLabel_->setPixmap(QPixmap());
+  coverLabel_->setText(tr("无预览"));
+  if (thumbnails_) {
+    // 已提取过的预览图由后台线程直接返回路径，随后经 handleThumbnailReady 显示
+    thumbnails_->request(mod.id, QString::fromStdString(mod.file_path), QString::fromStdString(mod.file_hash));
+  }
+}
+
+void RepositoryPresenter::prefetchNeighbourCovers() {
+  constexpr int kPrefetchRadius = 2;
+  if (!modTable_ || !coverLabel_) {
+    return;
+  }
+  const int current = modTable_->currentRow();
+  if (current < 0) {
+    return;
+  }
+  const QSize size = coverLabel_->size();
+  for (int offset = 1; offset <= kPrefetchRadius; ++offset) {
+    for (const int row : {current + offset, current - offset}) {
+      if (const ModRow* mod = modTable_->modModel()->modAt(row)) {
+        covers_->request(coverPathFor(*mod), size, true);
+      }
+    }
+  }
+}
+
 void RepositoryPresenter::updateDetailForMod(int modId) {
   if (!coverLabel_ || !metaLabel_ || !noteView_) {
     return;
   }
 
+  if (modId != detailModId_) {
+    // 上一个 MOD 及其相邻行尚未开始解码的封面、尚未提取的预览图已无用处
+    covers_->cancelPending();
+    if (thumbnails_) {
+      thumbnails_->cancelPending();
+    }
+  }
+  detailModId_ = modId;
+  detailCoverPath_.clear();
   if (modId <= 0) {
     coverLabel_->setPixmap(QPixmap());
     coverLabel_->setText(tr("未选择 MOD"));
@@ -655,36 +903,21 @@ void RepositoryPresenter::updateDetailForMod(int modId) {
   const auto& mod = *modOpt;
   const QString categoryName = categoryNameFor(mod.category_id);
   QString tags;
-  const auto cacheIt = modTagsCache_.find(mod.id);
-  if (cacheIt != modTagsCache_.end()) {
-    tags = formatTagSummary(cacheIt->second, QStringLiteral("\n"), QStringLiteral(" / "));
+  if (store_->indexOf(mod.id) >= 0) {
+    tags = ModStore::formatTagSummary(store_->tagsFor(mod.id), QStringLiteral("\n"), QStringLiteral(" / "));
   } else if (repo_) {
     auto rows = repo_->listTagsForMod(mod.id);
-    tags = formatTagSummary(rows, QStringLiteral("\n"), QStringLiteral(" / "));
+    tags = ModStore::formatTagSummary(rows, QStringLiteral("\n"), QStringLiteral(" / "));
   }
 
-  coverLabel_->setText(QString());
-  QPixmap pix;
-  auto tryLoad = [&](const QString& path) -> bool {
-    if (path.isEmpty()) return false;
-    QFileInfo info(path);
-    if (!info.exists() && !repoDir_.isEmpty()) {
-      QDir dir(repoDir_);
-      info = QFileInfo(dir.absoluteFilePath(path));
-    }
-    if (info.exists() && info.isFile()) {
-      pix = QPixmap(info.absoluteFilePath());
-      if (!pix.isNull()) {
-        coverLabel_->setPixmap(pix.scaled(coverLabel_->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
-        return true;
-      }
-    }
-    return false;
-  };
-  if (!tryLoad(QString::fromStdString(mod.cover_path))) {
-    coverLabel_->setPixmap(QPixmap());
-    coverLabel_->setText(tr("无预览"));
+  const QString coverPath = coverPathFor(mod);
+  if (coverPath.isEmpty()) {
+    // 没有封面时退回 VPK 内嵌的预览图
+    requestEmbeddedPreview(mod);
+  } else {
+    showCover(coverPath);
   }
+  prefetchNeighbourCovers();
 
   noteView_->setPlainText(QString::fromStdString(mod.note));
 
@@ -704,6 +937,7 @@ void RepositoryPresenter::updateDetailForMod(int modId) {
   if (!mod.source_platform.empty()) meta << tr("平台：%1").arg(QString::fromStdString(mod.source_platform));
   if (!mod.source_url.empty()) meta << tr("链接：%1").arg(QString::fromStdString(mod.source_url));
   if (!mod.file_path.empty()) meta << tr("文件：%1").arg(QString::fromStdString(mod.file_path));
+  if (!mod.archive_member.empty()) meta << tr("包内文件：%1").arg(QString::fromStdString(mod.archive_member));
   if (!mod.file_hash.empty()) meta << tr("校验：%1").arg(QString::fromStdString(mod.file_hash));
   metaLabel_->setText(meta.join('\n'));
 }
@@ -734,6 +968,121 @@ void RepositoryPresenter::handleRefreshRequested() {
   loadData();
 }
 
+void RepositoryPresenter::handleConflictScanRequested() {
+  if (!repo_) {
+    return;
+  }
+  AssetConflictScanner scanner(*repo_);
+  std::vector<ModRow> stale;
+  try {
+    stale = scanner.staleMods();
+  } catch (const std::exception& e) {
+    QMessageBox::warning(resolveParent(dialogParent_, page_), tr("检测失败"), QString::fromUtf8(e.what()));
+    return;
+  }
+
+  // 首次检测需要打开仓库中的每个 VPK，在后台线程中列出资源，进度对话框保持界面响应并支持取消
+  if (!stale.empty()) {
+    const int total = static_cast<int>(stale.size());
+    QProgressDialog progressDialog(tr("正在读取 VPK 资源列表（0/%1）…").arg(total), tr("取消"), 0, total,
+                                   resolveParent(dialogParent_, page_));
+    progressDialog.setWindowTitle(tr("检测冲突"));
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(0);
+    progressDialog.setAutoClose(false);
+    progressDialog.setAutoReset(false);
+
+    std::atomic<bool> cancelled{false};
+    std::vector<ModAssetList> lists;
+    QEventLoop loop;
+    connect(&progressDialog, &QProgressDialog::canceled, &loop, [&progressDialog, &cancelled]() {
+      cancelled = true;
+      progressDialog.setLabelText(tr("正在取消，等待进行中的文件读取完成…"));
+    });
+    std::thread worker([&]() {
+      lists = AssetConflictScanner::listAssets(stale, &cancelled, [&progressDialog, &cancelled, total](std::size_t done) {
+        // 每完成一个文件投递一次，界面线程中更新
+        QMetaObject::invokeMethod(
+            &progressDialog,
+            [&progressDialog, &cancelled, total, done]() {
+              progressDialog.setValue(static_cast<int>(done));
+              if (!cancelled) {
+                progressDialog.setLabelText(tr("正在读取 VPK 资源列表（%1/%2）…").arg(done).arg(total));
+              }
+            },
+            Qt::QueuedConnection);
+      });
+      QMetaObject::invokeMethod(&loop, &QEventLoop::quit, Qt::QueuedConnection);
+    });
+    loop.exec();
+    worker.join();
+    // 丢弃仍在队列中的进度更新，避免关闭后的对话框被 setValue 重新弹出
+    QCoreApplication::removePostedEvents(&progressDialog, QEvent::MetaCall);
+    progressDialog.close();
+
+    try {
+      // 取消前已读取的结果同样有效，先行入库，下次只需补扫其余文件
+      scanner.storeScans(lists);
+    } catch (const std::exception& e) {
+      QMessageBox::warning(resolveParent(dialogParent_, page_), tr("检测失败"), QString::fromUtf8(e.what()));
+      return;
+    }
+    if (cancelled) {
+      return;
+    }
+  }
+
+  std::vector<AssetConflict> conflicts;
+  try {
+    conflicts = scanner.suggestions();
+  } catch (const std::exception& e) {
+    QMessageBox::warning(resolveParent(dialogParent_, page_), tr("检测失败"), QString::fromUtf8(e.what()));
+    return;
+  }
+
+  if (conflicts.empty()) {
+    QMessageBox::information(resolveParent(dialogParent_, page_), tr("检测冲突"),
+                             tr("未发现新的资源冲突（已记录关系的 MOD 不再重复提示）"));
+    return;
+  }
+  offerConflictSuggestions(conflicts);
+}
+
+int RepositoryPresenter::offerConflictSuggestions(const std::vector<AssetConflict>& conflicts) {
+  if (!repo_ || conflicts.empty()) {
+    return 0;
+  }
+  const auto modName = [this](int modId) {
+    const auto mod = repo_->findMod(modId);
+    return mod ? QString::fromStdString(mod->name) : tr("#%1").arg(modId);
+  };
+  constexpr std::size_t kMaxListed = 15;
+  QStringList lines;
+  for (std::size_t i = 0; i < conflicts.size() && i < kMaxListed; ++i) {
+    const AssetConflict& conflict = conflicts[i];
+    lines << tr("%1 ↔ %2：%3 个相同资源（%4）")
+                 .arg(modName(conflict.a_mod_id), modName(conflict.b_mod_id))
+                 .arg(conflict.shared_paths)
+                 .arg(QString::fromStdString(conflict.slot_key));
+  }
+  if (conflicts.size() > kMaxListed) {
+    lines << tr("……共 %1 对").arg(conflicts.size());
+  }
+  const auto answer = QMessageBox::question(
+      resolveParent(dialogParent_, page_), tr("发现资源冲突"),
+      tr("以下 MOD 覆盖了相同的游戏资源，同时启用时只有一个生效：\n\n%1\n\n是否将它们记录为冲突关系？")
+          .arg(lines.join(QStringLiteral("\n"))));
+  if (answer != QMessageBox::Yes) {
+    return 0;
+  }
+  try {
+    return repo_->addConflictRelations(conflicts);
+  } catch (const std::exception& e) {
+    QMessageBox::warning(resolveParent(dialogParent_, page_), tr("保存失败"), QString::fromUtf8(e.what()));
+    return 0;
+  }
+}
+
 void RepositoryPresenter::handleImportRequested() {
   if (!repo_) {
     return;
@@ -762,7 +1111,11 @@ void RepositoryPresenter::handleImportRequested() {
       QMessageBox::warning(resolveParent(dialogParent_, page_), tr("关系处理提示"),
                            relationWarnings.join(QStringLiteral("\n")));
     }
-    loadData();
+    store_->applyPatch({newModId});
+    const int row = modTable_ ? modTable_->modModel()->rowForModId(newModId) : -1;
+    if (row >= 0) {
+      modTable_->setCurrentRow(row);
+    }
   } catch (const std::exception& e) {
     QMessageBox::warning(resolveParent(dialogParent_, page_), tr("导入失败"),
                          tr("MOD 入库失败：%1").arg(QString::fromUtf8(e.what())));
@@ -788,63 +1141,110 @@ void RepositoryPresenter::handleImportFolderRequested() {
     return;
   }
 
-  const QString targetDir = dialog.directory();
-  const bool recursive = dialog.includeSubdirectories();
-  QDirIterator::IteratorFlags flags = recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags;
-  QDirIterator iterator(targetDir, QStringList(), QDir::Files | QDir::Readable, flags);
-
-  QStringList filePaths;
-  while (iterator.hasNext()) {
-    const QString path = iterator.next();
-    const QFileInfo info(path);
-    if (isSupportedModFile(info)) {
-      filePaths.append(path);
-    }
+  if (!importService_ || !settings_) {
+    QMessageBox::warning(resolveParent(dialogParent_, page_), tr("导入失败"), tr("导入服务未初始化，无法执行批量导入"));
+    return;
   }
 
-  if (filePaths.isEmpty()) {
+  ImportPipeline::Options options;
+  options.directory = dialog.directory();
+  options.recursive = dialog.includeSubdirectories();
+
+  // 流水线在后台线程中执行，进度对话框保持界面响应并支持取消
+  ImportPipeline pipeline(*repo_, *importService_, *settings_);
+  QProgressDialog progressDialog(tr("正在扫描文件夹…"), tr("取消"), 0, 0, resolveParent(dialogParent_, page_));
+  progressDialog.setWindowTitle(tr("批量导入"));
+  progressDialog.setWindowModality(Qt::WindowModal);
+  progressDialog.setMinimumDuration(0);
+  progressDialog.setAutoClose(false);
+  progressDialog.setAutoReset(false);
+  QString stageText; // 文件计数提示，字节进度附在其后
+  bool cancelling = false;
+  connect(&pipeline, &ImportPipeline::progress, &progressDialog,
+          [&progressDialog, &stageText, &cancelling](int processed, int discovered, bool enumerationDone) {
+            if (enumerationDone) {
+              progressDialog.setMaximum(std::max(discovered, 1));
+            }
+            progressDialog.setValue(processed);
+            stageText = enumerationDone ? tr("正在导入 MOD（%1/%2）…").arg(processed).arg(discovered)
+                                        : tr("正在导入 MOD（已发现 %1 个）…").arg(discovered);
+            if (!cancelling) {
+              progressDialog.setLabelText(stageText);
+            }
+          });
+  connect(&pipeline, &ImportPipeline::transferProgress, &progressDialog,
+          [&progressDialog, &stageText, &cancelling](qint64 doneBytes, qint64 totalBytes) {
+            if (cancelling || stageText.isEmpty()) {
+              return;
+            }
+            constexpr double kMiB = 1024.0 * 1024.0;
+            progressDialog.setLabelText(tr("%1\n当前批次已传输 %2 / %3 MB")
+                                            .arg(stageText)
+                                            .arg(QString::number(static_cast<double>(doneBytes) / kMiB, 'f', 1))
+                                            .arg(QString::number(static_cast<double>(totalBytes) / kMiB, 'f', 1)));
+          });
+  connect(&pipeline, &ImportPipeline::duplicatesDetected, &progressDialog, [&progressDialog](const QStringList& names) {
+    progressDialog.setLabelText(tr("发现 %1 个重复文件，将跳过导入…").arg(names.size()));
+  });
+  connect(&progressDialog, &QProgressDialog::canceled, &pipeline, [&pipeline, &progressDialog, &cancelling]() {
+    cancelling = true;
+    progressDialog.setLabelText(tr("正在取消，等待进行中的文件中止…"));
+    pipeline.cancel();
+  });
+  QEventLoop loop;
+  connect(&pipeline, &ImportPipeline::finished, &loop, &QEventLoop::quit);
+  pipeline.start(options);
+  loop.exec();
+  progressDialog.close();
+
+  const ImportPipeline::Result& result = pipeline.result();
+  if (result.discovered == 0 && !result.cancelled) {
     QMessageBox::information(resolveParent(dialogParent_, page_), tr("未发现 MOD"),
                              tr("所选文件夹中没有符合条件的 MOD 文件（vpk/zip/7z/rar）"));
     return;
   }
 
-  if (!importService_ || !settings_) {
-    QMessageBox::warning(resolveParent(dialogParent_, page_), tr("导入失败"), tr("导入服务未初始化，无法执行批量导入"));
-    return;
-  }
-
-  int successCount = 0;
-  QStringList failureMessages;
-
-  for (const QString& path : filePaths) {
-    const QFileInfo info(path);
-    ModRow mod = buildModFromFile(info);
-    QStringList transferErrors;
-    // 逐项执行文件搬运
-    if (!importService_->ensureModFilesInRepository(*settings_, mod, transferErrors)) {
-      const QString detail = transferErrors.join(QStringLiteral("；"));
-      failureMessages << tr("%1：%2").arg(info.fileName()).arg(detail.isEmpty() ? tr("文件转移失败") : detail);
-      continue;
-    }
-    try {
-      repo_->createModWithTags(mod, {});
-      ++successCount;
-    } catch (const std::exception& e) {
-      failureMessages << tr("%1：%2").arg(info.fileName()).arg(QString::fromUtf8(e.what()));
-    }
+  const int successCount = result.imported;
+  QStringList failureMessages = result.failures;
+  for (const QString& name : result.duplicates) {
+    failureMessages << tr("%1：仓库中已存在相同文件").arg(name);
   }
 
   if (successCount > 0) {
-    loadData();
+    if (result.importedIds.empty()) {
+      loadData();
+    } else {
+      store_->applyPatch(result.importedIds);
+    }
   }
 
   QString summary = tr("成功导入 %1 个 MOD").arg(successCount);
-  if (failureMessages.isEmpty()) {
+  if (result.resumed > 0) {
+    summary.append(tr("（续接上次中断的导入，%1 个文件沿用已有进度）").arg(result.resumed));
+  }
+  if (result.cancelled) {
+    summary.append(tr("（导入已取消）"));
+  }
+  if (!result.warnings.isEmpty()) {
+    summary.append(tr("\n注意：\n%1").arg(result.warnings.join(QStringLiteral("\n"))));
+  }
+  if (failureMessages.isEmpty() && result.warnings.isEmpty()) {
     QMessageBox::information(resolveParent(dialogParent_, page_), tr("批量导入完成"), summary);
+  } else if (failureMessages.isEmpty()) {
+    QMessageBox::warning(resolveParent(dialogParent_, page_), tr("批量导入完成"), summary);
   } else {
     summary.append(tr("\n失败 %1 个：\n%2").arg(failureMessages.size()).arg(failureMessages.join(QStringLiteral("\n"))));
     QMessageBox::warning(resolveParent(dialogParent_, page_), tr("部分导入失败"), summary);
   }
+
+  // 新入库 MOD 的资源路径已随导入写入索引，只检查与它们相关的冲突
+  if (!result.importedIds.empty()) {
+    try {
+      offerConflictSuggestions(AssetConflictScanner(*repo_).suggestions(result.importedIds));
+    } catch (const std::exception& e) {
+      spdlog::warn("Conflict detection after import failed: {}", e.what());
+    }
+  }
 }
 
 void RepositoryPresenter::handleEditRequested() {
@@ -852,17 +1252,16 @@ void RepositoryPresenter::handleEditRequested() {
     return;
   }
 
-  auto* currentItem = modTable_->currentItem();
-  if (!currentItem) {
+  const int modId = modTable_->currentModId();
+  if (modId <= 0) {
     QMessageBox::information(resolveParent(dialogParent_, page_), tr("未选择"), tr("请先选择一个 MOD。"));
     return;
   }
 
-  const int modId = modTable_->item(modTable_->currentRow(), 0)->data(Qt::UserRole).toInt();
   auto modOpt = repo_->findMod(modId);
   if (!modOpt) {
     QMessageBox::warning(resolveParent(dialogParent_, page_), tr("缺失"), tr("该 MOD 记录已不存在。"));
-    loadData();
+    store_->applyPatch({modId});
     return;
   }
 
@@ -889,8 +1288,9 @@ void RepositoryPresenter::handleEditRequested() {
       QMessageBox::warning(resolveParent(dialogParent_, page_), tr("关系处理提示"),
                            relationWarnings.join(QStringLiteral("\n")));
     }
-    loadData();
-    updateDetailForMod(updated.id);
+    // 封面可能被原地替换，丢弃内存中按路径缓存的旧图
+    covers_->forget(coverPathFor(updated));
+    store_->applyPatch({updated.id});
   } catch (const std::exception& e) {
     QMessageBox::warning(resolveParent(dialogParent_, page_), tr("更新失败"),
                          tr("MOD 更新失败：%1").arg(QString::fromUtf8(e.what())));
@@ -902,11 +1302,10 @@ void RepositoryPresenter::handleDeleteRequested() {
     return;
   }
 
-  auto* item = modTable_->currentItem();
-  if (!item) {
+  const int modId = modTable_->currentModId();
+  if (modId <= 0) {
     return;
   }
-  const int modId = modTable_->item(modTable_->currentRow(), 0)->data(Qt::UserRole).toInt();
 
   const auto reply = QMessageBox::question(resolveParent(dialogParent_, page_), tr("删除 MOD"),
                                            tr("是否仅标记为已删除？"), QMessageBox::Yes | QMessageBox::No);
@@ -915,7 +1314,7 @@ void RepositoryPresenter::handleDeleteRequested() {
   }
 
   repo_->setModDeleted(modId, true);
-  loadData();
+  store_->applyPatch({modId});
 }
 
 void RepositoryPresenter::handleShowDeletedToggled(bool /*checked*/) {
@@ -937,7 +1336,8 @@ void RepositoryPresenter::handleFilterAttributeChanged(const QString& attribute)
 
   if (attribute == tr("名称")) {
     filterValue_->setEnabled(true);
-    placeholder = tr("搜索名称");
+    // 分页模式下名称只能按开头匹配，在提示中说明
+    placeholder = store_->paged() ? tr("搜索名称开头（大型仓库仅支持前缀匹配）") : tr("搜索名称");
   } else if (attribute == tr("分类")) {
     filterValue_->setEnabled(true);
     reloadCategories();
@@ -1008,12 +1408,8 @@ void RepositoryPresenter::handleCurrentCellChanged(int currentRow,
     updateDetailForMod(-1);
     return;
   }
-  auto* item = modTable_->item(currentRow, 0);
-  if (!item) {
-    updateDetailForMod(-1);
-    return;
-  }
-  updateDetailForMod(item->data(Qt::UserRole).toInt());
+  const int modId = modTable_->modModel()->modIdAt(currentRow);
+  updateDetailForMod(modId > 0 ? modId : -1);
 }
 
 void RepositoryPresenter::loadData() {
@@ -1021,75 +1417,77 @@ void RepositoryPresenter::loadData() {
     return;
   }
 
-  mods_ = repo_->listAll(true);
-  modTagsText_.clear();
-  modTagsCache_.clear();
-  for (const auto& mod : mods_) {
-    auto tagRows = repo_->listTagsForMod(mod.id);
-    modTagsCache_[mod.id] = tagRows;
-    modTagsText_[mod.id] = formatTagSummary(tagRows, QStringLiteral("  |  "), QStringLiteral(" / "));
-  }
+  // 表格填充与 modsReloaded 在 handleModsReset 中完成，与后台加载共用同一路径
+  store_->reload();
+}
 
-  populateTable();
+void RepositoryPresenter::handleModsReset() {
+  if (std::exchange(refreshFiltersOnReset_, false) && filterAttribute_) {
+    handleFilterAttributeChanged(filterAttribute_->currentText());
+  } else {
+    populateTable();
+  }
   emit modsReloaded();
 }
 
-void RepositoryPresenter::populateTable() {
-  if (!modTable_ || !filterAttribute_ || !filterValue_) {
+void RepositoryPresenter::handleModsInvalidated() {
+  if (!modTable_) {
     return;
   }
+  // 分页模式下写入可能使后面的行整体移动，重新查询后按 MOD id 找回当前行
+  const int currentId = modTable_->currentModId();
+  modTable_->modModel()->reloadPageSource();
+  const int row = currentId > 0 ? modTable_->modModel()->rowForModId(currentId) : -1;
+  if (row >= 0) {
+    modTable_->setCurrentRow(row);
+  } else {
+    updateDetailForMod(-1);
+  }
+}
 
-  modTable_->setRowCount(0);
+void RepositoryPresenter::handleModsPatched(const std::vector<int>& indices) {
+  if (!modTable_ || !filterAttribute_ || !filterValue_) {
+    return;
+  }
 
   const QString filterAttribute = filterAttribute_->currentText();
   const QString filterValueText = filterValue_->currentText();
   const int filterId = filterIdForCombo(filterValue_, filterProxy_, filterModel_);
+  const bool hideDeleted = showDeletedCheckBox_ && !showDeletedCheckBox_->isChecked();
+  const auto result = filterResult(filterAttribute, filterId, filterValueText);
+  modTable_->modModel()->updateRows(filteredRows(*result, !hideDeleted), indices);
 
-  int row = 0;
-  for (const auto& mod : mods_) {
-    if (showDeletedCheckBox_ && !showDeletedCheckBox_->isChecked() && mod.is_deleted) {
-      continue;
-    }
+  // 当前行被筛掉或详情区显示的 MOD 发生变化时刷新详情
+  const int currentId = modTable_->currentModId();
+  const int detailIndex = detailModId_ > 0 ? store_->indexOf(detailModId_) : -1;
+  const bool detailChanged = std::find(indices.begin(), indices.end(), detailIndex) != indices.end();
+  if (currentId != detailModId_ || detailChanged || (detailModId_ > 0 && detailIndex < 0)) {
+    updateDetailForMod(currentId > 0 ? currentId : -1);
+  }
+}
 
-    if (!modMatchesFilter(mod, filterAttribute, filterId, filterValueText)) {
-      continue;
-    }
+void RepositoryPresenter::populateTable() {
+  if (!modTable_ || !filterAttribute_ || !filterValue_) {
+    return;
+  }
 
-    const QString name = QString::fromStdString(mod.name);
-    const QString author = toDisplay(mod.author);
-    const QString status = toDisplay(mod.status, tr("未知"));
-    const QString lastPublished = toDisplay(mod.last_published_at, tr("-"));
-    const QString lastSaved = toDisplay(mod.last_saved_at, tr("-"));
-    const QString platform = toDisplay(mod.source_platform);
-    const QString url = toDisplay(mod.source_url);
-    const QString note = toDisplay(mod.note);
-    const QString integrity = toDisplay(mod.integrity);
-    const QString stability = toDisplay(mod.stability);
-    const QString acquisition = toDisplay(mod.acquisition_method);
-    const QString tags = tagsTextForMod(mod.id);
-
-    modTable_->insertRow(row);
-    auto* itemName = new QTableWidgetItem(name);
-    itemName->setData(Qt::UserRole, mod.id);
-    modTable_->setItem(row, 0, itemName);
-    modTable_->setItem(row, 1, new QTableWidgetItem(categoryNameFor(mod.category_id)));
-    modTable_->setItem(row, 2, new QTableWidgetItem(tags));
-    modTable_->setItem(row, 3, new QTableWidgetItem(author));
-    modTable_->setItem(row, 4, new QTableWidgetItem(mod.rating > 0 ? QString::number(mod.rating) : QString("-")));
-    modTable_->setItem(row, 5, new QTableWidgetItem(status));
-    modTable_->setItem(row, 6, new QTableWidgetItem(lastPublished));
-    modTable_->setItem(row, 7, new QTableWidgetItem(lastSaved));
-    modTable_->setItem(row, 8, new QTableWidgetItem(platform));
-    modTable_->setItem(row, 9, new QTableWidgetItem(url));
-    modTable_->setItem(row, 10, new QTableWidgetItem(integrity.isEmpty() ? tr("-") : integrity));
-    modTable_->setItem(row, 11, new QTableWidgetItem(stability.isEmpty() ? tr("-") : stability));
-    modTable_->setItem(row, 12, new QTableWidgetItem(acquisition.isEmpty() ? tr("-") : acquisition));
-    modTable_->setItem(row, 13, new QTableWidgetItem(note));
-    ++row;
-  }
-
-  if (modTable_->rowCount() > 0) {
-    modTable_->setCurrentCell(0, 0);
+  const QString filterAttribute = filterAttribute_->currentText();
+  const QString filterValueText = filterValue_->currentText();
+  const int filterId = filterIdForCombo(filterValue_, filterProxy_, filterModel_);
+  const bool hideDeleted = showDeletedCheckBox_ && !showDeletedCheckBox_->isChecked();
+
+  if (store_->paged()) {
+    // 超大仓库只按可见范围分页查询，总数来自聚合查询
+    modTable_->modModel()->setPageSource(pageSource(filterAttribute, filterId, filterValueText, !hideDeleted));
+  } else {
+    // 只记录通过筛选的下标，单元格文本由模型在绘制可见行时生成
+    const auto result = filterResult(filterAttribute, filterId, filterValueText);
+    std::vector<int> rows = filteredRows(*result, !hideDeleted);
+    modTable_->modModel()->setRows(&store_->mods(), std::move(rows));
+  }
+
+  if (modTable_->modModel()->rowCount() > 0) {
+    modTable_->setCurrentRow(0);
   } else {
     updateDetailForMod(-1);
   }
@@ -1101,6 +1499,8 @@ void RepositoryPresenter::reloadCategories() {
     filterModel_->clear();
   }
   populateCategoryFilterModel(usingCategoryFilter ? filterModel_ : nullptr, true);
+  // 分类树变化后子树倒排表随之失效
+  store_->setCategoryParents(categoryParent_);
 }
 
 void RepositoryPresenter::reloadTags() {
@@ -1115,34 +1515,6 @@ void RepositoryPresenter::reloadRatings() {
   populateRatingFilterModel(filterModel_);
 }
 
-QString RepositoryPresenter::formatTagSummary(const std::vector<TagWithGroupRow>& rows,
-                                              const QString& groupSeparator,
-                                              const QString& tagSeparator) const {
-  if (rows.empty()) {
-    return {};
-  }
-
-  QMap<QString, QStringList> grouped;
-  for (const auto& row : rows) {
-    const QString groupName = QString::fromStdString(row.group_name);
-    const QString tagName = QString::fromStdString(row.name);
-    QStringList& list = grouped[groupName];
-    if (!list.contains(tagName)) {
-      list.append(tagName);
-    }
-  }
-
-  QStringList sections;
-  for (auto it = grouped.constBegin(); it != grouped.constEnd(); ++it) {
-    QStringList tags = it.value();
-    std::sort(tags.begin(), tags.end(), [](const QString& a, const QString& b) {
-      return a.localeAwareCompare(b) < 0;
-    });
-    sections << QString("%1: %2").arg(it.key(), tags.join(tagSeparator));
-  }
-  return sections.join(groupSeparator);
-}
-
 bool RepositoryPresenter::categoryMatchesFilter(int modCategoryId, int filterCategoryId) const {
   if (filterCategoryId == kUncategorizedCategoryId) {
     return modCategoryId == 0;
@@ -2,25 +2,37 @@
 
 #include <QObject>
 #include <QString>
+#include <cstdint>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
+#include "core/index/FilterBitset.h"
+
 class QCheckBox;
 class QComboBox;
+class QImage;
 class QLabel;
+class QSize;
 class QSortFilterProxyModel;
 class QStandardItemModel;
 class QTextEdit;
 class QWidget;
 
+struct AssetConflict;
 struct CategoryRow;
+struct ModPageFilter;
 struct ModRow;
 struct TagDescriptor;
 struct TagWithGroupRow;
 
 class ImportService;
+class ModPageSource;
+class ModStore;
 class RepositoryPage;
 class RepositoryService;
+class ThumbnailCache;
+class CoverLoader;
 class ModFilterPanel;
 class ModTableWidget;
 struct Settings;
@@ -43,8 +55,13 @@ public:
 
   void initializeFilters();
   void reloadAll();
+  /// 与 reloadAll 相同，但 MOD 与标签在后台加载：表格先以空内容显示，加载完成后填充并发出 modsReloaded。
+  /// 仓库未打开时同样在事件循环中发出 modsReloaded。
+  void reloadAllAsync();
 
-  const std::vector<ModRow>& mods() const { return mods_; }
+  const std::vector<ModRow>& mods() const;
+  /// 仓库 MOD 的内存副本；选择器页订阅其行变化通知。
+  ModStore* modStore() const { return store_; }
 
   QString tagsTextForMod(int modId) const;
   std::vector<TagDescriptor> tagsForMod(int modId) const;
@@ -55,6 +72,30 @@ public:
                         int filterId,
                         const QString& filterValue) const;
 
+  /**
+   * @brief 当前 MOD 列表在某个筛选条件下的结果（包含已删除的 MOD），下标指向 mods()。
+   * @details 分类、标签、作者、评分直接取加载时建立的倒排表，结果按下标升序；
+   *          名称筛选走三元组模糊索引（同时匹配作者、容忍少量拼写错误），结果按相关度从高到低排列。
+   *          结果按筛选条件缓存，重新加载列表或分类后失效；仓库页、选择器页与游戏目录可见性共用同一份结果。
+   */
+  std::shared_ptr<const FilterBitset> filterResult(const QString& attribute,
+                                                   int filterId,
+                                                   const QString& filterValue) const;
+  /// 将筛选结果展开为表格行（mods() 下标，保持结果顺序），按需排除已删除的 MOD。
+  std::vector<int> filteredRows(const FilterBitset& result, bool includeDeleted) const;
+  /// MOD id 在 mods() 中的下标，不存在时返回 -1。
+  int modIndexForId(int modId) const;
+  /**
+   * @brief 分页模式（ModStore::paged()）下与筛选条件对应的 SQL 筛选。
+   * @details 分类、标签、作者、评分的含义与 filterResult 相同；名称筛选退化为 ASCII 不区分大小写的前缀匹配。
+   */
+  ModPageFilter pageFilter(const QString& attribute, int filterId, const QString& filterValue, bool includeDeleted) const;
+  /// 按 pageFilter 创建的分页数据源。
+  std::shared_ptr<ModPageSource> pageSource(const QString& attribute,
+                                            int filterId,
+                                            const QString& filterValue,
+                                            bool includeDeleted) const;
+
   void populateCategoryFilterModel(QStandardItemModel* model, bool updateCache);
   void populateTagFilterModel(QStandardItemModel* model) const;
   void populateAuthorFilterModel(QStandardItemModel* model) const;
@@ -71,6 +112,7 @@ signals:
 
 private slots:
   void handleRefreshRequested();
+  void handleConflictScanRequested();
   void handleImportRequested();
   void handleImportFolderRequested();
   void handleEditRequested();
@@ -80,19 +122,32 @@ private slots:
   void handleFilterValueTextChanged(const QString& text);
   void handleFilterChanged(const QString& text);
   void handleCurrentCellChanged(int currentRow, int currentColumn, int previousRow, int previousColumn);
+  void handleThumbnailReady(int modId, const QString& path);
+  void handleCoverReady(const QString& path, const QSize& size, const QImage& image);
+  void handleModsPatched(const std::vector<int>& indices);
+  void handleModsReset();
+  void handleModsInvalidated();
 
 private:
   void loadData();
+  /// 列出建议的冲突关系并询问是否写入；返回新增的关系数。
+  int offerConflictSuggestions(const std::vector<AssetConflict>& conflicts);
   void populateTable();
   void reloadCategories();
   void reloadTags();
   void reloadAuthors();
   void reloadRatings();
 
-  QString formatTagSummary(const std::vector<TagWithGroupRow>& rows,
-                           const QString& groupSeparator,
-                           const QString& tagSeparator) const;
   bool categoryMatchesFilter(int modCategoryId, int filterCategoryId) const;
+  FilterBitset computeFilter(const QString& attribute, int filterId, const QString& filterValue) const;
+  /// 封面的绝对路径（相对路径按仓库目录解析），不访问磁盘。
+  QString coverPathFor(const ModRow& mod) const;
+  /// 显示封面：内存缓存命中时立即显示，否则排队解码。
+  void showCover(const QString& path);
+  /// 没有可用封面时排队提取 VPK 内嵌预览图。
+  void requestEmbeddedPreview(const ModRow& mod);
+  /// 预先解码当前行前后若干行的封面。
+  void prefetchNeighbourCovers();
 
   RepositoryPage* page_{};
   RepositoryService* repo_{};
@@ -109,14 +164,26 @@ private:
   QLabel* coverLabel_{};
   QLabel* metaLabel_{};
   QTextEdit* noteView_{};
+  ThumbnailCache* thumbnails_{};
+  CoverLoader* covers_{};
+  QString detailCoverPath_; ///< 详情区正在显示或等待的封面，用于丢弃过时的解码结果
+  int detailModId_ = -1; ///< 详情区当前显示的 MOD，用于丢弃过时的缩略图结果
 
   QStandardItemModel* filterModel_{};
   QSortFilterProxyModel* filterProxy_{};
 
-  std::vector<ModRow> mods_;
+  ModStore* store_{};
   std::unordered_map<int, QString> categoryNames_;
   std::unordered_map<int, int> categoryParent_;
-  std::unordered_map<int, QString> modTagsText_;
-  std::unordered_map<int, std::vector<TagWithGroupRow>> modTagsCache_;
+
+  struct CachedFilter {
+    QString attribute;
+    int filterId{0};
+    QString value;
+    std::shared_ptr<const FilterBitset> result;
+  };
+  mutable std::vector<CachedFilter> filterCache_; ///< 最近使用的筛选结果，按使用先后排列
+  mutable std::uint64_t filterCacheVersion_{0};   ///< 缓存对应的 ModStore::version()
   bool suppressFilterSignals_ = false;
+  bool refreshFiltersOnReset_ = false; ///< 后台加载完成后按新数据重建筛选值（如作者列表）
 };
@@ -1,17 +1,20 @@
 #include "app/ui/presenters/SelectorPresenter.h"
 
-#include <algorithm>
-
 #include <QComboBox>
 #include <QFont>
 #include <QLineEdit>
 #include <QSortFilterProxyModel>
 #include <QStandardItem>
 #include <QStandardItemModel>
-#include <QTableWidgetItem>
+#include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "app/services/ModStore.h"
 #include "app/ui/components/ModFilterPanel.h"
+#include "app/ui/components/ModTableModel.h"
 #include "app/ui/components/ModTableWidget.h"
 #include "app/ui/pages/SelectorPage.h"
 #include "app/ui/presenters/RepositoryPresenter.h"
@@ -36,6 +39,12 @@ SelectorPresenter::SelectorPresenter(SelectorPage* page, QObject* parent)
     }
     gameDirTable_ = page_->gameDirectoryTable();
     repoTable_ = page_->repositoryTable();
+    if (gameDirTable_) {
+      // 游戏目录只包含实际安装的 MOD，条目少且需要逐项设置字体与提示，继续使用逐项模型
+      gameDirModel_ = new QStandardItemModel(this);
+      gameDirModel_->setHorizontalHeaderLabels(gameDirTable_->columnHeaders());
+      gameDirTable_->setModel(gameDirModel_);
+    }
 
     connect(page_, &SelectorPage::filterAttributeChanged, this, &SelectorPresenter::handleFilterAttributeChanged);
     connect(page_, &SelectorPage::filterValueChanged, this, &SelectorPresenter::handleFilterValueChanged);
@@ -70,6 +79,23 @@ void SelectorPresenter::initializeFilters() {
 
 void SelectorPresenter::setRepositoryPresenter(RepositoryPresenter* presenter) {
   repositoryPresenter_ = presenter;
+  if (repoTable_ && repositoryPresenter_) {
+    repoTable_->modModel()->setColumns({
+        [](const ModRow& mod) { return QString::fromStdString(mod.name); },
+        [presenter](const ModRow& mod) { return presenter->tagsTextForMod(mod.id); },
+        [](const ModRow& mod) { return toDisplay(mod.author); },
+        [](const ModRow& mod) { return mod.rating > 0 ? QString::number(mod.rating) : QStringLiteral("-"); },
+        [](const ModRow& mod) { return toDisplay(mod.note); },
+    });
+  }
+  if (repositoryPresenter_) {
+    // 单个 MOD 的增删改只刷新对应的行，不再整表重建
+    ModStore* store = repositoryPresenter_->modStore();
+    connect(store, &ModStore::rowsChanged, this, &SelectorPresenter::handleModsPatched, Qt::UniqueConnection);
+    connect(store, &ModStore::rowsInserted, this, &SelectorPresenter::handleModsPatched, Qt::UniqueConnection);
+    connect(store, &ModStore::rowsRemoved, this, &SelectorPresenter::handleModsPatched, Qt::UniqueConnection);
+    connect(store, &ModStore::pagesInvalidated, this, &SelectorPresenter::handleModsInvalidated, Qt::UniqueConnection);
+  }
 }
 
 void SelectorPresenter::setRepositoryService(RepositoryService* service) {
@@ -92,10 +118,10 @@ void SelectorPresenter::refreshRepositoryData() {
 
 
 void SelectorPresenter::refreshGameDirectory() {
-  if (!gameDirTable_) {
+  if (!gameDirModel_) {
     return;
   }
-  gameDirTable_->setRowCount(0);
+  gameDirModel_->removeRows(0, gameDirModel_->rowCount());
   if (!repoService_) {
     return;
   }
@@ -107,7 +133,21 @@ void SelectorPresenter::refreshGameDirectory() {
   // 通过仓库缓存表读取游戏目录扫描结果，并匹配仓库 MOD 补全展示信息
   const std::vector<GameModRow> gameMods = repoService_->listGameMods();
   std::unordered_map<int, const ModRow*> repoIndex;
-  if (repositoryPresenter_) {
+  std::unordered_map<int, ModRow> pagedMods; ///< 分页模式下逐个查询的仓库 MOD
+  if (repositoryPresenter_ && repositoryPresenter_->modStore()->paged()) {
+    // 仓库未载入内存，游戏目录中的 MOD 数量有限，逐个按 id 查询
+    for (const auto& cacheRow : gameMods) {
+      const int repoId = cacheRow.repo_mod_id.value_or(0);
+      if (repoId > 0 && pagedMods.count(repoId) == 0) {
+        if (auto mod = repoService_->findMod(repoId)) {
+          pagedMods.emplace(repoId, std::move(*mod));
+        }
+      }
+    }
+    for (const auto& [id, mod] : pagedMods) {
+      repoIndex.emplace(id, &mod);
+    }
+  } else if (repositoryPresenter_) {
     const auto& mods = repositoryPresenter_->mods();
     repoIndex.reserve(mods.size());
     for (const auto& mod : mods) {
@@ -115,7 +155,7 @@ void SelectorPresenter::refreshGameDirectory() {
     }
   }
 
-  gameDirTable_->setRowCount(static_cast<int>(gameMods.size()));
+  gameDirModel_->setRowCount(static_cast<int>(gameMods.size()));
   int rowIndex = 0;
   for (const auto& cacheRow : gameMods) {
     const int repoId = cacheRow.repo_mod_id.value_or(0);
@@ -129,8 +169,8 @@ void SelectorPresenter::refreshGameDirectory() {
 
     QString displayName = repoMod ? QString::fromStdString(repoMod->name)
                                   : QString::fromStdString(cacheRow.name);
-    auto* nameItem = new QTableWidgetItem(displayName);
-    nameItem->setData(Qt::UserRole, repoMod ? repoMod->id : 0);
+    auto* nameItem = new QStandardItem(displayName);
+    nameItem->setData(repoMod ? repoMod->id : 0, Qt::UserRole);
     const bool isWorkshop = QString::fromStdString(cacheRow.source) == QStringLiteral("workshop");
     if (isWorkshop) {
       QFont font = nameItem->font();
@@ -146,28 +186,28 @@ void SelectorPresenter::refreshGameDirectory() {
                                 .arg(QString::number(sizeMb, 'f', 2))
                                 .arg(QString::fromStdString(cacheRow.modified_at));
     nameItem->setToolTip(tooltip);
-    gameDirTable_->setItem(rowIndex, 0, nameItem);
+    gameDirModel_->setItem(rowIndex, 0, nameItem);
 
     const QString tagsText = (repoMod && repositoryPresenter_)
                                  ? repositoryPresenter_->tagsTextForMod(repoMod->id)
                                  : QString();
-    gameDirTable_->setItem(rowIndex, 1, new QTableWidgetItem(tagsText));
+    gameDirModel_->setItem(rowIndex, 1, new QStandardItem(tagsText));
 
     const QString authorText = repoMod ? QString::fromStdString(repoMod->author) : QString();
-    gameDirTable_->setItem(rowIndex, 2, new QTableWidgetItem(authorText.isEmpty() ? QStringLiteral("-") : authorText));
+    gameDirModel_->setItem(rowIndex, 2, new QStandardItem(authorText.isEmpty() ? QStringLiteral("-") : authorText));
 
     QString ratingText = QStringLiteral("-");
     if (repoMod && repoMod->rating > 0) {
       ratingText = QString::number(repoMod->rating);
     }
-    gameDirTable_->setItem(rowIndex, 3, new QTableWidgetItem(ratingText));
+    gameDirModel_->setItem(rowIndex, 3, new QStandardItem(ratingText));
 
     const QString noteText = repoMod ? QString::fromStdString(repoMod->note) : QString();
-    gameDirTable_->setItem(rowIndex, 4, new QTableWidgetItem(noteText));
+    gameDirModel_->setItem(rowIndex, 4, new QStandardItem(noteText));
 
-    auto* statusItem = new QTableWidgetItem(QString::fromStdString(cacheRow.status));
-    statusItem->setData(Qt::UserRole, QString::fromStdString(cacheRow.source));
-    gameDirTable_->setItem(rowIndex, 5, statusItem);
+    auto* statusItem = new QStandardItem(QString::fromStdString(cacheRow.status));
+    statusItem->setData(QString::fromStdString(cacheRow.source), Qt::UserRole);
+    gameDirModel_->setItem(rowIndex, 5, statusItem);
 
     ++rowIndex;
   }
@@ -185,31 +225,67 @@ void SelectorPresenter::applyFilter() {
   const QString filterValueText = filterValue_->currentText();
   const int filterId = filterIdForCombo(filterValue_, filterProxy_, filterModel_);
 
-  repoTable_->setRowCount(0);
-  const auto& mods = repositoryPresenter_->mods();
-  int row = 0;
-  for (const auto& mod : mods) {
-    if (mod.is_deleted) {
-      continue;
+  if (repositoryPresenter_->modStore()->paged()) {
+    repoTable_->modModel()->setPageSource(repositoryPresenter_->pageSource(attribute, filterId, filterValueText, false));
+  } else {
+    // 与仓库页共用倒排索引，只记录通过筛选的下标，单元格文本由模型在绘制可见行时生成
+    const auto& mods = repositoryPresenter_->mods();
+    const auto result = repositoryPresenter_->filterResult(attribute, filterId, filterValueText);
+    repoTable_->modModel()->setRows(&mods, repositoryPresenter_->filteredRows(*result, false));
+  }
+
+  updateGameDirVisibility(attribute, filterId, filterValueText);
+}
+
+void SelectorPresenter::handleModsPatched(const std::vector<int>& indices) {
+  if (!repoTable_ || !filterAttribute_ || !filterValue_ || !repositoryPresenter_) {
+    return;
+  }
+
+  const QString attribute = filterAttribute_->currentText();
+  const QString filterValueText = filterValue_->currentText();
+  const int filterId = filterIdForCombo(filterValue_, filterProxy_, filterModel_);
+
+  const auto result = repositoryPresenter_->filterResult(attribute, filterId, filterValueText);
+  repoTable_->modModel()->updateRows(repositoryPresenter_->filteredRows(*result, false), indices);
+
+  // 游戏目录中关联到这些 MOD 的行只更新仓库信息列，扫描得到的文件信息保持不变
+  if (gameDirModel_) {
+    const ModStore* store = repositoryPresenter_->modStore();
+    const auto& mods = store->mods();
+    std::unordered_set<int> changedIds;
+    for (const int index : indices) {
+      if (index >= 0 && static_cast<std::size_t>(index) < mods.size()) {
+        changedIds.insert(mods[static_cast<std::size_t>(index)].id);
+      }
     }
-    if (!repositoryPresenter_->modMatchesFilter(mod, attribute, filterId, filterValueText)) {
-      continue;
+    const int rowCount = gameDirModel_->rowCount();
+    for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+      auto* nameItem = gameDirModel_->item(rowIndex, 0);
+      const int modId = nameItem ? nameItem->data(Qt::UserRole).toInt() : 0;
+      const int index = changedIds.count(modId) ? store->indexOf(modId) : -1;
+      if (index < 0) {
+        continue;
+      }
+      const ModRow& mod = mods[static_cast<std::size_t>(index)];
+      nameItem->setText(QString::fromStdString(mod.name));
+      gameDirModel_->item(rowIndex, 1)->setText(repositoryPresenter_->tagsTextForMod(mod.id));
+      gameDirModel_->item(rowIndex, 2)->setText(toDisplay(mod.author, QStringLiteral("-")));
+      gameDirModel_->item(rowIndex, 3)->setText(mod.rating > 0 ? QString::number(mod.rating) : QStringLiteral("-"));
+      gameDirModel_->item(rowIndex, 4)->setText(toDisplay(mod.note));
     }
-
-    repoTable_->insertRow(row);
-    auto* itemName = new QTableWidgetItem(QString::fromStdString(mod.name));
-    itemName->setData(Qt::UserRole, mod.id);
-    repoTable_->setItem(row, 0, itemName);
-    repoTable_->setItem(row, 1, new QTableWidgetItem(repositoryPresenter_->tagsTextForMod(mod.id)));
-    repoTable_->setItem(row, 2, new QTableWidgetItem(toDisplay(mod.author)));
-    repoTable_->setItem(row, 3, new QTableWidgetItem(mod.rating > 0 ? QString::number(mod.rating) : QString("-")));
-    repoTable_->setItem(row, 4, new QTableWidgetItem(toDisplay(mod.note)));
-    ++row;
   }
 
   updateGameDirVisibility(attribute, filterId, filterValueText);
 }
 
+void SelectorPresenter::handleModsInvalidated() {
+  if (repoTable_) {
+    repoTable_->modModel()->reloadPageSource();
+  }
+  refreshGameDirectory();
+}
+
 
 void SelectorPresenter::handleFilterAttributeChanged(const QString& attribute) {
   if (!filterModel_ || !filterProxy_ || !filterValue_ || !repositoryPresenter_) {
@@ -224,7 +300,9 @@ void SelectorPresenter::handleFilterAttributeChanged(const QString& attribute) {
 
   QString placeholder;
   if (attribute == tr("名称")) {
-    placeholder = tr("搜索名称");
+    // 分页模式下名称只能按开头匹配，在提示中说明
+    placeholder = repositoryPresenter_->modStore()->paged() ? tr("搜索名称开头（大型仓库仅支持前缀匹配）")
+                                                             : tr("搜索名称");
   } else if (attribute == tr("分类")) {
     repositoryPresenter_->populateCategoryFilterModel(filterModel_, false);
     placeholder = tr("选择分类");
@@ -299,25 +377,56 @@ int SelectorPresenter::filterIdForCombo(const QComboBox* combo,
 void SelectorPresenter::updateGameDirVisibility(const QString& attribute,
                                                 int filterId,
                                                 const QString& filterValueText) {
-  if (!gameDirTable_ || !repositoryPresenter_) {
+  if (!gameDirTable_ || !gameDirModel_ || !repositoryPresenter_) {
     return;
   }
 
-  const auto& mods = repositoryPresenter_->mods();
-  const int rowCount = gameDirTable_->rowCount();
+  const int rowCount = gameDirModel_->rowCount();
+  std::vector<int> modIds(static_cast<std::size_t>(rowCount), 0);
   for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
-    bool visible = true;
-    if (auto* item = gameDirTable_->item(rowIndex, 0)) {
-      const int modId = item->data(Qt::UserRole).toInt();
+    if (auto* item = gameDirModel_->item(rowIndex, 0)) {
+      modIds[static_cast<std::size_t>(rowIndex)] = item->data(Qt::UserRole).toInt();
+    }
+  }
+
+  if (repositoryPresenter_->modStore()->paged()) {
+    // 分页模式下没有内存索引；游戏目录只有少量 MOD，一次 SQL 查询即可得到其中满足筛选条件的 id
+    if (!repoService_) {
+      return;
+    }
+    std::vector<int> linkedIds;
+    for (const int modId : modIds) {
       if (modId > 0) {
-        const auto it = std::find_if(mods.begin(), mods.end(), [modId](const ModRow& row) {
-          return row.id == modId;
-        });
-        if (it != mods.end()) {
-          visible = repositoryPresenter_->modMatchesFilter(*it, attribute, filterId, filterValueText);
-        }
+        linkedIds.push_back(modId);
       }
     }
+    std::sort(linkedIds.begin(), linkedIds.end());
+    linkedIds.erase(std::unique(linkedIds.begin(), linkedIds.end()), linkedIds.end());
+    // 与内存模式一致：已删除的 MOD 同样参与筛选，仓库中已不存在的 MOD 保持可见
+    const auto filter = repositoryPresenter_->pageFilter(attribute, filterId, filterValueText, true);
+    const auto matchedIds = repoService_->filterModIds(filter, linkedIds);
+    const std::unordered_set<int> matched(matchedIds.begin(), matchedIds.end());
+    std::unordered_set<int> existing;
+    if (matched.size() < linkedIds.size()) {
+      ModPageFilter anyMod;
+      anyMod.include_deleted = true;
+      const auto existingIds = repoService_->filterModIds(anyMod, linkedIds);
+      existing.insert(existingIds.begin(), existingIds.end());
+    }
+    for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+      const int modId = modIds[static_cast<std::size_t>(rowIndex)];
+      const bool visible = modId <= 0 || matched.count(modId) > 0 || existing.count(modId) == 0;
+      gameDirTable_->setRowHidden(rowIndex, !visible);
+    }
+    return;
+  }
+
+  // 与选择器表格共用同一次筛选的结果，每行只需一次 id 查找与一次位测试
+  const auto result = repositoryPresenter_->filterResult(attribute, filterId, filterValueText);
+  for (int rowIndex = 0; rowIndex < rowCount; ++rowIndex) {
+    const int modId = modIds[static_cast<std::size_t>(rowIndex)];
+    const int index = modId > 0 ? repositoryPresenter_->modIndexForId(modId) : -1;
+    const bool visible = index < 0 || result->test(index);
     gameDirTable_->setRowHidden(rowIndex, !visible);
   }
 }
@@ -3,6 +3,8 @@
 #include <QObject>
 #include <QString>
 
+#include <vector>
+
 class QComboBox;
 class QSortFilterProxyModel;
 class QStandardItemModel;
@@ -32,6 +34,10 @@ private slots:
   void handleFilterAttributeChanged(const QString& attribute);
   void handleFilterValueChanged(const QString& text);
   void handleFilterValueTextChanged(const QString& text);
+  /// 仓库中部分 MOD 变化后就地更新两张表格中对应的行。
+  void handleModsPatched(const std::vector<int>& indices);
+  /// 分页模式下数据库写入后重新查询仓库表格与游戏目录。
+  void handleModsInvalidated();
 
 private:
   int filterIdForCombo(const QComboBox* combo,
@@ -47,6 +53,7 @@ private:
   QComboBox* filterValue_{};
   ModTableWidget* repoTable_{};
   ModTableWidget* gameDirTable_{};
+  QStandardItemModel* gameDirModel_{};
   QStandardItemModel* filterModel_{};
   QSortFilterProxyModel* filterProxy_{};
   bool suppressFilterSignals_ = false;
@@ -76,6 +76,7 @@ SettingsPresenter::SettingsPresenter(SettingsPage* page,
   connect(gameBrowseBtn, &QPushButton::clicked, this, &SettingsPresenter::onBrowseGameDir);
   connect(gameDirEdit, &QLineEdit::textChanged, this, &SettingsPresenter::onGameDirEdited);
   connect(importCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SettingsPresenter::onImportModeChanged);
+  connect(page_->contentStoreCheck(), &QCheckBox::toggled, this, [this]() { setSettingsStatus({}); });
   connect(autoImportCheck, &QCheckBox::toggled, this, &SettingsPresenter::onAutoImportToggled);
   connect(autoImportCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SettingsPresenter::onAutoImportModeChanged);
   connect(saveBtn, &QPushButton::clicked, this, &SettingsPresenter::onSaveSettings);
@@ -190,6 +191,7 @@ void SettingsPresenter::onSaveSettings() {
   auto* repoEdit = page_->repoDirEdit();
   auto* gameEdit = page_->gameDirEdit();
   auto* importCombo = page_->importModeCombo();
+  auto* contentStoreCheck = page_->contentStoreCheck();
   auto* autoImportCheck = page_->autoImportCheck();
   auto* autoImportCombo = page_->autoImportModeCombo();
   auto* retainDeleted = page_->retainDeletedCheck();
@@ -225,6 +227,9 @@ void SettingsPresenter::onSaveSettings() {
   if (importCombo) {
     updated.importAction = static_cast<ImportAction>(importCombo->currentData().toInt());
   }
+  if (contentStoreCheck) {
+    updated.contentAddressedStore = contentStoreCheck->isChecked();
+  }
 
   if (autoImportCheck) {
     updated.addonsAutoImportEnabled = autoImportCheck->isChecked();
@@ -286,6 +291,7 @@ void SettingsPresenter::refreshBasicSettingsUi() {
   auto* repoEdit = page_->repoDirEdit();
   auto* gameEdit = page_->gameDirEdit();
   auto* importCombo = page_->importModeCombo();
+  auto* contentStoreCheck = page_->contentStoreCheck();
   auto* autoImportCheck = page_->autoImportCheck();
   auto* autoImportCombo = page_->autoImportModeCombo();
 
@@ -304,6 +310,10 @@ void SettingsPresenter::refreshBasicSettingsUi() {
     const int index = importCombo->findData(static_cast<int>(settings_->importAction));
     importCombo->setCurrentIndex(index >= 0 ? index : 0);
   }
+  if (contentStoreCheck) {
+    QSignalBlocker blocker(contentStoreCheck);
+    contentStoreCheck->setChecked(settings_->contentAddressedStore);
+  }
   if (autoImportCheck) {
     QSignalBlocker blocker(autoImportCheck);
     autoImportCheck->setChecked(settings_->addonsAutoImportEnabled);
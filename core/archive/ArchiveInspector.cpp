@@ -0,0 +1,687 @@
+#include "core/archive/ArchiveInspector.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/io/MappedFile.h"
+
+/**
+ * @file ArchiveInspector.cpp
+ * @brief ZIP 中央目录与 7z 头部解析的实现。
+ */
+
+namespace {
+
+constexpr std::uint32_t kZipEndOfCentralDir = 0x06054b50;
+constexpr std::uint32_t kZip64EndOfCentralDir = 0x06064b50;
+constexpr std::uint32_t kZip64Locator = 0x07064b50;
+constexpr std::uint32_t kZipCentralHeader = 0x02014b50;
+constexpr std::size_t kZipEndSize = 22;
+constexpr std::size_t kZipCentralHeaderSize = 46;
+constexpr std::size_t kZip64LocatorSize = 20;
+constexpr std::size_t kZip64EndSize = 56;
+constexpr std::size_t kZipMaxComment = 0xFFFF;
+constexpr std::uint16_t kZip64ExtraId = 0x0001;
+
+constexpr std::uint8_t kSevenZipSignature[6] = {'7', 'z', 0xBC, 0xAF, 0x27, 0x1C};
+constexpr std::size_t kSevenZipStartHeaderSize = 32;
+constexpr std::uint8_t kRarSignature[6] = {'R', 'a', 'r', '!', 0x1A, 0x07};
+
+/// 7z 头部中的属性编号。
+enum SevenZipId : std::uint64_t {
+  kEnd = 0x00,
+  kHeader = 0x01,
+  kArchiveProperties = 0x02,
+  kAdditionalStreamsInfo = 0x03,
+  kMainStreamsInfo = 0x04,
+  kFilesInfo = 0x05,
+  kPackInfo = 0x06,
+  kUnPackInfo = 0x07,
+  kSubStreamsInfo = 0x08,
+  kSize = 0x09,
+  kCRC = 0x0A,
+  kFolder = 0x0B,
+  kCodersUnPackSize = 0x0C,
+  kNumUnPackStream = 0x0D,
+  kEmptyStream = 0x0E,
+  kEmptyFile = 0x0F,
+  kName = 0x11,
+  kEncodedHeader = 0x17,
+};
+
+inline std::uint16_t readU16(const std::uint8_t* p) {
+  return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline std::uint32_t readU32(const std::uint8_t* p) {
+  return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline std::uint64_t readU64(const std::uint8_t* p) {
+  return static_cast<std::uint64_t>(readU32(p)) | (static_cast<std::uint64_t>(readU32(p + 4)) << 32);
+}
+
+inline std::error_code malformed() {
+  return std::make_error_code(std::errc::illegal_byte_sequence);
+}
+
+/// 统一分隔符并去掉开头的 "./" 与 '/'。
+std::string normalizeEntryPath(std::string path) {
+  std::replace(path.begin(), path.end(), '\\', '/');
+  std::size_t start = 0;
+  while (start < path.size() && (path[start] == '/' || (path.compare(start, 2, "./") == 0))) {
+    start += path[start] == '/' ? 1 : 2;
+  }
+  return path.substr(start);
+}
+
+void appendUtf8(std::string& out, std::uint32_t codePoint) {
+  if (codePoint < 0x80) {
+    out.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else if (codePoint < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+/// 定位 ZIP 尾部的 End of Central Directory 记录；注释最长 64 KiB，只需扫描文件末尾。
+std::optional<std::size_t> findZipEnd(const std::uint8_t* data, std::size_t size) {
+  if (size < kZipEndSize) {
+    return std::nullopt;
+  }
+  const std::size_t lowest = size > kZipEndSize + kZipMaxComment ? size - kZipEndSize - kZipMaxComment : 0;
+  for (std::size_t pos = size - kZipEndSize + 1; pos-- > lowest;) {
+    if (readU32(data + pos) == kZipEndOfCentralDir && pos + kZipEndSize + readU16(data + pos + 20) <= size) {
+      return pos;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief 7z 头部的字节读取器；任何越界读取都会置位 failed，之后的读取全部返回 0。
+ */
+class SevenZipReader {
+public:
+  SevenZipReader(const std::uint8_t* data, std::size_t size) : data_(data), size_(size) {}
+
+  bool failed() const { return failed_; }
+  std::size_t remaining() const { return failed_ ? 0 : size_ - pos_; }
+
+  std::uint8_t byte() {
+    if (failed_ || pos_ >= size_) {
+      failed_ = true;
+      return 0;
+    }
+    return data_[pos_++];
+  }
+
+  /// 7z 的变长整数：首字节的前导 1 位数表示额外字节数。
+  std::uint64_t number() {
+    const std::uint8_t first = byte();
+    std::uint8_t mask = 0x80;
+    std::uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+      if ((first & mask) == 0) {
+        const std::uint64_t high = first & (mask - 1u);
+        return value | (high << (8 * i));
+      }
+      value |= static_cast<std::uint64_t>(byte()) << (8 * i);
+      mask >>= 1;
+    }
+    return value;
+  }
+
+  /// 读取数量类字段，超过剩余字节数的数量必然是损坏的数据。
+  std::size_t count() {
+    const std::uint64_t value = number();
+    if (value > remaining()) {
+      failed_ = true;
+      return 0;
+    }
+    return static_cast<std::size_t>(value);
+  }
+
+  void skip(std::uint64_t bytes) {
+    if (failed_ || bytes > size_ - pos_) {
+      failed_ = true;
+      return;
+    }
+    pos_ += static_cast<std::size_t>(bytes);
+  }
+
+  const std::uint8_t* take(std::uint64_t bytes) {
+    if (failed_ || bytes > size_ - pos_) {
+      failed_ = true;
+      return nullptr;
+    }
+    const std::uint8_t* p = data_ + pos_;
+    pos_ += static_cast<std::size_t>(bytes);
+    return p;
+  }
+
+  std::vector<bool> bits(std::size_t n) {
+    std::vector<bool> out(n, false);
+    std::uint8_t current = 0;
+    for (std::size_t i = 0; i < n && !failed_; ++i) {
+      if (i % 8 == 0) {
+        current = byte();
+      }
+      out[i] = (current & (0x80 >> (i % 8))) != 0;
+    }
+    return out;
+  }
+
+  /// 可选的“全部已定义”标志 + 位向量。
+  std::vector<bool> definedBits(std::size_t n) {
+    if (byte() != 0) {
+      return std::vector<bool>(n, true);
+    }
+    return bits(n);
+  }
+
+  void skipDigests(std::size_t n) {
+    const auto defined = definedBits(n);
+    skip(4ull * static_cast<std::uint64_t>(std::count(defined.begin(), defined.end(), true)));
+  }
+
+private:
+  const std::uint8_t* data_;
+  std::size_t size_;
+  std::size_t pos_{0};
+  bool failed_{false};
+};
+
+/// StreamsInfo 中列出文件所需的部分：每个数据流（子流）的解压后大小。
+struct SevenZipStreams {
+  std::vector<std::uint64_t> folderSizes;
+  std::vector<bool> folderCrcDefined; ///< 文件夹级 CRC 是否已给出（决定 SubStreamsInfo 中校验值的数量）
+  std::vector<std::uint64_t> streamSizes;
+};
+
+bool parseFolders(SevenZipReader& in, SevenZipStreams& streams) {
+  std::vector<std::uint64_t>& folderSizes = streams.folderSizes;
+  if (in.number() != kFolder) {
+    return false;
+  }
+  const std::size_t folders = in.count();
+  if (in.byte() != 0) {
+    return false; // 文件夹定义放在其它数据流中（External），头部未压缩的归档不会出现
+  }
+  std::vector<std::size_t> outputs(folders, 0);
+  std::vector<std::vector<bool>> boundOutputs(folders);
+  for (std::size_t f = 0; f < folders && !in.failed(); ++f) {
+    const std::size_t coders = in.count();
+    std::size_t totalIn = 0;
+    std::size_t totalOut = 0;
+    for (std::size_t c = 0; c < coders && !in.failed(); ++c) {
+      const std::uint8_t flags = in.byte();
+      in.skip(flags & 0x0F);
+      if (flags & 0x10) {
+        totalIn += in.count();
+        totalOut += in.count();
+      } else {
+        ++totalIn;
+        ++totalOut;
+      }
+      if (flags & 0x20) {
+        in.skip(in.number());
+      }
+    }
+    if (totalOut == 0 || totalOut > in.remaining() + 1) {
+      return false;
+    }
+    boundOutputs[f].assign(totalOut, false);
+    for (std::size_t b = 0; b + 1 < totalOut && !in.failed(); ++b) {
+      in.number(); // inIndex
+      const std::uint64_t outIndex = in.number();
+      if (outIndex >= totalOut) {
+        return false;
+      }
+      boundOutputs[f][static_cast<std::size_t>(outIndex)] = true;
+    }
+    const std::size_t boundPairs = totalOut - 1;
+    if (totalIn < boundPairs) {
+      return false;
+    }
+    const std::size_t packed = totalIn - boundPairs;
+    if (packed > 1) {
+      for (std::size_t p = 0; p < packed; ++p) {
+        in.number();
+      }
+    }
+    outputs[f] = totalOut;
+  }
+
+  if (in.number() != kCodersUnPackSize) {
+    return false;
+  }
+  folderSizes.assign(folders, 0);
+  for (std::size_t f = 0; f < folders && !in.failed(); ++f) {
+    for (std::size_t o = 0; o < outputs[f]; ++o) {
+      const std::uint64_t size = in.number();
+      // 未被绑定到其它编码器输入的输出即为整个文件夹的解压结果
+      if (!boundOutputs[f][o]) {
+        folderSizes[f] = size;
+      }
+    }
+  }
+  streams.folderCrcDefined.assign(folders, false);
+  for (std::uint64_t id = in.number(); id != kEnd && !in.failed(); id = in.number()) {
+    if (id != kCRC) {
+      return false;
+    }
+    streams.folderCrcDefined = in.definedBits(folders);
+    in.skip(4ull * static_cast<std::uint64_t>(
+                       std::count(streams.folderCrcDefined.begin(), streams.folderCrcDefined.end(), true)));
+  }
+  return !in.failed();
+}
+
+bool parseStreamsInfo(SevenZipReader& in, SevenZipStreams& streams) {
+  std::uint64_t id = in.number();
+  if (id == kPackInfo) {
+    in.number(); // packPos
+    const std::size_t packStreams = in.count();
+    for (id = in.number(); id != kEnd && !in.failed(); id = in.number()) {
+      if (id == kSize) {
+        for (std::size_t i = 0; i < packStreams; ++i) {
+          in.number();
+        }
+      } else if (id == kCRC) {
+        in.skipDigests(packStreams);
+      } else {
+        return false;
+      }
+    }
+    id = in.number();
+  }
+  if (id == kUnPackInfo) {
+    if (!parseFolders(in, streams)) {
+      return false;
+    }
+    id = in.number();
+  }
+
+  // 没有 SubStreamsInfo 时每个文件夹恰好对应一个数据流
+  std::vector<std::size_t> perFolder(streams.folderSizes.size(), 1);
+  bool sizesRead = false;
+  if (id == kSubStreamsInfo) {
+    for (id = in.number(); id != kEnd && !in.failed(); id = in.number()) {
+      if (id == kNumUnPackStream) {
+        for (auto& n : perFolder) {
+          n = in.count();
+        }
+      } else if (id == kSize) {
+        for (std::size_t f = 0; f < perFolder.size() && !in.failed(); ++f) {
+          if (perFolder[f] == 0) {
+            continue;
+          }
+          std::uint64_t sum = 0;
+          for (std::size_t s = 0; s + 1 < perFolder[f]; ++s) {
+            const std::uint64_t size = in.number();
+            sum += size;
+            streams.streamSizes.push_back(size);
+          }
+          if (sum > streams.folderSizes[f]) {
+            return false;
+          }
+          streams.streamSizes.push_back(streams.folderSizes[f] - sum);
+        }
+        sizesRead = true;
+      } else if (id == kCRC) {
+        // 单数据流且文件夹已有 CRC 的不再重复列出，其余数据流各有一个校验值；列表不需要它们，按数量跳过
+        std::size_t digests = 0;
+        for (std::size_t f = 0; f < perFolder.size(); ++f) {
+          const bool known = perFolder[f] == 1 && f < streams.folderCrcDefined.size() && streams.folderCrcDefined[f];
+          digests += known ? 0 : perFolder[f];
+        }
+        in.skipDigests(digests);
+      } else {
+        return false;
+      }
+    }
+    id = in.number();
+  }
+  if (!sizesRead) {
+    for (std::size_t f = 0; f < perFolder.size(); ++f) {
+      if (perFolder[f] == 1) {
+        streams.streamSizes.push_back(streams.folderSizes[f]);
+      } else if (perFolder[f] > 1) {
+        return false;
+      }
+    }
+  }
+  return id == kEnd && !in.failed();
+}
+
+bool parseFilesInfo(SevenZipReader& in, const SevenZipStreams& streams, ArchiveListing& listing) {
+  const std::size_t files = in.count();
+  std::vector<bool> emptyStream(files, false);
+  std::vector<bool> emptyFile;
+  std::vector<std::string> names(files);
+
+  for (std::uint64_t id = in.number(); id != kEnd && !in.failed(); id = in.number()) {
+    const std::uint64_t size = in.number();
+    if (size > in.remaining()) {
+      return false;
+    }
+    if (id == kEmptyStream) {
+      emptyStream = in.bits(files);
+    } else if (id == kEmptyFile) {
+      emptyFile = in.bits(static_cast<std::size_t>(std::count(emptyStream.begin(), emptyStream.end(), true)));
+    } else if (id == kName) {
+      const std::uint8_t* p = in.take(size);
+      if (!p || size < 1 || p[0] != 0) {
+        return false;
+      }
+      std::size_t pos = 1;
+      for (std::size_t f = 0; f < files; ++f) {
+        std::string& name = names[f];
+        for (;;) {
+          if (pos + 2 > size) {
+            return false;
+          }
+          std::uint32_t unit = readU16(p + pos);
+          pos += 2;
+          if (unit == 0) {
+            break;
+          }
+          if (unit >= 0xD800 && unit < 0xDC00 && pos + 2 <= size) {
+            const std::uint32_t low = readU16(p + pos);
+            if (low >= 0xDC00 && low < 0xE000) {
+              pos += 2;
+              unit = 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+            }
+          }
+          appendUtf8(name, unit);
+        }
+      }
+    } else {
+      in.skip(size);
+    }
+  }
+  if (in.failed()) {
+    return false;
+  }
+
+  std::size_t stream = 0;
+  std::size_t emptyIndex = 0;
+  listing.entries.reserve(files);
+  for (std::size_t f = 0; f < files; ++f) {
+    ArchiveEntry entry;
+    entry.path = normalizeEntryPath(std::move(names[f]));
+    if (emptyStream[f]) {
+      // 空数据流的条目中，未标记为空文件的是目录
+      entry.directory = emptyIndex >= emptyFile.size() || !emptyFile[emptyIndex];
+      ++emptyIndex;
+    } else {
+      if (stream >= streams.streamSizes.size()) {
+        return false;
+      }
+      entry.uncompressed_size = streams.streamSizes[stream++];
+    }
+    listing.entries.push_back(std::move(entry));
+  }
+  return true;
+}
+
+} // namespace
+
+bool ArchiveEntry::isVpk() const {
+  if (directory || path.size() < 4) {
+    return false;
+  }
+  const std::string_view tail(path.data() + path.size() - 4, 4);
+  return tail[0] == '.' && (tail[1] | 0x20) == 'v' && (tail[2] | 0x20) == 'p' && (tail[3] | 0x20) == 'k';
+}
+
+std::vector<const ArchiveEntry*> ArchiveListing::vpkEntries() const {
+  std::vector<const ArchiveEntry*> result;
+  for (const auto& entry : entries) {
+    // macOS 压缩工具附带的 __MACOSX/._xxx.vpk 只是资源分支，不是真正的 VPK
+    if (!entry.isVpk() || entry.path.rfind("__MACOSX/", 0) == 0) {
+      continue;
+    }
+    const std::size_t slash = entry.path.find_last_of('/');
+    if (entry.path.compare(slash == std::string::npos ? 0 : slash + 1, 2, "._") == 0) {
+      continue;
+    }
+    result.push_back(&entry);
+  }
+  return result;
+}
+
+std::uint64_t ArchiveListing::vpkUncompressedBytes() const {
+  std::uint64_t total = 0;
+  for (const ArchiveEntry* entry : vpkEntries()) {
+    total += entry->uncompressed_size;
+  }
+  return total;
+}
+
+ArchiveFormat detectArchiveFormat(const std::uint8_t* data, std::size_t size) {
+  if (!data || size < 6) {
+    return ArchiveFormat::Unknown;
+  }
+  if (std::memcmp(data, kSevenZipSignature, 6) == 0) {
+    return ArchiveFormat::SevenZip;
+  }
+  if (std::memcmp(data, kRarSignature, 6) == 0) {
+    return ArchiveFormat::Rar;
+  }
+  // 本地文件头或空 ZIP 的结束记录
+  if (data[0] == 'P' && data[1] == 'K' &&
+      ((data[2] == 3 && data[3] == 4) || (data[2] == 5 && data[3] == 6))) {
+    return ArchiveFormat::Zip;
+  }
+  return ArchiveFormat::Unknown;
+}
+
+std::optional<ArchiveListing> inspectZip(const std::uint8_t* data, std::size_t size, std::error_code& ec) {
+  ec.clear();
+  const auto end = findZipEnd(data, size);
+  if (!end) {
+    ec = malformed();
+    return std::nullopt;
+  }
+  const std::uint8_t* record = data + *end;
+  std::uint64_t entries = readU16(record + 10);
+  std::uint64_t directorySize = readU32(record + 12);
+  std::uint64_t directoryOffset = readU32(record + 16);
+  std::uint64_t directoryEnd = *end;
+
+  // 任一字段溢出时改用 Zip64 结束记录
+  if (entries == 0xFFFF || directorySize == 0xFFFFFFFFu || directoryOffset == 0xFFFFFFFFu) {
+    if (*end < kZip64LocatorSize || readU32(data + *end - kZip64LocatorSize) != kZip64Locator) {
+      ec = malformed();
+      return std::nullopt;
+    }
+    std::uint64_t zip64Offset = readU64(data + *end - kZip64LocatorSize + 8);
+    // 前置数据同样会让记录的偏移失效；Zip64 结束记录通常紧挨在定位器之前
+    if ((zip64Offset > size || size - zip64Offset < kZip64EndSize ||
+         readU32(data + zip64Offset) != kZip64EndOfCentralDir) &&
+        *end >= kZip64LocatorSize + kZip64EndSize) {
+      zip64Offset = *end - kZip64LocatorSize - kZip64EndSize;
+    }
+    if (zip64Offset > size || size - zip64Offset < kZip64EndSize ||
+        readU32(data + zip64Offset) != kZip64EndOfCentralDir) {
+      ec = malformed();
+      return std::nullopt;
+    }
+    const std::uint8_t* zip64 = data + zip64Offset;
+    entries = readU64(zip64 + 32);
+    directorySize = readU64(zip64 + 40);
+    directoryOffset = readU64(zip64 + 48);
+    directoryEnd = zip64Offset;
+  }
+  if (directorySize > directoryEnd) {
+    ec = malformed();
+    return std::nullopt;
+  }
+  // 自解压程序等在 ZIP 前附加了数据时，记录的偏移会整体偏小，此时按结束记录的位置倒推
+  if (entries > 0 && (directoryOffset > directoryEnd - directorySize ||
+                      readU32(data + directoryOffset) != kZipCentralHeader)) {
+    directoryOffset = directoryEnd - directorySize;
+  }
+  if (entries > directorySize / kZipCentralHeaderSize) {
+    ec = malformed();
+    return std::nullopt;
+  }
+
+  ArchiveListing listing;
+  listing.format = ArchiveFormat::Zip;
+  listing.entries.reserve(static_cast<std::size_t>(entries));
+  std::size_t pos = static_cast<std::size_t>(directoryOffset);
+  const std::size_t limit = static_cast<std::size_t>(directoryOffset + directorySize);
+  for (std::uint64_t i = 0; i < entries; ++i) {
+    if (limit - pos < kZipCentralHeaderSize || readU32(data + pos) != kZipCentralHeader) {
+      ec = malformed();
+      return std::nullopt;
+    }
+    const std::uint8_t* header = data + pos;
+    const std::size_t nameLength = readU16(header + 28);
+    const std::size_t extraLength = readU16(header + 30);
+    const std::size_t commentLength = readU16(header + 32);
+    const std::size_t recordLength = kZipCentralHeaderSize + nameLength + extraLength + commentLength;
+    if (limit - pos < recordLength) {
+      ec = malformed();
+      return std::nullopt;
+    }
+
+    ArchiveEntry entry;
+    entry.compressed_size = readU32(header + 20);
+    entry.uncompressed_size = readU32(header + 24);
+    const bool needUncompressed = entry.uncompressed_size == 0xFFFFFFFFu;
+    const bool needCompressed = entry.compressed_size == 0xFFFFFFFFu;
+    if (needUncompressed || needCompressed) {
+      // Zip64 扩展字段只包含溢出的值，按 解压大小 → 压缩大小 的顺序排列
+      const std::uint8_t* extra = header + kZipCentralHeaderSize + nameLength;
+      for (std::size_t e = 0; e + 4 <= extraLength;) {
+        const std::uint16_t id = readU16(extra + e);
+        const std::size_t length = readU16(extra + e + 2);
+        if (e + 4 + length > extraLength) {
+          break;
+        }
+        if (id == kZip64ExtraId) {
+          std::size_t field = e + 4;
+          if (needUncompressed && field + 8 <= e + 4 + length) {
+            entry.uncompressed_size = readU64(extra + field);
+            field += 8;
+          }
+          if (needCompressed && field + 8 <= e + 4 + length) {
+            entry.compressed_size = readU64(extra + field);
+          }
+          break;
+        }
+        e += 4 + length;
+      }
+    }
+    entry.path = normalizeEntryPath(
+        std::string(reinterpret_cast<const char*>(header + kZipCentralHeaderSize), nameLength));
+    entry.directory = !entry.path.empty() && entry.path.back() == '/';
+    if (entry.directory) {
+      entry.path.pop_back();
+    }
+    listing.entries.push_back(std::move(entry));
+    pos += recordLength;
+  }
+  return listing;
+}
+
+std::optional<ArchiveListing> inspectSevenZip(const std::uint8_t* data, std::size_t size, std::error_code& ec) {
+  ec.clear();
+  if (detectArchiveFormat(data, size) != ArchiveFormat::SevenZip || size < kSevenZipStartHeaderSize) {
+    ec = malformed();
+    return std::nullopt;
+  }
+  const std::uint64_t nextOffset = readU64(data + 12);
+  const std::uint64_t nextSize = readU64(data + 20);
+  const std::uint64_t available = size - kSevenZipStartHeaderSize;
+  if (nextOffset > available || nextSize > available - nextOffset) {
+    ec = malformed();
+    return std::nullopt;
+  }
+
+  ArchiveListing listing;
+  listing.format = ArchiveFormat::SevenZip;
+  if (nextSize == 0) {
+    return listing; // 空归档
+  }
+  SevenZipReader in(data + kSevenZipStartHeaderSize + nextOffset, static_cast<std::size_t>(nextSize));
+  const std::uint64_t headerType = in.number();
+  if (headerType == kEncodedHeader) {
+    ec = std::make_error_code(std::errc::not_supported);
+    return std::nullopt;
+  }
+  if (headerType != kHeader) {
+    ec = malformed();
+    return std::nullopt;
+  }
+
+  SevenZipStreams streams;
+  std::uint64_t id = in.number();
+  if (id == kArchiveProperties) {
+    for (std::uint64_t property = in.number(); property != kEnd && !in.failed(); property = in.number()) {
+      in.skip(in.number());
+    }
+    id = in.number();
+  }
+  if (id == kAdditionalStreamsInfo) {
+    SevenZipStreams additional;
+    if (!parseStreamsInfo(in, additional)) {
+      ec = malformed();
+      return std::nullopt;
+    }
+    id = in.number();
+  }
+  if (id == kMainStreamsInfo) {
+    if (!parseStreamsInfo(in, streams)) {
+      ec = malformed();
+      return std::nullopt;
+    }
+    id = in.number();
+  }
+  if (id == kFilesInfo) {
+    if (!parseFilesInfo(in, streams, listing)) {
+      ec = malformed();
+      return std::nullopt;
+    }
+    id = in.number();
+  }
+  if (id != kEnd || in.failed()) {
+    ec = malformed();
+    return std::nullopt;
+  }
+  return listing;
+}
+
+std::optional<ArchiveListing> inspectArchive(const std::filesystem::path& path, std::error_code& ec) {
+  MappedFile file;
+  if (!file.open(path, ec)) {
+    return std::nullopt;
+  }
+  switch (detectArchiveFormat(file.data(), file.size())) {
+    case ArchiveFormat::Zip:
+      return inspectZip(file.data(), file.size(), ec);
+    case ArchiveFormat::SevenZip:
+      return inspectSevenZip(file.data(), file.size(), ec);
+    case ArchiveFormat::Rar:
+      ec = std::make_error_code(std::errc::not_supported);
+      return std::nullopt;
+    case ArchiveFormat::Unknown:
+      break;
+  }
+  ec = malformed();
+  return std::nullopt;
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+/**
+ * @file ArchiveInspector.h
+ * @brief 在不解压的前提下列出 ZIP/7z 压缩包的内容。
+ * @details ZIP 从文件尾部定位中央目录（支持 Zip64），7z 读取文件尾部的未压缩头部；
+ *          两者都只在内存映射上访问目录所在的页，与压缩包大小无关。
+ *          7z 的头部本身被压缩（kEncodedHeader，多数 7-Zip 默认设置）时无法列出，返回 std::errc::not_supported；
+ *          RAR 同样不受支持。所有偏移与长度均经过边界检查。
+ */
+
+/// 压缩包格式。
+enum class ArchiveFormat {
+  Unknown,
+  Zip,
+  SevenZip,
+  Rar,
+};
+
+/**
+ * @brief 压缩包中的单个条目。
+ */
+struct ArchiveEntry {
+  std::string path;                   ///< 包内路径，使用 '/' 分隔（ZIP 非 UTF-8 文件名保留原始字节）
+  std::uint64_t uncompressed_size{0}; ///< 解压后大小
+  std::uint64_t compressed_size{0};   ///< 压缩后大小；7z 固实压缩无法按文件划分，为 0
+  bool directory{false};
+
+  /// 扩展名是否为 .vpk（不区分大小写）。
+  bool isVpk() const;
+};
+
+/**
+ * @brief 压缩包的目录列表。
+ */
+struct ArchiveListing {
+  ArchiveFormat format{ArchiveFormat::Unknown};
+  std::vector<ArchiveEntry> entries;
+
+  /// 包内所有 VPK 文件（忽略目录与 __MACOSX 等附带文件），按包内顺序排列。
+  std::vector<const ArchiveEntry*> vpkEntries() const;
+
+  /// 包内 VPK 的解压后总字节数，即部署到游戏目录后实际占用的大小。
+  std::uint64_t vpkUncompressedBytes() const;
+};
+
+/// 按文件头签名识别格式（至少需要 6 字节），无法识别时返回 ArchiveFormat::Unknown。
+ArchiveFormat detectArchiveFormat(const std::uint8_t* data, std::size_t size);
+
+/**
+ * @brief 解析内存中的 ZIP 中央目录。
+ * @param ec 格式错误时为 std::errc::illegal_byte_sequence。
+ */
+std::optional<ArchiveListing> inspectZip(const std::uint8_t* data, std::size_t size, std::error_code& ec);
+
+/**
+ * @brief 解析内存中的 7z 头部。
+ * @param ec 格式错误时为 std::errc::illegal_byte_sequence；头部被压缩时为 std::errc::not_supported。
+ */
+std::optional<ArchiveListing> inspectSevenZip(const std::uint8_t* data, std::size_t size, std::error_code& ec);
+
+/**
+ * @brief 映射文件并按签名选择解析器。
+ * @param ec 打开失败、格式错误或格式不受支持（RAR、压缩头部的 7z）的原因。
+ */
+std::optional<ArchiveListing> inspectArchive(const std::filesystem::path& path, std::error_code& ec);
@@ -131,6 +131,7 @@ Settings Settings::loadOrCreate() {
       // New settings
       settings.gameDirectory = j.value("gameDirectory", "");
       settings.importAction = stringToImportAction(j.value("importAction", "Cut"));
+      settings.contentAddressedStore = j.value("contentAddressedStore", false);
       settings.addonsAutoImportEnabled = j.value("addonsAutoImportEnabled", false);
       settings.addonsAutoImportMethod = stringToAddonsAutoImportMethod(j.value("addonsAutoImportMethod", "Copy"));
       settings.combinerMemoryWarningMb = j.value("combinerMemoryWarningMb", 2048); // Default
@@ -145,6 +146,7 @@ Settings Settings::loadOrCreate() {
       settings.repoDbPath = defaultDbPath.string();
       settings.gameDirectory = "";
       settings.importAction = ImportAction::Cut;
+      settings.contentAddressedStore = false;
       settings.addonsAutoImportEnabled = false;
       settings.addonsAutoImportMethod = AddonsAutoImportMethod::Copy;
       settings.combinerMemoryWarningMb = 2048; // Default
@@ -161,6 +163,7 @@ Settings Settings::loadOrCreate() {
     settings.repoDbPath = defaultDbPath.string();
     settings.gameDirectory = "";
     settings.importAction = ImportAction::Cut;
+    settings.contentAddressedStore = false;
     settings.addonsAutoImportEnabled = false;
     settings.addonsAutoImportMethod = AddonsAutoImportMethod::Copy;
     settings.combinerMemoryWarningMb = 2048; // Default
@@ -181,6 +184,7 @@ void Settings::save() const {
   j["addonsPath"] = addonsPath;
   j["workshopPath"] = workshopPath;
   j["importAction"] = importActionToString(importAction);
+  j["contentAddressedStore"] = contentAddressedStore;
   j["addonsAutoImportEnabled"] = addonsAutoImportEnabled;
   j["addonsAutoImportMethod"] = addonsAutoImportMethodToString(addonsAutoImportMethod);
   j["combinerMemoryWarningMb"] = combinerMemoryWarningMb;
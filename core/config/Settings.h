@@ -10,7 +10,7 @@
 enum class ImportAction {
   Cut,  ///< 剪切文件（移动）。
   Copy, ///< 复制文件。
-  Link  ///< 创建符号链接。
+  Link  ///< 链接文件：优先 reflink，其次硬链接、符号链接，最后复制。
 };
 
 /**
@@ -43,6 +43,11 @@ struct Settings {
   std::string workshopPath;
 
   ImportAction importAction{ImportAction::Cut}; ///< 默认导入操作。
+  /**
+   * @brief 是否按内容寻址存放导入的 MOD 文件（repoDir/objects/ab/cdef…）。
+   * @details 相同内容只保存一份，并在 repoDir/by-name 下保留原文件名索引；关闭时沿用按原文件名存放的布局。
+   */
+  bool contentAddressedStore{false};
   bool addonsAutoImportEnabled{false}; ///< 是否启用 addons 目录自动导入。
   AddonsAutoImportMethod addonsAutoImportMethod{AddonsAutoImportMethod::Copy}; ///< addons 目录自动导入方式。
   int combinerMemoryWarningMb{2048}; ///< MOD 合并器内存警告阈值（MB）。
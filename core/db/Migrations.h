@@ -565,6 +565,182 @@ inline void applyMigration2(Db& db) {
   tx.commit();
 }
 
+/**
+ * @brief 应用版本 3 的数据库迁移：新增 MOD 内容指纹表，并为游戏目录缓存记录指纹。
+ * @param db 数据库连接。
+ */
+inline void applyMigration3(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    CREATE TABLE IF NOT EXISTS mod_fingerprints (
+      mod_id INTEGER PRIMARY KEY REFERENCES mods(id) ON DELETE CASCADE,
+      size_bytes INTEGER NOT NULL,
+      head_tail_hash INTEGER NOT NULL,
+      updated_at TEXT NOT NULL DEFAULT (datetime('now'))
+    );
+    CREATE INDEX IF NOT EXISTS idx_mod_fingerprints_key ON mod_fingerprints(size_bytes, head_tail_hash);
+
+    ALTER TABLE gamemods ADD COLUMN fingerprint INTEGER;
+  )SQL");
+  updateSchemaVersion(db, 3);
+  tx.commit();
+}
+
+/**
+ * @brief 迁移4：记录 MOD 文件在仓库中的存放方式（storage_method：move/copy/reflink/hardlink/symlink，空表示未知）。
+ * @param db 数据库连接。
+ */
+inline void applyMigration4(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    ALTER TABLE mods ADD COLUMN storage_method TEXT;
+  )SQL");
+  updateSchemaVersion(db, 4);
+  tx.commit();
+}
+
+/**
+ * @brief 迁移5：记录文件哈希所用算法，早期的 SHA-256 哈希（hash_algo 为空）与新的 BLAKE3 哈希并存。
+ * @param db 数据库连接。
+ */
+inline void applyMigration5(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    ALTER TABLE mods ADD COLUMN hash_algo TEXT;
+  )SQL");
+  updateSchemaVersion(db, 5);
+  tx.commit();
+}
+
+/**
+ * @brief 迁移6：新增导入日志表，记录批量导入中每个文件所处的阶段，用于中断后续传。
+ * @param db 数据库连接。
+ */
+inline void applyMigration6(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    CREATE TABLE IF NOT EXISTS import_jobs (
+      id INTEGER PRIMARY KEY AUTOINCREMENT,
+      source_dir TEXT NOT NULL,
+      recursive INTEGER NOT NULL DEFAULT 1,
+      action TEXT,
+      status TEXT NOT NULL DEFAULT 'running',
+      created_at TEXT NOT NULL DEFAULT (datetime('now')),
+      updated_at TEXT NOT NULL DEFAULT (datetime('now'))
+    );
+    CREATE INDEX IF NOT EXISTS idx_import_jobs_source ON import_jobs(source_dir, status);
+
+    CREATE TABLE IF NOT EXISTS import_journal (
+      job_id INTEGER NOT NULL REFERENCES import_jobs(id) ON DELETE CASCADE,
+      source_path TEXT NOT NULL,
+      size_bytes INTEGER NOT NULL,
+      modified_at INTEGER NOT NULL,
+      stage TEXT NOT NULL,
+      file_hash TEXT,
+      hash_algo TEXT,
+      head_tail_hash INTEGER,
+      mod_name TEXT,
+      target_path TEXT,
+      cover_path TEXT,
+      storage_method TEXT,
+      mod_id INTEGER,
+      error TEXT,
+      updated_at TEXT NOT NULL DEFAULT (datetime('now')),
+      PRIMARY KEY(job_id, source_path)
+    );
+  )SQL");
+  updateSchemaVersion(db, 6);
+  tx.commit();
+}
+
+/**
+ * @brief 迁移7：新增 VPK 资源路径索引，用于自动检测覆盖同一资源的冲突 MOD。
+ * @details asset_paths 为去重后的路径表；mod_assets 记录每个 MOD 包含的路径，按 path_id 建立倒排索引；
+ *          mod_asset_scans 记录索引时的文件哈希，文件变化后才需要重新扫描。
+ * @param db 数据库连接。
+ */
+inline void applyMigration7(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    CREATE TABLE IF NOT EXISTS asset_paths (
+      id INTEGER PRIMARY KEY,
+      path TEXT NOT NULL UNIQUE
+    );
+
+    CREATE TABLE IF NOT EXISTS mod_assets (
+      mod_id INTEGER NOT NULL REFERENCES mods(id) ON DELETE CASCADE,
+      path_id INTEGER NOT NULL REFERENCES asset_paths(id),
+      PRIMARY KEY(mod_id, path_id)
+    ) WITHOUT ROWID;
+    CREATE INDEX IF NOT EXISTS idx_mod_assets_path ON mod_assets(path_id);
+
+    CREATE TABLE IF NOT EXISTS mod_asset_scans (
+      mod_id INTEGER PRIMARY KEY REFERENCES mods(id) ON DELETE CASCADE,
+      file_hash TEXT,
+      path_count INTEGER NOT NULL DEFAULT 0,
+      scanned_at TEXT NOT NULL DEFAULT (datetime('now'))
+    );
+  )SQL");
+  updateSchemaVersion(db, 7);
+  tx.commit();
+}
+
+/**
+ * @brief 迁移8：记录从多 VPK 压缩包拆分出的条目对应的包内路径，同一压缩包可对应多条 MOD 记录。
+ * @param db 数据库连接。
+ */
+inline void applyMigration8(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    ALTER TABLE mods ADD COLUMN archive_member TEXT;
+  )SQL");
+  updateSchemaVersion(db, 8);
+  tx.commit();
+}
+
+/**
+ * @brief 迁移9：记录 MOD 目录的变更计数与数据库标识，供目录快照判断是否过期。
+ * @details mods、mod_tags、tags、tag_groups 的每次写入都通过触发器递增 app_meta.catalog_version；
+ *          catalog_id 为建库时生成的随机值，区分不同的数据库文件。
+ * @param db 数据库连接。
+ */
+inline void applyMigration9(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    INSERT OR IGNORE INTO app_meta(key, value) VALUES ('catalog_version', '0');
+    INSERT OR IGNORE INTO app_meta(key, value) VALUES ('catalog_id', lower(hex(randomblob(8))));
+  )SQL");
+  for (const char* table : {"mods", "mod_tags", "tags", "tag_groups"}) {
+    for (const char* event : {"INSERT", "UPDATE", "DELETE"}) {
+      db.exec(std::string("CREATE TRIGGER IF NOT EXISTS trg_catalog_") + table + "_" + event + " AFTER " + event +
+              " ON " + table +
+              " BEGIN UPDATE app_meta SET value = CAST(value AS INTEGER) + 1 WHERE key = 'catalog_version'; END;");
+    }
+  }
+  updateSchemaVersion(db, 9);
+  tx.commit();
+}
+
+/**
+ * @brief 迁移10：为按名称与 id 排序的键集分页以及分类、作者、评分、标签筛选建立索引。
+ * @details 名称按 NOCASE 排序，名称前缀筛选对 ASCII 字母不区分大小写，且仍可按索引范围查找；
+ *          各索引末尾附带 is_deleted，隐藏已删除 MOD 时计数与 OFFSET 定位只读索引、不回表，
+ *          包含已删除 MOD 的查询也使用同一组索引。
+ * @param db 数据库连接。
+ */
+inline void applyMigration10(Db& db) {
+  Db::Tx tx(db);
+  db.exec(R"SQL(
+    CREATE INDEX IF NOT EXISTS idx_mods_name ON mods(name COLLATE NOCASE, id, is_deleted);
+    CREATE INDEX IF NOT EXISTS idx_mods_category ON mods(category_id, name COLLATE NOCASE, id, is_deleted);
+    CREATE INDEX IF NOT EXISTS idx_mods_author ON mods(author, name COLLATE NOCASE, id, is_deleted);
+    CREATE INDEX IF NOT EXISTS idx_mods_rating ON mods(rating, name COLLATE NOCASE, id, is_deleted);
+    CREATE INDEX IF NOT EXISTS idx_mod_tags_tag ON mod_tags(tag_id, mod_id);
+  )SQL");
+  updateSchemaVersion(db, 10);
+  tx.commit();
+}
+
 } // namespace migrations
 
 /**
@@ -580,5 +756,37 @@ inline void runMigrations(Db& db) {
   }
   if (current < 2) {
     migrations::applyMigration2(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 3) {
+    migrations::applyMigration3(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 4) {
+    migrations::applyMigration4(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 5) {
+    migrations::applyMigration5(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 6) {
+    migrations::applyMigration6(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 7) {
+    migrations::applyMigration7(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 8) {
+    migrations::applyMigration8(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 9) {
+    migrations::applyMigration9(db);
+    current = migrations::currentSchemaVersion(db);
+  }
+  if (current < 10) {
+    migrations::applyMigration10(db);
   }
 }
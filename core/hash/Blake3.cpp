@@ -0,0 +1,300 @@
+#include "core/hash/Blake3.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/**
+ * @file Blake3.cpp
+ * @brief BLAKE3 哈希的实现（按规范的参考实现编写，压缩函数交由编译器自动向量化）。
+ */
+
+namespace {
+
+constexpr std::uint32_t kIv[8] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                                  0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+constexpr unsigned kMsgPermutation[16] = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+
+constexpr std::uint32_t kChunkStart = 1u << 0;
+constexpr std::uint32_t kChunkEnd = 1u << 1;
+constexpr std::uint32_t kParent = 1u << 2;
+constexpr std::uint32_t kRoot = 1u << 3;
+
+// 并行计算时每个任务处理的块数（1 MiB），必须是 2 的幂以保证子树在树中对齐
+constexpr std::size_t kParallelSubtreeChunks = 1024;
+
+inline std::uint32_t rotr(std::uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+inline std::uint32_t load32(const std::uint8_t* p) {
+  return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline void g(std::uint32_t* s, int a, int b, int c, int d, std::uint32_t mx, std::uint32_t my) {
+  s[a] = s[a] + s[b] + mx;
+  s[d] = rotr(s[d] ^ s[a], 16);
+  s[c] = s[c] + s[d];
+  s[b] = rotr(s[b] ^ s[c], 12);
+  s[a] = s[a] + s[b] + my;
+  s[d] = rotr(s[d] ^ s[a], 8);
+  s[c] = s[c] + s[d];
+  s[b] = rotr(s[b] ^ s[c], 7);
+}
+
+void compress(const std::uint32_t cv[8], const std::uint32_t blockWords[16], std::uint64_t counter,
+              std::uint32_t blockLen, std::uint32_t flags, std::uint32_t out[16]) {
+  std::uint32_t s[16] = {cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+                         kIv[0], kIv[1], kIv[2], kIv[3],
+                         static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32),
+                         blockLen, flags};
+  std::uint32_t m[16];
+  std::memcpy(m, blockWords, sizeof(m));
+  for (int round = 0; round < 7; ++round) {
+    g(s, 0, 4, 8, 12, m[0], m[1]);
+    g(s, 1, 5, 9, 13, m[2], m[3]);
+    g(s, 2, 6, 10, 14, m[4], m[5]);
+    g(s, 3, 7, 11, 15, m[6], m[7]);
+    g(s, 0, 5, 10, 15, m[8], m[9]);
+    g(s, 1, 6, 11, 12, m[10], m[11]);
+    g(s, 2, 7, 8, 13, m[12], m[13]);
+    g(s, 3, 4, 9, 14, m[14], m[15]);
+    if (round < 6) {
+      std::uint32_t permuted[16];
+      for (int i = 0; i < 16; ++i) {
+        permuted[i] = m[kMsgPermutation[i]];
+      }
+      std::memcpy(m, permuted, sizeof(m));
+    }
+  }
+  for (int i = 0; i < 8; ++i) {
+    out[i] = s[i] ^ s[i + 8];
+    out[i + 8] = s[i + 8] ^ cv[i];
+  }
+}
+
+void wordsFromBytes(const std::uint8_t* bytes, std::uint32_t words[16]) {
+  for (int i = 0; i < 16; ++i) {
+    words[i] = load32(bytes + 4 * i);
+  }
+}
+
+// 一次压缩的全部输入；根节点需要以 ROOT 标志重新压缩，因此延迟到确定是否为根时再计算
+struct Output {
+  std::uint32_t inputCv[8];
+  std::uint32_t blockWords[16];
+  std::uint64_t counter;
+  std::uint32_t blockLen;
+  std::uint32_t flags;
+
+  void chainingValue(std::uint32_t cv[8]) const {
+    std::uint32_t out[16];
+    compress(inputCv, blockWords, counter, blockLen, flags, out);
+    std::memcpy(cv, out, 8 * sizeof(std::uint32_t));
+  }
+
+  Blake3::Digest rootDigest() const {
+    std::uint32_t out[16];
+    compress(inputCv, blockWords, 0, blockLen, flags | kRoot, out);
+    Blake3::Digest digest{};
+    for (std::size_t i = 0; i < 8; ++i) {
+      digest[4 * i] = static_cast<std::uint8_t>(out[i]);
+      digest[4 * i + 1] = static_cast<std::uint8_t>(out[i] >> 8);
+      digest[4 * i + 2] = static_cast<std::uint8_t>(out[i] >> 16);
+      digest[4 * i + 3] = static_cast<std::uint8_t>(out[i] >> 24);
+    }
+    return digest;
+  }
+};
+
+Output parentOutput(const std::uint32_t left[8], const std::uint32_t right[8]) {
+  Output output{};
+  std::memcpy(output.inputCv, kIv, sizeof(output.inputCv));
+  std::memcpy(output.blockWords, left, 8 * sizeof(std::uint32_t));
+  std::memcpy(output.blockWords + 8, right, 8 * sizeof(std::uint32_t));
+  output.counter = 0;
+  output.blockLen = Blake3::kBlockLen;
+  output.flags = kParent;
+  return output;
+}
+
+// 计算一个完整 1 KiB 块（非根）的链接值
+void fullChunkCv(const std::uint8_t* chunk, std::uint64_t counter, std::uint32_t cv[8]) {
+  std::memcpy(cv, kIv, sizeof(kIv));
+  constexpr std::size_t blocks = Blake3::kChunkLen / Blake3::kBlockLen;
+  std::uint32_t words[16];
+  std::uint32_t out[16];
+  for (std::size_t b = 0; b < blocks; ++b) {
+    std::uint32_t flags = 0;
+    if (b == 0) {
+      flags |= kChunkStart;
+    }
+    if (b == blocks - 1) {
+      flags |= kChunkEnd;
+    }
+    wordsFromBytes(chunk + b * Blake3::kBlockLen, words);
+    compress(cv, words, counter, Blake3::kBlockLen, flags, out);
+    std::memcpy(cv, out, 8 * sizeof(std::uint32_t));
+  }
+}
+
+// 计算 chunkCount（2 的幂）个完整块组成的对齐子树的链接值
+void subtreeCv(const std::uint8_t* data, std::size_t chunkCount, std::uint64_t firstCounter, std::uint32_t cv[8]) {
+  std::uint32_t stack[32][8];
+  std::size_t depth = 0;
+  for (std::size_t i = 0; i < chunkCount; ++i) {
+    std::uint32_t current[8];
+    fullChunkCv(data + i * Blake3::kChunkLen, firstCounter + i, current);
+    for (std::size_t total = i + 1; (total & 1) == 0; total >>= 1) {
+      parentOutput(stack[--depth], current).chainingValue(current);
+    }
+    std::memcpy(stack[depth++], current, sizeof(current));
+  }
+  std::memcpy(cv, stack[0], 8 * sizeof(std::uint32_t));
+}
+
+} // namespace
+
+void Blake3::reset() {
+  std::memcpy(chunkCv_, kIv, sizeof(chunkCv_));
+  chunkCounter_ = 0;
+  std::memset(block_, 0, sizeof(block_));
+  blockLen_ = 0;
+  blocksCompressed_ = 0;
+  cvStackSize_ = 0;
+}
+
+void Blake3::pushChunkCv(const std::uint32_t cv[8], std::uint64_t totalChunks) {
+  std::uint32_t current[8];
+  std::memcpy(current, cv, sizeof(current));
+  // 每完成一个子树（totalChunks 的低位为 0）就与栈顶合并为父节点
+  while ((totalChunks & 1) == 0) {
+    parentOutput(cvStack_[--cvStackSize_], current).chainingValue(current);
+    totalChunks >>= 1;
+  }
+  std::memcpy(cvStack_[cvStackSize_++], current, sizeof(current));
+}
+
+void Blake3::update(const void* data, std::size_t length) {
+  const auto* input = static_cast<const std::uint8_t*>(data);
+  while (length > 0) {
+    // 当前块已满且还有后续数据，说明它不是最后一块，可以结束并压入栈
+    if (kBlockLen * blocksCompressed_ + blockLen_ == kChunkLen) {
+      std::uint32_t words[16];
+      std::uint32_t out[16];
+      wordsFromBytes(block_, words);
+      compress(chunkCv_, words, chunkCounter_, static_cast<std::uint32_t>(blockLen_), kChunkEnd, out);
+      pushChunkCv(out, chunkCounter_ + 1);
+      std::memcpy(chunkCv_, kIv, sizeof(chunkCv_));
+      ++chunkCounter_;
+      std::memset(block_, 0, sizeof(block_));
+      blockLen_ = 0;
+      blocksCompressed_ = 0;
+    }
+
+    // 整块对齐且剩余数据超过一块时直接计算，跳过缓冲区拷贝
+    if (blockLen_ == 0 && blocksCompressed_ == 0 && length > kChunkLen) {
+      std::uint32_t cv[8];
+      fullChunkCv(input, chunkCounter_, cv);
+      pushChunkCv(cv, chunkCounter_ + 1);
+      ++chunkCounter_;
+      input += kChunkLen;
+      length -= kChunkLen;
+      continue;
+    }
+
+    if (blockLen_ == kBlockLen) {
+      std::uint32_t words[16];
+      std::uint32_t out[16];
+      wordsFromBytes(block_, words);
+      compress(chunkCv_, words, chunkCounter_, kBlockLen, blocksCompressed_ == 0 ? kChunkStart : 0, out);
+      std::memcpy(chunkCv_, out, sizeof(chunkCv_));
+      ++blocksCompressed_;
+      std::memset(block_, 0, sizeof(block_));
+      blockLen_ = 0;
+    }
+
+    const std::size_t take = std::min(kBlockLen - blockLen_, length);
+    std::memcpy(block_ + blockLen_, input, take);
+    blockLen_ += take;
+    input += take;
+    length -= take;
+  }
+}
+
+Blake3::Digest Blake3::digest() const {
+  Output output{};
+  std::memcpy(output.inputCv, chunkCv_, sizeof(output.inputCv));
+  wordsFromBytes(block_, output.blockWords);
+  output.counter = chunkCounter_;
+  output.blockLen = static_cast<std::uint32_t>(blockLen_);
+  output.flags = kChunkEnd | (blocksCompressed_ == 0 ? kChunkStart : 0);
+
+  // 自栈顶向下依次合并，最后一次压缩带 ROOT 标志
+  for (std::size_t i = cvStackSize_; i > 0; --i) {
+    std::uint32_t right[8];
+    output.chainingValue(right);
+    output = parentOutput(cvStack_[i - 1], right);
+  }
+  return output.rootDigest();
+}
+
+Blake3::Digest Blake3::hash(const void* data, std::size_t length) {
+  Blake3 hasher;
+  hasher.update(data, length);
+  return hasher.digest();
+}
+
+Blake3::Digest Blake3::hashParallel(const void* data, std::size_t length, int threads) {
+  const auto* input = static_cast<const std::uint8_t*>(data);
+  const std::size_t subtreeBytes = kParallelSubtreeChunks * kChunkLen;
+  // 最后一块必须留给 digest() 以便带上 ROOT 标志，因此只有严格多于两个子树时才值得并行
+  if (threads <= 1 || length <= 2 * subtreeBytes) {
+    return hash(data, length);
+  }
+
+  const std::size_t subtrees = (length - 1) / subtreeBytes;
+  std::vector<std::array<std::uint32_t, 8>> cvs(subtrees);
+  std::atomic<std::size_t> next{0};
+  const auto worker = [&]() {
+    for (;;) {
+      const std::size_t index = next.fetch_add(1);
+      if (index >= subtrees) {
+        return;
+      }
+      subtreeCv(input + index * subtreeBytes, kParallelSubtreeChunks,
+                static_cast<std::uint64_t>(index) * kParallelSubtreeChunks, cvs[index].data());
+    }
+  };
+  const std::size_t threadCount = std::min<std::size_t>(static_cast<std::size_t>(threads), subtrees);
+  std::vector<std::thread> pool;
+  pool.reserve(threadCount - 1);
+  for (std::size_t t = 1; t < threadCount; ++t) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : pool) {
+    thread.join();
+  }
+
+  // 子树链接值按出现顺序并入栈：每个子树相当于低位全零的一组块
+  Blake3 hasher;
+  for (std::size_t index = 0; index < subtrees; ++index) {
+    std::uint32_t current[8];
+    std::memcpy(current, cvs[index].data(), sizeof(current));
+    std::uint64_t total = static_cast<std::uint64_t>(index) + 1;
+    while ((total & 1) == 0) {
+      parentOutput(hasher.cvStack_[--hasher.cvStackSize_], current).chainingValue(current);
+      total >>= 1;
+    }
+    std::memcpy(hasher.cvStack_[hasher.cvStackSize_++], current, sizeof(current));
+  }
+  hasher.chunkCounter_ = static_cast<std::uint64_t>(subtrees) * kParallelSubtreeChunks;
+  const std::size_t consumed = subtrees * subtreeBytes;
+  hasher.update(input + consumed, length - consumed);
+  return hasher.digest();
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file Blake3.h
+ * @brief BLAKE3 哈希的可移植实现，用于 MOD 文件的全量哈希。
+ * @details BLAKE3 将输入切分为 1 KiB 的块并组织成二叉树，互不相关的子树可以并行计算。
+ *          hashParallel() 把整段内存按对齐的 2 的幂子树分配给多个线程，结果与顺序计算完全一致。
+ */
+
+/**
+ * @brief BLAKE3 流式哈希器（默认 32 字节输出，无密钥模式）。
+ * @details 可多次调用 update() 追加数据，最后调用 digest() 获取结果；digest() 不会改变内部状态。
+ */
+class Blake3 {
+public:
+  static constexpr std::size_t kOutLen = 32;     ///< 输出长度（字节）
+  static constexpr std::size_t kBlockLen = 64;   ///< 压缩函数的分组长度（字节）
+  static constexpr std::size_t kChunkLen = 1024; ///< 树的叶子块长度（字节）
+
+  using Digest = std::array<std::uint8_t, kOutLen>;
+
+  Blake3() { reset(); }
+
+  /** @brief 重置内部状态，以便复用同一对象。 */
+  void reset();
+
+  /**
+   * @brief 追加一段数据。
+   * @param data 数据起始地址。
+   * @param length 数据长度（字节）。
+   */
+  void update(const void* data, std::size_t length);
+
+  /** @brief 计算当前已追加数据的哈希值。 */
+  Digest digest() const;
+
+  /**
+   * @brief 一次性计算整段数据的哈希值。
+   */
+  static Digest hash(const void* data, std::size_t length);
+
+  /**
+   * @brief 使用多个线程计算整段数据的哈希值，适合内存映射后的大文件。
+   * @param threads 线程数，小于等于 1 或数据较小时退化为顺序计算。
+   */
+  static Digest hashParallel(const void* data, std::size_t length, int threads);
+
+private:
+  void pushChunkCv(const std::uint32_t cv[8], std::uint64_t totalChunks);
+
+  // 当前未完成的块
+  std::uint32_t chunkCv_[8]{};
+  std::uint64_t chunkCounter_{0};
+  std::uint8_t block_[kBlockLen]{};
+  std::size_t blockLen_{0};
+  std::size_t blocksCompressed_{0};
+
+  // 已完成子树的链接值栈；2^54 个块已超出 64 位长度可表示的范围
+  std::uint32_t cvStack_[54][8]{};
+  std::size_t cvStackSize_{0};
+};
@@ -0,0 +1,271 @@
+#include "core/hash/DuplicateDetector.h"
+
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @file DuplicateDetector.cpp
+ * @brief 按大小分桶、指纹初筛、全量哈希确认的重复检测实现。
+ */
+
+namespace {
+
+bool isCancelled(const std::atomic<bool>* cancelled) {
+  return cancelled && cancelled->load();
+}
+
+// 以 workers 个线程并行执行 fn(0..count-1)，调用线程也参与计算
+template <typename Fn>
+void parallelFor(std::size_t count, int workers, const std::atomic<bool>* cancelled, Fn&& fn) {
+  if (count == 0) {
+    return;
+  }
+  const std::size_t threadCount = std::min<std::size_t>(static_cast<std::size_t>(std::max(1, workers)), count);
+  std::atomic<std::size_t> next{0};
+  const auto run = [&]() {
+    while (!isCancelled(cancelled)) {
+      const std::size_t index = next.fetch_add(1);
+      if (index >= count) {
+        return;
+      }
+      fn(index);
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1);
+  for (std::size_t t = 1; t < threadCount; ++t) {
+    threads.emplace_back(run);
+  }
+  run();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+struct Group {
+  std::vector<std::size_t> batch; ///< 本批中的文件下标（升序）
+  std::vector<std::size_t> known; ///< known_ 中的下标
+};
+
+} // namespace
+
+DuplicateDetector::DuplicateDetector(std::vector<KnownFile> known, FullHashFn fullHash, FullHashFn legacyHash)
+    : known_(std::move(known)), fullHash_(std::move(fullHash)), legacyHash_(std::move(legacyHash)) {}
+
+std::vector<DuplicateDecision> DuplicateDetector::resolve(const std::vector<std::filesystem::path>& paths,
+                                                          const std::vector<std::uint64_t>& sizes,
+                                                          int workers,
+                                                          const std::atomic<bool>* cancelled) {
+  const std::size_t count = std::min(paths.size(), sizes.size());
+  std::vector<DuplicateDecision> decisions(count);
+  std::atomic<std::uint64_t> bytes{0};
+
+  // 1. 按大小分桶，只有与仓库或本批其它文件同大小的文件才需要读取内容
+  // 只有近似大小的早期记录单独按大小范围匹配，只能以早期算法的哈希比较
+  std::unordered_map<std::uint64_t, std::vector<std::size_t>> knownBySize;
+  std::multimap<std::uint64_t, std::size_t> approximateBySize;
+  std::uint64_t maxSlack = 0;
+  for (std::size_t k = 0; k < known_.size(); ++k) {
+    const KnownFile& file = known_[k];
+    if (file.size_slack_bytes == 0) {
+      knownBySize[file.size_bytes].push_back(k);
+    } else if (legacyHash_ && !file.legacy_hash.empty()) {
+      approximateBySize.emplace(file.size_bytes, k);
+      maxSlack = std::max(maxSlack, file.size_slack_bytes);
+    }
+  }
+  std::unordered_map<std::uint64_t, std::vector<std::size_t>> batchBySize;
+  for (std::size_t i = 0; i < count; ++i) {
+    batchBySize[sizes[i]].push_back(i);
+  }
+  // 待导入文件 i 可能对应的近似大小记录
+  const auto approximateMatches = [&](std::size_t i) {
+    std::vector<std::size_t> matches;
+    const std::uint64_t size = sizes[i];
+    const auto end = approximateBySize.upper_bound(size + maxSlack);
+    for (auto it = approximateBySize.lower_bound(size > maxSlack ? size - maxSlack : 0); it != end; ++it) {
+      const KnownFile& file = known_[it->second];
+      const std::uint64_t distance = size > file.size_bytes ? size - file.size_bytes : file.size_bytes - size;
+      if (distance <= file.size_slack_bytes) {
+        matches.push_back(it->second);
+      }
+    }
+    return matches;
+  };
+  std::vector<char> needsLegacyHash(count, 0);
+  std::vector<std::size_t> approximateCandidates;
+  if (!approximateBySize.empty()) {
+    for (std::size_t i = 0; i < count; ++i) {
+      if (!approximateMatches(i).empty()) {
+        needsLegacyHash[i] = 1;
+        approximateCandidates.push_back(i);
+      }
+    }
+  }
+
+  std::vector<std::size_t> colliding;
+  std::vector<std::size_t> knownNeedingFingerprint;
+  for (const auto& [size, members] : batchBySize) {
+    const auto knownIt = knownBySize.find(size);
+    if (members.size() < 2 && knownIt == knownBySize.end()) {
+      continue;
+    }
+    colliding.insert(colliding.end(), members.begin(), members.end());
+    if (knownIt != knownBySize.end()) {
+      for (std::size_t k : knownIt->second) {
+        if (!known_[k].head_tail_hash) {
+          knownNeedingFingerprint.push_back(k);
+        }
+      }
+    }
+  }
+  std::sort(colliding.begin(), colliding.end());
+
+  // 2. 计算首尾指纹（部分哈希）
+  parallelFor(colliding.size(), workers, cancelled, [&](std::size_t n) {
+    const std::size_t i = colliding[n];
+    decisions[i].fingerprint = computeFileFingerprint(paths[i]);
+    bytes += std::min<std::uint64_t>(sizes[i], 2 * kFingerprintWindowBytes);
+  });
+  parallelFor(knownNeedingFingerprint.size(), workers, cancelled, [&](std::size_t n) {
+    KnownFile& file = known_[knownNeedingFingerprint[n]];
+    const auto fingerprint = computeFileFingerprint(file.path);
+    if (fingerprint && fingerprint->size_bytes == file.size_bytes) {
+      file.head_tail_hash = fingerprint->head_tail_hash;
+      bytes += std::min<std::uint64_t>(file.size_bytes, 2 * kFingerprintWindowBytes);
+    }
+  });
+  if (isCancelled(cancelled)) {
+    bytesHashed_ = bytes;
+    return decisions;
+  }
+
+  // 3. 按（大小, 指纹）分组，指纹仍冲突的组才做全量哈希
+  std::map<std::pair<std::uint64_t, std::uint64_t>, Group> groups;
+  for (std::size_t i : colliding) {
+    if (!decisions[i].fingerprint) {
+      decisions[i].kind = DuplicateDecision::Kind::Distinct; // 读取失败，交由后续阶段报告
+      continue;
+    }
+    groups[{sizes[i], decisions[i].fingerprint->head_tail_hash}].batch.push_back(i);
+  }
+  for (std::size_t k = 0; k < known_.size(); ++k) {
+    if (!known_[k].head_tail_hash) {
+      continue;
+    }
+    const auto it = groups.find({known_[k].size_bytes, *known_[k].head_tail_hash});
+    if (it != groups.end()) {
+      it->second.known.push_back(k);
+    }
+  }
+
+  std::vector<std::size_t> batchNeedingFullHash;
+  std::vector<std::size_t> knownNeedingFullHash;
+  for (auto& [key, group] : groups) {
+    if (group.batch.size() + group.known.size() < 2) {
+      continue;
+    }
+    batchNeedingFullHash.insert(batchNeedingFullHash.end(), group.batch.begin(), group.batch.end());
+    bool needsLegacy = false;
+    for (std::size_t k : group.known) {
+      if (!known_[k].full_hash.empty()) {
+        continue;
+      }
+      if (legacyHash_ && !known_[k].legacy_hash.empty()) {
+        needsLegacy = true; // 按早期算法计算本组待导入文件，不必读取仓库文件
+      } else {
+        knownNeedingFullHash.push_back(k);
+      }
+    }
+    if (needsLegacy) {
+      for (std::size_t i : group.batch) {
+        needsLegacyHash[i] = 1;
+      }
+    }
+  }
+  std::vector<std::size_t> batchNeedingLegacyHash;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (needsLegacyHash[i]) {
+      batchNeedingLegacyHash.push_back(i);
+    }
+  }
+  parallelFor(batchNeedingFullHash.size(), workers, cancelled, [&](std::size_t n) {
+    const std::size_t i = batchNeedingFullHash[n];
+    decisions[i].full_hash = fullHash_(paths[i]);
+    bytes += sizes[i];
+  });
+  std::vector<std::string> legacyHashes(count);
+  parallelFor(batchNeedingLegacyHash.size(), workers, cancelled, [&](std::size_t n) {
+    const std::size_t i = batchNeedingLegacyHash[n];
+    legacyHashes[i] = legacyHash_(paths[i]);
+    bytes += sizes[i];
+  });
+  parallelFor(knownNeedingFullHash.size(), workers, cancelled, [&](std::size_t n) {
+    KnownFile& file = known_[knownNeedingFullHash[n]];
+    file.full_hash = fullHash_(file.path);
+    bytes += file.size_bytes;
+  });
+  bytesHashed_ = bytes;
+  if (isCancelled(cancelled)) {
+    return decisions;
+  }
+
+  // 4. 按本批顺序判定：先与仓库比较，再与本批中更早出现的文件比较
+  for (auto& [key, group] : groups) {
+    std::unordered_map<std::string, int> knownByHash;
+    std::unordered_map<std::string, int> knownByLegacyHash;
+    for (std::size_t k : group.known) {
+      if (!known_[k].full_hash.empty()) {
+        knownByHash.emplace(known_[k].full_hash, known_[k].id);
+      } else if (!known_[k].legacy_hash.empty()) {
+        knownByLegacyHash.emplace(known_[k].legacy_hash, known_[k].id);
+      }
+    }
+    std::unordered_map<std::string, std::size_t> firstInBatch;
+    for (std::size_t i : group.batch) {
+      DuplicateDecision& decision = decisions[i];
+      decision.kind = DuplicateDecision::Kind::Distinct;
+      if (decision.full_hash.empty()) {
+        continue;
+      }
+      if (const auto it = knownByHash.find(decision.full_hash); it != knownByHash.end()) {
+        decision.kind = DuplicateDecision::Kind::DuplicateOfKnown;
+        decision.known_id = it->second;
+      } else if (const auto legacy = knownByLegacyHash.find(legacyHashes[i]);
+                 !legacyHashes[i].empty() && legacy != knownByLegacyHash.end()) {
+        decision.kind = DuplicateDecision::Kind::DuplicateOfKnown;
+        decision.known_id = legacy->second;
+      } else if (const auto first = firstInBatch.find(decision.full_hash); first != firstInBatch.end()) {
+        decision.kind = DuplicateDecision::Kind::DuplicateInBatch;
+        decision.batch_index = first->second;
+      } else {
+        firstInBatch.emplace(decision.full_hash, i);
+      }
+    }
+  }
+
+  // 5. 与只有近似大小的早期记录比较；仓库中的重复优先于本批中的重复
+  for (std::size_t i : approximateCandidates) {
+    DuplicateDecision& decision = decisions[i];
+    if (decision.kind == DuplicateDecision::Kind::DuplicateOfKnown) {
+      continue;
+    }
+    if (decision.kind == DuplicateDecision::Kind::Unique) {
+      decision.kind = DuplicateDecision::Kind::Distinct; // 已读取内容
+    }
+    if (legacyHashes[i].empty()) {
+      continue;
+    }
+    for (std::size_t k : approximateMatches(i)) {
+      if (known_[k].legacy_hash == legacyHashes[i]) {
+        decision.kind = DuplicateDecision::Kind::DuplicateOfKnown;
+        decision.known_id = known_[k].id;
+        break;
+      }
+    }
+  }
+  return decisions;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/hash/Fingerprint.h"
+
+/**
+ * @file DuplicateDetector.h
+ * @brief 按文件大小分桶的重复文件检测。
+ * @details 大小不同的文件不可能逐字节相同，因此只有与仓库或本批其它文件大小相同的文件才需要哈希：
+ *          先比较首尾窗口指纹（部分哈希），指纹仍相同时再比较全量哈希。
+ *          大小唯一的文件完全不读取内容。
+ *          仓库中仅以早期算法（SHA-256）记录哈希的文件，改为按早期算法计算同组待导入文件的哈希来比较，
+ *          无需读取仓库中的文件，文件已丢失的记录也能识别：这类记录没有精确大小时，
+ *          以 size_slack_bytes 给出的近似范围匹配待导入文件，再按早期算法的哈希比较。
+ */
+
+/**
+ * @brief 仓库中已有的文件。
+ */
+struct KnownFile {
+  int id{0};                                  ///< 仓库 MOD ID
+  std::uint64_t size_bytes{0};                ///< 文件大小（字节）
+  std::optional<std::uint64_t> head_tail_hash; ///< 已记录的首尾指纹，缺失时按需从 path 计算
+  std::string full_hash;                       ///< 已记录的全量哈希，缺失时按需从 path 计算
+  std::string legacy_hash;                     ///< 以早期算法记录的全量哈希（full_hash 为空时使用）
+  std::uint64_t size_slack_bytes{0};           ///< 非零时 size_bytes 只是近似值（仅按 legacy_hash 比较）
+  std::filesystem::path path;                  ///< 仓库中的文件路径
+};
+
+/**
+ * @brief 待导入文件的检测结果。
+ */
+struct DuplicateDecision {
+  enum class Kind {
+    Unique,           ///< 大小唯一，未读取内容
+    Distinct,         ///< 大小有冲突，但经指纹或全量哈希确认不重复
+    DuplicateOfKnown, ///< 与仓库中的文件重复
+    DuplicateInBatch  ///< 与本批中更早出现的文件重复
+  };
+  Kind kind{Kind::Unique};
+  int known_id{0};                          ///< DuplicateOfKnown 时为仓库 MOD ID
+  std::size_t batch_index{0};               ///< DuplicateInBatch 时为保留的那个文件的下标
+  std::optional<FileFingerprint> fingerprint; ///< 检测过程中计算出的指纹（可复用）
+  std::string full_hash;                    ///< 检测过程中计算出的全量哈希（可复用）
+
+  bool isDuplicate() const { return kind == Kind::DuplicateOfKnown || kind == Kind::DuplicateInBatch; }
+};
+
+/**
+ * @brief 重复文件检测器。
+ */
+class DuplicateDetector {
+public:
+  /// 全量哈希函数，读取失败时返回空字符串。
+  using FullHashFn = std::function<std::string(const std::filesystem::path&)>;
+
+  /**
+   * @brief 以仓库已有文件构建大小索引。
+   * @param known 仓库已有文件列表。
+   * @param fullHash 全量哈希函数，需与 KnownFile::full_hash 使用同一算法。
+   * @param legacyHash 早期算法的全量哈希函数，需与 KnownFile::legacy_hash 使用同一算法；
+   *                   为空时只记录了 legacy_hash 的文件按 fullHash 从 path 重新计算。
+   */
+  DuplicateDetector(std::vector<KnownFile> known, FullHashFn fullHash, FullHashFn legacyHash = {});
+
+  /**
+   * @brief 检测一批待导入文件。
+   * @param paths 待导入文件路径。
+   * @param sizes 与 paths 一一对应的文件大小。
+   * @param workers 哈希并行线程数（至少为 1）。
+   * @param cancelled 可选的取消标志，置位后尽快返回（未完成的文件视为 Unique）。
+   * @return 与 paths 一一对应的检测结果；本批中首个出现的文件总是保留。
+   */
+  std::vector<DuplicateDecision> resolve(const std::vector<std::filesystem::path>& paths,
+                                         const std::vector<std::uint64_t>& sizes,
+                                         int workers,
+                                         const std::atomic<bool>* cancelled = nullptr);
+
+  /// 最近一次 resolve 中读取的字节数（指纹窗口与全量哈希）。
+  std::uint64_t bytesHashed() const { return bytesHashed_; }
+
+private:
+  std::vector<KnownFile> known_;
+  FullHashFn fullHash_;
+  FullHashFn legacyHash_;
+  std::uint64_t bytesHashed_{0};
+};
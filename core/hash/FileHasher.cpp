@@ -0,0 +1,110 @@
+#include "core/hash/FileHasher.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+#include "core/hash/Blake3.h"
+#include "core/hash/Sha256.h"
+#include "core/io/MappedFile.h"
+
+/**
+ * @file FileHasher.cpp
+ * @brief 文件全量哈希的实现。
+ */
+
+namespace {
+
+// 分块读取时的块大小，同时作为缓冲区对齐粒度
+constexpr std::size_t kReadChunkBytes = 4 * 1024 * 1024;
+
+template <std::size_t N>
+std::string toHex(const std::array<std::uint8_t, N>& digest) {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  std::string hex(N * 2, '0');
+  for (std::size_t i = 0; i < N; ++i) {
+    hex[2 * i] = kDigits[digest[i] >> 4];
+    hex[2 * i + 1] = kDigits[digest[i] & 0x0F];
+  }
+  return hex;
+}
+
+int resolveThreads(int threads) {
+  if (threads > 0) {
+    return threads;
+  }
+  return std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+}
+
+// 映射失败时的退路：以较大的对齐块顺序读取，流式计算
+std::string hashByReading(const std::filesystem::path& path, HashAlgorithm algorithm) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return {};
+  }
+  auto storage = std::make_unique<std::uint8_t[]>(kReadChunkBytes + 4096);
+  auto* buffer = reinterpret_cast<std::uint8_t*>(
+      (reinterpret_cast<std::uintptr_t>(storage.get()) + 4095) & ~static_cast<std::uintptr_t>(4095));
+
+  Blake3 blake3;
+  Sha256 sha256;
+  while (in) {
+    in.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(kReadChunkBytes));
+    const auto count = static_cast<std::size_t>(in.gcount());
+    if (count == 0) {
+      break;
+    }
+    if (algorithm == HashAlgorithm::Blake3) {
+      blake3.update(buffer, count);
+    } else {
+      sha256.update(buffer, count);
+    }
+  }
+  if (in.bad()) {
+    return {};
+  }
+  return algorithm == HashAlgorithm::Blake3 ? toHex(blake3.digest()) : toHex(sha256.digest());
+}
+
+} // namespace
+
+std::string_view hashAlgorithmName(HashAlgorithm algorithm) {
+  switch (algorithm) {
+  case HashAlgorithm::Sha256:
+    return "sha256";
+  case HashAlgorithm::Blake3:
+    return "blake3";
+  }
+  return {};
+}
+
+std::optional<HashAlgorithm> hashAlgorithmFromName(std::string_view name) {
+  if (name.empty()) {
+    return HashAlgorithm::Sha256;
+  }
+  for (HashAlgorithm algorithm : {HashAlgorithm::Sha256, HashAlgorithm::Blake3}) {
+    if (hashAlgorithmName(algorithm) == name) {
+      return algorithm;
+    }
+  }
+  return std::nullopt;
+}
+
+std::string hashBytes(const void* data, std::size_t length, HashAlgorithm algorithm, int threads) {
+  if (algorithm == HashAlgorithm::Blake3) {
+    return toHex(Blake3::hashParallel(data, length, resolveThreads(threads)));
+  }
+  return toHex(Sha256::hash(data, length));
+}
+
+std::string hashFile(const std::filesystem::path& path, HashAlgorithm algorithm, int threads) {
+  MappedFile file;
+  std::error_code ec;
+  if (file.open(path, ec)) {
+    return hashBytes(file.data(), file.size(), algorithm, threads);
+  }
+  return hashByReading(path, algorithm);
+}
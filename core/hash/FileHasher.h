@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @file FileHasher.h
+ * @brief 可选算法的文件全量哈希：新入库文件使用多线程 BLAKE3，早期记录的 SHA-256 仍可校验。
+ * @details 文件优先通过内存映射读取；映射失败（如网络盘、特殊文件）时退回到 4 MiB 对齐分块读取。
+ *          哈希结果均为小写十六进制字符串，所用算法记录在 mods.hash_algo 中。
+ */
+
+/**
+ * @brief 文件全量哈希算法。
+ */
+enum class HashAlgorithm {
+  Sha256, ///< 早期版本使用的算法，hash_algo 为空的记录均视为 SHA-256
+  Blake3  ///< 当前默认算法，大文件按子树多线程计算
+};
+
+/// 新计算的文件哈希所使用的算法。
+inline constexpr HashAlgorithm kDefaultHashAlgorithm = HashAlgorithm::Blake3;
+
+/**
+ * @brief 返回算法的持久化名称（sha256/blake3）。
+ */
+std::string_view hashAlgorithmName(HashAlgorithm algorithm);
+
+/**
+ * @brief 从持久化名称解析算法；空字符串视为 SHA-256，无法识别时返回 std::nullopt。
+ */
+std::optional<HashAlgorithm> hashAlgorithmFromName(std::string_view name);
+
+/**
+ * @brief 计算内存中数据的哈希。
+ * @param threads 并行线程数（仅 BLAKE3 有效），0 表示按硬件线程数自动选择。
+ * @return 小写十六进制哈希字符串。
+ */
+std::string hashBytes(const void* data, std::size_t length, HashAlgorithm algorithm, int threads = 0);
+
+/**
+ * @brief 计算文件的全量哈希。
+ * @param threads 并行线程数（仅 BLAKE3 有效），0 表示按硬件线程数自动选择。
+ * @return 小写十六进制哈希字符串；文件无法读取时返回空字符串。
+ */
+std::string hashFile(const std::filesystem::path& path, HashAlgorithm algorithm, int threads = 0);
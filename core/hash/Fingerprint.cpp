@@ -0,0 +1,56 @@
+#include "core/hash/Fingerprint.h"
+
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#include "core/hash/Xxh64.h"
+
+/**
+ * @file Fingerprint.cpp
+ * @brief 文件内容指纹的计算实现。
+ */
+
+std::optional<FileFingerprint> computeFileFingerprint(const std::filesystem::path& path) {
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  std::ifstream in(path, std::ios::binary);
+  if (!in.is_open()) {
+    return std::nullopt;
+  }
+
+  FileFingerprint fp;
+  fp.size_bytes = static_cast<std::uint64_t>(size);
+  Xxh64 hasher(fp.size_bytes);
+  std::vector<char> buffer(kFingerprintWindowBytes);
+
+  const auto readWindow = [&](std::uint64_t offset, std::size_t length) {
+    in.seekg(static_cast<std::streamoff>(offset));
+    in.read(buffer.data(), static_cast<std::streamsize>(length));
+    if (static_cast<std::size_t>(in.gcount()) != length) {
+      return false;
+    }
+    hasher.update(buffer.data(), length);
+    return true;
+  };
+
+  // 小文件首尾窗口会重叠，直接整体读取一次
+  if (fp.size_bytes <= 2 * kFingerprintWindowBytes) {
+    buffer.resize(static_cast<std::size_t>(fp.size_bytes));
+    if (!buffer.empty() && !readWindow(0, buffer.size())) {
+      return std::nullopt;
+    }
+  } else {
+    if (!readWindow(0, kFingerprintWindowBytes) ||
+        !readWindow(fp.size_bytes - kFingerprintWindowBytes, kFingerprintWindowBytes)) {
+      return std::nullopt;
+    }
+  }
+
+  fp.head_tail_hash = hasher.digest();
+  return fp;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+
+/**
+ * @file Fingerprint.h
+ * @brief MOD 文件的内容指纹：文件大小 + 首尾各 64 KiB 的快速哈希。
+ * @details 指纹只读取文件首尾少量数据，可在不做全量哈希的前提下识别被重命名或移动的文件。
+ *          指纹相同并不代表内容完全一致，命中后仍需使用全量哈希确认。
+ */
+
+/// 指纹计算时首尾各读取的字节数。
+inline constexpr std::size_t kFingerprintWindowBytes = 64 * 1024;
+
+/**
+ * @brief 文件内容指纹。
+ */
+struct FileFingerprint {
+  std::uint64_t size_bytes{0};     ///< 文件大小（字节）
+  std::uint64_t head_tail_hash{0}; ///< 首尾窗口数据的 XXH64 哈希（以文件大小为种子）
+
+  bool operator==(const FileFingerprint& other) const {
+    return size_bytes == other.size_bytes && head_tail_hash == other.head_tail_hash;
+  }
+  bool operator!=(const FileFingerprint& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief 计算指定文件的内容指纹。
+ * @param path 文件路径。
+ * @return 成功时返回指纹；文件不存在或读取失败时返回 std::nullopt。
+ */
+std::optional<FileFingerprint> computeFileFingerprint(const std::filesystem::path& path);
+
+/**
+ * @brief 将指纹折叠为单个 64 位键，便于放入哈希表。
+ * @note 不同指纹可能折叠为相同的键，查找后需再比较完整指纹。
+ */
+inline std::uint64_t fingerprintKey(const FileFingerprint& fp) {
+  return fp.head_tail_hash ^ (fp.size_bytes * 0x9E3779B97F4A7C15ULL);
+}
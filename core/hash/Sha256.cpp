@@ -0,0 +1,130 @@
+#include "core/hash/Sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @file Sha256.cpp
+ * @brief SHA-256 的实现（FIPS 180-4）。
+ */
+
+namespace {
+
+constexpr std::uint32_t kRoundConstants[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2};
+
+inline std::uint32_t rotr(std::uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+} // namespace
+
+void Sha256::reset() {
+  static constexpr std::uint32_t kInitial[8] = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                                                0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+  std::memcpy(state_, kInitial, sizeof(state_));
+  totalLength_ = 0;
+  bufferSize_ = 0;
+}
+
+void Sha256::processBlock(const std::uint8_t* block) {
+  std::uint32_t w[64];
+  for (int i = 0; i < 16; ++i) {
+    w[i] = (static_cast<std::uint32_t>(block[4 * i]) << 24) | (static_cast<std::uint32_t>(block[4 * i + 1]) << 16) |
+           (static_cast<std::uint32_t>(block[4 * i + 2]) << 8) | static_cast<std::uint32_t>(block[4 * i + 3]);
+  }
+  for (int i = 16; i < 64; ++i) {
+    const std::uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    const std::uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  std::uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+  std::uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+  for (int i = 0; i < 64; ++i) {
+    const std::uint32_t s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+    const std::uint32_t ch = (e & f) ^ (~e & g);
+    const std::uint32_t t1 = h + s1 + ch + kRoundConstants[i] + w[i];
+    const std::uint32_t s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+    const std::uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    const std::uint32_t t2 = s0 + maj;
+    h = g;
+    g = f;
+    f = e;
+    e = d + t1;
+    d = c;
+    c = b;
+    b = a;
+    a = t1 + t2;
+  }
+  state_[0] += a;
+  state_[1] += b;
+  state_[2] += c;
+  state_[3] += d;
+  state_[4] += e;
+  state_[5] += f;
+  state_[6] += g;
+  state_[7] += h;
+}
+
+void Sha256::update(const void* data, std::size_t length) {
+  const auto* input = static_cast<const std::uint8_t*>(data);
+  totalLength_ += length;
+  if (bufferSize_ > 0) {
+    const std::size_t take = std::min(sizeof(buffer_) - bufferSize_, length);
+    std::memcpy(buffer_ + bufferSize_, input, take);
+    bufferSize_ += take;
+    input += take;
+    length -= take;
+    if (bufferSize_ < sizeof(buffer_)) {
+      return;
+    }
+    processBlock(buffer_);
+    bufferSize_ = 0;
+  }
+  while (length >= sizeof(buffer_)) {
+    processBlock(input);
+    input += sizeof(buffer_);
+    length -= sizeof(buffer_);
+  }
+  std::memcpy(buffer_, input, length);
+  bufferSize_ = length;
+}
+
+Sha256::Digest Sha256::digest() const {
+  Sha256 copy = *this;
+  const std::uint64_t bitLength = totalLength_ * 8;
+  const std::uint8_t pad = 0x80;
+  copy.update(&pad, 1);
+  const std::uint8_t zero = 0;
+  while (copy.bufferSize_ != 56) {
+    copy.update(&zero, 1);
+  }
+  std::uint8_t lengthBytes[8];
+  for (int i = 0; i < 8; ++i) {
+    lengthBytes[i] = static_cast<std::uint8_t>(bitLength >> (56 - 8 * i));
+  }
+  copy.update(lengthBytes, sizeof(lengthBytes));
+
+  Digest digest{};
+  for (int i = 0; i < 8; ++i) {
+    digest[4 * i] = static_cast<std::uint8_t>(copy.state_[i] >> 24);
+    digest[4 * i + 1] = static_cast<std::uint8_t>(copy.state_[i] >> 16);
+    digest[4 * i + 2] = static_cast<std::uint8_t>(copy.state_[i] >> 8);
+    digest[4 * i + 3] = static_cast<std::uint8_t>(copy.state_[i]);
+  }
+  return digest;
+}
+
+Sha256::Digest Sha256::hash(const void* data, std::size_t length) {
+  Sha256 hasher;
+  hasher.update(data, length);
+  return hasher.digest();
+}
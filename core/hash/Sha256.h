@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file Sha256.h
+ * @brief SHA-256 的轻量实现，用于校验早期以 SHA-256 记录的 MOD 文件哈希。
+ */
+
+/**
+ * @brief SHA-256 流式哈希器。
+ * @details 可多次调用 update() 追加数据，最后调用 digest() 获取结果；digest() 不会改变内部状态。
+ */
+class Sha256 {
+public:
+  using Digest = std::array<std::uint8_t, 32>;
+
+  Sha256() { reset(); }
+
+  /** @brief 重置内部状态，以便复用同一对象。 */
+  void reset();
+
+  /**
+   * @brief 追加一段数据。
+   * @param data 数据起始地址。
+   * @param length 数据长度（字节）。
+   */
+  void update(const void* data, std::size_t length);
+
+  /** @brief 计算当前已追加数据的哈希值。 */
+  Digest digest() const;
+
+  /** @brief 一次性计算整段数据的哈希值。 */
+  static Digest hash(const void* data, std::size_t length);
+
+private:
+  void processBlock(const std::uint8_t* block);
+
+  std::uint32_t state_[8]{};
+  std::uint64_t totalLength_{0};
+  std::uint8_t buffer_[64]{};
+  std::size_t bufferSize_{0};
+};
@@ -0,0 +1,138 @@
+#include "core/hash/Xxh64.h"
+
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @file Xxh64.cpp
+ * @brief XXH64 算法实现（与官方 xxHash 输出一致，按小端序读取输入）。
+ */
+
+namespace {
+
+constexpr std::uint64_t kPrime1 = 11400714785074694791ULL;
+constexpr std::uint64_t kPrime2 = 14029467366897019727ULL;
+constexpr std::uint64_t kPrime3 = 1609587929392839161ULL;
+constexpr std::uint64_t kPrime4 = 9650029242287828579ULL;
+constexpr std::uint64_t kPrime5 = 2870177450012600261ULL;
+
+inline std::uint64_t rotl(std::uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+inline std::uint64_t read64(const unsigned char* p) {
+  std::uint64_t v = 0;
+  for (int i = 7; i >= 0; --i) {
+    v = (v << 8) | p[i];
+  }
+  return v;
+}
+
+inline std::uint32_t read32(const unsigned char* p) {
+  return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline std::uint64_t round(std::uint64_t acc, std::uint64_t input) {
+  acc += input * kPrime2;
+  acc = rotl(acc, 31);
+  return acc * kPrime1;
+}
+
+inline std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t value) {
+  acc ^= round(0, value);
+  return acc * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+void Xxh64::reset(std::uint64_t seed) {
+  seed_ = seed;
+  totalLength_ = 0;
+  bufferSize_ = 0;
+  acc_[0] = seed + kPrime1 + kPrime2;
+  acc_[1] = seed + kPrime2;
+  acc_[2] = seed;
+  acc_[3] = seed - kPrime1;
+}
+
+void Xxh64::update(const void* data, std::size_t length) {
+  if (!data || length == 0) {
+    return;
+  }
+  const auto* p = static_cast<const unsigned char*>(data);
+  const auto* end = p + length;
+  totalLength_ += length;
+
+  // 先补齐上一轮残留的缓冲区
+  if (bufferSize_ > 0) {
+    const std::size_t fill = std::min<std::size_t>(32 - bufferSize_, length);
+    std::memcpy(buffer_ + bufferSize_, p, fill);
+    bufferSize_ += fill;
+    p += fill;
+    if (bufferSize_ < 32) {
+      return;
+    }
+    for (int i = 0; i < 4; ++i) {
+      acc_[i] = round(acc_[i], read64(buffer_ + i * 8));
+    }
+    bufferSize_ = 0;
+  }
+
+  // 按 32 字节条带批量处理
+  while (end - p >= 32) {
+    for (int i = 0; i < 4; ++i) {
+      acc_[i] = round(acc_[i], read64(p + i * 8));
+    }
+    p += 32;
+  }
+
+  if (p < end) {
+    bufferSize_ = static_cast<std::size_t>(end - p);
+    std::memcpy(buffer_, p, bufferSize_);
+  }
+}
+
+std::uint64_t Xxh64::digest() const {
+  std::uint64_t h64 = 0;
+  if (totalLength_ >= 32) {
+    h64 = rotl(acc_[0], 1) + rotl(acc_[1], 7) + rotl(acc_[2], 12) + rotl(acc_[3], 18);
+    for (int i = 0; i < 4; ++i) {
+      h64 = mergeRound(h64, acc_[i]);
+    }
+  } else {
+    h64 = seed_ + kPrime5;
+  }
+  h64 += totalLength_;
+
+  const unsigned char* p = buffer_;
+  const unsigned char* end = buffer_ + bufferSize_;
+  while (end - p >= 8) {
+    h64 ^= round(0, read64(p));
+    h64 = rotl(h64, 27) * kPrime1 + kPrime4;
+    p += 8;
+  }
+  if (end - p >= 4) {
+    h64 ^= static_cast<std::uint64_t>(read32(p)) * kPrime1;
+    h64 = rotl(h64, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  while (p < end) {
+    h64 ^= static_cast<std::uint64_t>(*p) * kPrime5;
+    h64 = rotl(h64, 11) * kPrime1;
+    ++p;
+  }
+
+  h64 ^= h64 >> 33;
+  h64 *= kPrime2;
+  h64 ^= h64 >> 29;
+  h64 *= kPrime3;
+  h64 ^= h64 >> 32;
+  return h64;
+}
+
+std::uint64_t Xxh64::hash(const void* data, std::size_t length, std::uint64_t seed) {
+  Xxh64 hasher(seed);
+  hasher.update(data, length);
+  return hasher.digest();
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file Xxh64.h
+ * @brief XXH64 非加密哈希的轻量实现，用于文件指纹等快速比对场景。
+ */
+
+/**
+ * @brief XXH64 流式哈希器。
+ * @details 可多次调用 update() 追加数据，最后调用 digest() 获取结果；digest() 不会改变内部状态。
+ */
+class Xxh64 {
+public:
+  /**
+   * @brief 构造哈希器。
+   * @param seed 哈希种子。
+   */
+  explicit Xxh64(std::uint64_t seed = 0) { reset(seed); }
+
+  /** @brief 重置内部状态，以便复用同一对象。 */
+  void reset(std::uint64_t seed = 0);
+
+  /**
+   * @brief 追加一段数据。
+   * @param data 数据起始地址。
+   * @param length 数据长度（字节）。
+   */
+  void update(const void* data, std::size_t length);
+
+  /** @brief 计算当前已追加数据的哈希值。 */
+  std::uint64_t digest() const;
+
+  /**
+   * @brief 一次性计算整段数据的哈希值。
+   * @param data 数据起始地址。
+   * @param length 数据长度（字节）。
+   * @param seed 哈希种子。
+   */
+  static std::uint64_t hash(const void* data, std::size_t length, std::uint64_t seed = 0);
+
+private:
+  std::uint64_t seed_{0};
+  std::uint64_t totalLength_{0};
+  std::uint64_t acc_[4]{};
+  unsigned char buffer_[32]{};
+  std::size_t bufferSize_{0};
+};
@@ -0,0 +1,167 @@
+#include "core/index/FacetIndex.h"
+
+#include <algorithm>
+
+namespace {
+
+const FacetIndex::Postings kEmptyPostings;
+
+/// 分类父链深度上限，防止数据库中的环路导致死循环。
+constexpr int kMaxCategoryDepth = 64;
+
+/// 按序插入下标；下标通常递增，直接追加。
+void addPosting(FacetIndex::Postings& postings, int index) {
+  if (postings.empty() || postings.back() < index) {
+    postings.push_back(index);
+    return;
+  }
+  const auto it = std::lower_bound(postings.begin(), postings.end(), index);
+  if (it == postings.end() || *it != index) {
+    postings.insert(it, index);
+  }
+}
+
+void removePosting(FacetIndex::Postings& postings, int index) {
+  const auto it = std::lower_bound(postings.begin(), postings.end(), index);
+  if (it != postings.end() && *it == index) {
+    postings.erase(it);
+  }
+}
+
+} // namespace
+
+void FacetIndex::clear() {
+  size_ = 0;
+  placements_.clear();
+  categories_.clear();
+  uncategorized_.clear();
+  tags_.clear();
+  untagged_.clear();
+  authors_.clear();
+  ratings_.clear();
+  unrated_.clear();
+}
+
+void FacetIndex::build(const std::vector<ModRow>& mods,
+                       const std::unordered_map<int, std::vector<int>>& tagIdsByMod,
+                       const std::unordered_map<int, int>& categoryParent) {
+  static const std::vector<int> kNoTags;
+  clear();
+  size_ = mods.size();
+  placements_.resize(mods.size());
+  for (std::size_t i = 0; i < mods.size(); ++i) {
+    const auto tags = tagIdsByMod.find(mods[i].id);
+    place(i, mods[i], tags != tagIdsByMod.end() ? tags->second : kNoTags, categoryParent);
+  }
+}
+
+void FacetIndex::update(std::size_t index,
+                        const ModRow& mod,
+                        const std::vector<int>& tagIds,
+                        const std::unordered_map<int, int>& categoryParent) {
+  if (index > size_) {
+    return;
+  }
+  if (index == size_) {
+    ++size_;
+    placements_.emplace_back();
+  } else {
+    erase(index);
+  }
+  place(index, mod, tagIds, categoryParent);
+}
+
+void FacetIndex::erase(std::size_t index) {
+  if (index >= size_ || !placements_[index].indexed) {
+    return;
+  }
+  Placement& placement = placements_[index];
+  const int value = static_cast<int>(index);
+  if (placement.categories.empty()) {
+    removePosting(uncategorized_, value);
+  }
+  for (const int categoryId : placement.categories) {
+    removePosting(categories_[categoryId], value);
+  }
+  if (placement.tags.empty()) {
+    removePosting(untagged_, value);
+  }
+  for (const int tagId : placement.tags) {
+    removePosting(tags_[tagId], value);
+  }
+  if (!placement.author.empty()) {
+    removePosting(authors_[placement.author], value);
+  }
+  removePosting(placement.rating > 0 ? ratings_[placement.rating] : unrated_, value);
+  placement = Placement{};
+}
+
+void FacetIndex::place(std::size_t index,
+                       const ModRow& mod,
+                       const std::vector<int>& tagIds,
+                       const std::unordered_map<int, int>& categoryParent) {
+  Placement& placement = placements_[index];
+  placement.indexed = true;
+  const int value = static_cast<int>(index);
+
+  if (mod.category_id <= 0) {
+    addPosting(uncategorized_, value);
+  } else {
+    int current = mod.category_id;
+    for (int depth = 0; current > 0 && depth < kMaxCategoryDepth; ++depth) {
+      // 环路中的分类可能重复出现，addPosting 会跳过已记录的下标
+      if (std::find(placement.categories.begin(), placement.categories.end(), current) ==
+          placement.categories.end()) {
+        placement.categories.push_back(current);
+      }
+      addPosting(categories_[current], value);
+      const auto parent = categoryParent.find(current);
+      if (parent == categoryParent.end() || parent->second == current) {
+        break;
+      }
+      current = parent->second;
+    }
+  }
+
+  if (tagIds.empty()) {
+    addPosting(untagged_, value);
+  } else {
+    for (const int tagId : tagIds) {
+      // 同一 MOD 重复关联同一标签时只记录一次
+      if (std::find(placement.tags.begin(), placement.tags.end(), tagId) == placement.tags.end()) {
+        placement.tags.push_back(tagId);
+      }
+      addPosting(tags_[tagId], value);
+    }
+  }
+
+  if (!mod.author.empty()) {
+    placement.author = mod.author;
+    addPosting(authors_[mod.author], value);
+  }
+
+  placement.rating = mod.rating;
+  addPosting(mod.rating > 0 ? ratings_[mod.rating] : unrated_, value);
+}
+
+const FacetIndex::Postings& FacetIndex::lookup(const std::unordered_map<int, Postings>& map, int key) {
+  const auto it = map.find(key);
+  return it != map.end() ? it->second : kEmptyPostings;
+}
+
+const FacetIndex::Postings& FacetIndex::categorySubtree(int categoryId) const {
+  return lookup(categories_, categoryId);
+}
+
+const FacetIndex::Postings& FacetIndex::tag(int tagId) const {
+  return lookup(tags_, tagId);
+}
+
+const FacetIndex::Postings& FacetIndex::author(std::string_view author) const {
+  const auto it = authors_.find(std::string(author));
+  return it != authors_.end() ? it->second : kEmptyPostings;
+}
+
+const FacetIndex::Postings& FacetIndex::rating(int rating) const {
+  return rating > 0 ? lookup(ratings_, rating) : unrated_;
+}
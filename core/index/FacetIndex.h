@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/repo/RepositoryService.h"
+
+/**
+ * @file FacetIndex.h
+ * @brief 分类、标签、作者、评分筛选的倒排索引。
+ * @details 加载 MOD 列表时一次性建立“筛选值 -> MOD 下标”的倒排表，下标指向构建时传入的 MOD 列表，
+ *          每张倒排表按升序排列。切换筛选条件只需取出对应的倒排表，耗时与结果数量成正比。
+ *          分类倒排表覆盖整棵子树：构建时沿父链把 MOD 记入每一级祖先分类。
+ *          单个 MOD 变化时可用 update()/erase() 就地修改，无需重建整个索引。
+ */
+class FacetIndex {
+public:
+  using Postings = std::vector<int>;
+
+  /**
+   * @brief 重新建立索引。
+   * @param mods MOD 列表，倒排表中的下标即为该列表的下标
+   * @param tagIdsByMod MOD id -> 标签 id 列表，未出现的 MOD 视为无标签
+   * @param categoryParent 分类 id -> 父分类 id（顶级分类的父 id 为 0）
+   */
+  void build(const std::vector<ModRow>& mods,
+             const std::unordered_map<int, std::vector<int>>& tagIdsByMod,
+             const std::unordered_map<int, int>& categoryParent);
+
+  void clear();
+
+  /**
+   * @brief 更新单个下标的筛选值；index 等于 size() 时追加新下标。
+   * @details 先从旧值对应的倒排表中移除该下标，再按新值有序插入，耗时与相关倒排表的长度成正比。
+   */
+  void update(std::size_t index,
+              const ModRow& mod,
+              const std::vector<int>& tagIds,
+              const std::unordered_map<int, int>& categoryParent);
+
+  /// 从所有倒排表中移除该下标；下标本身保留，size() 不变。
+  void erase(std::size_t index);
+
+  /// 建立索引时的 MOD 数量。
+  std::size_t size() const { return size_; }
+
+  /// 属于该分类或其任一子分类的 MOD。
+  const Postings& categorySubtree(int categoryId) const;
+  /// 未设置分类（category_id 为 0）的 MOD。
+  const Postings& uncategorized() const { return uncategorized_; }
+
+  const Postings& tag(int tagId) const;
+  const Postings& untagged() const { return untagged_; }
+
+  /// 作者完全相同（区分大小写）的 MOD。
+  const Postings& author(std::string_view author) const;
+
+  /// 评分等于 rating 的 MOD；rating <= 0 时返回未评分的 MOD。
+  const Postings& rating(int rating) const;
+
+private:
+  /// 某个下标当前所在的倒排表，用于增量更新时定位旧值。
+  struct Placement {
+    std::vector<int> categories; ///< 所属分类及其全部祖先；为空表示未分类
+    std::vector<int> tags;
+    std::string author;
+    int rating{0};
+    bool indexed{false};
+  };
+
+  static const Postings& lookup(const std::unordered_map<int, Postings>& map, int key);
+  void place(std::size_t index,
+             const ModRow& mod,
+             const std::vector<int>& tagIds,
+             const std::unordered_map<int, int>& categoryParent);
+
+  std::size_t size_{0};
+  std::vector<Placement> placements_;
+  std::unordered_map<int, Postings> categories_;
+  Postings uncategorized_;
+  std::unordered_map<int, Postings> tags_;
+  Postings untagged_;
+  std::unordered_map<std::string, Postings> authors_;
+  std::unordered_map<int, Postings> ratings_;
+  Postings unrated_;
+};
@@ -0,0 +1,37 @@
+#include "core/index/FilterBitset.h"
+
+#include <utility>
+
+FilterBitset::FilterBitset(std::size_t universe, std::vector<int> ordered)
+    : universe_(universe), words_((universe + 63) / 64, 0) {
+  ordered_.reserve(ordered.size());
+  for (const int index : ordered) {
+    if (index < 0 || static_cast<std::size_t>(index) >= universe) {
+      continue;
+    }
+    std::uint64_t& word = words_[static_cast<std::size_t>(index) / 64];
+    const std::uint64_t bit = std::uint64_t{1} << (index % 64);
+    if (word & bit) {
+      continue;
+    }
+    word |= bit;
+    ordered_.push_back(index);
+  }
+}
+
+FilterBitset FilterBitset::all(std::size_t universe) {
+  FilterBitset result;
+  result.universe_ = universe;
+  result.matchesAll_ = true;
+  return result;
+}
+
+bool FilterBitset::test(int index) const {
+  if (index < 0 || static_cast<std::size_t>(index) >= universe_) {
+    return false;
+  }
+  if (matchesAll_) {
+    return true;
+  }
+  return (words_[static_cast<std::size_t>(index) / 64] >> (index % 64)) & 1;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file FilterBitset.h
+ * @brief 一次筛选的结果：MOD 下标位图加结果顺序。
+ * @details 下标指向筛选时的 MOD 列表。位图用于按行判断是否通过筛选（O(1)），
+ *          有序下标列表保留筛选给出的顺序（名称搜索为相关度顺序，其它筛选为升序），用于填充表格。
+ *          “全部通过”的结果不展开列表，ordered() 为空，由调用方按需遍历全体下标。
+ */
+class FilterBitset {
+public:
+  FilterBitset() = default;
+
+  /**
+   * @brief 由筛选命中的下标构造结果。
+   * @param universe MOD 总数，越界或重复的下标会被忽略
+   * @param ordered 命中的下标，按希望展示的顺序排列
+   */
+  FilterBitset(std::size_t universe, std::vector<int> ordered);
+
+  /// 全部通过（未设置筛选条件）。
+  static FilterBitset all(std::size_t universe);
+
+  bool test(int index) const;
+  bool matchesAll() const { return matchesAll_; }
+
+  /// 构造时的 MOD 总数。
+  std::size_t universe() const { return universe_; }
+  /// 通过筛选的数量。
+  std::size_t count() const { return matchesAll_ ? universe_ : ordered_.size(); }
+  /// 通过筛选的下标（matchesAll() 时为空）。
+  const std::vector<int>& ordered() const { return ordered_; }
+
+private:
+  std::size_t universe_{0};
+  bool matchesAll_{false};
+  std::vector<std::uint64_t> words_;
+  std::vector<int> ordered_;
+};
@@ -0,0 +1,534 @@
+#include "core/index/NameSearchIndex.h"
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+constexpr char32_t kReplacement = 0xFFFD;
+
+/// 解码一个 UTF-8 码点，返回消耗的字节数（至少为 1）。
+std::size_t decodeUtf8(std::string_view text, std::size_t pos, char32_t& out) {
+  const auto byte = [&](std::size_t i) { return static_cast<unsigned char>(text[i]); };
+  const unsigned char lead = byte(pos);
+  if (lead < 0x80) {
+    out = lead;
+    return 1;
+  }
+  std::size_t length = 0;
+  char32_t value = 0;
+  char32_t minimum = 0;
+  if ((lead & 0xE0) == 0xC0) {
+    length = 2;
+    value = lead & 0x1F;
+    minimum = 0x80;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 3;
+    value = lead & 0x0F;
+    minimum = 0x800;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 4;
+    value = lead & 0x07;
+    minimum = 0x10000;
+  } else {
+    out = kReplacement;
+    return 1;
+  }
+  if (pos + length > text.size()) {
+    out = kReplacement;
+    return 1;
+  }
+  for (std::size_t i = 1; i < length; ++i) {
+    const unsigned char next = byte(pos + i);
+    if ((next & 0xC0) != 0x80) {
+      out = kReplacement;
+      return 1;
+    }
+    value = (value << 6) | (next & 0x3F);
+  }
+  out = (value < minimum || value > 0x10FFFF) ? kReplacement : value;
+  return length;
+}
+
+bool isSeparator(char32_t c) {
+  if (c < 0x80) {
+    return !((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z'));
+  }
+  // 全角空格与 CJK 标点、通用标点
+  return (c >= 0x3000 && c <= 0x303F) || (c >= 0x2000 && c <= 0x206F) || c == 0x00A0 || c == 0x30FB;
+}
+
+char32_t foldCase(char32_t c) {
+  if (c >= 0xFF01 && c <= 0xFF5E) {
+    c -= 0xFEE0; // 全角 ASCII 转半角
+  }
+  if (c >= 'A' && c <= 'Z') {
+    return c + 32;
+  }
+  // Latin-1 大写字母（跳过乘号 U+00D7）
+  if (c >= 0xC0 && c <= 0xDE && c != 0xD7) {
+    return c + 32;
+  }
+  return c;
+}
+
+/// 二元组首位填充的值，大于任何合法码点，保证与三元组的键不冲突。
+constexpr char32_t kBigramPad = 0x1FFFFF;
+
+std::uint64_t packGram(char32_t a, char32_t b, char32_t c) {
+  return (static_cast<std::uint64_t>(a) << 42) | (static_cast<std::uint64_t>(b) << 21) | static_cast<std::uint64_t>(c);
+}
+
+bool startsWith(const std::u32string& text, const std::u32string& prefix) {
+  return text.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), text.begin());
+}
+
+bool ranksBefore(const NameSearchIndex::Match& a, std::size_t aLength, const NameSearchIndex::Match& b,
+                 std::size_t bLength) {
+  if (a.distance != b.distance) {
+    return a.distance < b.distance;
+  }
+  if (a.field != b.field) {
+    return a.field == NameSearchIndex::Field::Name;
+  }
+  if (a.prefix != b.prefix) {
+    return a.prefix;
+  }
+  if (aLength != bLength) {
+    return aLength < bLength;
+  }
+  return a.id < b.id;
+}
+
+} // namespace
+
+std::u32string NameSearchIndex::normalize(std::string_view utf8) {
+  std::u32string result;
+  result.reserve(utf8.size());
+  for (std::size_t pos = 0; pos < utf8.size();) {
+    char32_t c = 0;
+    pos += decodeUtf8(utf8, pos, c);
+    c = foldCase(c);
+    if (!isSeparator(c)) {
+      result.push_back(c);
+    }
+  }
+  return result;
+}
+
+int NameSearchIndex::maxEditsFor(std::size_t queryLength) {
+  if (queryLength < 4) {
+    return 0;
+  }
+  return queryLength < 7 ? 1 : 2;
+}
+
+/// 查询各码点在模式中出现位置的位掩码，供位并行编辑距离使用。
+struct NameSearchIndex::PatternMasks {
+  explicit PatternMasks(std::u32string_view pattern) : length(pattern.size()) {
+    for (std::size_t i = 0; i < pattern.size() && i < kMaxBitParallelLength; ++i) {
+      const std::uint64_t bit = std::uint64_t{1} << i;
+      const char32_t c = pattern[i];
+      if (c < ascii.size()) {
+        ascii[c] |= bit;
+        continue;
+      }
+      const auto it = std::lower_bound(other.begin(), other.end(), c,
+                                       [](const auto& item, char32_t key) { return item.first < key; });
+      if (it != other.end() && it->first == c) {
+        it->second |= bit;
+      } else {
+        other.insert(it, {c, bit});
+      }
+    }
+  }
+
+  std::uint64_t operator()(char32_t c) const {
+    if (c < ascii.size()) {
+      return ascii[c];
+    }
+    const auto it = std::lower_bound(other.begin(), other.end(), c,
+                                     [](const auto& item, char32_t key) { return item.first < key; });
+    return it != other.end() && it->first == c ? it->second : 0;
+  }
+
+  static constexpr std::size_t kMaxBitParallelLength = 64;
+
+  std::size_t length;
+  std::array<std::uint64_t, 128> ascii{};
+  std::vector<std::pair<char32_t, std::uint64_t>> other;
+};
+
+int NameSearchIndex::boundedSubstringDistance(std::u32string_view pattern, std::u32string_view text, int maxDistance) {
+  const PatternMasks masks(pattern);
+  return boundedSubstringDistance(pattern, masks, text, maxDistance);
+}
+
+int NameSearchIndex::boundedSubstringDistance(std::u32string_view pattern,
+                                              const PatternMasks& masks,
+                                              std::u32string_view text,
+                                              int maxDistance) {
+  const std::size_t m = pattern.size();
+  const std::size_t n = text.size();
+  if (m == 0) {
+    return 0;
+  }
+  const int over = maxDistance + 1;
+  if (m > n + static_cast<std::size_t>(maxDistance)) {
+    return over;
+  }
+
+  if (m <= PatternMasks::kMaxBitParallelLength) {
+    // Myers 位并行算法的相邻交换扩展（Hyyrö 2003）：每个文本码点只需常数次位运算，
+    // 每一位对应查询的一个前缀，vp/vn 记录 DP 列中相邻行之差为 +1/-1 的位置
+    const std::uint64_t full = m == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << m) - 1;
+    const std::uint64_t last = std::uint64_t{1} << (m - 1);
+    std::uint64_t vp = full;
+    std::uint64_t vn = 0;
+    std::uint64_t d0 = 0;
+    std::uint64_t previousEq = 0;
+    int score = static_cast<int>(m);
+    int best = score;
+    for (std::size_t j = 0; j < n; ++j) {
+      const std::uint64_t eq = masks(text[j]);
+      const std::uint64_t transposed = ((~d0 & eq) << 1) & previousEq;
+      d0 = ((((eq & vp) + vp) ^ vp) | eq | vn | transposed) & full;
+      std::uint64_t hp = (vn | ~(d0 | vp)) & full;
+      std::uint64_t hn = d0 & vp;
+      if (hp & last) {
+        ++score;
+      } else if (hn & last) {
+        --score;
+      }
+      // 首行全为 0（匹配可从任意位置开始），因此左移时不补 1
+      hp <<= 1;
+      hn <<= 1;
+      vp = (hn | ~(d0 | hp)) & full;
+      vn = d0 & hp;
+      previousEq = eq;
+      best = std::min(best, score);
+      // 每个码点最多让得分减 1：已为 0，或剩余文本不足以降到上限以内时提前结束
+      const int remaining = static_cast<int>(n - j - 1);
+      if (best == 0 || (best > maxDistance && score - remaining > maxDistance)) {
+        break;
+      }
+    }
+    return best > maxDistance ? over : best;
+  }
+
+  // 超长查询退回三行滚动数组的 DP
+  const std::size_t width = n + 1;
+  std::vector<int> rows(width * 3, 0);
+  int* twoBack = rows.data();
+  int* previous = twoBack + width;
+  int* current = previous + width;
+  // 行对应查询前缀，列对应文本位置；首行全为 0 表示匹配可以从文本任意位置开始
+  for (std::size_t i = 1; i <= m; ++i) {
+    current[0] = static_cast<int>(i);
+    int rowMin = current[0];
+    for (std::size_t j = 1; j <= n; ++j) {
+      const int cost = pattern[i - 1] == text[j - 1] ? 0 : 1;
+      int value = std::min({previous[j] + 1, current[j - 1] + 1, previous[j - 1] + cost});
+      if (i > 1 && j > 1 && pattern[i - 1] == text[j - 2] && pattern[i - 2] == text[j - 1]) {
+        value = std::min(value, twoBack[j - 2] + 1);
+      }
+      current[j] = value;
+      rowMin = std::min(rowMin, value);
+    }
+    if (rowMin > maxDistance) {
+      return over;
+    }
+    int* recycled = twoBack;
+    twoBack = previous;
+    previous = current;
+    current = recycled;
+  }
+  const int best = *std::min_element(previous, previous + width);
+  return best > maxDistance ? over : best;
+}
+
+void NameSearchIndex::clear() {
+  entries_.clear();
+  freeSlots_.clear();
+  slotById_.clear();
+  postings_.clear();
+}
+
+std::vector<std::uint64_t> NameSearchIndex::gramsOf(const std::u32string& text, std::size_t n) {
+  std::vector<std::uint64_t> grams;
+  if (text.size() < n) {
+    return grams;
+  }
+  grams.reserve(text.size() - n + 1);
+  for (std::size_t i = 0; i + n <= text.size(); ++i) {
+    grams.push_back(n == 3 ? packGram(text[i], text[i + 1], text[i + 2]) : packGram(kBigramPad, text[i], text[i + 1]));
+  }
+  std::sort(grams.begin(), grams.end());
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+  return grams;
+}
+
+std::vector<std::uint64_t> NameSearchIndex::entryGrams(const Entry& entry) {
+  std::vector<std::uint64_t> grams;
+  for (const std::u32string* text : {&entry.name, &entry.author}) {
+    for (const std::size_t n : {std::size_t{2}, std::size_t{3}}) {
+      const std::vector<std::uint64_t> part = gramsOf(*text, n);
+      grams.insert(grams.end(), part.begin(), part.end());
+    }
+  }
+  std::sort(grams.begin(), grams.end());
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+  return grams;
+}
+
+void NameSearchIndex::indexEntry(Slot slot) {
+  for (const std::uint64_t gram : entryGrams(entries_[slot])) {
+    auto& list = postings_[gram];
+    // 新槽位通常最大，直接追加；复用的空闲槽位需按序插入
+    if (list.empty() || list.back() < slot) {
+      list.push_back(slot);
+    } else {
+      list.insert(std::lower_bound(list.begin(), list.end(), slot), slot);
+    }
+  }
+}
+
+void NameSearchIndex::unindexEntry(Slot slot) {
+  for (const std::uint64_t gram : entryGrams(entries_[slot])) {
+    const auto it = postings_.find(gram);
+    if (it == postings_.end()) {
+      continue;
+    }
+    auto& list = it->second;
+    const auto pos = std::lower_bound(list.begin(), list.end(), slot);
+    if (pos != list.end() && *pos == slot) {
+      list.erase(pos);
+    }
+    if (list.empty()) {
+      postings_.erase(it);
+    }
+  }
+}
+
+void NameSearchIndex::upsert(int id, std::string_view name, std::string_view author) {
+  remove(id);
+  Slot slot;
+  if (!freeSlots_.empty()) {
+    slot = freeSlots_.back();
+    freeSlots_.pop_back();
+  } else {
+    slot = static_cast<Slot>(entries_.size());
+    entries_.emplace_back();
+  }
+  Entry& entry = entries_[slot];
+  entry.id = id;
+  entry.name = normalize(name);
+  entry.author = normalize(author);
+  entry.live = true;
+  slotById_[id] = slot;
+  indexEntry(slot);
+}
+
+void NameSearchIndex::remove(int id) {
+  const auto it = slotById_.find(id);
+  if (it == slotById_.end()) {
+    return;
+  }
+  const Slot slot = it->second;
+  unindexEntry(slot);
+  Entry& entry = entries_[slot];
+  entry.live = false;
+  entry.name.clear();
+  entry.author.clear();
+  freeSlots_.push_back(slot);
+  slotById_.erase(it);
+}
+
+bool NameSearchIndex::matchEntry(const Entry& entry,
+                                 const std::u32string& query,
+                                 const PatternMasks& masks,
+                                 int maxEdits,
+                                 Match& match,
+                                 std::size_t& matchLength) const {
+  bool found = false;
+  const auto consider = [&](const std::u32string& text, Field field) {
+    if (text.empty()) {
+      return;
+    }
+    Match candidate;
+    candidate.id = entry.id;
+    candidate.field = field;
+    if (maxEdits > 0) {
+      // 编辑距离为 0 即包含查询文本，无需另做子串查找
+      candidate.distance = boundedSubstringDistance(query, masks, text, maxEdits);
+      if (candidate.distance > maxEdits) {
+        return;
+      }
+    } else if (text.find(query) == std::u32string::npos) {
+      return;
+    }
+    candidate.prefix = startsWith(text, query);
+    if (!found || ranksBefore(candidate, text.size(), match, matchLength)) {
+      match = candidate;
+      matchLength = text.size();
+      found = true;
+    }
+  };
+  consider(entry.name, Field::Name);
+  consider(entry.author, Field::Author);
+  return found;
+}
+
+std::vector<NameSearchIndex::Match> NameSearchIndex::search(std::string_view query, std::size_t limit) const {
+  // 命中结果连同所在字段的长度一起排序，避免比较时反查条目
+  std::vector<std::pair<Match, std::size_t>> ranked;
+  const std::u32string normalized = normalize(query);
+  if (normalized.empty()) {
+    return {};
+  }
+  const int maxEdits = maxEditsFor(normalized.size());
+  const PatternMasks masks(normalized);
+  std::vector<char> matched(entries_.size(), 0);
+
+  const auto verify = [&](Slot slot, int edits) {
+    const Entry& entry = entries_[slot];
+    if (!entry.live || matched[slot]) {
+      return;
+    }
+    Match match;
+    std::size_t length = 0;
+    if (matchEntry(entry, normalized, masks, edits, match, length)) {
+      ranked.emplace_back(match, length);
+      matched[slot] = 1;
+    }
+  };
+  const auto enough = [&]() { return limit > 0 && ranked.size() >= limit; };
+
+  const std::vector<std::uint64_t> grams = gramsOf(normalized, 3);
+  if (normalized.size() == 2) {
+    // 两个码点的查询直接取对应二元组的倒排表
+    const auto it = postings_.find(packGram(kBigramPad, normalized[0], normalized[1]));
+    if (it != postings_.end()) {
+      for (const Slot slot : it->second) {
+        verify(slot, 0);
+      }
+    }
+  } else if (grams.empty()) {
+    // 单个码点的查询没有可用的倒排表，扫描全部条目
+    for (Slot slot = 0; slot < entries_.size(); ++slot) {
+      verify(slot, 0);
+    }
+  } else {
+    // 查询各 n 元组的倒排表（缺失的略去），按长度升序
+    const auto postingsOf = [this](const std::vector<std::uint64_t>& keys) {
+      std::vector<const std::vector<Slot>*> lists;
+      lists.reserve(keys.size());
+      for (const std::uint64_t gram : keys) {
+        const auto it = postings_.find(gram);
+        if (it != postings_.end()) {
+          lists.push_back(&it->second);
+        }
+      }
+      std::sort(lists.begin(), lists.end(), [](const auto* a, const auto* b) { return a->size() < b->size(); });
+      return lists;
+    };
+    /// 各条目命中的不同 n 元组个数，各级共用同一次计数。
+    struct HitCounts {
+      std::vector<std::uint16_t> hits;
+      std::vector<Slot> touched;
+    };
+    const auto countHits = [this](const std::vector<const std::vector<Slot>*>& lists, HitCounts& counts) {
+      if (!counts.hits.empty()) {
+        return;
+      }
+      counts.hits.assign(entries_.size(), 0);
+      for (const auto* list : lists) {
+        for (const Slot slot : *list) {
+          if (counts.hits[slot]++ == 0) {
+            counts.touched.push_back(slot);
+          }
+        }
+      }
+    };
+    const auto verifyCounted = [&](const HitCounts& counts, int required, int edits) {
+      for (const Slot slot : counts.touched) {
+        if (counts.hits[slot] >= required) {
+          verify(slot, edits);
+        }
+      }
+    };
+
+    const std::vector<const std::vector<Slot>*> lists = postingsOf(grams);
+    const std::vector<std::uint64_t> bigrams = gramsOf(normalized, 2);
+    std::vector<const std::vector<Slot>*> bigramLists;
+    HitCounts trigramHits;
+    HitCounts bigramHits;
+
+    // 按允许的编辑次数逐级放宽：排序以编辑距离为先，前一级已凑够 limit 条时后面的级别不可能进入结果
+    for (int edits = 0; edits <= maxEdits && !enough(); ++edits) {
+      // 相邻换位一次最多破坏 4 个三元组：命中数低于该下限的条目不可能在距离上限内
+      const int required = static_cast<int>(grams.size()) - 4 * edits;
+      if (required >= 1) {
+        if (static_cast<int>(lists.size()) < required) {
+          continue;
+        }
+        if (required == static_cast<int>(grams.size())) {
+          // 需要命中全部三元组时直接对倒排表求交，从最短的表开始
+          std::vector<Slot> candidates = *lists.front();
+          std::vector<Slot> next;
+          for (std::size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+            next.clear();
+            std::set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(),
+                                  std::back_inserter(next));
+            candidates.swap(next);
+          }
+          for (const Slot slot : candidates) {
+            verify(slot, edits);
+          }
+          continue;
+        }
+        countHits(lists, trigramHits);
+        verifyCounted(trigramHits, required, edits);
+        continue;
+      }
+
+      // 短查询的三元组下限降到 0 以下时改用二元组：相邻换位一次最多破坏 3 个
+      const int bigramRequired = static_cast<int>(bigrams.size()) - 3 * edits;
+      if (bigramRequired >= 1) {
+        if (bigramLists.empty()) {
+          bigramLists = postingsOf(bigrams);
+        }
+        if (static_cast<int>(bigramLists.size()) < bigramRequired) {
+          continue;
+        }
+        countHits(bigramLists, bigramHits);
+        verifyCounted(bigramHits, bigramRequired, edits);
+        continue;
+      }
+
+      // 二元组也无法排除任何条目，扫描全部条目
+      for (Slot slot = 0; slot < entries_.size(); ++slot) {
+        verify(slot, edits);
+      }
+    }
+  }
+
+  const auto before = [](const std::pair<Match, std::size_t>& a, const std::pair<Match, std::size_t>& b) {
+    return ranksBefore(a.first, a.second, b.first, b.second);
+  };
+  if (limit > 0 && ranked.size() > limit) {
+    std::partial_sort(ranked.begin(), ranked.begin() + static_cast<std::ptrdiff_t>(limit), ranked.end(), before);
+    ranked.resize(limit);
+  } else {
+    std::sort(ranked.begin(), ranked.end(), before);
+  }
+
+  std::vector<Match> matches;
+  matches.reserve(ranked.size());
+  for (const auto& entry : ranked) {
+    matches.push_back(entry.first);
+  }
+  return matches;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file NameSearchIndex.h
+ * @brief MOD 名称与作者的模糊搜索：三元组倒排索引 + 有界 Damerau-Levenshtein 重排。
+ * @details 文本先规范化（转小写、全角 ASCII 转半角、去掉空白与标点），再按码点切分为三元组，
+ *          每个三元组保存包含它的条目槽位（升序）。查询按允许的编辑次数逐级放宽，每级合并查询三元组的倒排表并计数，
+ *          命中数不少于“三元组数 - 4 × 编辑次数”的条目才进入校验（相邻交换一次最多破坏 4 个三元组）；
+ *          该下限不足 1 时改用二元组，下限为“二元组数 - 3 × 编辑次数”；两者都不足 1 时扫描全部条目，
+ *          即 4 个码点的查询在 1 次编辑、7 个码点的查询在 2 次编辑时退回全量扫描。
+ *          校验使用允许在文本任意位置开始与结束的有界编辑距离（含相邻交换），
+ *          结果按编辑距离、名称优先于作者、是否前缀匹配、文本长度排序。
+ *          两个码点的查询直接取二元组倒排表；单个码点的查询退回对全部条目做子串扫描。
+ *          条目可逐个增删，无需重建整个索引。不做拼音转换，中文名称按字匹配。
+ */
+class NameSearchIndex {
+public:
+  /// 命中的字段。
+  enum class Field : std::uint8_t {
+    Name,
+    Author,
+  };
+
+  struct Match {
+    int id{0};          ///< 调用方提供的条目 id
+    int distance{0};    ///< 编辑距离，0 表示包含查询文本
+    Field field{Field::Name};
+    bool prefix{false}; ///< 字段以查询文本开头
+  };
+
+  /// 规范化文本（输入为 UTF-8，非法字节按 U+FFFD 处理）。
+  static std::u32string normalize(std::string_view utf8);
+
+  /**
+   * @brief 查询 pattern 与 text 中任意子串之间的最小编辑距离（插入、删除、替换、相邻交换各计 1）。
+   * @return 距离；超过 maxDistance 时返回 maxDistance + 1 并提前结束。
+   */
+  static int boundedSubstringDistance(std::u32string_view pattern, std::u32string_view text, int maxDistance);
+
+  /// 查询允许的最大编辑次数，随规范化后的查询长度增加。
+  static int maxEditsFor(std::size_t queryLength);
+
+  void clear();
+  std::size_t size() const { return slotById_.size(); }
+
+  /// 新增或替换条目。
+  void upsert(int id, std::string_view name, std::string_view author);
+  void remove(int id);
+
+  /**
+   * @brief 搜索名称或作者。
+   * @param limit 最多返回的条数，0 表示不限。
+   * @return 按相关度从高到低排列的结果；查询规范化后为空时返回空列表。
+   */
+  std::vector<Match> search(std::string_view query, std::size_t limit = 50) const;
+
+private:
+  using Slot = std::uint32_t;
+  struct PatternMasks;
+
+  struct Entry {
+    int id{0};
+    std::u32string name;
+    std::u32string author;
+    bool live{false};
+  };
+
+  /// 文本中去重后的 n 元组键（n 为 2 或 3）。
+  static std::vector<std::uint64_t> gramsOf(const std::u32string& text, std::size_t n);
+  /// 条目名称与作者的全部二元组、三元组键。
+  static std::vector<std::uint64_t> entryGrams(const Entry& entry);
+  void indexEntry(Slot slot);
+  void unindexEntry(Slot slot);
+  /// 计算单个条目的最佳匹配；不满足距离上限时返回 false。
+  bool matchEntry(const Entry& entry,
+                  const std::u32string& query,
+                  const PatternMasks& masks,
+                  int maxEdits,
+                  Match& match,
+                  std::size_t& matchLength) const;
+  static int boundedSubstringDistance(std::u32string_view pattern,
+                                      const PatternMasks& masks,
+                                      std::u32string_view text,
+                                      int maxDistance);
+
+  std::vector<Entry> entries_;
+  std::vector<Slot> freeSlots_;
+  std::unordered_map<int, Slot> slotById_;
+  std::unordered_map<std::uint64_t, std::vector<Slot>> postings_;
+};
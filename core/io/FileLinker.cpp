@@ -0,0 +1,115 @@
+#include "core/io/FileLinker.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <sys/clonefile.h>
+#endif
+
+#include <cerrno>
+
+/**
+ * @file FileLinker.cpp
+ * @brief 文件链接策略的实现。
+ */
+
+std::string_view storageMethodName(StorageMethod method) {
+  switch (method) {
+    case StorageMethod::Move: return "move";
+    case StorageMethod::Copy: return "copy";
+    case StorageMethod::Reflink: return "reflink";
+    case StorageMethod::Hardlink: return "hardlink";
+    case StorageMethod::Symlink: return "symlink";
+  }
+  return "copy";
+}
+
+std::optional<StorageMethod> storageMethodFromName(std::string_view name) {
+  for (StorageMethod method : {StorageMethod::Move, StorageMethod::Copy, StorageMethod::Reflink,
+                               StorageMethod::Hardlink, StorageMethod::Symlink}) {
+    if (storageMethodName(method) == name) {
+      return method;
+    }
+  }
+  return std::nullopt;
+}
+
+bool reflinkFile(const std::filesystem::path& src, const std::filesystem::path& dst, std::error_code& ec) {
+  ec.clear();
+#if defined(__linux__) && defined(FICLONE)
+  const int srcFd = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+  if (srcFd < 0) {
+    ec.assign(errno, std::generic_category());
+    return false;
+  }
+  // 克隆只共享数据块，权限位需按源文件设置（例如只读或可执行）
+  struct stat st {};
+  if (::fstat(srcFd, &st) != 0) {
+    ec.assign(errno, std::generic_category());
+    ::close(srcFd);
+    return false;
+  }
+  const int dstFd = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, st.st_mode & 0777);
+  if (dstFd < 0) {
+    ec.assign(errno, std::generic_category());
+    ::close(srcFd);
+    return false;
+  }
+  const bool ok = ::ioctl(dstFd, FICLONE, srcFd) == 0;
+  if (!ok) {
+    ec.assign(errno, std::generic_category());
+  }
+  ::close(dstFd);
+  ::close(srcFd);
+  if (!ok) {
+    ::unlink(dst.c_str()); // 不支持克隆的文件系统上会留下空文件，需清理
+  }
+  return ok;
+#elif defined(__APPLE__)
+  if (::clonefile(src.c_str(), dst.c_str(), 0) != 0) {
+    ec.assign(errno, std::generic_category());
+    return false;
+  }
+  return true;
+#else
+  (void)src;
+  (void)dst;
+  ec = std::make_error_code(std::errc::operation_not_supported);
+  return false;
+#endif
+}
+
+std::optional<StorageMethod> linkFile(const std::filesystem::path& src,
+                                      const std::filesystem::path& dst,
+                                      std::error_code& ec,
+                                      bool allowSymlink) {
+  if (reflinkFile(src, dst, ec)) {
+    return StorageMethod::Reflink;
+  }
+
+  // 跨设备时返回 EXDEV，继续尝试后续方式
+  std::filesystem::create_hard_link(src, dst, ec);
+  if (!ec) {
+    return StorageMethod::Hardlink;
+  }
+
+  if (allowSymlink) {
+    const auto absoluteSrc = std::filesystem::absolute(src, ec);
+    if (!ec) {
+      std::filesystem::create_symlink(absoluteSrc, dst, ec);
+      if (!ec) {
+        return StorageMethod::Symlink;
+      }
+    }
+  }
+
+  std::filesystem::copy_file(src, dst, std::filesystem::copy_options::none, ec);
+  if (!ec) {
+    return StorageMethod::Copy;
+  }
+  return std::nullopt;
+}
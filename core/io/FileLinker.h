@@ -0,0 +1,53 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+/**
+ * @file FileLinker.h
+ * @brief 将文件“链接”进仓库目录：按 reflink → 硬链接 → 符号链接 → 复制 的顺序尝试。
+ * @details reflink（Linux FICLONE / macOS clonefile）与硬链接均不占用额外磁盘空间且几乎瞬时完成；
+ *          硬链接要求源与目标位于同一设备；符号链接依赖源文件保持原位；复制为最终兜底。
+ */
+
+/**
+ * @brief 文件进入仓库目录的方式，会记录在 mods.storage_method 中。
+ */
+enum class StorageMethod {
+  Move,     ///< 剪切（移动）
+  Copy,     ///< 完整复制
+  Reflink,  ///< 写时复制克隆（共享数据块）
+  Hardlink, ///< 硬链接
+  Symlink   ///< 符号链接
+};
+
+/**
+ * @brief 返回存储方式的持久化名称（move/copy/reflink/hardlink/symlink）。
+ */
+std::string_view storageMethodName(StorageMethod method);
+
+/**
+ * @brief 从持久化名称解析存储方式，无法识别时返回 std::nullopt。
+ */
+std::optional<StorageMethod> storageMethodFromName(std::string_view name);
+
+/**
+ * @brief 尝试以写时复制方式克隆文件，目标文件不得已存在。
+ * @param ec 失败原因；平台或文件系统不支持时为 std::errc::operation_not_supported。
+ * @return 成功返回 true，失败时不会留下目标文件。
+ */
+bool reflinkFile(const std::filesystem::path& src, const std::filesystem::path& dst, std::error_code& ec);
+
+/**
+ * @brief 按 reflink → 硬链接 → 符号链接 → 复制 的顺序将 src 链接到 dst。
+ * @param allowSymlink 是否允许使用符号链接（为 false 时跳过该方式直接复制）。
+ * @param ec 所有方式都失败时为最后一次失败的原因。
+ * @return 实际使用的方式；全部失败时返回 std::nullopt。
+ */
+std::optional<StorageMethod> linkFile(const std::filesystem::path& src,
+                                      const std::filesystem::path& dst,
+                                      std::error_code& ec,
+                                      bool allowSymlink = true);
@@ -0,0 +1,133 @@
+#include "core/io/MappedFile.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#include <utility>
+
+/**
+ * @file MappedFile.cpp
+ * @brief 只读内存映射文件的平台实现。
+ */
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    open_ = std::exchange(other.open_, false);
+#if defined(_WIN32)
+    mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+  }
+  return *this;
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(const std::filesystem::path& path, std::error_code& ec) {
+  close();
+  ec.clear();
+  HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    ec.assign(static_cast<int>(::GetLastError()), std::system_category());
+    return false;
+  }
+  LARGE_INTEGER size{};
+  if (!::GetFileSizeEx(file, &size)) {
+    ec.assign(static_cast<int>(::GetLastError()), std::system_category());
+    ::CloseHandle(file);
+    return false;
+  }
+  if (size.QuadPart == 0) {
+    ::CloseHandle(file);
+    open_ = true; // 空文件无法创建映射
+    return true;
+  }
+  HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  ::CloseHandle(file); // 映射对象持有文件引用
+  if (!mapping) {
+    ec.assign(static_cast<int>(::GetLastError()), std::system_category());
+    return false;
+  }
+  const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!view) {
+    ec.assign(static_cast<int>(::GetLastError()), std::system_category());
+    ::CloseHandle(mapping);
+    return false;
+  }
+  mapping_ = mapping;
+  data_ = static_cast<const std::uint8_t*>(view);
+  size_ = static_cast<std::size_t>(size.QuadPart);
+  open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_) {
+    ::UnmapViewOfFile(data_);
+  }
+  if (mapping_) {
+    ::CloseHandle(static_cast<HANDLE>(mapping_));
+  }
+  data_ = nullptr;
+  mapping_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+#else
+
+bool MappedFile::open(const std::filesystem::path& path, std::error_code& ec) {
+  close();
+  ec.clear();
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    ec.assign(errno, std::generic_category());
+    return false;
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ec.assign(errno, std::generic_category());
+    ::close(fd);
+    return false;
+  }
+  if (st.st_size == 0) {
+    ::close(fd);
+    open_ = true;
+    return true;
+  }
+  void* view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // 映射建立后即可关闭描述符
+  if (view == MAP_FAILED) {
+    ec.assign(errno, std::generic_category());
+    return false;
+  }
+  ::madvise(view, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+  data_ = static_cast<const std::uint8_t*>(view);
+  size_ = static_cast<std::size_t>(st.st_size);
+  open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_) {
+    ::munmap(const_cast<std::uint8_t*>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+
+/**
+ * @file MappedFile.h
+ * @brief 只读内存映射文件，用于对大文件做零拷贝的顺序读取（哈希、解析等）。
+ * @details POSIX 平台使用 mmap 并提示顺序访问，Windows 使用 CreateFileMapping/MapViewOfFile。
+ *          映射期间文件若被其它进程截断，访问越界部分的行为由操作系统决定，调用方应只映射稳定的文件。
+ */
+
+/**
+ * @brief 只读内存映射文件（仅可移动，不可复制）。
+ */
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile() { close(); }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * @brief 映射整个文件。
+   * @param ec 失败原因。
+   * @return 成功返回 true；空文件同样视为成功，此时 data() 为 nullptr。
+   */
+  bool open(const std::filesystem::path& path, std::error_code& ec);
+
+  /** @brief 解除映射并关闭文件。 */
+  void close();
+
+  bool isOpen() const { return open_; }
+  const std::uint8_t* data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private:
+  const std::uint8_t* data_{nullptr};
+  std::size_t size_{0};
+  bool open_{false};
+#if defined(_WIN32)
+  void* mapping_{nullptr};
+#endif
+};
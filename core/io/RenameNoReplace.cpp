@@ -0,0 +1,60 @@
+#include "core/io/RenameNoReplace.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+
+/**
+ * @file RenameNoReplace.cpp
+ * @brief 不覆盖已有目标的改名实现。
+ */
+
+void renameNoReplace(const std::filesystem::path& from, const std::filesystem::path& to, std::error_code& ec) {
+  ec.clear();
+#if defined(_WIN32)
+  // WRITE_THROUGH：返回时改名已落盘，调用方据目标存在判断提交完成
+  if (!::MoveFileExW(from.c_str(), to.c_str(), MOVEFILE_WRITE_THROUGH)) {
+    const DWORD error = ::GetLastError();
+    ec = (error == ERROR_ALREADY_EXISTS || error == ERROR_FILE_EXISTS)
+             ? std::make_error_code(std::errc::file_exists)
+             : std::error_code(static_cast<int>(error), std::system_category());
+  }
+#else
+#if defined(__linux__) && defined(RENAME_NOREPLACE)
+  if (::renameat2(AT_FDCWD, from.c_str(), AT_FDCWD, to.c_str(), RENAME_NOREPLACE) == 0) {
+    return;
+  }
+  if (errno != EINVAL && errno != ENOSYS) {
+    ec = std::error_code(errno, std::generic_category());
+    return;
+  }
+#endif
+  if (::link(from.c_str(), to.c_str()) == 0) {
+    if (::unlink(from.c_str()) != 0) {
+      ec = std::error_code(errno, std::generic_category());
+      ::unlink(to.c_str());
+    }
+    return;
+  }
+  if (errno != EPERM && errno != ENOTSUP && errno != EOPNOTSUPP && errno != EMLINK && errno != ENOSYS) {
+    ec = std::error_code(errno, std::generic_category());
+    return;
+  }
+  if (std::filesystem::exists(to, ec)) {
+    ec = std::make_error_code(std::errc::file_exists);
+    return;
+  }
+  if (!ec) {
+    std::filesystem::rename(from, to, ec);
+  }
+#endif
+}
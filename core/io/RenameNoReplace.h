@@ -0,0 +1,17 @@
+#pragma once
+
+#include <filesystem>
+#include <system_error>
+
+/**
+ * @file RenameNoReplace.h
+ * @brief 不覆盖已有目标的改名，供把临时文件提交为最终文件的各处共用。
+ */
+
+/**
+ * @brief 将 from 改名为 to，to 已存在时以 std::errc::file_exists 失败且不改动两者。
+ * @details 先检查再 rename 之间目标可能被并发任务创建，而 POSIX rename 会静默覆盖它。
+ *          Linux 使用 renameat2(RENAME_NOREPLACE)；文件系统不支持时改用 link + unlink（link 不覆盖已有文件）；
+ *          硬链接也不支持时才退回先检查后改名。Windows 的 MoveFileExW 不带 MOVEFILE_REPLACE_EXISTING 时本身不覆盖。
+ */
+void renameNoReplace(const std::filesystem::path& from, const std::filesystem::path& to, std::error_code& ec);
@@ -0,0 +1,349 @@
+#include "core/io/TransferEngine.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <io.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "core/io/RenameNoReplace.h"
+
+/**
+ * @file TransferEngine.cpp
+ * @brief 批量文件传输引擎的实现。
+ */
+
+namespace {
+
+bool isCancelled(const std::atomic<bool>* cancelled) {
+  return cancelled && cancelled->load();
+}
+
+/// 把目录项的变更（改名）落盘；部分文件系统不支持对目录 fsync，失败时忽略。
+void syncParentDirectory(const std::filesystem::path& file) {
+#if !defined(_WIN32)
+  const auto parent = file.has_parent_path() ? file.parent_path() : std::filesystem::path(".");
+  const int fd = ::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd >= 0) {
+    ::fsync(fd);
+    ::close(fd);
+  }
+#else
+  (void)file; // MoveFileExW 带 MOVEFILE_WRITE_THROUGH，返回时改名已落盘
+#endif
+}
+
+} // namespace
+
+/**
+ * @brief 多线程共享的令牌桶限速器：每个数据块传输后按实际字节数记账，并等待到其时间片结束。
+ */
+class TransferEngine::Throttle {
+public:
+  Throttle(std::uint64_t bytesPerSecond, const std::atomic<bool>* cancelled)
+      : bytesPerSecond_(bytesPerSecond), cancelled_(cancelled), next_(Clock::now()) {}
+
+  /// 记入已传输的 bytes 并等待；等待期间被取消时立即返回。
+  void consume(std::uint64_t bytes) {
+    if (bytesPerSecond_ == 0 || bytes == 0) {
+      return;
+    }
+    Clock::time_point wakeAt;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      const auto now = Clock::now();
+      if (next_ < now) {
+        next_ = now;
+      }
+      next_ += std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(static_cast<double>(bytes) / static_cast<double>(bytesPerSecond_)));
+      wakeAt = next_;
+    }
+    // 分段睡眠，限速很低时取消也能及时生效
+    while (!isCancelled(cancelled_)) {
+      const auto now = Clock::now();
+      if (now >= wakeAt) {
+        return;
+      }
+      std::this_thread::sleep_until(std::min(wakeAt, now + kCancelPollInterval));
+    }
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+  static constexpr auto kCancelPollInterval = std::chrono::milliseconds(50);
+  const std::uint64_t bytesPerSecond_;
+  const std::atomic<bool>* cancelled_;
+  std::mutex mutex_;
+  Clock::time_point next_;
+};
+
+TransferEngine::TransferEngine(TransferOptions options) : options_(std::move(options)) {
+  options_.queueDepth = std::max(1, options_.queueDepth);
+  options_.bufferSize = std::max<std::size_t>(options_.bufferSize, 64 * 1024);
+}
+
+std::vector<TransferResult> TransferEngine::run(const std::vector<TransferJob>& jobs) {
+  std::vector<TransferResult> results(jobs.size());
+  if (jobs.empty()) {
+    return results;
+  }
+
+  std::vector<std::uint64_t> sizes(jobs.size(), 0);
+  std::uint64_t totalBytes = 0;
+  for (std::size_t i = 0; i < jobs.size(); ++i) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(jobs[i].source, ec);
+    sizes[i] = ec ? 0 : static_cast<std::uint64_t>(size);
+    totalBytes += sizes[i];
+  }
+
+  Throttle throttle(options_.maxBytesPerSecond, options_.cancelled);
+  std::atomic<std::size_t> next{0};
+  std::atomic<std::uint64_t> doneBytes{0};
+
+  const auto worker = [&]() {
+    std::vector<char> buffer(options_.bufferSize); // 每个线程复用固定缓冲区
+    for (;;) {
+      const std::size_t index = next.fetch_add(1);
+      if (index >= jobs.size()) {
+        return;
+      }
+      const TransferJob& job = jobs[index];
+      TransferResult result;
+      std::error_code ec;
+      if (isCancelled(options_.cancelled)) {
+        result.error = std::make_error_code(std::errc::operation_canceled);
+      } else if (std::filesystem::exists(job.destination, ec)) {
+        result.error = std::make_error_code(std::errc::file_exists);
+      } else if (job.mode == TransferJob::Mode::Move) {
+        renameNoReplace(job.source, job.destination, ec);
+        if (ec == std::errc::file_exists) {
+          // 检查之后目标被其它任务创建，不覆盖也不再复制
+          result.error = ec;
+        } else if (!ec) {
+          result.renamed = true;
+          doneBytes += sizes[index];
+          if (options_.onProgress) {
+            options_.onProgress(doneBytes, totalBytes);
+          }
+        } else {
+          // 跨设备（或其它原因无法 rename）时复制后删除源文件
+          result = copyFile(job, buffer, throttle, doneBytes, totalBytes);
+          if (result.ok()) {
+            std::error_code removeError;
+            std::filesystem::remove(job.source, removeError);
+            result.sourceError = removeError;
+          }
+        }
+      } else {
+        result = copyFile(job, buffer, throttle, doneBytes, totalBytes);
+      }
+      results[index] = result;
+      if (options_.onFileDone) {
+        options_.onFileDone(index, results[index]);
+      }
+    }
+  };
+
+  const std::size_t threadCount = std::min<std::size_t>(static_cast<std::size_t>(options_.queueDepth), jobs.size());
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1);
+  for (std::size_t t = 1; t < threadCount; ++t) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+std::size_t TransferEngine::removeStalePartials(const std::filesystem::path& directory) {
+  std::size_t removed = 0;
+  std::error_code ec;
+  // 对象存储把文件写入 objects/ab/ 等子目录，需要递归清理
+  const auto options = std::filesystem::directory_options::skip_permission_denied;
+  for (std::filesystem::recursive_directory_iterator it(directory, options, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    const auto& path = it->path();
+    if (path.extension() == kPartialSuffix && it->is_regular_file(ec)) {
+      std::error_code removeError;
+      if (std::filesystem::remove(path, removeError)) {
+        ++removed;
+      }
+    }
+  }
+  return removed;
+}
+
+TransferResult TransferEngine::copyFile(const TransferJob& job, std::vector<char>& buffer, Throttle& throttle,
+                                        std::atomic<std::uint64_t>& doneBytes, std::uint64_t totalBytes) {
+  TransferResult result;
+  std::filesystem::path partial = job.destination;
+  partial += kPartialSuffix;
+  const auto reportChunk = [&](std::uint64_t bytes) {
+    result.bytes += bytes;
+    const std::uint64_t done = doneBytes.fetch_add(bytes) + bytes;
+    if (options_.onProgress) {
+      options_.onProgress(done, totalBytes);
+    }
+  };
+
+#if defined(__linux__)
+  const int in = ::open(job.source.c_str(), O_RDONLY | O_CLOEXEC);
+  if (in < 0) {
+    result.error.assign(errno, std::generic_category());
+    return result;
+  }
+  struct stat st {};
+  if (::fstat(in, &st) != 0) {
+    result.error.assign(errno, std::generic_category());
+    ::close(in);
+    return result;
+  }
+  const int out = ::open(partial.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, st.st_mode & 0777);
+  if (out < 0) {
+    result.error.assign(errno, std::generic_category());
+    ::close(in);
+    return result;
+  }
+
+  bool useCopyFileRange = true;
+  for (;;) {
+    if (isCancelled(options_.cancelled)) {
+      result.error = std::make_error_code(std::errc::operation_canceled);
+      break;
+    }
+    const std::size_t chunk = buffer.size();
+    ssize_t transferred = 0;
+    if (useCopyFileRange) {
+      // 在内核中完成拷贝，避免用户态缓冲区往返
+      transferred = ::copy_file_range(in, nullptr, out, nullptr, chunk, 0);
+      if (transferred < 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP)) {
+        useCopyFileRange = false;
+        continue;
+      }
+    } else {
+      transferred = ::read(in, buffer.data(), chunk);
+      if (transferred > 0) {
+        ssize_t written = 0;
+        while (written < transferred) {
+          const ssize_t n = ::write(out, buffer.data() + written, static_cast<std::size_t>(transferred - written));
+          if (n < 0) {
+            if (errno == EINTR) {
+              continue;
+            }
+            written = -1;
+            break;
+          }
+          written += n;
+        }
+        if (written < 0) {
+          transferred = -1;
+        }
+      }
+    }
+    if (transferred < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      result.error.assign(errno, std::generic_category());
+      break;
+    }
+    if (transferred == 0) {
+      break;
+    }
+    reportChunk(static_cast<std::uint64_t>(transferred));
+    throttle.consume(static_cast<std::uint64_t>(transferred));
+  }
+
+  // 数据落盘后再改名，避免断电后出现大小正确但内容不完整的目标文件
+  if (!result.error && ::fdatasync(out) != 0) {
+    result.error.assign(errno, std::generic_category());
+  }
+  if (::close(out) != 0 && !result.error) {
+    result.error.assign(errno, std::generic_category());
+  }
+  ::close(in);
+#else
+  std::ifstream in(job.source, std::ios::binary);
+  if (!in.is_open()) {
+    result.error = std::make_error_code(std::errc::no_such_file_or_directory);
+    return result;
+  }
+  // "x"：独占创建，临时文件已存在（另一任务正在写同一目标）时失败而不是截断
+#if defined(_WIN32)
+  std::FILE* out = ::_wfopen(partial.c_str(), L"wbx");
+#else
+  std::FILE* out = std::fopen(partial.c_str(), "wbx");
+#endif
+  if (!out) {
+    result.error.assign(errno, std::generic_category());
+    return result;
+  }
+  while (in) {
+    if (isCancelled(options_.cancelled)) {
+      result.error = std::make_error_code(std::errc::operation_canceled);
+      break;
+    }
+    in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    const std::streamsize count = in.gcount();
+    if (count <= 0) {
+      break;
+    }
+    if (std::fwrite(buffer.data(), 1, static_cast<std::size_t>(count), out) != static_cast<std::size_t>(count)) {
+      result.error = std::make_error_code(std::errc::io_error);
+      break;
+    }
+    reportChunk(static_cast<std::uint64_t>(count));
+    throttle.consume(static_cast<std::uint64_t>(count));
+  }
+  if (!result.error && in.bad()) {
+    result.error = std::make_error_code(std::errc::io_error);
+  }
+  if (!result.error) {
+    // 数据落盘后再改名，避免断电后出现大小正确但内容不完整的目标文件
+#if defined(_WIN32)
+    const bool synced = std::fflush(out) == 0 &&
+                        ::FlushFileBuffers(reinterpret_cast<HANDLE>(::_get_osfhandle(::_fileno(out))));
+#else
+    const bool synced = std::fflush(out) == 0 && ::fsync(::fileno(out)) == 0;
+#endif
+    if (!synced) {
+      result.error = std::make_error_code(std::errc::io_error);
+    }
+  }
+  if (std::fclose(out) != 0 && !result.error) {
+    result.error = std::make_error_code(std::errc::io_error);
+  }
+#endif
+
+  // 数据完整写入后才以目标名出现；失败时不保留不完整的临时文件
+  std::error_code ec;
+  if (!result.error) {
+    renameNoReplace(partial, job.destination, ec);
+    result.error = ec;
+    if (!ec) {
+      syncParentDirectory(job.destination);
+    }
+  }
+  if (result.error) {
+    std::filesystem::remove(partial, ec);
+  }
+  return result;
+}
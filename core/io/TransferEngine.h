@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <system_error>
+#include <vector>
+
+/**
+ * @file TransferEngine.h
+ * @brief 批量文件复制/移动引擎：多个文件并发传输，支持限速、进度回调与逐文件错误报告。
+ * @details 每个工作线程持有一块固定大小的缓冲区，按块传输以便限速与汇报进度；
+ *          Linux 上优先使用 copy_file_range 在内核中完成拷贝，不支持时退回到 read/write。
+ *          移动操作先尝试 rename，跨设备时再复制并删除源文件。
+ *          复制时先写入“目标名 + kPartialSuffix”的临时文件，数据落盘后再改名为目标文件并同步所在目录，
+ *          因此进程中途退出或断电只会留下可识别的临时文件，不会留下看似完整的半截目标文件。
+ */
+
+/**
+ * @brief 单个传输任务。
+ */
+struct TransferJob {
+  enum class Mode {
+    Copy, ///< 复制，保留源文件
+    Move  ///< 移动，跨设备时复制后删除源文件（删除失败记入 TransferResult::sourceError）
+  };
+  std::filesystem::path source;      ///< 源文件
+  std::filesystem::path destination; ///< 目标文件（不得已存在；传输途中被创建时同样以 file_exists 失败，不会覆盖）
+  Mode mode{Mode::Copy};
+};
+
+/**
+ * @brief 单个传输任务的结果。
+ */
+struct TransferResult {
+  std::error_code error;       ///< 失败原因，成功时为空
+  std::uint64_t bytes{0};      ///< 实际传输的字节数（同设备 rename 为 0）
+  bool renamed{false};         ///< 是否通过 rename 完成移动
+  std::error_code sourceError; ///< 跨设备移动已复制完成、但删除源文件失败的原因（目标文件完整，ok() 仍为 true）
+  bool ok() const { return !error; }
+};
+
+/**
+ * @brief 传输引擎参数。
+ */
+struct TransferOptions {
+  int queueDepth{4};                    ///< 同时进行的文件数（工作线程数）
+  std::size_t bufferSize{1 << 20};      ///< 每个工作线程的固定缓冲区大小（字节）
+  std::uint64_t maxBytesPerSecond{0};   ///< 总吞吐上限，0 表示不限速
+  /// 进度回调（任意工作线程中调用）：已传输字节数 / 总字节数
+  std::function<void(std::uint64_t doneBytes, std::uint64_t totalBytes)> onProgress;
+  /// 单个文件完成回调（任意工作线程中调用）
+  std::function<void(std::size_t jobIndex, const TransferResult& result)> onFileDone;
+  const std::atomic<bool>* cancelled{nullptr}; ///< 取消标志，置位后未开始的任务以 operation_canceled 失败
+};
+
+/**
+ * @brief 批量文件传输引擎。
+ */
+class TransferEngine {
+public:
+  /// 复制过程中临时文件的后缀。
+  static constexpr const char* kPartialSuffix = ".l4d2part";
+
+  explicit TransferEngine(TransferOptions options = {});
+
+  /**
+   * @brief 递归删除目录及其子目录中由中断的传输遗留的临时文件。
+   * @return 删除的文件数。
+   */
+  static std::size_t removeStalePartials(const std::filesystem::path& directory);
+
+  /**
+   * @brief 执行一批传输任务，阻塞直到全部完成。
+   * @return 与 jobs 一一对应的结果；失败的任务不会留下不完整的目标文件。
+   */
+  std::vector<TransferResult> run(const std::vector<TransferJob>& jobs);
+
+private:
+  class Throttle;
+
+  TransferResult copyFile(const TransferJob& job, std::vector<char>& buffer, Throttle& throttle,
+                          std::atomic<std::uint64_t>& doneBytes, std::uint64_t totalBytes);
+
+  TransferOptions options_;
+};
@@ -0,0 +1,314 @@
+#include "core/repo/CatalogSnapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "core/hash/Xxh64.h"
+
+/**
+ * @file CatalogSnapshot.cpp
+ * @brief 目录快照的写出、映射与校验。
+ */
+
+namespace {
+
+/// 字符串区中的一段字符串。
+struct StrRef {
+  std::uint32_t offset;
+  std::uint32_t length;
+};
+
+struct Header {
+  std::uint32_t magic;
+  std::uint32_t format_version;
+  std::int32_t schema_version;
+  std::uint32_t mod_count;
+  std::int64_t catalog_version;
+  std::uint32_t tag_count;
+  StrRef catalog_id;
+  std::uint32_t reserved0;
+  std::uint64_t arena_size;
+  std::uint64_t body_hash; ///< 文件头之后全部字节的 XXH64
+  std::uint64_t reserved1;
+};
+
+constexpr std::size_t kModStringCount = 17;
+
+struct ModRecord {
+  std::int32_t id;
+  std::int32_t rating;
+  std::int32_t category_id;
+  std::uint32_t flags; ///< 位 0：is_deleted
+  double size_mb;
+  std::uint32_t tag_begin;
+  std::uint32_t tag_count;
+  StrRef strings[kModStringCount]; ///< 顺序见 modStringFields
+};
+
+struct TagRecord {
+  std::int32_t id;
+  std::int32_t group_id;
+  std::int32_t group_priority;
+  std::int32_t priority;
+  StrRef group_name;
+  StrRef name;
+};
+
+static_assert(std::is_trivially_copyable_v<Header> && sizeof(Header) == 64);
+static_assert(std::is_trivially_copyable_v<ModRecord> && sizeof(ModRecord) % 8 == 0);
+static_assert(std::is_trivially_copyable_v<TagRecord> && sizeof(TagRecord) % 8 == 0);
+
+constexpr std::uint32_t kDeletedFlag = 1u;
+
+/// ModRecord::strings 与 ModRow 字符串字段的对应关系。
+constexpr std::string ModRow::*kModStringFields[kModStringCount] = {
+    &ModRow::name,          &ModRow::author,          &ModRow::note,
+    &ModRow::last_published_at, &ModRow::last_saved_at, &ModRow::status,
+    &ModRow::source_platform, &ModRow::source_url,    &ModRow::cover_path,
+    &ModRow::file_path,     &ModRow::file_hash,       &ModRow::integrity,
+    &ModRow::stability,     &ModRow::acquisition_method, &ModRow::storage_method,
+    &ModRow::hash_algo,     &ModRow::archive_member,
+};
+
+inline std::error_code malformed() {
+  return std::make_error_code(std::errc::illegal_byte_sequence);
+}
+
+/// 写出时去重的字符串区：分组名、状态等大量重复的字符串只存一份。
+class ArenaBuilder {
+public:
+  StrRef add(std::string_view text) {
+    if (text.empty()) {
+      return {0, 0};
+    }
+    const auto it = offsets_.find(std::string(text));
+    if (it != offsets_.end()) {
+      return {it->second, static_cast<std::uint32_t>(text.size())};
+    }
+    const auto offset = static_cast<std::uint32_t>(bytes_.size());
+    bytes_.append(text);
+    offsets_.emplace(std::string(text), offset);
+    return {offset, static_cast<std::uint32_t>(text.size())};
+  }
+
+  const std::string& bytes() const { return bytes_; }
+
+private:
+  std::string bytes_;
+  std::unordered_map<std::string, std::uint32_t> offsets_;
+};
+
+template <typename T>
+void append(std::vector<std::uint8_t>& out, const T& value) {
+  const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+  out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+T load(const std::uint8_t* p) {
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+inline bool fits(const StrRef& ref, std::uint64_t arenaSize) {
+  return static_cast<std::uint64_t>(ref.offset) + ref.length <= arenaSize;
+}
+
+inline std::string toString(const char* arena, const StrRef& ref) {
+  return std::string(arena + ref.offset, ref.length);
+}
+
+}  // namespace
+
+bool CatalogSnapshot::write(const std::filesystem::path& path,
+                            const CatalogSnapshotKey& key,
+                            const std::vector<ModRow>& mods,
+                            const std::unordered_map<int, std::vector<TagWithGroupRow>>& tagsByMod,
+                            std::error_code& ec) {
+  ec.clear();
+  ArenaBuilder arena;
+  std::vector<ModRecord> modRecords;
+  std::vector<TagRecord> tagRecords;
+  modRecords.reserve(mods.size());
+
+  for (const ModRow& mod : mods) {
+    ModRecord record{};
+    record.id = mod.id;
+    record.rating = mod.rating;
+    record.category_id = mod.category_id;
+    record.flags = mod.is_deleted ? kDeletedFlag : 0u;
+    record.size_mb = mod.size_mb;
+    record.tag_begin = static_cast<std::uint32_t>(tagRecords.size());
+    for (std::size_t i = 0; i < kModStringCount; ++i) {
+      record.strings[i] = arena.add(mod.*kModStringFields[i]);
+    }
+    const auto tags = tagsByMod.find(mod.id);
+    if (tags != tagsByMod.end()) {
+      for (const TagWithGroupRow& tag : tags->second) {
+        tagRecords.push_back({tag.id, tag.group_id, tag.group_priority, tag.priority,
+                              arena.add(tag.group_name), arena.add(tag.name)});
+      }
+    }
+    record.tag_count = static_cast<std::uint32_t>(tagRecords.size()) - record.tag_begin;
+    modRecords.push_back(record);
+  }
+
+  Header header{};
+  header.magic = kMagic;
+  header.format_version = kFormatVersion;
+  header.schema_version = key.schema_version;
+  header.mod_count = static_cast<std::uint32_t>(modRecords.size());
+  header.catalog_version = key.catalog_version;
+  header.tag_count = static_cast<std::uint32_t>(tagRecords.size());
+  header.catalog_id = arena.add(key.catalog_id);
+  header.arena_size = arena.bytes().size();
+
+  std::vector<std::uint8_t> body;
+  body.reserve(modRecords.size() * sizeof(ModRecord) + tagRecords.size() * sizeof(TagRecord) +
+               arena.bytes().size());
+  for (const ModRecord& record : modRecords) {
+    append(body, record);
+  }
+  for (const TagRecord& record : tagRecords) {
+    append(body, record);
+  }
+  body.insert(body.end(), arena.bytes().begin(), arena.bytes().end());
+  header.body_hash = Xxh64::hash(body.data(), body.size());
+
+  std::filesystem::path temp = path;
+  temp += ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      ec = std::make_error_code(std::errc::io_error);
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+    out.close();
+    if (!out) {
+      std::error_code ignored;
+      std::filesystem::remove(temp, ignored);
+      ec = std::make_error_code(std::errc::io_error);
+      return false;
+    }
+  }
+  std::filesystem::rename(temp, path, ec);
+  if (ec) {
+    std::error_code ignored;
+    std::filesystem::remove(temp, ignored);
+    return false;
+  }
+  return true;
+}
+
+bool CatalogSnapshot::open(const std::filesystem::path& path, const CatalogSnapshotKey& key, std::error_code& ec) {
+  close();
+  if (!file_.open(path, ec)) {
+    return false;
+  }
+  const std::uint8_t* data = file_.data();
+  const std::size_t size = file_.size();
+  const auto fail = [this, &ec](std::error_code reason) {
+    close();
+    ec = reason;
+    return false;
+  };
+
+  if (size < sizeof(Header)) {
+    return fail(malformed());
+  }
+  const auto header = load<Header>(data);
+  if (header.magic != kMagic || header.format_version != kFormatVersion) {
+    return fail(malformed());
+  }
+  const std::uint64_t expectedSize = sizeof(Header) + std::uint64_t{header.mod_count} * sizeof(ModRecord) +
+                                     std::uint64_t{header.tag_count} * sizeof(TagRecord) + header.arena_size;
+  if (expectedSize != size) {
+    return fail(malformed());
+  }
+  const auto* arena = reinterpret_cast<const char*>(data + (size - header.arena_size));
+  if (!fits(header.catalog_id, header.arena_size)) {
+    return fail(malformed());
+  }
+  // 先比较键：过期的快照无需计算校验和
+  const CatalogSnapshotKey stored{header.schema_version, header.catalog_version, toString(arena, header.catalog_id)};
+  if (stored != key) {
+    return fail(std::make_error_code(std::errc::invalid_argument));
+  }
+  if (Xxh64::hash(data + sizeof(Header), size - sizeof(Header)) != header.body_hash) {
+    return fail(malformed());
+  }
+
+  // 校验一次全部引用，之后的访问无需再做边界检查
+  const std::uint8_t* mods = data + sizeof(Header);
+  const std::uint8_t* tags = mods + std::size_t{header.mod_count} * sizeof(ModRecord);
+  for (std::uint32_t i = 0; i < header.mod_count; ++i) {
+    const auto record = load<ModRecord>(mods + std::size_t{i} * sizeof(ModRecord));
+    if (std::uint64_t{record.tag_begin} + record.tag_count > header.tag_count) {
+      return fail(malformed());
+    }
+    for (const StrRef& ref : record.strings) {
+      if (!fits(ref, header.arena_size)) {
+        return fail(malformed());
+      }
+    }
+  }
+  for (std::uint32_t i = 0; i < header.tag_count; ++i) {
+    const auto record = load<TagRecord>(tags + std::size_t{i} * sizeof(TagRecord));
+    if (!fits(record.group_name, header.arena_size) || !fits(record.name, header.arena_size)) {
+      return fail(malformed());
+    }
+  }
+
+  mods_ = mods;
+  tags_ = tags;
+  arena_ = arena;
+  modCount_ = header.mod_count;
+  ec.clear();
+  return true;
+}
+
+void CatalogSnapshot::close() {
+  file_.close();
+  mods_ = nullptr;
+  tags_ = nullptr;
+  arena_ = nullptr;
+  modCount_ = 0;
+}
+
+ModRow CatalogSnapshot::mod(std::size_t index) const {
+  const auto record = load<ModRecord>(mods_ + index * sizeof(ModRecord));
+  ModRow row;
+  row.id = record.id;
+  row.rating = record.rating;
+  row.category_id = record.category_id;
+  row.is_deleted = (record.flags & kDeletedFlag) != 0;
+  row.size_mb = record.size_mb;
+  for (std::size_t i = 0; i < kModStringCount; ++i) {
+    row.*kModStringFields[i] = toString(arena_, record.strings[i]);
+  }
+  return row;
+}
+
+std::vector<TagWithGroupRow> CatalogSnapshot::tags(std::size_t index) const {
+  const auto record = load<ModRecord>(mods_ + index * sizeof(ModRecord));
+  std::vector<TagWithGroupRow> rows;
+  rows.reserve(record.tag_count);
+  for (std::uint32_t i = 0; i < record.tag_count; ++i) {
+    const auto tag = load<TagRecord>(tags_ + std::size_t{record.tag_begin + i} * sizeof(TagRecord));
+    TagWithGroupRow row;
+    row.id = tag.id;
+    row.group_id = tag.group_id;
+    row.group_priority = tag.group_priority;
+    row.priority = tag.priority;
+    row.group_name = toString(arena_, tag.group_name);
+    row.name = toString(arena_, tag.name);
+    rows.push_back(std::move(row));
+  }
+  return rows;
+}
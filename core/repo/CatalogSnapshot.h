@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "core/io/MappedFile.h"
+#include "core/repo/RepositoryDao.h"
+#include "core/repo/TagDao.h"
+
+/**
+ * @file CatalogSnapshot.h
+ * @brief MOD 目录（MOD 行与标签绑定）的二进制快照，用于数据未变化时跳过逐条查询数据库。
+ * @details 文件为可直接映射的平铺布局：定长文件头、定长 MOD 记录表、定长标签记录表，之后是去重的字符串区；
+ *          记录中的字符串以（偏移, 长度）引用字符串区。文件头携带结构版本、目录变更计数与数据库标识，
+ *          三者与当前数据库一致且正文的 XXH64 校验通过时快照才有效。整数按本机字节序写入，
+ *          换到字节序不同的机器上魔数不匹配，快照自然作废。
+ */
+
+/**
+ * @brief 只读的目录快照（仅可移动，不可复制）。
+ */
+class CatalogSnapshot {
+public:
+  static constexpr std::uint32_t kMagic = 0x5343344C;   ///< "L4CS"
+  static constexpr std::uint32_t kFormatVersion = 1;
+
+  CatalogSnapshot() = default;
+  CatalogSnapshot(const CatalogSnapshot&) = delete;
+  CatalogSnapshot& operator=(const CatalogSnapshot&) = delete;
+  CatalogSnapshot(CatalogSnapshot&&) noexcept = default;
+  CatalogSnapshot& operator=(CatalogSnapshot&&) noexcept = default;
+
+  /**
+   * @brief 写出快照：先写入同目录的临时文件再替换，读取方不会看到写了一半的文件。
+   * @param tagsByMod MOD id -> 标签；没有条目的 MOD 视为无标签
+   */
+  static bool write(const std::filesystem::path& path,
+                    const CatalogSnapshotKey& key,
+                    const std::vector<ModRow>& mods,
+                    const std::unordered_map<int, std::vector<TagWithGroupRow>>& tagsByMod,
+                    std::error_code& ec);
+
+  /**
+   * @brief 映射并校验快照。
+   * @param ec 失败原因：与 key 不一致为 std::errc::invalid_argument，格式错误或校验失败为 std::errc::illegal_byte_sequence。
+   */
+  bool open(const std::filesystem::path& path, const CatalogSnapshotKey& key, std::error_code& ec);
+
+  /** @brief 解除映射。已取出的 ModRow 与标签不受影响。 */
+  void close();
+
+  std::size_t modCount() const { return modCount_; }
+  /** @brief 取出第 index 条 MOD（按写入顺序）。 */
+  ModRow mod(std::size_t index) const;
+  /** @brief 取出第 index 条 MOD 的标签（按写入顺序）。 */
+  std::vector<TagWithGroupRow> tags(std::size_t index) const;
+
+private:
+  MappedFile file_;
+  const std::uint8_t* mods_{nullptr};
+  const std::uint8_t* tags_{nullptr};
+  const char* arena_{nullptr};
+  std::size_t modCount_{0};
+};
@@ -21,6 +21,48 @@ inline void bindOptionalInt(Stmt& stmt, int index, const std::optional<int>& val
   }
 }
 
+/**
+ * @brief 将可选的 64 位指纹绑定到 SQLite 语句的参数上。
+ * @param stmt SQLite 语句对象。
+ * @param index 参数的索引（从1开始）。
+ * @param value 可选指纹。无值时绑定 NULL。
+ */
+inline void bindOptionalFingerprint(Stmt& stmt, int index, const std::optional<std::uint64_t>& value) {
+  if (value.has_value()) {
+    stmt.bind(index, static_cast<sqlite3_int64>(value.value()));
+  } else {
+    stmt.bindNull(index);
+  }
+}
+
+/**
+ * @brief 从查询结果中填充 GameModRow 结构。
+ * @details 假设 SELECT 列顺序为 id, name, file_path, source, file_size, modified_at,
+ *          status, repo_mod_id, last_scanned_at, fingerprint。
+ */
+GameModRow readGameModRow(const Stmt& stmt) {
+  GameModRow row;
+  row.id = stmt.getInt(0);
+  row.name = stmt.getText(1);
+  row.file_path = stmt.getText(2);
+  row.source = stmt.getText(3);
+  row.file_size = static_cast<std::uint64_t>(stmt.getInt64(4));
+  if (!stmt.isNull(5)) {
+    row.modified_at = stmt.getText(5);
+  }
+  row.status = stmt.getText(6);
+  if (!stmt.isNull(7)) {
+    row.repo_mod_id = stmt.getInt(7);
+  }
+  if (!stmt.isNull(8)) {
+    row.last_scanned_at = stmt.getText(8);
+  }
+  if (!stmt.isNull(9)) {
+    row.fingerprint = static_cast<std::uint64_t>(stmt.getInt64(9));
+  }
+  return row;
+}
+
 }  // namespace
 
 void GameModDao::replaceForSource(const std::string& source, const std::vector<GameModRow>& rows) {
@@ -34,8 +76,9 @@ void GameModDao::replaceForSource(const std::string& source, const std::vector<G
 
   // 步骤2: 准备插入新记录的语句
   Stmt ins(*db_, R"SQL(
-    INSERT INTO gamemods(name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at)
-    VALUES(?, ?, ?, ?, ?, ?, ?, ?);
+    INSERT INTO gamemods(name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at,
+                         fingerprint)
+    VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?);
   )SQL");
 
   // 步骤3: 遍历并插入所有新行
@@ -56,6 +99,7 @@ void GameModDao::replaceForSource(const std::string& source, const std::vector<G
     } else {
       ins.bindNull(8);
     }
+    bindOptionalFingerprint(ins, 9, row.fingerprint);
     ins.step();
     ins.reset(); // 重置语句以便下次循环使用
   }
@@ -66,7 +110,7 @@ void GameModDao::replaceForSource(const std::string& source, const std::vector<G
 
 std::optional<GameModRow> GameModDao::findByPath(const std::string& filePath) const {
   Stmt stmt(*db_, R"SQL(
-    SELECT id, name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at
+    SELECT id, name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at, fingerprint
     FROM gamemods
     WHERE file_path = ?;
   )SQL");
@@ -76,25 +120,7 @@ std::optional<GameModRow> GameModDao::findByPath(const std::string& filePath) co
   if (!stmt.step()) {
     return std::nullopt;
   }
-
-  // 从查询结果中填充 GameModRow 结构
-  GameModRow row;
-  row.id = stmt.getInt(0);
-  row.name = stmt.getText(1);
-  row.file_path = stmt.getText(2);
-  row.source = stmt.getText(3);
-  row.file_size = static_cast<std::uint64_t>(stmt.getInt64(4));
-  if (!stmt.isNull(5)) {
-    row.modified_at = stmt.getText(5);
-  }
-  row.status = stmt.getText(6);
-  if (!stmt.isNull(7)) {
-    row.repo_mod_id = stmt.getInt(7);
-  }
-  if (!stmt.isNull(8)) {
-    row.last_scanned_at = stmt.getText(8);
-  }
-  return row;
+  return readGameModRow(stmt);
 }
 
 void GameModDao::upsert(const GameModRow& row) {
@@ -102,8 +128,9 @@ void GameModDao::upsert(const GameModRow& row) {
   // 使用 "INSERT ... ON CONFLICT DO UPDATE" (即 "upsert") 语法
   // 如果 file_path 已存在，则更新现有记录；否则，插入新记录。
   Stmt stmt(*db_, R"SQL(
-    INSERT INTO gamemods(name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at)
-    VALUES(?, ?, ?, ?, ?, ?, ?, ?)
+    INSERT INTO gamemods(name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at,
+                         fingerprint)
+    VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?)
     ON CONFLICT(file_path) DO UPDATE SET
       name = excluded.name,
       source = excluded.source,
@@ -111,7 +138,8 @@ void GameModDao::upsert(const GameModRow& row) {
       modified_at = excluded.modified_at,
       status = excluded.status,
       repo_mod_id = excluded.repo_mod_id,
-      last_scanned_at = excluded.last_scanned_at;
+      last_scanned_at = excluded.last_scanned_at,
+      fingerprint = excluded.fingerprint;
   )SQL");
   
   // 绑定所有字段的值
@@ -131,6 +159,7 @@ void GameModDao::upsert(const GameModRow& row) {
   } else {
     stmt.bindNull(8);
   }
+  bindOptionalFingerprint(stmt, 9, row.fingerprint);
   
   stmt.step();
   tx.commit();
@@ -171,29 +200,13 @@ void GameModDao::removeByPaths(const std::string& source, const std::vector<std:
 std::vector<GameModRow> GameModDao::listAll() const {
   // 查询所有记录，并按来源和名称（不区分大小写）排序
   Stmt stmt(*db_, R"SQL(
-    SELECT id, name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at
+    SELECT id, name, file_path, source, file_size, modified_at, status, repo_mod_id, last_scanned_at, fingerprint
     FROM gamemods
     ORDER BY source, name COLLATE NOCASE;
   )SQL");
   std::vector<GameModRow> rows;
   while (stmt.step()) {
-    GameModRow row;
-    row.id = stmt.getInt(0);
-    row.name = stmt.getText(1);
-    row.file_path = stmt.getText(2);
-    row.source = stmt.getText(3);
-    row.file_size = static_cast<std::uint64_t>(stmt.getInt64(4));
-    if (!stmt.isNull(5)) {
-      row.modified_at = stmt.getText(5);
-    }
-    row.status = stmt.getText(6);
-    if (!stmt.isNull(7)) {
-      row.repo_mod_id = stmt.getInt(7);
-    }
-    if (!stmt.isNull(8)) {
-      row.last_scanned_at = stmt.getText(8);
-    }
-    rows.push_back(std::move(row));
+    rows.push_back(readGameModRow(stmt));
   }
   return rows;
 }
\ No newline at end of file
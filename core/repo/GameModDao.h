@@ -28,6 +28,7 @@ struct GameModRow {
   std::string status; ///< MOD状态（例如，是否启用）
   std::optional<int> repo_mod_id; ///< 关联的仓库MOD ID，可以为空
   std::string last_scanned_at; ///< 最后扫描时间
+  std::optional<std::uint64_t> fingerprint; ///< 首尾窗口内容指纹（与 file_size 共同构成完整指纹），可以为空
 };
 
 /**
@@ -0,0 +1,188 @@
+#include "core/repo/ImportJournalDao.h"
+
+#include <array>
+
+/**
+ * @file ImportJournalDao.cpp
+ * @brief 实现了 ImportJournalDao 类中定义的方法。
+ * @note SQLite 仅支持有符号 64 位整数，无符号值按位转换后存储，读取时再转换回来。
+ */
+
+namespace {
+
+constexpr std::array<ImportStage, 6> kAllStages = {ImportStage::Pending,  ImportStage::Hashed,
+                                                   ImportStage::Transferred, ImportStage::Inserted,
+                                                   ImportStage::Duplicate, ImportStage::Failed};
+
+void bindOptionalText(Stmt& stmt, int index, const std::string& value) {
+  if (value.empty()) {
+    stmt.bindNull(index);
+  } else {
+    stmt.bind(index, value);
+  }
+}
+
+} // namespace
+
+std::string_view importStageName(ImportStage stage) {
+  switch (stage) {
+  case ImportStage::Pending:
+    return "pending";
+  case ImportStage::Hashed:
+    return "hashed";
+  case ImportStage::Transferred:
+    return "transferred";
+  case ImportStage::Inserted:
+    return "inserted";
+  case ImportStage::Duplicate:
+    return "duplicate";
+  case ImportStage::Failed:
+    return "failed";
+  }
+  return {};
+}
+
+std::optional<ImportStage> importStageFromName(std::string_view name) {
+  for (ImportStage stage : kAllStages) {
+    if (importStageName(stage) == name) {
+      return stage;
+    }
+  }
+  return std::nullopt;
+}
+
+int ImportJournalDao::createJob(const std::string& sourceDir, bool recursive, const std::string& action) {
+  Stmt stmt(*db_, "INSERT INTO import_jobs(source_dir, recursive, action, status) VALUES(?, ?, ?, ?);");
+  stmt.bind(1, sourceDir);
+  stmt.bind(2, recursive ? 1 : 0);
+  bindOptionalText(stmt, 3, action);
+  stmt.bind(4, std::string(kImportJobRunning));
+  stmt.step();
+  return static_cast<int>(sqlite3_last_insert_rowid(db_->raw()));
+}
+
+std::optional<ImportJobRow> ImportJournalDao::findUnfinishedJob(const std::string& sourceDir) const {
+  Stmt stmt(*db_, R"SQL(
+    SELECT id, source_dir, recursive, COALESCE(action, ''), status, created_at, updated_at
+    FROM import_jobs
+    WHERE source_dir = ?
+    ORDER BY id DESC
+    LIMIT 1;
+  )SQL");
+  stmt.bind(1, sourceDir);
+  if (!stmt.step()) {
+    return std::nullopt;
+  }
+  ImportJobRow row;
+  row.id = stmt.getInt(0);
+  row.source_dir = stmt.getText(1);
+  row.recursive = stmt.getInt(2) != 0;
+  row.action = stmt.getText(3);
+  row.status = stmt.getText(4);
+  row.created_at = stmt.getText(5);
+  row.updated_at = stmt.getText(6);
+  return row;
+}
+
+void ImportJournalDao::setJobStatus(int jobId, const std::string& status) {
+  Stmt stmt(*db_, "UPDATE import_jobs SET status = ?, updated_at = datetime('now') WHERE id = ?;");
+  stmt.bind(1, status);
+  stmt.bind(2, jobId);
+  stmt.step();
+}
+
+void ImportJournalDao::deleteJob(int jobId) {
+  Stmt entries(*db_, "DELETE FROM import_journal WHERE job_id = ?;");
+  entries.bind(1, jobId);
+  entries.step();
+  Stmt job(*db_, "DELETE FROM import_jobs WHERE id = ?;");
+  job.bind(1, jobId);
+  job.step();
+}
+
+void ImportJournalDao::upsertEntries(const std::vector<ImportJournalRow>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+  Stmt stmt(*db_, R"SQL(
+    INSERT INTO import_journal(
+      job_id, source_path, size_bytes, modified_at, stage, file_hash, hash_algo, head_tail_hash,
+      mod_name, target_path, cover_path, storage_method, mod_id, error, updated_at
+    ) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, datetime('now'))
+    ON CONFLICT(job_id, source_path) DO UPDATE SET
+      size_bytes = excluded.size_bytes,
+      modified_at = excluded.modified_at,
+      stage = excluded.stage,
+      file_hash = excluded.file_hash,
+      hash_algo = excluded.hash_algo,
+      head_tail_hash = excluded.head_tail_hash,
+      mod_name = excluded.mod_name,
+      target_path = excluded.target_path,
+      cover_path = excluded.cover_path,
+      storage_method = excluded.storage_method,
+      mod_id = excluded.mod_id,
+      error = excluded.error,
+      updated_at = excluded.updated_at;
+  )SQL");
+
+  for (const auto& row : rows) {
+    stmt.bind(1, row.job_id);
+    stmt.bind(2, row.source_path);
+    stmt.bind(3, static_cast<sqlite3_int64>(row.size_bytes));
+    stmt.bind(4, static_cast<sqlite3_int64>(row.modified_at));
+    stmt.bind(5, std::string(importStageName(row.stage)));
+    bindOptionalText(stmt, 6, row.file_hash);
+    bindOptionalText(stmt, 7, row.hash_algo);
+    if (row.head_tail_hash) {
+      stmt.bind(8, static_cast<sqlite3_int64>(*row.head_tail_hash));
+    } else {
+      stmt.bindNull(8);
+    }
+    bindOptionalText(stmt, 9, row.mod_name);
+    bindOptionalText(stmt, 10, row.target_path);
+    bindOptionalText(stmt, 11, row.cover_path);
+    bindOptionalText(stmt, 12, row.storage_method);
+    if (row.mod_id > 0) {
+      stmt.bind(13, row.mod_id);
+    } else {
+      stmt.bindNull(13);
+    }
+    bindOptionalText(stmt, 14, row.error);
+    stmt.step();
+    stmt.reset(); // 重置语句以便下次循环使用
+  }
+}
+
+std::vector<ImportJournalRow> ImportJournalDao::listEntries(int jobId) const {
+  Stmt stmt(*db_, R"SQL(
+    SELECT job_id, source_path, size_bytes, modified_at, stage, COALESCE(file_hash, ''),
+           COALESCE(hash_algo, ''), head_tail_hash, COALESCE(mod_name, ''), COALESCE(target_path, ''),
+           COALESCE(cover_path, ''), COALESCE(storage_method, ''), COALESCE(mod_id, 0), COALESCE(error, '')
+    FROM import_journal
+    WHERE job_id = ?
+    ORDER BY source_path;
+  )SQL");
+  stmt.bind(1, jobId);
+  std::vector<ImportJournalRow> rows;
+  while (stmt.step()) {
+    ImportJournalRow row;
+    row.job_id = stmt.getInt(0);
+    row.source_path = stmt.getText(1);
+    row.size_bytes = static_cast<std::uint64_t>(stmt.getInt64(2));
+    row.modified_at = static_cast<std::int64_t>(stmt.getInt64(3));
+    row.stage = importStageFromName(stmt.getText(4)).value_or(ImportStage::Pending);
+    row.file_hash = stmt.getText(5);
+    row.hash_algo = stmt.getText(6);
+    if (!stmt.isNull(7)) {
+      row.head_tail_hash = static_cast<std::uint64_t>(stmt.getInt64(7));
+    }
+    row.mod_name = stmt.getText(8);
+    row.target_path = stmt.getText(9);
+    row.cover_path = stmt.getText(10);
+    row.storage_method = stmt.getText(11);
+    row.mod_id = stmt.getInt(12);
+    row.error = stmt.getText(13);
+    rows.push_back(std::move(row));
+  }
+  return rows;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/db/Db.h"
+#include "core/db/Stmt.h"
+
+/**
+ * @file ImportJournalDao.h
+ * @brief 负责维护批量导入日志（import_jobs / import_journal）。
+ * @details 每次文件夹导入对应一个任务，任务内每个源文件记录其所处阶段：
+ *          已哈希 → 已转移 → 已入库（或重复、失败）。导入中断后再次导入同一文件夹时，
+ *          可依据日志跳过已完成的文件、复用已算出的哈希，并为已转移但未入库的文件补登记录。
+ */
+
+/**
+ * @brief 单个文件在导入任务中的阶段。
+ */
+enum class ImportStage {
+  Pending,     ///< 已发现，尚未处理
+  Hashed,      ///< 指纹/哈希已计算
+  Transferred, ///< 文件已进入仓库目录，尚未写入 mods 表
+  Inserted,    ///< 已写入 mods 表
+  Duplicate,   ///< 与仓库或同批文件重复，已跳过
+  Failed       ///< 处理失败，续传时会重试
+};
+
+/**
+ * @brief 返回阶段的持久化名称。
+ */
+std::string_view importStageName(ImportStage stage);
+
+/**
+ * @brief 从持久化名称解析阶段，无法识别时返回 std::nullopt。
+ */
+std::optional<ImportStage> importStageFromName(std::string_view name);
+
+/// import_jobs.status 的取值
+inline constexpr const char* kImportJobRunning = "running";         ///< 正在进行（进程崩溃后也保持此状态）
+inline constexpr const char* kImportJobInterrupted = "interrupted"; ///< 被取消或有失败项，可续传
+
+/**
+ * @brief 代表 import_jobs 数据表中的一行记录。
+ */
+struct ImportJobRow {
+  int id{0}; ///< 任务ID
+  std::string source_dir; ///< 导入的源文件夹（规范化路径）
+  bool recursive{true}; ///< 是否包含子目录
+  std::string action; ///< 导入方式（cut/copy/link）
+  std::string status; ///< 任务状态
+  std::string created_at; ///< 创建时间
+  std::string updated_at; ///< 最后更新时间
+};
+
+/**
+ * @brief 代表 import_journal 数据表中的一行记录。
+ * @note 对于数据库中的可选字段，使用空字符串或0表示未设置。
+ */
+struct ImportJournalRow {
+  int job_id{0}; ///< 所属任务ID
+  std::string source_path; ///< 源文件路径（规范化绝对路径）
+  std::uint64_t size_bytes{0}; ///< 记录时的文件大小，用于判断源文件是否已变化
+  std::int64_t modified_at{0}; ///< 记录时的修改时间（毫秒时间戳）
+  ImportStage stage{ImportStage::Pending}; ///< 当前阶段
+  std::string file_hash; ///< 全量哈希
+  std::string hash_algo; ///< 哈希算法
+  std::optional<std::uint64_t> head_tail_hash; ///< 首尾指纹
+  std::string mod_name; ///< 待入库的 MOD 名称
+  std::string target_path; ///< 仓库中的目标文件路径（Transferred 之后有效）
+  std::string cover_path; ///< 封面路径（Transferred 之后为仓库内路径）
+  std::string storage_method; ///< 文件进入仓库的方式
+  int mod_id{0}; ///< 入库后的 MOD ID
+  std::string error; ///< 失败原因
+};
+
+/**
+ * @brief 导入日志数据访问对象（DAO）。
+ */
+class ImportJournalDao {
+public:
+  /**
+   * @brief 构造一个新的 ImportJournalDao 对象。
+   * @param db 数据库连接的共享指针。
+   */
+  explicit ImportJournalDao(std::shared_ptr<Db> db) : db_(std::move(db)) {}
+
+  /**
+   * @brief 创建一个状态为 running 的导入任务。
+   * @return 新任务的ID。
+   */
+  int createJob(const std::string& sourceDir, bool recursive, const std::string& action);
+
+  /**
+   * @brief 查找指定文件夹最近一次未完成的导入任务。
+   * @param sourceDir 规范化后的源文件夹路径。
+   */
+  std::optional<ImportJobRow> findUnfinishedJob(const std::string& sourceDir) const;
+
+  /**
+   * @brief 更新任务状态与更新时间。
+   */
+  void setJobStatus(int jobId, const std::string& status);
+
+  /**
+   * @brief 删除任务及其全部日志记录。
+   */
+  void deleteJob(int jobId);
+
+  /**
+   * @brief 批量写入或覆盖日志记录。
+   * @details 复用同一条预处理语句；调用方负责开启事务。
+   */
+  void upsertEntries(const std::vector<ImportJournalRow>& rows);
+
+  /**
+   * @brief 读取任务的全部日志记录。
+   */
+  std::vector<ImportJournalRow> listEntries(int jobId) const;
+
+private:
+  std::shared_ptr<Db> db_; ///< 数据库连接实例
+};
@@ -0,0 +1,92 @@
+#include "core/repo/ModAssetDao.h"
+
+#include <unordered_map>
+
+/**
+ * @file ModAssetDao.cpp
+ * @brief 实现了 ModAssetDao 类中定义的方法。
+ */
+
+void ModAssetDao::replaceMany(const std::vector<ModAssetList>& lists) {
+  if (lists.empty()) {
+    return;
+  }
+
+  Stmt insertPath(*db_, "INSERT OR IGNORE INTO asset_paths(path) VALUES(?);");
+  Stmt selectPath(*db_, "SELECT id FROM asset_paths WHERE path = ?;");
+  Stmt clearMod(*db_, "DELETE FROM mod_assets WHERE mod_id = ?;");
+  Stmt insertAsset(*db_, "INSERT OR IGNORE INTO mod_assets(mod_id, path_id) VALUES(?, ?);");
+  Stmt upsertScan(*db_, R"SQL(
+    INSERT INTO mod_asset_scans(mod_id, file_hash, path_count, scanned_at)
+    VALUES(?, ?, ?, datetime('now'))
+    ON CONFLICT(mod_id) DO UPDATE SET
+      file_hash = excluded.file_hash,
+      path_count = excluded.path_count,
+      scanned_at = excluded.scanned_at;
+  )SQL");
+
+  // 同一批次中的重复路径只查询一次
+  std::unordered_map<std::string, int> pathIds;
+  for (const auto& list : lists) {
+    clearMod.bind(1, list.mod_id);
+    clearMod.step();
+    clearMod.reset();
+
+    for (const auto& path : list.paths) {
+      auto it = pathIds.find(path);
+      if (it == pathIds.end()) {
+        insertPath.bind(1, path);
+        insertPath.step();
+        insertPath.reset();
+        selectPath.bind(1, path);
+        const int id = selectPath.step() ? selectPath.getInt(0) : 0;
+        selectPath.reset();
+        it = pathIds.emplace(path, id).first;
+      }
+      if (it->second <= 0) {
+        continue;
+      }
+      insertAsset.bind(1, list.mod_id);
+      insertAsset.bind(2, it->second);
+      insertAsset.step();
+      insertAsset.reset();
+    }
+
+    upsertScan.bind(1, list.mod_id);
+    upsertScan.bind(2, list.file_hash);
+    upsertScan.bind(3, static_cast<int>(list.paths.size()));
+    upsertScan.step();
+    upsertScan.reset();
+  }
+}
+
+std::vector<std::pair<int, std::string>> ModAssetDao::listPaths() const {
+  Stmt stmt(*db_, "SELECT id, path FROM asset_paths ORDER BY id;");
+  std::vector<std::pair<int, std::string>> rows;
+  while (stmt.step()) {
+    rows.emplace_back(stmt.getInt(0), stmt.getText(1));
+  }
+  return rows;
+}
+
+std::vector<std::pair<int, int>> ModAssetDao::listModAssets() const {
+  Stmt stmt(*db_, "SELECT mod_id, path_id FROM mod_assets ORDER BY mod_id, path_id;");
+  std::vector<std::pair<int, int>> rows;
+  while (stmt.step()) {
+    rows.emplace_back(stmt.getInt(0), stmt.getInt(1));
+  }
+  return rows;
+}
+
+std::vector<ModAssetScanRow> ModAssetDao::listScans() const {
+  Stmt stmt(*db_, "SELECT mod_id, COALESCE(file_hash, ''), path_count FROM mod_asset_scans;");
+  std::vector<ModAssetScanRow> rows;
+  while (stmt.step()) {
+    ModAssetScanRow row;
+    row.mod_id = stmt.getInt(0);
+    row.file_hash = stmt.getText(1);
+    row.path_count = stmt.getInt(2);
+    rows.push_back(std::move(row));
+  }
+  return rows;
+}
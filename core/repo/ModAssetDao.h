@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/db/Db.h"
+#include "core/db/Stmt.h"
+
+/**
+ * @file ModAssetDao.h
+ * @brief 负责维护 MOD 资源路径索引（asset_paths / mod_assets / mod_asset_scans）。
+ * @details 路径在 asset_paths 中去重存储，mod_assets 只保存 (mod_id, path_id)，
+ *          idx_mod_assets_path 即“路径 -> MOD”的倒排索引。
+ */
+
+/**
+ * @brief 代表 mod_asset_scans 数据表中的一行记录。
+ */
+struct ModAssetScanRow {
+  int mod_id{0};         ///< 关联的仓库 MOD ID
+  std::string file_hash; ///< 扫描时 MOD 文件的哈希，与 mods.file_hash 不一致时需要重新扫描
+  int path_count{0};     ///< 参与冲突检测的资源路径数
+};
+
+/**
+ * @brief 单个 MOD 的资源路径列表，作为批量写入的输入。
+ */
+struct ModAssetList {
+  int mod_id{0};
+  std::string file_hash;
+  std::vector<std::string> paths; ///< 已规范化的资源路径
+};
+
+/**
+ * @brief MOD 资源路径数据访问对象（DAO）。
+ */
+class ModAssetDao {
+public:
+  /**
+   * @brief 构造一个新的 ModAssetDao 对象。
+   * @param db 数据库连接的共享指针。
+   */
+  explicit ModAssetDao(std::shared_ptr<Db> db) : db_(std::move(db)) {}
+
+  /**
+   * @brief 替换一批 MOD 的资源路径并记录扫描结果。
+   * @details 路径按需写入 asset_paths；调用方负责开启事务。
+   */
+  void replaceMany(const std::vector<ModAssetList>& lists);
+
+  /**
+   * @brief 读取全部驻留路径。
+   * @return (path_id, path) 列表，按 ID 排序。
+   */
+  std::vector<std::pair<int, std::string>> listPaths() const;
+
+  /**
+   * @brief 读取全部 (mod_id, path_id) 记录，按 MOD ID、路径 ID 排序。
+   */
+  std::vector<std::pair<int, int>> listModAssets() const;
+
+  /**
+   * @brief 读取全部扫描记录。
+   */
+  std::vector<ModAssetScanRow> listScans() const;
+
+private:
+  std::shared_ptr<Db> db_; ///< 数据库连接实例
+};
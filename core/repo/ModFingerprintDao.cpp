@@ -0,0 +1,51 @@
+#include "core/repo/ModFingerprintDao.h"
+
+/**
+ * @file ModFingerprintDao.cpp
+ * @brief 实现了 ModFingerprintDao 类中定义的方法。
+ * @note SQLite 仅支持有符号 64 位整数，无符号值按位转换后存储，读取时再转换回来。
+ */
+
+void ModFingerprintDao::upsertMany(const std::vector<ModFingerprintRow>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+
+  Db::Tx tx(*db_);
+  Stmt stmt(*db_, R"SQL(
+    INSERT INTO mod_fingerprints(mod_id, size_bytes, head_tail_hash, updated_at)
+    VALUES(?, ?, ?, datetime('now'))
+    ON CONFLICT(mod_id) DO UPDATE SET
+      size_bytes = excluded.size_bytes,
+      head_tail_hash = excluded.head_tail_hash,
+      updated_at = excluded.updated_at;
+  )SQL");
+
+  for (const auto& row : rows) {
+    stmt.bind(1, row.mod_id);
+    stmt.bind(2, static_cast<sqlite3_int64>(row.size_bytes));
+    stmt.bind(3, static_cast<sqlite3_int64>(row.head_tail_hash));
+    stmt.step();
+    stmt.reset(); // 重置语句以便下次循环使用
+  }
+  tx.commit();
+}
+
+void ModFingerprintDao::remove(int modId) {
+  Stmt stmt(*db_, "DELETE FROM mod_fingerprints WHERE mod_id = ?;");
+  stmt.bind(1, modId);
+  stmt.step();
+}
+
+std::vector<ModFingerprintRow> ModFingerprintDao::listAll() const {
+  Stmt stmt(*db_, "SELECT mod_id, size_bytes, head_tail_hash FROM mod_fingerprints;");
+  std::vector<ModFingerprintRow> rows;
+  while (stmt.step()) {
+    ModFingerprintRow row;
+    row.mod_id = stmt.getInt(0);
+    row.size_bytes = static_cast<std::uint64_t>(stmt.getInt64(1));
+    row.head_tail_hash = static_cast<std::uint64_t>(stmt.getInt64(2));
+    rows.push_back(row);
+  }
+  return rows;
+}
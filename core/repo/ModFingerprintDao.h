@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/db/Db.h"
+#include "core/db/Stmt.h"
+
+/**
+ * @file ModFingerprintDao.h
+ * @brief 负责维护仓库 MOD 的内容指纹表（mod_fingerprints）。
+ * @details 指纹由文件大小与首尾 64 KiB 的快速哈希组成，用于在游戏目录扫描时识别被重命名或移动的文件。
+ */
+
+/**
+ * @brief 代表 mod_fingerprints 数据表中的一行记录。
+ */
+struct ModFingerprintRow {
+  int mod_id{0}; ///< 关联的仓库 MOD ID
+  std::uint64_t size_bytes{0}; ///< 文件大小（字节）
+  std::uint64_t head_tail_hash{0}; ///< 首尾窗口哈希
+};
+
+/**
+ * @brief MOD 指纹数据访问对象（DAO）。
+ */
+class ModFingerprintDao {
+public:
+  /**
+   * @brief 构造一个新的 ModFingerprintDao 对象。
+   * @param db 数据库连接的共享指针。
+   */
+  explicit ModFingerprintDao(std::shared_ptr<Db> db) : db_(std::move(db)) {}
+
+  /**
+   * @brief 批量写入或覆盖指纹记录。
+   * @details 所有记录在单个事务中写入，并复用同一条预处理语句。
+   * @param rows 待写入的指纹记录。
+   */
+  void upsertMany(const std::vector<ModFingerprintRow>& rows);
+
+  /**
+   * @brief 删除指定 MOD 的指纹记录。
+   * @param modId MOD ID。
+   */
+  void remove(int modId);
+
+  /**
+   * @brief 读取全部指纹记录。
+   * @return 指纹记录列表。
+   */
+  std::vector<ModFingerprintRow> listAll() const;
+
+private:
+  std::shared_ptr<Db> db_; ///< 数据库连接实例
+};
@@ -0,0 +1,98 @@
+#include "core/repo/ModPageSource.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * @file ModPageSource.cpp
+ * @brief 键集分页数据源的实现。
+ */
+
+ModPageSource::ModPageSource(const RepositoryService& repo, ModPageFilter filter,
+                             std::size_t pageSize, std::size_t cachedPages)
+    : repo_(repo),
+      filter_(std::move(filter)),
+      pageSize_(std::max<std::size_t>(pageSize, 1)),
+      pages_(std::max<std::size_t>(cachedPages, 1)) {}
+
+std::size_t ModPageSource::count() {
+  if (!count_) {
+    count_ = static_cast<std::size_t>(repo_.countMods(filter_));
+  }
+  return *count_;
+}
+
+const ModRow* ModPageSource::rowAt(std::size_t index) {
+  if (index >= count()) {
+    return nullptr;
+  }
+  Page rows = page(index / pageSize_);
+  const std::size_t offset = index % pageSize_;
+  if (!rows || offset >= rows->size()) {
+    return nullptr;
+  }
+  current_ = std::move(rows);
+  return &(*current_)[offset];
+}
+
+int ModPageSource::indexOf(const ModRow& mod) {
+  const int rank = repo_.countMods(filter_, ModPageKey{mod.name, mod.id});
+  // 排名只说明有多少行排在它前面，还需确认该行本身满足筛选条件
+  const ModRow* row = rowAt(static_cast<std::size_t>(rank));
+  return row && row->id == mod.id ? rank : -1;
+}
+
+int ModPageSource::indexOf(int modId) {
+  const auto mod = repo_.findMod(modId);
+  return mod ? indexOf(*mod) : -1;
+}
+
+void ModPageSource::invalidate() {
+  count_.reset();
+  pages_.clear();
+  startKeys_.clear();
+  current_.reset();
+}
+
+ModPageSource::Page ModPageSource::page(std::size_t pageIndex) {
+  if (const Page* cached = pages_.find(pageIndex)) {
+    return *cached;
+  }
+  const auto after = startKey(pageIndex);
+  if (pageIndex > 0 && !after) {
+    return nullptr;
+  }
+  auto rows = std::make_shared<const std::vector<ModRow>>(
+      repo_.listModsPage(filter_, after, static_cast<int>(pageSize_)));
+  if (rows->size() == pageSize_) {
+    startKeys_[pageIndex + 1] = ModPageKey{rows->back().name, rows->back().id};
+  }
+  pages_.insert(pageIndex, rows, 1);
+  return rows;
+}
+
+std::optional<ModPageKey> ModPageSource::startKey(std::size_t pageIndex) {
+  if (pageIndex == 0) {
+    return std::nullopt;
+  }
+  const auto known = startKeys_.find(pageIndex);
+  if (known != startKeys_.end()) {
+    return known->second;
+  }
+
+  // 从最近的已知页向后数到目标页前一行，只扫描按名称排序的索引
+  std::size_t base = 0;
+  std::optional<ModPageKey> baseKey;
+  auto below = startKeys_.lower_bound(pageIndex);
+  if (below != startKeys_.begin()) {
+    --below;
+    base = below->first;
+    baseKey = below->second;
+  }
+  const std::size_t offset = (pageIndex - base) * pageSize_ - 1;
+  auto key = repo_.modPageKeyAt(filter_, baseKey, static_cast<int>(offset));
+  if (key) {
+    startKeys_[pageIndex] = *key;
+  }
+  return key;
+}
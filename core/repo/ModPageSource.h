@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "core/repo/RepositoryService.h"
+#include "core/util/LruCache.h"
+
+/**
+ * @file ModPageSource.h
+ * @brief 按需分页读取 MOD 的数据源，供超大仓库的表格使用。
+ * @details 筛选在 SQL 中执行，行按名称（NOCASE）、id 排序并以键集分页读取：每页以上一页最后一行的键为起点，
+ *          不使用随 OFFSET 变慢的整表偏移。最近访问的若干页缓存在内存中，总数由聚合查询给出，
+ *          因此内存占用只与页大小和缓存页数有关，与仓库规模无关。
+ *          跳到未访问过的远处页时，从最近的已知页起用只扫描索引的 OFFSET 查询定位该页的起始键。
+ *          数据库发生写入后应调用 invalidate()。非线程安全。
+ */
+class ModPageSource {
+public:
+  /**
+   * @param repo 仓库服务，须在本对象销毁前保持有效
+   * @param pageSize 每页行数
+   * @param cachedPages 最多缓存的页数
+   */
+  ModPageSource(const RepositoryService& repo, ModPageFilter filter,
+                std::size_t pageSize = 256, std::size_t cachedPages = 8);
+
+  const ModPageFilter& filter() const { return filter_; }
+
+  /// 满足筛选条件的行数（首次调用时查询并缓存）。
+  std::size_t count();
+
+  /**
+   * @brief 第 index 行的 MOD，越界时返回 nullptr。
+   * @note 返回的指针在下一次调用 rowAt()、indexOf() 或 invalidate() 之前有效。
+   */
+  const ModRow* rowAt(std::size_t index);
+
+  /// MOD 所在的行；不满足筛选条件时返回 -1。
+  int indexOf(const ModRow& mod);
+  /// 同上，先按 id 读取 MOD；MOD 不存在时返回 -1。
+  int indexOf(int modId);
+
+  /// 丢弃缓存的页、页起始键与总数。
+  void invalidate();
+
+  /// 当前缓存的页数。
+  std::size_t cachedPageCount() const { return pages_.size(); }
+
+private:
+  using Page = std::shared_ptr<const std::vector<ModRow>>;
+
+  Page page(std::size_t pageIndex);
+  /// 第 pageIndex 页之前一行的键；第 0 页为空。
+  std::optional<ModPageKey> startKey(std::size_t pageIndex);
+
+  const RepositoryService& repo_;
+  ModPageFilter filter_;
+  std::size_t pageSize_;
+  std::optional<std::size_t> count_;
+  LruCache<std::size_t, Page> pages_;
+  std::map<std::size_t, ModPageKey> startKeys_; ///< 已知的页起始键（页下标 -> 上一页最后一行的键）
+  Page current_;                                ///< 最近一次 rowAt 所在的页，保证返回的指针有效
+};
@@ -81,4 +81,26 @@ std::vector<ModRelationRow> ModRelationDao::listByMod(int modId) const {
     rows.push_back(std::move(row));
   }
   return rows;
-}
\ No newline at end of file
+}
+
+std::vector<ModRelationRow> ModRelationDao::listAll() const {
+  Stmt stmt(*db_, R"SQL(
+    SELECT id, a_mod_id, b_mod_id, type, slot_key, note
+    FROM mod_relations
+    ORDER BY id;
+  )SQL");
+
+  std::vector<ModRelationRow> rows;
+  while (stmt.step()) {
+    ModRelationRow row;
+    row.id = stmt.getInt(0);
+    row.a_mod_id = stmt.getInt(1);
+    row.b_mod_id = stmt.getInt(2);
+    row.type = stmt.getText(3);
+    // 处理可选字段
+    row.slot_key = stmt.isNull(4) ? std::optional<std::string>{} : std::optional<std::string>{stmt.getText(4)};
+    row.note = stmt.isNull(5) ? std::optional<std::string>{} : std::optional<std::string>{stmt.getText(5)};
+    rows.push_back(std::move(row));
+  }
+  return rows;
+}
@@ -76,6 +76,13 @@ public:
    */
   std::vector<ModRelationRow> listByMod(int modId) const;
 
+  /**
+   * @brief 查询全部关系记录。
+   * @details 用于批量比对（如自动冲突检测时排除已有关系的 MOD 对）。
+   * @return 按ID排序的全部关系记录。
+   */
+  std::vector<ModRelationRow> listAll() const;
+
 private:
   std::shared_ptr<Db> db_; ///< 数据库连接实例
 };
\ No newline at end of file
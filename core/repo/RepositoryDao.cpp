@@ -1,5 +1,9 @@
 #include "core/repo/RepositoryDao.h"
 
+#include <algorithm>
+#include <cctype>
+#include <variant>
+
 /**
  * @file RepositoryDao.cpp
  * @brief 实现了 RepositoryDao 类中定义的方法。
@@ -62,20 +66,141 @@ ModRow readRow(Stmt& stmt) {
       stmt.getDouble(15),          // size_mb
       stmt.getText(16),            // integrity
       stmt.getText(17),            // stability
-      stmt.getText(18)             // acquisition_method
+      stmt.getText(18),            // acquisition_method
+      stmt.getText(19),            // storage_method
+      stmt.getText(20),            // hash_algo
+      stmt.getText(21)             // archive_member
   };
 }
 
+/// readRow 所需的列，顺序与 ModRow 成员一致。
+constexpr const char* kModColumns = R"SQL(
+    id, name, COALESCE(author, ''), COALESCE(rating, 0), COALESCE(category_id, 0),
+    COALESCE(note, ''), COALESCE(last_published_at, ''), COALESCE(last_saved_at, ''),
+    COALESCE(status, '最新'), COALESCE(source_platform, ''), COALESCE(source_url, ''),
+    is_deleted, COALESCE(cover_path, ''), COALESCE(file_path, ''),
+    COALESCE(file_hash, ''), size_mb, COALESCE(integrity, ''),
+    COALESCE(stability, ''), COALESCE(acquisition_method, ''),
+    COALESCE(storage_method, ''), COALESCE(hash_algo, ''),
+    COALESCE(archive_member, '')
+)SQL";
+
+/**
+ * @brief 分页查询的 WHERE 子句及其参数，参数按出现顺序从 1 开始绑定。
+ */
+struct PageWhere {
+  std::string sql;
+  std::vector<std::variant<int, std::string>> params;
+
+  void add(const char* clause) {
+    sql += sql.empty() ? " WHERE " : " AND ";
+    sql += clause;
+  }
+
+  /// 追加键比较条件，op 为 "<" 或 ">"；名称按 NOCASE 比较，与索引及排序一致。
+  void addKey(const char* op, const ModPageKey& key) {
+    add(op[0] == '<' ? "(name, id) < (? COLLATE NOCASE, ?)" : "(name, id) > (? COLLATE NOCASE, ?)");
+    params.emplace_back(key.name);
+    params.emplace_back(key.id);
+  }
+
+  /// 绑定全部参数，返回下一个可用的参数下标。
+  int bindAll(Stmt& stmt) const {
+    int index = 1;
+    for (const auto& param : params) {
+      std::visit([&stmt, index](const auto& value) { stmt.bind(index, value); }, param);
+      ++index;
+    }
+    return index;
+  }
+};
+
+/**
+ * @brief 把筛选条件转换为 WHERE 子句；各条件均可使用迁移 10 建立的索引。
+ */
+PageWhere buildPageWhere(const ModPageFilter& filter) {
+  PageWhere where;
+  if (!filter.include_deleted) {
+    // 索引末尾带有 is_deleted，该条件直接在索引中判断
+    where.add("is_deleted = 0");
+  }
+  if (filter.category_id) {
+    if (*filter.category_id <= 0) {
+      where.add("(category_id IS NULL OR category_id = 0)");
+    } else {
+      where.add(R"SQL(category_id IN (
+        WITH RECURSIVE subtree(id) AS (
+          SELECT ?
+          UNION ALL
+          SELECT c.id FROM categories c JOIN subtree s ON c.parent_id = s.id
+        )
+        SELECT id FROM subtree))SQL");
+      where.params.emplace_back(*filter.category_id);
+    }
+  }
+  if (filter.tag_id) {
+    if (*filter.tag_id <= 0) {
+      where.add("NOT EXISTS (SELECT 1 FROM mod_tags mt WHERE mt.mod_id = mods.id)");
+    } else {
+      where.add("id IN (SELECT mod_id FROM mod_tags WHERE tag_id = ?)");
+      where.params.emplace_back(*filter.tag_id);
+    }
+  }
+  if (filter.author) {
+    if (filter.author->empty()) {
+      where.add("(author IS NULL OR author = '')");
+    } else {
+      where.add("author = ?");
+      where.params.emplace_back(*filter.author);
+    }
+  }
+  if (filter.rating) {
+    if (*filter.rating <= 0) {
+      where.add("(rating IS NULL OR rating <= 0)");
+    } else {
+      where.add("rating = ?");
+      where.params.emplace_back(*filter.rating);
+    }
+  }
+  if (!filter.name_prefix.empty()) {
+    // UTF-8 中不会出现 0xFF 字节，前缀后接 0xFF 即为所有以该前缀开头的名称的上界；
+    // NOCASE 只折叠 ASCII 字母，与 idx_mods_name 的排序规则一致，可按索引范围查找
+    where.add("name >= ? COLLATE NOCASE AND name < ? COLLATE NOCASE");
+    where.params.emplace_back(filter.name_prefix);
+    where.params.emplace_back(filter.name_prefix + '\xFF');
+  }
+  return where;
+}
+
 } // namespace
 
+std::string modFileStem(const ModRow& mod) {
+  const std::string& path = mod.archive_member.empty() ? mod.file_path : mod.archive_member;
+  const auto slash = path.find_last_of("/\\");
+  std::string stem = path.substr(slash == std::string::npos ? 0 : slash + 1);
+  const auto dot = stem.rfind('.');
+  if (dot != std::string::npos) {
+    stem.erase(dot);
+  }
+  const auto sameChar = [](char a, char b) {
+    return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+  };
+  if (mod.archive_member.empty() && !mod.file_hash.empty() &&
+      std::equal(stem.begin(), stem.end(), mod.file_hash.begin(), mod.file_hash.end(), sameChar)) {
+    return {};
+  }
+  return stem;
+}
+
 int RepositoryDao::insertMod(const ModRow& row) {
   // 准备 SQL INSERT 语句
   Stmt stmt(*db_, R"SQL(
     INSERT INTO mods(
       name, author, rating, category_id, note, last_published_at, last_saved_at,
       status, source_platform, source_url, is_deleted, cover_path, file_path,
-      file_hash, size_mb, integrity, stability, acquisition_method
-    ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);
+      file_hash, size_mb, integrity, stability, acquisition_method, storage_method, hash_algo,
+      archive_member
+    ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);
   )SQL");
 
   // 依次绑定 ModRow 中的所有字段到语句中
@@ -97,6 +222,9 @@ int RepositoryDao::insertMod(const ModRow& row) {
   bindOptionalText(stmt, 16, row.integrity);
   bindOptionalText(stmt, 17, row.stability);
   bindOptionalText(stmt, 18, row.acquisition_method);
+  bindOptionalText(stmt, 19, row.storage_method);
+  bindOptionalText(stmt, 20, row.hash_algo);
+  bindOptionalText(stmt, 21, row.archive_member);
   
   stmt.step();
   return static_cast<int>(sqlite3_last_insert_rowid(db_->raw()));
@@ -109,7 +237,7 @@ void RepositoryDao::updateMod(const ModRow& row) {
       name = ?, author = ?, rating = ?, category_id = ?, note = ?, last_published_at = ?,
       last_saved_at = ?, status = ?, source_platform = ?, source_url = ?, cover_path = ?,
       file_path = ?, file_hash = ?, size_mb = ?, integrity = ?, stability = ?,
-      acquisition_method = ?
+      acquisition_method = ?, hash_algo = ?
     WHERE id = ?;
   )SQL");
 
@@ -131,11 +259,39 @@ void RepositoryDao::updateMod(const ModRow& row) {
   bindOptionalText(stmt, 15, row.integrity);
   bindOptionalText(stmt, 16, row.stability);
   bindOptionalText(stmt, 17, row.acquisition_method);
-  stmt.bind(18, row.id); // 绑定 WHERE 子句的 ID
+  bindOptionalText(stmt, 18, row.hash_algo);
+  stmt.bind(19, row.id); // 绑定 WHERE 子句的 ID
   
   stmt.step();
 }
 
+void RepositoryDao::updateFileMetadata(const std::vector<ModFileMetadataRow>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+  // 仅更新文件相关列，其余字段与标签绑定保持不变
+  Stmt stmt(*db_, R"SQL(
+    UPDATE mods SET
+      file_path = ?, file_hash = ?, size_mb = ?, last_published_at = ?, last_saved_at = ?,
+      cover_path = ?, storage_method = COALESCE(?, storage_method), hash_algo = ?
+    WHERE id = ?;
+  )SQL");
+
+  for (const auto& row : rows) {
+    bindOptionalText(stmt, 1, row.file_path);
+    bindOptionalText(stmt, 2, row.file_hash);
+    stmt.bind(3, row.size_mb);
+    bindOptionalText(stmt, 4, row.last_published_at);
+    bindOptionalText(stmt, 5, row.last_saved_at);
+    bindOptionalText(stmt, 6, row.cover_path);
+    bindOptionalText(stmt, 7, row.storage_method);
+    bindOptionalText(stmt, 8, row.hash_algo);
+    stmt.bind(9, row.mod_id);
+    stmt.step();
+    stmt.reset(); // 重置语句以便下次循环使用
+  }
+}
+
 void RepositoryDao::setDeleted(int id, bool deleted) {
   // 更新指定 ID 的 MOD 的 is_deleted 标志
   Stmt stmt(*db_, "UPDATE mods SET is_deleted = ? WHERE id = ?;");
@@ -152,13 +308,7 @@ void RepositoryDao::deleteDeletedMods() {
 
 std::optional<ModRow> RepositoryDao::findById(int id) const {
   // 使用 COALESCE 将 NULL 值转换为空字符串或0，以便 readRow 函数处理
-  Stmt stmt(*db_, R"SQL(
-    SELECT id, name, COALESCE(author, ''), COALESCE(rating, 0), COALESCE(category_id, 0),
-           COALESCE(note, ''), COALESCE(last_published_at, ''), COALESCE(last_saved_at, ''),
-           COALESCE(status, '最新'), COALESCE(source_platform, ''), COALESCE(source_url, ''),
-           is_deleted, COALESCE(cover_path, ''), COALESCE(file_path, ''),
-           COALESCE(file_hash, ''), size_mb, COALESCE(integrity, ''),
-           COALESCE(stability, ''), COALESCE(acquisition_method, '')
+  Stmt stmt(*db_, std::string("SELECT ") + kModColumns + R"SQL(
     FROM mods
     WHERE id = ?;
   )SQL");
@@ -172,13 +322,7 @@ std::optional<ModRow> RepositoryDao::findById(int id) const {
 
 std::optional<ModRow> RepositoryDao::findByFileHash(const std::string& fileHash) const {
   // 同样使用 COALESCE 处理 NULL 值
-  Stmt stmt(*db_, R"SQL(
-    SELECT id, name, COALESCE(author, ''), COALESCE(rating, 0), COALESCE(category_id, 0),
-           COALESCE(note, ''), COALESCE(last_published_at, ''), COALESCE(last_saved_at, ''),
-           COALESCE(status, '最新'), COALESCE(source_platform, ''), COALESCE(source_url, ''),
-           is_deleted, COALESCE(cover_path, ''), COALESCE(file_path, ''),
-           COALESCE(file_hash, ''), size_mb, COALESCE(integrity, ''),
-           COALESCE(stability, ''), COALESCE(acquisition_method, '')
+  Stmt stmt(*db_, std::string("SELECT ") + kModColumns + R"SQL(
     FROM mods
     WHERE file_hash = ?;
   )SQL");
@@ -192,13 +336,7 @@ std::optional<ModRow> RepositoryDao::findByFileHash(const std::string& fileHash)
 
 std::vector<ModRow> RepositoryDao::listVisible() const {
   // 从 v_mods_visible 视图查询，该视图已预先过滤掉 is_deleted = 1 的记录
-  Stmt stmt(*db_, R"SQL(
-    SELECT id, name, COALESCE(author, ''), COALESCE(rating, 0), COALESCE(category_id, 0),
-           COALESCE(note, ''), COALESCE(last_published_at, ''), COALESCE(last_saved_at, ''),
-           COALESCE(status, '最新'), COALESCE(source_platform, ''), COALESCE(source_url, ''),
-           is_deleted, COALESCE(cover_path, ''), COALESCE(file_path, ''),
-           COALESCE(file_hash, ''), size_mb, COALESCE(integrity, ''),
-           COALESCE(stability, ''), COALESCE(acquisition_method, '')
+  Stmt stmt(*db_, std::string("SELECT ") + kModColumns + R"SQL(
     FROM v_mods_visible
     ORDER BY name;
   )SQL");
@@ -210,15 +348,24 @@ std::vector<ModRow> RepositoryDao::listVisible() const {
   return rows;
 }
 
+std::optional<ModRow> RepositoryDao::findByFileHash(const std::string& fileHash, const std::string& hashAlgo) const {
+  // 早期记录的 hash_algo 为空，按 sha256 处理
+  Stmt stmt(*db_, std::string("SELECT ") + kModColumns + R"SQL(
+    FROM mods
+    WHERE file_hash = ? AND COALESCE(NULLIF(hash_algo, ''), 'sha256') = ?;
+  )SQL");
+  stmt.bind(1, fileHash);
+  stmt.bind(2, hashAlgo);
+
+  if (!stmt.step()) {
+    return std::nullopt;
+  }
+  return readRow(stmt);
+}
+
 std::vector<ModRow> RepositoryDao::listAll(bool includeDeleted) const {
   // 动态构建 SQL 查询
-  std::string sql = R"SQL(
-    SELECT id, name, COALESCE(author, ''), COALESCE(rating, 0), COALESCE(category_id, 0),
-           COALESCE(note, ''), COALESCE(last_published_at, ''), COALESCE(last_saved_at, ''),
-           COALESCE(status, '最新'), COALESCE(source_platform, ''), COALESCE(source_url, ''),
-           is_deleted, COALESCE(cover_path, ''), COALESCE(file_path, ''),
-           COALESCE(file_hash, ''), size_mb, COALESCE(integrity, ''),
-           COALESCE(stability, ''), COALESCE(acquisition_method, '')
+  std::string sql = std::string("SELECT ") + kModColumns + R"SQL(
     FROM mods
   )SQL";
 
@@ -235,4 +382,105 @@ std::vector<ModRow> RepositoryDao::listAll(bool includeDeleted) const {
     rows.push_back(readRow(stmt));
   }
   return rows;
-}
\ No newline at end of file
+}
+
+CatalogSnapshotKey RepositoryDao::catalogSnapshotKey() const {
+  CatalogSnapshotKey key;
+  Stmt stmt(*db_, R"SQL(
+    SELECT key, value FROM app_meta
+    WHERE key IN ('schema_version', 'catalog_version', 'catalog_id');
+  )SQL");
+  while (stmt.step()) {
+    const std::string name = stmt.getText(0);
+    if (name == "schema_version") {
+      key.schema_version = stmt.getInt(1);
+    } else if (name == "catalog_version") {
+      key.catalog_version = stmt.getInt64(1);
+    } else {
+      key.catalog_id = stmt.getText(1);
+    }
+  }
+  return key;
+}
+
+int RepositoryDao::countMods(const ModPageFilter& filter, const std::optional<ModPageKey>& before) const {
+  PageWhere where = buildPageWhere(filter);
+  if (before) {
+    where.addKey("<", *before);
+  }
+  Stmt stmt(*db_, "SELECT COUNT(*) FROM mods" + where.sql + ";");
+  where.bindAll(stmt);
+  return stmt.step() ? stmt.getInt(0) : 0;
+}
+
+std::vector<ModRow> RepositoryDao::listModsPage(const ModPageFilter& filter,
+                                                const std::optional<ModPageKey>& after,
+                                                int limit) const {
+  PageWhere where = buildPageWhere(filter);
+  if (after) {
+    where.addKey(">", *after);
+  }
+  Stmt stmt(*db_, std::string("SELECT ") + kModColumns + " FROM mods" + where.sql +
+                      " ORDER BY name COLLATE NOCASE, id LIMIT ?;");
+  stmt.bind(where.bindAll(stmt), limit);
+
+  std::vector<ModRow> rows;
+  rows.reserve(static_cast<std::size_t>(limit > 0 ? limit : 0));
+  while (stmt.step()) {
+    rows.push_back(readRow(stmt));
+  }
+  return rows;
+}
+
+std::optional<ModPageKey> RepositoryDao::modPageKeyAt(const ModPageFilter& filter,
+                                                      const std::optional<ModPageKey>& after,
+                                                      int offset) const {
+  PageWhere where = buildPageWhere(filter);
+  if (after) {
+    where.addKey(">", *after);
+  }
+  Stmt stmt(*db_, "SELECT name, id FROM mods" + where.sql + " ORDER BY name COLLATE NOCASE, id LIMIT 1 OFFSET ?;");
+  stmt.bind(where.bindAll(stmt), offset);
+  if (!stmt.step()) {
+    return std::nullopt;
+  }
+  return ModPageKey{stmt.getText(0), stmt.getInt(1)};
+}
+
+std::vector<int> RepositoryDao::filterModIds(const ModPageFilter& filter, const std::vector<int>& ids) const {
+  // 旧版 SQLite 每条语句最多 999 个参数，ID 分批放入 IN 列表，为筛选条件自身的参数留出余量
+  constexpr std::size_t kIdsPerStatement = 500;
+  std::vector<int> matched;
+  for (std::size_t begin = 0; begin < ids.size(); begin += kIdsPerStatement) {
+    const std::size_t end = std::min(ids.size(), begin + kIdsPerStatement);
+    PageWhere where = buildPageWhere(filter);
+    std::string inList = "id IN (";
+    for (std::size_t i = begin; i < end; ++i) {
+      inList += i == begin ? "?" : ", ?";
+      where.params.emplace_back(ids[i]);
+    }
+    inList += ")";
+    where.add(inList.c_str());
+    Stmt stmt(*db_, "SELECT id FROM mods" + where.sql + ";");
+    where.bindAll(stmt);
+    while (stmt.step()) {
+      matched.push_back(stmt.getInt(0));
+    }
+  }
+  std::sort(matched.begin(), matched.end());
+  matched.erase(std::unique(matched.begin(), matched.end()), matched.end());
+  return matched;
+}
+
+std::vector<std::string> RepositoryDao::listAuthors() const {
+  Stmt stmt(*db_, R"SQL(
+    SELECT DISTINCT author FROM mods
+    WHERE author IS NOT NULL AND author <> ''
+    ORDER BY author;
+  )SQL");
+  std::vector<std::string> authors;
+  while (stmt.step()) {
+    authors.push_back(stmt.getText(0));
+  }
+  return authors;
+}
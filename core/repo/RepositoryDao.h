@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -37,6 +38,66 @@ struct ModRow {
   std::string integrity; ///< 完整性状态
   std::string stability; ///< 稳定性状态
   std::string acquisition_method; ///< 获取方式
+  std::string storage_method; ///< 文件进入仓库目录的方式（move/copy/reflink/hardlink/symlink），空表示未知
+  std::string hash_algo; ///< file_hash 所用算法（sha256/blake3），空表示早期记录的 SHA-256
+  std::string archive_member; ///< 压缩包拆分出的条目在包内的 VPK 路径，空表示整个文件即一个 MOD
+};
+
+/**
+ * @brief MOD 文件相关元数据，用于在文件同步后仅更新文件列而不触碰其余字段。
+ */
+struct ModFileMetadataRow {
+  int mod_id{0}; ///< 目标MOD的ID
+  std::string file_path; ///< MOD文件路径
+  std::string file_hash; ///< MOD文件哈希值
+  double size_mb{0.0}; ///< 文件大小（MB）
+  std::string last_published_at; ///< 最后发布时间
+  std::string last_saved_at; ///< 在本仓库中的最后保存时间
+  std::string cover_path; ///< 封面图片路径
+  std::string storage_method; ///< 文件进入仓库的方式，空表示保持原值
+  std::string hash_algo; ///< file_hash 所用算法，空表示 SHA-256
+};
+
+/**
+ * @brief MOD 文件的文件名主干（去掉最后一个扩展名），游戏目录扫描据此按文件名匹配部署的文件。
+ * @details MOD 名称可能来自 addoninfo.txt 的标题，与文件名无关。压缩包条目取包内 VPK 的文件名，
+ *          其余取 file_path 的文件名；按内容寻址存放（文件名即哈希）时返回空字符串。
+ */
+std::string modFileStem(const ModRow& mod);
+
+/**
+ * @brief MOD 目录（MOD 与标签相关表）当前的版本标识，用于判断目录快照是否过期。
+ */
+struct CatalogSnapshotKey {
+  int schema_version{0};           ///< app_meta.schema_version
+  std::int64_t catalog_version{0}; ///< app_meta.catalog_version，MOD 与标签相关表每次写入都会递增
+  std::string catalog_id;          ///< app_meta.catalog_id，区分不同的数据库文件
+
+  bool operator==(const CatalogSnapshotKey& other) const {
+    return schema_version == other.schema_version && catalog_version == other.catalog_version &&
+           catalog_id == other.catalog_id;
+  }
+  bool operator!=(const CatalogSnapshotKey& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief 分页查询 MOD 时下推到 SQL 的筛选条件，未设置的条件不参与筛选。
+ */
+struct ModPageFilter {
+  std::optional<int> category_id;    ///< 分类ID，匹配该分类及其全部子分类；<=0 表示只要未分类的MOD
+  std::optional<int> tag_id;         ///< 标签ID；<=0 表示只要没有任何标签的MOD
+  std::optional<std::string> author; ///< 作者（完全相等）
+  std::optional<int> rating;         ///< 评分（1-5）；<=0 表示只要未评分的MOD
+  std::string name_prefix;           ///< 名称前缀，ASCII 字母不区分大小写，空表示不限
+  bool include_deleted{false};       ///< 是否包含已被逻辑删除的MOD
+};
+
+/**
+ * @brief 分页查询的排序键：MOD 按名称（NOCASE）、id 升序排列，键即某一行的这两个值。
+ */
+struct ModPageKey {
+  std::string name; ///< MOD名称
+  int id{0};        ///< MOD ID，名称相同时用于确定先后
 };
 
 /**
@@ -64,6 +125,13 @@ public:
    */
   void updateMod(const ModRow& row);
 
+  /**
+   * @brief 批量更新MOD的文件元数据列（路径、哈希、大小、日期、封面）。
+   * @details 复用同一条预处理语句；调用方负责开启事务。
+   * @param rows 待更新的文件元数据列表。
+   */
+  void updateFileMetadata(const std::vector<ModFileMetadataRow>& rows);
+
   /**
    * @brief 设置或取消MOD的逻辑删除状态。
    * @param id 目标MOD的ID。
@@ -90,6 +158,14 @@ public:
    */
   std::optional<ModRow> findByFileHash(const std::string& fileHash) const;
 
+  /**
+   * @brief 根据文件哈希值及其算法查找MOD；hash_algo 为空的记录按 sha256 比较。
+   * @param fileHash 要查找的MOD文件哈希值。
+   * @param hashAlgo 哈希算法的持久化名称（sha256/blake3）。
+   * @return 如果找到，则返回包含MOD信息的 ModRow，否则返回 std::nullopt。
+   */
+  std::optional<ModRow> findByFileHash(const std::string& fileHash, const std::string& hashAlgo) const;
+
   /**
    * @brief 列出所有可见（即未被逻辑删除）的MOD。
    * @return 包含所有可见MOD信息的列表。
@@ -103,6 +179,44 @@ public:
    */
   std::vector<ModRow> listAll(bool includeDeleted = false) const;
 
+  /**
+   * @brief 读取 MOD 目录当前的版本标识。
+   * @return 迁移 9 之前的数据库中 catalog_version 为 0、catalog_id 为空。
+   */
+  CatalogSnapshotKey catalogSnapshotKey() const;
+
+  /**
+   * @brief 统计满足筛选条件的MOD数量。
+   * @param before 若给出，只统计排在该键之前的MOD（即该键所在行的下标）。
+   */
+  int countMods(const ModPageFilter& filter, const std::optional<ModPageKey>& before = std::nullopt) const;
+
+  /**
+   * @brief 按名称（NOCASE）、id 顺序读取一页MOD（键集分页）。
+   * @param after 上一页最后一行的键；为空时从第一行开始。
+   * @param limit 最多读取的行数。
+   */
+  std::vector<ModRow> listModsPage(const ModPageFilter& filter, const std::optional<ModPageKey>& after, int limit) const;
+
+  /**
+   * @brief 定位排在 after 之后第 offset 行（从 0 开始）的键，只扫描索引，用于跳转到远处的页。
+   * @return 行数不足时返回 std::nullopt。
+   */
+  std::optional<ModPageKey> modPageKeyAt(const ModPageFilter& filter,
+                                         const std::optional<ModPageKey>& after,
+                                         int offset) const;
+
+  /**
+   * @brief 从给定的少量 MOD ID 中挑出满足筛选条件的（按 id 升序），供游戏目录这类小列表按分页筛选同步可见性。
+   * @param ids 待检查的 MOD ID，按每批 500 个分多条语句查询，不适合整个仓库规模的列表。
+   */
+  std::vector<int> filterModIds(const ModPageFilter& filter, const std::vector<int>& ids) const;
+
+  /**
+   * @brief 列出所有非空的作者名（去重，按字节序排列）。
+   */
+  std::vector<std::string> listAuthors() const;
+
 private:
   std::shared_ptr<Db> db_; ///< 数据库连接实例
 };
\ No newline at end of file
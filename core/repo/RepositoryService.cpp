@@ -2,10 +2,14 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
+#include "core/hash/FileHasher.h"
+
 /**
  * @file RepositoryService.cpp
  * @brief 实现了 RepositoryService 类中定义的方法。
@@ -82,7 +86,10 @@ RepositoryService::RepositoryService(std::shared_ptr<Db> db)
       relationDao_(std::make_unique<ModRelationDao>(db_)),
       savedSchemeDao_(std::make_unique<SavedSchemeDao>(db_)),
       fixedBundleDao_(std::make_unique<FixedBundleDao>(db_)),
-      gameModDao_(std::make_unique<GameModDao>(db_)) {}
+      gameModDao_(std::make_unique<GameModDao>(db_)),
+      fingerprintDao_(std::make_unique<ModFingerprintDao>(db_)),
+      importJournalDao_(std::make_unique<ImportJournalDao>(db_)),
+      assetDao_(std::make_unique<ModAssetDao>(db_)) {}
 
 // --- MOD 管理 ---
 
@@ -94,16 +101,42 @@ std::vector<ModRow> RepositoryService::listAll(bool includeDeleted) const {
   return repoDao_->listAll(includeDeleted);
 }
 
+CatalogSnapshotKey RepositoryService::catalogSnapshotKey() const {
+  return repoDao_->catalogSnapshotKey();
+}
+
+int RepositoryService::countMods(const ModPageFilter& filter, const std::optional<ModPageKey>& before) const {
+  return repoDao_->countMods(filter, before);
+}
+
+std::vector<ModRow> RepositoryService::listModsPage(const ModPageFilter& filter,
+                                                    const std::optional<ModPageKey>& after,
+                                                    int limit) const {
+  return repoDao_->listModsPage(filter, after, limit);
+}
+
+std::optional<ModPageKey> RepositoryService::modPageKeyAt(const ModPageFilter& filter,
+                                                          const std::optional<ModPageKey>& after,
+                                                          int offset) const {
+  return repoDao_->modPageKeyAt(filter, after, offset);
+}
+
+std::vector<int> RepositoryService::filterModIds(const ModPageFilter& filter, const std::vector<int>& ids) const {
+  return repoDao_->filterModIds(filter, ids);
+}
+
+std::vector<std::string> RepositoryService::listAuthors() const {
+  return repoDao_->listAuthors();
+}
+
 std::optional<ModRow> RepositoryService::findMod(int modId) const {
   return repoDao_->findById(modId);
 }
 
 int RepositoryService::createModWithTags(const ModRow& mod, const std::vector<TagDescriptor>& tags) {
   // 检查文件哈希是否已存在，防止重复
-  if (!mod.file_hash.empty()) {
-    if (repoDao_->findByFileHash(mod.file_hash)) {
-      throw DbError("A mod with the same file hash already exists.");
-    }
+  if (findDuplicateByHash(mod)) {
+    throw DbError("A mod with the same file hash already exists.");
   }
 
   // 在事务中创建MOD并绑定标签
@@ -115,6 +148,45 @@ int RepositoryService::createModWithTags(const ModRow& mod, const std::vector<Ta
   return modId;
 }
 
+std::vector<int> RepositoryService::createModsBatch(const std::vector<ModRow>& mods,
+                                                   std::vector<ImportJournalRow>* journal) {
+  std::vector<int> ids(mods.size(), 0);
+  if (mods.empty()) {
+    return ids;
+  }
+  // 整批在同一事务中写入，避免逐条提交的 fsync 开销
+  Db::Tx tx(*db_);
+  for (size_t i = 0; i < mods.size(); ++i) {
+    const ModRow& mod = mods[i];
+    if (findDuplicateByHash(mod)) {
+      continue;
+    }
+    ids[i] = repoDao_->insertMod(mod);
+  }
+  if (journal) {
+    for (size_t i = 0; i < journal->size() && i < ids.size(); ++i) {
+      ImportJournalRow& row = (*journal)[i];
+      row.stage = ids[i] > 0 ? ImportStage::Inserted : ImportStage::Duplicate;
+      row.mod_id = ids[i];
+    }
+    importJournalDao_->upsertEntries(*journal);
+  }
+  tx.commit();
+  return ids;
+}
+
+std::optional<ModRow> RepositoryService::findDuplicateByHash(const ModRow& mod) const {
+  if (mod.file_hash.empty()) {
+    return std::nullopt;
+  }
+  const auto algorithm = hashAlgorithmFromName(mod.hash_algo);
+  if (!algorithm) {
+    // 无法识别的算法只能按哈希字符串比较
+    return repoDao_->findByFileHash(mod.file_hash);
+  }
+  return repoDao_->findByFileHash(mod.file_hash, std::string(hashAlgorithmName(*algorithm)));
+}
+
 void RepositoryService::updateModWithTags(const ModRow& mod, const std::vector<TagDescriptor>& tags) {
   if (mod.id <= 0) {
     throw DbError("updateModWithTags requires a valid mod id");
@@ -135,6 +207,21 @@ void RepositoryService::updateModTags(int modId, const std::vector<TagDescriptor
   tx.commit();
 }
 
+void RepositoryService::updateModFileMetadata(const std::vector<ModFileMetadataRow>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+  for (const auto& row : rows) {
+    if (row.mod_id <= 0) {
+      throw DbError("updateModFileMetadata requires a valid mod id");
+    }
+  }
+  // 在事务中批量更新文件列
+  Db::Tx tx(*db_);
+  repoDao_->updateFileMetadata(rows);
+  tx.commit();
+}
+
 void RepositoryService::setModDeleted(int modId, bool deleted) {
   repoDao_->setDeleted(modId, deleted);
 }
@@ -269,6 +356,129 @@ void RepositoryService::removeGameModsExcept(const std::string& source, const st
   gameModDao_->removeByPaths(source, keepPaths);
 }
 
+// --- 内容指纹管理 ---
+
+std::vector<ModFingerprintRow> RepositoryService::listModFingerprints() const {
+  return fingerprintDao_->listAll();
+}
+
+void RepositoryService::upsertModFingerprints(const std::vector<ModFingerprintRow>& rows) {
+  fingerprintDao_->upsertMany(rows);
+}
+
+// --- 导入日志管理 ---
+
+std::optional<ImportJobRow> RepositoryService::findResumableImportJob(const std::string& sourceDir) const {
+  return importJournalDao_->findUnfinishedJob(sourceDir);
+}
+
+int RepositoryService::beginImportJob(const std::string& sourceDir, bool recursive, const std::string& action) {
+  return importJournalDao_->createJob(sourceDir, recursive, action);
+}
+
+std::vector<ImportJournalRow> RepositoryService::listImportJournal(int jobId) const {
+  return importJournalDao_->listEntries(jobId);
+}
+
+void RepositoryService::recordImportJournal(const std::vector<ImportJournalRow>& rows) {
+  if (rows.empty()) {
+    return;
+  }
+  Db::Tx tx(*db_);
+  importJournalDao_->upsertEntries(rows);
+  tx.commit();
+}
+
+void RepositoryService::finishImportJob(int jobId, bool completed) {
+  Db::Tx tx(*db_);
+  if (completed) {
+    importJournalDao_->deleteJob(jobId);
+  } else {
+    importJournalDao_->setJobStatus(jobId, kImportJobInterrupted);
+  }
+  tx.commit();
+}
+
+// --- 资源冲突检测 ---
+
+void RepositoryService::indexModAssets(const std::vector<ModAssetList>& lists) {
+  if (lists.empty()) {
+    return;
+  }
+  Db::Tx tx(*db_);
+  assetDao_->replaceMany(lists);
+  tx.commit();
+}
+
+std::vector<ModAssetScanRow> RepositoryService::listAssetScans() const {
+  return assetDao_->listScans();
+}
+
+AssetIndex RepositoryService::loadAssetIndex() const {
+  AssetIndex index;
+  // 数据库 ID 可能不连续，先映射到索引内部的驻留 ID
+  std::unordered_map<int, AssetIndex::PathId> idMap;
+  for (const auto& [id, path] : assetDao_->listPaths()) {
+    idMap.emplace(id, index.intern(path));
+  }
+  const auto rows = assetDao_->listModAssets();
+  std::vector<AssetIndex::PathId> paths;
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    const auto it = idMap.find(rows[i].second);
+    if (it != idMap.end()) {
+      paths.push_back(it->second);
+    }
+    if (i + 1 == rows.size() || rows[i + 1].first != rows[i].first) {
+      index.setModPaths(rows[i].first, std::move(paths));
+      paths = {};
+    }
+  }
+  return index;
+}
+
+std::vector<AssetConflict> RepositoryService::suggestConflicts(const AssetIndex& index, int modId) const {
+  auto conflicts = modId > 0 ? index.conflictsFor(modId) : index.conflicts();
+  if (conflicts.empty()) {
+    return conflicts;
+  }
+  // 已有依赖、同源、冲突等任何关系的 MOD 对由用户维护，不再建议
+  std::unordered_set<std::uint64_t> related;
+  const auto key = [](int a, int b) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(std::min(a, b))) << 32) |
+           static_cast<std::uint32_t>(std::max(a, b));
+  };
+  const auto relations = modId > 0 ? relationDao_->listByMod(modId) : relationDao_->listAll();
+  for (const auto& rel : relations) {
+    related.insert(key(rel.a_mod_id, rel.b_mod_id));
+  }
+  conflicts.erase(std::remove_if(conflicts.begin(), conflicts.end(),
+                                 [&](const AssetConflict& c) { return related.count(key(c.a_mod_id, c.b_mod_id)) > 0; }),
+                  conflicts.end());
+  return conflicts;
+}
+
+int RepositoryService::addConflictRelations(const std::vector<AssetConflict>& conflicts) {
+  int added = 0;
+  Db::Tx tx(*db_);
+  for (const auto& conflict : conflicts) {
+    if (conflict.a_mod_id <= 0 || conflict.b_mod_id <= 0 || conflict.a_mod_id == conflict.b_mod_id) {
+      continue;
+    }
+    ModRelationRow row{};
+    row.a_mod_id = conflict.a_mod_id;
+    row.b_mod_id = conflict.b_mod_id;
+    row.type = "conflicts";
+    if (!conflict.slot_key.empty()) {
+      row.slot_key = conflict.slot_key;
+    }
+    row.note = "自动检测：共同覆盖 " + std::to_string(conflict.shared_paths) + " 个资源，例如 " + conflict.sample_path;
+    relationDao_->insert(row);
+    ++added;
+  }
+  tx.commit();
+  return added;
+}
+
 // --- 固定搭配管理 ---
 
 std::vector<FixedBundleRow> RepositoryService::listFixedBundles() const {
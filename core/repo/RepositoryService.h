@@ -8,10 +8,14 @@
 #include "core/repo/CategoryDao.h"
 #include "core/repo/FixedBundleDao.h"
 #include "core/repo/GameModDao.h"
+#include "core/repo/ImportJournalDao.h"
+#include "core/repo/ModAssetDao.h"
+#include "core/repo/ModFingerprintDao.h"
 #include "core/repo/ModRelationDao.h"
 #include "core/repo/RepositoryDao.h"
 #include "core/repo/SavedSchemeDao.h"
 #include "core/repo/TagDao.h"
+#include "core/vpk/AssetIndex.h"
 
 /**
  * @file RepositoryService.h
@@ -53,6 +57,26 @@ public:
    * @return MOD列表。
    */
   std::vector<ModRow> listAll(bool includeDeleted = false) const;
+
+  /**
+   * @brief 读取 MOD 目录当前的版本标识，用于校验目录快照。
+   */
+  CatalogSnapshotKey catalogSnapshotKey() const;
+
+  /**
+   * @brief 键集分页查询，筛选条件在 SQL 中执行；详见 RepositoryDao 的同名方法。
+   */
+  int countMods(const ModPageFilter& filter, const std::optional<ModPageKey>& before = std::nullopt) const;
+  std::vector<ModRow> listModsPage(const ModPageFilter& filter, const std::optional<ModPageKey>& after, int limit) const;
+  std::optional<ModPageKey> modPageKeyAt(const ModPageFilter& filter,
+                                         const std::optional<ModPageKey>& after,
+                                         int offset) const;
+  std::vector<int> filterModIds(const ModPageFilter& filter, const std::vector<int>& ids) const;
+
+  /**
+   * @brief 列出所有非空的作者名（去重）。
+   */
+  std::vector<std::string> listAuthors() const;
   
   /**
    * @brief 根据ID查找MOD。
@@ -63,11 +87,23 @@ public:
   
   /**
    * @brief 以原子方式创建一个新的MOD并绑定其标签。
+   * @details 仓库中已有相同 (hash_algo, file_hash) 的记录时抛出 DbError。
    * @param mod 要创建的MOD的数据。
    * @param tags 要绑定的标签列表。
    * @return 新创建的MOD的ID。
    */
   int createModWithTags(const ModRow& mod, const std::vector<TagDescriptor>& tags);
+
+  /**
+   * @brief 在单个事务中批量创建MOD（不绑定标签），用于文件夹批量导入。
+   * @details 文件哈希已存在于仓库中的记录会被跳过；判定方式与 createModWithTags 相同。
+   * @param mods 要创建的MOD列表。
+   * @param journal 可选的导入日志，与 mods 一一对应；在同一事务中标记为已入库或重复，
+   *                保证进程中断后日志与 mods 表不会出现不一致。
+   * @return 与输入一一对应的新ID，被跳过的项为 0。
+   */
+  std::vector<int> createModsBatch(const std::vector<ModRow>& mods,
+                                   std::vector<ImportJournalRow>* journal = nullptr);
   
   /**
    * @brief 更新MOD信息并刷新其标签绑定。
@@ -82,6 +118,12 @@ public:
    * @param tags 新的标签列表。
    */
   void updateModTags(int modId, const std::vector<TagDescriptor>& tags);
+
+  /**
+   * @brief 在单个事务中批量更新MOD的文件元数据，不修改其他字段与标签绑定。
+   * @param rows 文件元数据列表（mod_id 必须有效）。
+   */
+  void updateModFileMetadata(const std::vector<ModFileMetadataRow>& rows);
   
   /**
    * @brief 设置MOD的逻辑删除状态。
@@ -132,6 +174,79 @@ public:
   void upsertGameMod(const GameModRow& row);
   void removeGameModsExcept(const std::string& source, const std::vector<std::string>& keepPaths);
 
+  // --- 内容指纹管理 ---
+
+  /**
+   * @brief 读取全部仓库 MOD 的内容指纹。
+   * @return 指纹记录列表。
+   */
+  std::vector<ModFingerprintRow> listModFingerprints() const;
+
+  /**
+   * @brief 在单个事务中批量写入或覆盖 MOD 指纹。
+   * @param rows 指纹记录列表。
+   */
+  void upsertModFingerprints(const std::vector<ModFingerprintRow>& rows);
+
+  // --- 导入日志管理 ---
+
+  /**
+   * @brief 查找指定文件夹未完成的导入任务，用于续传。
+   * @param sourceDir 规范化后的源文件夹路径。
+   */
+  std::optional<ImportJobRow> findResumableImportJob(const std::string& sourceDir) const;
+
+  /**
+   * @brief 为一次文件夹导入创建新的日志任务。
+   * @return 新任务的ID。
+   */
+  int beginImportJob(const std::string& sourceDir, bool recursive, const std::string& action);
+
+  /**
+   * @brief 读取导入任务的全部文件记录。
+   */
+  std::vector<ImportJournalRow> listImportJournal(int jobId) const;
+
+  /**
+   * @brief 在单个事务中写入一批导入日志检查点。
+   */
+  void recordImportJournal(const std::vector<ImportJournalRow>& rows);
+
+  /**
+   * @brief 结束导入任务。
+   * @param completed 为 true 时删除任务及其日志；否则标记为 interrupted 以便下次续传。
+   */
+  void finishImportJob(int jobId, bool completed);
+
+  // --- 资源冲突检测 ---
+
+  /**
+   * @brief 在单个事务中写入一批 MOD 的资源路径（替换旧记录）。
+   */
+  void indexModAssets(const std::vector<ModAssetList>& lists);
+
+  /**
+   * @brief 读取资源扫描记录，用于判断哪些 MOD 文件变化后需要重新扫描。
+   */
+  std::vector<ModAssetScanRow> listAssetScans() const;
+
+  /**
+   * @brief 从数据库加载完整的资源路径索引。
+   */
+  AssetIndex loadAssetIndex() const;
+
+  /**
+   * @brief 根据资源索引给出建议的冲突关系，已存在任何关系的 MOD 对不再重复建议。
+   * @param modId 大于 0 时只检查与该 MOD 相关的冲突。
+   */
+  std::vector<AssetConflict> suggestConflicts(const AssetIndex& index, int modId = 0) const;
+
+  /**
+   * @brief 将建议的冲突写入 mod_relations（type 为 conflicts，并填写 slot_key 与说明）。
+   * @return 实际新增的关系数。
+   */
+  int addConflictRelations(const std::vector<AssetConflict>& conflicts);
+
   // --- 固定搭配管理 ---
 
   std::vector<FixedBundleRow> listFixedBundles() const;
@@ -149,6 +264,13 @@ public:
   void deleteSavedScheme(int schemeId);
 
 private:
+  /**
+   * @brief 按 (hash_algo, file_hash) 查找与 mod 为同一文件的已有记录。
+   * @details 只做索引查找，不读取文件：与早期 SHA-256 记录的比较由导入流水线的去重阶段在工作线程中完成，
+   *          避免在写事务与 UI 线程中计算整个文件的哈希。
+   */
+  std::optional<ModRow> findDuplicateByHash(const ModRow& mod) const;
+
   std::shared_ptr<Db> db_; ///< 共享的数据库连接实例
   
   // --- Data Access Objects ---
@@ -160,4 +282,7 @@ private:
   std::unique_ptr<SavedSchemeDao> savedSchemeDao_;
   std::unique_ptr<FixedBundleDao> fixedBundleDao_;
   std::unique_ptr<GameModDao> gameModDao_;
+  std::unique_ptr<ModFingerprintDao> fingerprintDao_;
+  std::unique_ptr<ImportJournalDao> importJournalDao_;
+  std::unique_ptr<ModAssetDao> assetDao_;
 };
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "core/store/ObjectStore.h"
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
+#include "core/io/RenameNoReplace.h"
+#include "core/io/TransferEngine.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string lowerExtension(std::string_view extension) {
+  if (!extension.empty() && extension.front() == '.') {
+    extension.remove_prefix(1);
+  }
+  std::string result(extension);
+  std::transform(result.begin(), result.end(), result.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return result;
+}
+
+fs::path partialPath(const fs::path& target) {
+  fs::path partial = target;
+  partial += TransferEngine::kPartialSuffix;
+  return partial;
+}
+
+/// 把已写好的临时文件改名为目标；目标已存在（并发写入同一对象）时丢弃临时文件。
+/// 改名不覆盖已有目标：by-name 条目以硬链接指向对象，覆盖会使它们指向被替换掉的旧文件。
+/// @param restoreTo 非空时临时文件即由源文件改名而来，改名失败时改回该路径而不是删除，避免丢失用户唯一的副本。
+bool commitPartial(const fs::path& partial, const fs::path& target, const fs::path* restoreTo, bool& raced,
+                   std::error_code& ec) {
+  raced = false;
+  std::error_code ignored;
+  renameNoReplace(partial, target, ec);
+  if (ec == std::errc::file_exists && fs::is_regular_file(target, ignored)) {
+    ec.clear();
+    fs::remove(partial, ignored);
+    raced = true;
+    return true;
+  }
+  if (ec) {
+    if (restoreTo) {
+      fs::rename(partial, *restoreTo, ignored);
+    } else {
+      fs::remove(partial, ignored);
+    }
+    return false;
+  }
+  return true;
+}
+
+/// 在 entry 处建立指向 object 的 by-name 条目：优先硬链接，不支持时为符号链接。
+bool createNameEntry(const fs::path& object, const fs::path& entry, std::error_code& ec) {
+  fs::create_hard_link(object, entry, ec);
+  if (ec) {
+    ec.clear();
+    fs::create_symlink(fs::absolute(object), entry, ec);
+  }
+  return !ec;
+}
+
+} // namespace
+
+ObjectStore::ObjectStore(fs::path repoDir) : repoDir_(std::move(repoDir)) {}
+
+bool ObjectStore::isValidHash(std::string_view hash) {
+  return hash.size() >= 8 &&
+         std::all_of(hash.begin(), hash.end(), [](unsigned char c) { return std::isxdigit(c) != 0; });
+}
+
+fs::path ObjectStore::objectPath(std::string_view hash, std::string_view extension) const {
+  std::string name = lowerExtension(hash);
+  const std::string ext = lowerExtension(extension);
+  fs::path dir = objectsDir() / name.substr(0, 2);
+  name.erase(0, 2);
+  if (!ext.empty()) {
+    name += '.';
+    name += ext;
+  }
+  return dir / name;
+}
+
+bool ObjectStore::isObjectPath(const fs::path& path) const {
+  const fs::path base = objectsDir().lexically_normal();
+  const fs::path candidate = path.lexically_normal();
+  const auto mismatch = std::mismatch(base.begin(), base.end(), candidate.begin(), candidate.end());
+  // 基准目录末尾的空组件来自尾随分隔符，可以忽略
+  return (mismatch.first == base.end() || mismatch.first->empty()) && mismatch.second != candidate.end();
+}
+
+bool ObjectStore::prepare(const fs::path& object, std::error_code& ec) const {
+  ec.clear();
+  fs::create_directories(object.parent_path(), ec);
+  return !ec;
+}
+
+std::optional<ObjectStore::PutResult> ObjectStore::put(const fs::path& src,
+                                                       std::string_view hash,
+                                                       PutMode mode,
+                                                       std::error_code& ec) const {
+  ec.clear();
+  if (!isValidHash(hash)) {
+    ec = std::make_error_code(std::errc::invalid_argument);
+    return std::nullopt;
+  }
+  PutResult result;
+  result.object = objectPath(hash, src.extension().string());
+
+  std::error_code ignored;
+  if (fs::is_regular_file(result.object, ignored)) {
+    result.deduplicated = true;
+    if (mode == PutMode::Move && !fs::equivalent(src, result.object, ignored)) {
+      fs::remove(src, ec);
+      if (ec) {
+        return std::nullopt;
+      }
+    }
+    return result;
+  }
+  if (!prepare(result.object, ec)) {
+    return std::nullopt;
+  }
+
+  const fs::path partial = partialPath(result.object);
+  fs::remove(partial, ignored);
+  bool movedSource = false;
+  switch (mode) {
+    case PutMode::Move:
+      fs::rename(src, partial, ec);
+      if (!ec) {
+        movedSource = true;
+        result.method = StorageMethod::Move;
+        break;
+      }
+      // 跨设备时复制后删除源文件
+      ec.clear();
+      if (!fs::copy_file(src, partial, ec)) {
+        fs::remove(partial, ignored);
+        return std::nullopt;
+      }
+      result.method = StorageMethod::Move;
+      break;
+    case PutMode::Copy:
+      if (!fs::copy_file(src, partial, ec)) {
+        fs::remove(partial, ignored);
+        return std::nullopt;
+      }
+      result.method = StorageMethod::Copy;
+      break;
+    case PutMode::Link:
+      // 硬链接会让对象随仓库外的源文件一起被原地修改，内容与哈希名不再一致；写时复制克隆则互不影响
+      if (reflinkFile(src, partial, ec)) {
+        result.method = StorageMethod::Reflink;
+        break;
+      }
+      ec.clear();
+      if (!fs::copy_file(src, partial, ec)) {
+        fs::remove(partial, ignored);
+        return std::nullopt;
+      }
+      result.method = StorageMethod::Copy;
+      break;
+  }
+
+  bool raced = false;
+  if (!commitPartial(partial, result.object, movedSource ? &src : nullptr, raced, ec)) {
+    return std::nullopt;
+  }
+  if (raced) {
+    result.deduplicated = true;
+    result.method.reset();
+  }
+  if (mode == PutMode::Move && fs::exists(src, ignored) && !fs::equivalent(src, result.object, ignored)) {
+    fs::remove(src, ignored);
+  }
+  return result;
+}
+
+std::optional<fs::path> ObjectStore::linkName(const fs::path& object,
+                                              std::string_view name,
+                                              std::error_code& ec) const {
+  ec.clear();
+  const fs::path fileName = fs::path(std::string(name)).filename();
+  if (fileName.empty() || fileName == "." || fileName == "..") {
+    ec = std::make_error_code(std::errc::invalid_argument);
+    return std::nullopt;
+  }
+  fs::create_directories(namesDir(), ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  const fs::path stem = fileName.stem();
+  const fs::path extension = fileName.extension();
+  fs::path candidate = namesDir() / fileName;
+  for (int counter = 1;; ++counter) {
+    std::error_code probe;
+    if (!fs::exists(fs::symlink_status(candidate, probe))) {
+      break;
+    }
+    if (fs::equivalent(candidate, object, probe)) {
+      return candidate;
+    }
+    candidate = namesDir() / (stem.string() + "_" + std::to_string(counter) + extension.string());
+  }
+
+  if (!createNameEntry(object, candidate, ec)) {
+    return std::nullopt;
+  }
+  return candidate;
+}
+
+bool ObjectStore::release(const fs::path& object, const fs::path& replacement, std::error_code& ec) const {
+  ec.clear();
+  if (!isObjectPath(object)) {
+    ec = std::make_error_code(std::errc::invalid_argument);
+    return false;
+  }
+  std::error_code ignored;
+  if (!fs::exists(object, ignored)) {
+    return true;
+  }
+
+  // 硬链接与符号链接条目都按所指文件比较，必须在删除对象之前找出
+  std::vector<fs::path> entries;
+  for (fs::directory_iterator it(namesDir(), ignored), end; !ignored && it != end; it.increment(ignored)) {
+    std::error_code probe;
+    if (fs::equivalent(it->path(), object, probe)) {
+      entries.push_back(it->path());
+    }
+  }
+  for (const auto& entry : entries) {
+    fs::remove(entry, ignored);
+    if (!replacement.empty()) {
+      createNameEntry(replacement, entry, ignored);
+    }
+  }
+
+  fs::remove(object, ec);
+  return !ec;
+}
+
+std::optional<StorageMethod> ObjectStore::deploy(const fs::path& object, const fs::path& target, std::error_code& ec) {
+  ec.clear();
+  std::error_code ignored;
+  if (fs::equivalent(object, target, ignored)) {
+    return StorageMethod::Hardlink;
+  }
+  if (!target.parent_path().empty()) {
+    fs::create_directories(target.parent_path(), ec);
+    if (ec) {
+      return std::nullopt;
+    }
+  }
+
+  const fs::path partial = partialPath(target);
+  fs::remove(partial, ignored);
+  std::optional<StorageMethod> method;
+  fs::create_hard_link(object, partial, ec);
+  if (!ec) {
+    method = StorageMethod::Hardlink;
+  } else {
+    ec.clear();
+    method = linkFile(object, partial, ec, /*allowSymlink*/ false);
+    if (!method) {
+      return std::nullopt;
+    }
+  }
+  // rename 会原子地替换已存在的目标文件
+  fs::rename(partial, target, ec);
+  if (ec) {
+    fs::remove(partial, ignored);
+    return std::nullopt;
+  }
+  return method;
+}
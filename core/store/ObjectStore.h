@@ -0,0 +1,97 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "core/io/FileLinker.h"
+
+/**
+ * @file ObjectStore.h
+ * @brief 仓库目录下按内容寻址的文件布局：repoDir/objects/ab/cdef….vpk。
+ * @details 对象以 mods.file_hash（十六进制）命名，前两位作为子目录以控制单个目录的条目数；
+ *          保留原扩展名，按后缀识别 VPK 的逻辑无需改动。相同内容只保存一份，重复导入直接复用。
+ *          repoDir/by-name/ 下以原始文件名建立指向对象的硬链接（不支持时为符号链接），
+ *          仅供在文件管理器中浏览，删除或重建不会影响仓库记录。
+ *          对象写入后视为只读：部署到游戏目录时同样以硬链接共享数据，修改部署出的文件等同于修改对象。
+ */
+class ObjectStore {
+public:
+  static constexpr const char* kObjectsDirName = "objects";
+  static constexpr const char* kNamesDirName = "by-name";
+
+  /// 文件进入对象库的方式。
+  enum class PutMode {
+    Move, ///< 移动源文件，对象已存在时删除源文件
+    Copy, ///< 复制源文件
+    Link  ///< reflink → 复制；不使用硬链接与符号链接，对象必须独占数据，不能与仓库外可被原地修改的文件共享 inode
+  };
+
+  struct PutResult {
+    std::filesystem::path object;
+    bool deduplicated{false};          ///< 对象已存在，本次没有写入任何数据
+    std::optional<StorageMethod> method; ///< 新写入对象时实际使用的方式
+  };
+
+  explicit ObjectStore(std::filesystem::path repoDir);
+
+  const std::filesystem::path& repoDir() const { return repoDir_; }
+  std::filesystem::path objectsDir() const { return repoDir_ / kObjectsDirName; }
+  std::filesystem::path namesDir() const { return repoDir_ / kNamesDirName; }
+
+  /// 哈希是否可用作对象名：至少 8 位十六进制字符。
+  static bool isValidHash(std::string_view hash);
+
+  /**
+   * @brief 对象的存放路径（不检查是否存在）。
+   * @param extension 原文件扩展名，可带或不带前导 '.'，会转为小写；为空时不加扩展名。
+   */
+  std::filesystem::path objectPath(std::string_view hash, std::string_view extension) const;
+
+  /// 路径是否位于 objects 目录内。
+  bool isObjectPath(const std::filesystem::path& path) const;
+
+  /// 创建对象所在的子目录，便于调用方自行把文件写到 objectPath()。
+  bool prepare(const std::filesystem::path& object, std::error_code& ec) const;
+
+  /**
+   * @brief 将 src 放入对象库。
+   * @param hash 调用方已计算好的内容哈希，不会重新校验。
+   * @param ec 失败原因；对象已存在不视为失败。
+   */
+  std::optional<PutResult> put(const std::filesystem::path& src,
+                               std::string_view hash,
+                               PutMode mode,
+                               std::error_code& ec) const;
+
+  /**
+   * @brief 在 by-name 目录下以 name 建立指向对象的条目；同名条目指向其它文件时追加 _1、_2 后缀。
+   * @return 条目路径；已有同名条目指向同一对象时直接返回该条目。
+   */
+  std::optional<std::filesystem::path> linkName(const std::filesystem::path& object,
+                                                std::string_view name,
+                                                std::error_code& ec) const;
+
+  /**
+   * @brief 删除已不再被任何记录引用的对象，by-name 中指向它的条目改为指向 replacement。
+   * @details 是否仍有记录引用由调用方判断。replacement 为空或改指向失败时直接删除这些条目，浏览用的索引可随时重建。
+   * @return 对象已删除或本就不存在时返回 true。
+   */
+  bool release(const std::filesystem::path& object,
+               const std::filesystem::path& replacement,
+               std::error_code& ec) const;
+
+  /**
+   * @brief 将对象部署到 target（例如游戏 addons 目录），替换已存在的文件。
+   * @details 优先硬链接（O(1)，不占额外空间），跨设备时依次退回 reflink 与复制；
+   *          先写入临时名再改名，target 不会出现半截文件。
+   */
+  static std::optional<StorageMethod> deploy(const std::filesystem::path& object,
+                                             const std::filesystem::path& target,
+                                             std::error_code& ec);
+
+private:
+  std::filesystem::path repoDir_;
+};
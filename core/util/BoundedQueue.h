@@ -0,0 +1,109 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/**
+ * @file BoundedQueue.h
+ * @brief 多生产者/多消费者的有界阻塞队列，用于连接流水线各阶段。
+ * @details 队列满时 push 阻塞，从而把下游的处理速度反压到上游；
+ *          close() 之后 push 立即失败，pop 在取完剩余元素后返回 std::nullopt。
+ */
+template <typename T>
+class BoundedQueue {
+public:
+  /**
+   * @brief 构造队列。
+   * @param capacity 最大容量，至少为 1。
+   */
+  explicit BoundedQueue(std::size_t capacity) : capacity_(capacity == 0 ? 1 : capacity) {}
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  /**
+   * @brief 放入一个元素，队列满时阻塞等待。
+   * @return 队列已关闭时返回 false，元素被丢弃。
+   */
+  bool push(T value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(std::move(value));
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief 取出一个元素，队列为空时阻塞等待。
+   * @return 队列已关闭且为空时返回 std::nullopt。
+   */
+  std::optional<T> pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    T value = std::move(items_.front());
+    items_.pop_front();
+    notFull_.notify_one();
+    return value;
+  }
+
+  /**
+   * @brief 非阻塞地取出一个元素。
+   * @return 当前为空时返回 std::nullopt。
+   */
+  std::optional<T> tryPop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.empty()) {
+      return std::nullopt;
+    }
+    T value = std::move(items_.front());
+    items_.pop_front();
+    notFull_.notify_one();
+    return value;
+  }
+
+  /**
+   * @brief 关闭队列并唤醒所有等待者。已在队列中的元素仍可被取出。
+   */
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  /**
+   * @brief 关闭队列并丢弃尚未取出的元素，用于取消流水线。
+   */
+  void abort() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    items_.clear();
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  bool closed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+  std::size_t capacity() const { return capacity_; }
+
+private:
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::condition_variable notEmpty_;
+  std::condition_variable notFull_;
+  std::deque<T> items_;
+  bool closed_{false};
+};
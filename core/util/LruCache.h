@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @file LruCache.h
+ * @brief 按总开销（通常为字节数）限制大小的最近最少使用缓存。
+ * @details 每个元素在插入时给出开销，总开销超过上限时从最久未访问的元素开始淘汰；
+ *          开销本身超过上限的元素不会被缓存。查找会把元素移到最近使用的位置。
+ *          本类不做同步，多线程访问时由调用方加锁。
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+  /// @param capacity 总开销上限。
+  explicit LruCache(std::size_t capacity) : capacity_(capacity) {}
+
+  /**
+   * @brief 查找元素并标记为最近使用。
+   * @return 指向缓存中值的指针；不存在时返回 nullptr。指针在下一次修改缓存前有效。
+   */
+  const Value* find(const Key& key) {
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    items_.splice(items_.begin(), items_, it->second);
+    return &it->second->value;
+  }
+
+  bool contains(const Key& key) const { return index_.find(key) != index_.end(); }
+
+  /**
+   * @brief 插入或替换元素，随后按需淘汰旧元素。
+   * @return 元素被缓存时返回 true；开销超过上限时返回 false（同键的旧值同样被移除）。
+   */
+  bool insert(const Key& key, Value value, std::size_t cost) {
+    erase(key);
+    if (cost > capacity_) {
+      return false;
+    }
+    items_.push_front(Item{key, std::move(value), cost});
+    index_.emplace(key, items_.begin());
+    total_ += cost;
+    trim();
+    return true;
+  }
+
+  void erase(const Key& key) {
+    const auto it = index_.find(key);
+    if (it == index_.end()) {
+      return;
+    }
+    total_ -= it->second->cost;
+    items_.erase(it->second);
+    index_.erase(it);
+  }
+
+  void clear() {
+    items_.clear();
+    index_.clear();
+    total_ = 0;
+  }
+
+  /// 调整上限，立即淘汰超出的部分。
+  void setCapacity(std::size_t capacity) {
+    capacity_ = capacity;
+    trim();
+  }
+
+  std::size_t capacity() const { return capacity_; }
+  std::size_t totalCost() const { return total_; }
+  std::size_t size() const { return index_.size(); }
+
+private:
+  struct Item {
+    Key key;
+    Value value;
+    std::size_t cost{0};
+  };
+
+  void trim() {
+    while (total_ > capacity_ && !items_.empty()) {
+      const Item& last = items_.back();
+      total_ -= last.cost;
+      index_.erase(last.key);
+      items_.pop_back();
+    }
+  }
+
+  std::size_t capacity_;
+  std::size_t total_{0};
+  std::list<Item> items_; ///< 头部为最近使用
+  std::unordered_map<Key, typename std::list<Item>::iterator, Hash> index_;
+};
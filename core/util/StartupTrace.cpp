@@ -0,0 +1,60 @@
+#include "core/util/StartupTrace.h"
+
+#include <cstdio>
+#include <utility>
+
+namespace {
+
+std::string formatMs(std::chrono::microseconds value) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.1fms", static_cast<double>(value.count()) / 1000.0);
+  return buffer;
+}
+
+} // namespace
+
+std::size_t StartupTrace::begin(std::string name) {
+  const auto now = Clock::now();
+  Phase phase;
+  phase.name = std::move(name);
+  phase.start = std::chrono::duration_cast<std::chrono::microseconds>(now - origin_);
+  phases_.push_back(std::move(phase));
+  starts_.push_back(now);
+  return phases_.size() - 1;
+}
+
+void StartupTrace::end(std::size_t handle) {
+  if (handle >= phases_.size() || phases_[handle].finished) {
+    return;
+  }
+  Phase& phase = phases_[handle];
+  phase.duration = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - starts_[handle]);
+  phase.finished = true;
+}
+
+void StartupTrace::mark(std::string name) {
+  end(begin(std::move(name)));
+  phases_.back().duration = std::chrono::microseconds{0};
+  phases_.back().milestone = true;
+}
+
+std::chrono::microseconds StartupTrace::elapsed() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - origin_);
+}
+
+std::string StartupTrace::summary() const {
+  std::string text;
+  for (const Phase& phase : phases_) {
+    if (!text.empty()) {
+      text += " | ";
+    }
+    text += phase.name;
+    if (phase.milestone) {
+      text += " @" + formatMs(phase.start);
+      continue;
+    }
+    text += " +" + formatMs(phase.start) + " ";
+    text += phase.finished ? formatMs(phase.duration) : std::string("(running)");
+  }
+  return text;
+}
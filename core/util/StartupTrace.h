@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @file StartupTrace.h
+ * @brief 启动阶段计时：记录各阶段相对启动时刻的起点与耗时。
+ * @details 阶段可以重叠（例如后台加载与界面初始化并行），begin() 返回的句柄用于结束对应阶段；
+ *          mark() 记录零耗时的里程碑（如“可交互”）。非线程安全，只应在同一线程上调用，
+ *          后台任务的完成通知应先投递回该线程再结束阶段。
+ */
+class StartupTrace {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Phase {
+    std::string name;
+    std::chrono::microseconds start{0};    ///< 相对构造时刻
+    std::chrono::microseconds duration{0}; ///< 未结束的阶段为 0
+    bool finished = false;
+    bool milestone = false;                ///< 由 mark() 记录
+  };
+
+  StartupTrace() : origin_(Clock::now()) {}
+
+  /// 开始一个阶段，返回用于 end() 的句柄。
+  std::size_t begin(std::string name);
+  /// 结束阶段；重复结束或句柄无效时忽略。
+  void end(std::size_t handle);
+  /// 记录一个里程碑（耗时为 0 的已结束阶段）。
+  void mark(std::string name);
+
+  /// 自构造以来经过的时间。
+  std::chrono::microseconds elapsed() const;
+  const std::vector<Phase>& phases() const { return phases_; }
+
+  /// 单行摘要，如 “settings +0.0ms 3.2ms | database +3.2ms 10.5ms | interactive @48.1ms”。
+  std::string summary() const;
+
+private:
+  Clock::time_point origin_;
+  std::vector<Clock::time_point> starts_;
+  std::vector<Phase> phases_;
+};
@@ -0,0 +1,199 @@
+#include "core/vpk/AddonInfo.h"
+
+#include <cctype>
+
+#include "core/vpk/VpkArchive.h"
+
+/**
+ * @file AddonInfo.cpp
+ * @brief addoninfo.txt 的 KeyValues 解析实现。
+ */
+
+namespace {
+
+/// addoninfo.txt 通常只有几 KiB，超出该长度的条目视为损坏。
+constexpr std::uint64_t kMaxAddonInfoBytes = 256 * 1024;
+
+enum class TokenType { String, OpenBrace, CloseBrace, End };
+
+struct Token {
+  TokenType type{TokenType::End};
+  std::string text;
+};
+
+/**
+ * @brief KeyValues 词法分析器：只产出字符串与花括号。
+ */
+class Tokenizer {
+public:
+  explicit Tokenizer(std::string_view text) : text_(text) {
+    // 跳过 UTF-8 BOM
+    if (text_.size() >= 3 && static_cast<unsigned char>(text_[0]) == 0xEF &&
+        static_cast<unsigned char>(text_[1]) == 0xBB && static_cast<unsigned char>(text_[2]) == 0xBF) {
+      pos_ = 3;
+    }
+  }
+
+  Token next() {
+    skipSpaceAndComments();
+    Token token;
+    if (pos_ >= text_.size()) {
+      return token;
+    }
+    const char ch = text_[pos_];
+    if (ch == '{' || ch == '}') {
+      ++pos_;
+      token.type = ch == '{' ? TokenType::OpenBrace : TokenType::CloseBrace;
+      return token;
+    }
+    token.type = TokenType::String;
+    if (ch == '"') {
+      ++pos_;
+      while (pos_ < text_.size() && text_[pos_] != '"') {
+        char c = text_[pos_++];
+        if (c == '\\' && pos_ < text_.size()) {
+          const char escaped = text_[pos_++];
+          switch (escaped) {
+            case 'n': c = '\n'; break;
+            case 't': c = '\t'; break;
+            case '\\': c = '\\'; break;
+            case '"': c = '"'; break;
+            default:
+              token.text.push_back('\\');
+              c = escaped;
+              break;
+          }
+        }
+        token.text.push_back(c);
+      }
+      if (pos_ < text_.size()) {
+        ++pos_; // 结尾引号；缺失时读到文件末尾为止
+      }
+      return token;
+    }
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_];
+      if (std::isspace(static_cast<unsigned char>(c)) || c == '"' || c == '{' || c == '}') {
+        break;
+      }
+      token.text.push_back(c);
+      ++pos_;
+    }
+    return token;
+  }
+
+private:
+  void skipSpaceAndComments() {
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_];
+      if (std::isspace(static_cast<unsigned char>(c))) {
+        ++pos_;
+      } else if (c == '/' && pos_ + 1 < text_.size() && text_[pos_ + 1] == '/') {
+        while (pos_ < text_.size() && text_[pos_] != '\n') {
+          ++pos_;
+        }
+      } else {
+        break;
+      }
+    }
+  }
+
+  std::string_view text_;
+  std::size_t pos_{0};
+};
+
+std::string toLower(std::string text) {
+  for (char& c : text) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  return text;
+}
+
+std::string trimmed(const std::string& text) {
+  std::size_t begin = 0;
+  std::size_t end = text.size();
+  while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) {
+    ++begin;
+  }
+  while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+    --end;
+  }
+  return text.substr(begin, end - begin);
+}
+
+void assignField(AddonInfo& info, const std::string& key, const std::string& value) {
+  std::string* field = nullptr;
+  if (key == "addontitle") {
+    field = &info.title;
+  } else if (key == "addonauthor") {
+    field = &info.author;
+  } else if (key == "addondescription") {
+    field = &info.description;
+  } else if (key == "addonversion") {
+    field = &info.version;
+  } else if (key == "addontagline") {
+    field = &info.tagline;
+  } else if (key == "addonurl0") {
+    field = &info.url;
+  }
+  // 同一键重复出现时保留第一个非空值
+  if (field && field->empty()) {
+    *field = trimmed(value);
+  }
+}
+
+}  // namespace
+
+std::optional<AddonInfo> parseAddonInfo(std::string_view text) {
+  Tokenizer tokenizer(text);
+  AddonInfo info;
+  // 只关心各层级中的“键 值”对，块名与嵌套层级不影响字段识别
+  while (true) {
+    Token key = tokenizer.next();
+    if (key.type == TokenType::End) {
+      break;
+    }
+    if (key.type != TokenType::String) {
+      continue;
+    }
+    Token value = tokenizer.next();
+    if (value.type == TokenType::End) {
+      break;
+    }
+    if (value.type == TokenType::String) {
+      assignField(info, toLower(std::move(key.text)), value.text);
+    }
+  }
+  if (info.empty()) {
+    return std::nullopt;
+  }
+  return info;
+}
+
+std::optional<AddonInfo> readAddonInfo(const std::filesystem::path& vpkPath, std::error_code& ec) {
+  VpkArchive archive;
+  if (!archive.open(vpkPath, ec)) {
+    return std::nullopt;
+  }
+  const VpkEntry* entry = archive.find("addoninfo.txt");
+  if (!entry) {
+    return std::nullopt;
+  }
+  std::string text;
+  if (!archive.read(*entry, text, ec, kMaxAddonInfoBytes)) {
+    return std::nullopt;
+  }
+  return parseAddonInfo(text);
+}
+
+const VpkEntry* findAddonImage(const VpkArchive& archive) {
+  static constexpr std::string_view kCandidates[] = {
+      "addonimage.jpg", "addonimage.jpeg", "addonimage.png", "addonimage.vtf", "materials/vgui/addonimage.vtf",
+  };
+  for (const auto candidate : kCandidates) {
+    if (const VpkEntry* entry = archive.find(candidate)) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+class VpkArchive;
+struct VpkEntry;
+
+/**
+ * @file AddonInfo.h
+ * @brief 读取 L4D2 附加组件 VPK 中的 addoninfo.txt（KeyValues 文本格式）。
+ * @details 创意工坊与手工打包的 MOD 通常在 VPK 根目录携带 addoninfo.txt，
+ *          其中的标题、作者、描述与版本可用于预填导入时的 MOD 信息。
+ */
+
+/**
+ * @brief addoninfo.txt 中与 MOD 信息相关的字段，缺失的字段为空字符串。
+ */
+struct AddonInfo {
+  std::string title;       ///< addontitle
+  std::string author;      ///< addonauthor
+  std::string description; ///< addonDescription
+  std::string version;     ///< addonversion
+  std::string tagline;     ///< addontagline
+  std::string url;         ///< addonURL0
+
+  bool empty() const {
+    return title.empty() && author.empty() && description.empty() && version.empty() && tagline.empty() &&
+           url.empty();
+  }
+};
+
+/**
+ * @brief 解析 addoninfo.txt 文本。
+ * @details 键名不区分大小写，支持带引号与不带引号的值、// 注释及 \\n \\t \\" \\\\ 转义；
+ *          无法识别的键与嵌套块会被忽略。
+ * @return 没有任何可用字段时返回 std::nullopt。
+ */
+std::optional<AddonInfo> parseAddonInfo(std::string_view text);
+
+/**
+ * @brief 从 VPK 文件中读取并解析根目录下的 addoninfo.txt，不解包其它文件。
+ * @param ec 打开或读取失败的原因；VPK 中没有 addoninfo.txt 时 ec 为空且返回 std::nullopt。
+ */
+std::optional<AddonInfo> readAddonInfo(const std::filesystem::path& vpkPath, std::error_code& ec);
+
+/**
+ * @brief 查找 VPK 内嵌的预览图条目。
+ * @details 依次尝试根目录的 addonimage.jpg/.jpeg/.png、addonimage.vtf 与 materials/vgui/addonimage.vtf；
+ *          JPEG/PNG 优先，因为它们通常是作者为创意工坊准备的原图。
+ * @return 没有预览图时返回 nullptr。
+ */
+const VpkEntry* findAddonImage(const VpkArchive& archive);
@@ -0,0 +1,231 @@
+#include "core/vpk/AssetIndex.h"
+
+#include <algorithm>
+
+#include "core/vpk/VpkArchive.h"
+
+/**
+ * @file AssetIndex.cpp
+ * @brief 资源路径驻留表、倒排索引与冲突配对的实现。
+ */
+
+namespace {
+
+const std::vector<int> kNoMods;
+const std::vector<AssetIndex::PathId> kNoPaths;
+
+inline bool startsWith(std::string_view text, std::string_view prefix) {
+  return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+/// 路径的代表性排序：模型最能说明两个 MOD 替换的是同一对象，其次是声音、脚本与材质。
+int assetRank(std::string_view path) {
+  if (startsWith(path, "models/")) {
+    return 0;
+  }
+  if (startsWith(path, "sound/")) {
+    return 1;
+  }
+  if (startsWith(path, "scripts/")) {
+    return 2;
+  }
+  if (startsWith(path, "materials/")) {
+    return 3;
+  }
+  return 4;
+}
+
+inline std::uint64_t pairKey(int a, int b) {
+  return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(a)) << 32) | static_cast<std::uint32_t>(b);
+}
+
+}  // namespace
+
+std::string normalizeAssetPath(std::string_view path) {
+  std::string result;
+  result.reserve(path.size());
+  for (const char ch : path) {
+    if (ch == '\\' || ch == '/') {
+      if (!result.empty() && result.back() != '/') {
+        result.push_back('/');
+      }
+    } else {
+      result.push_back((ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch);
+    }
+  }
+  return result;
+}
+
+bool isConflictRelevantAsset(std::string_view normalizedPath) {
+  if (normalizedPath.empty() || normalizedPath.back() == '/') {
+    return false;
+  }
+  // 根目录下的 addoninfo.txt / addonimage.* 是附加组件的元数据，每个 MOD 都有
+  if (normalizedPath.find('/') == std::string_view::npos) {
+    return !startsWith(normalizedPath, "addoninfo.") && !startsWith(normalizedPath, "addonimage.");
+  }
+  return true;
+}
+
+std::string assetSlotKey(std::string_view normalizedPath) {
+  const auto slash = normalizedPath.rfind('/');
+  if (startsWith(normalizedPath, "models/")) {
+    // 同一模型的 .mdl/.vvd/.phy/.dx90.vtx 共用槽位
+    const auto dot = normalizedPath.find('.', slash == std::string_view::npos ? 0 : slash + 1);
+    return std::string(normalizedPath.substr(0, dot));
+  }
+  if (slash == std::string_view::npos) {
+    return std::string(normalizedPath);
+  }
+  return std::string(normalizedPath.substr(0, slash));
+}
+
+std::vector<std::string> conflictAssetPaths(const VpkArchive& archive) {
+  std::vector<std::string> paths;
+  paths.reserve(archive.entries().size());
+  for (const VpkEntry& entry : archive.entries()) {
+    std::string path = normalizeAssetPath(entry.path());
+    if (isConflictRelevantAsset(path)) {
+      paths.push_back(std::move(path));
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+  paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+  return paths;
+}
+
+std::optional<std::vector<std::string>> readConflictAssetPaths(const std::filesystem::path& vpkPath,
+                                                               std::error_code& ec) {
+  VpkArchive archive;
+  if (!archive.open(vpkPath, ec)) {
+    return std::nullopt;
+  }
+  return conflictAssetPaths(archive);
+}
+
+AssetIndex::PathId AssetIndex::intern(std::string_view normalizedPath) {
+  const auto it = pathIds_.find(normalizedPath);
+  if (it != pathIds_.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<PathId>(paths_.size());
+  paths_.emplace_back(normalizedPath);
+  pathIds_.emplace(std::string_view(paths_.back()), id);
+  pathRank_.push_back(assetRank(paths_.back()));
+  pathMods_.emplace_back();
+  return id;
+}
+
+std::optional<AssetIndex::PathId> AssetIndex::find(std::string_view normalizedPath) const {
+  const auto it = pathIds_.find(normalizedPath);
+  if (it == pathIds_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void AssetIndex::setModPaths(int modId, std::vector<PathId> pathIds) {
+  removeMod(modId);
+  std::sort(pathIds.begin(), pathIds.end());
+  pathIds.erase(std::unique(pathIds.begin(), pathIds.end()), pathIds.end());
+  for (const PathId id : pathIds) {
+    if (id >= pathMods_.size()) {
+      continue;
+    }
+    auto& mods = pathMods_[id];
+    // 按 MOD ID 升序批量加载时总是追加到末尾
+    if (mods.empty() || mods.back() < modId) {
+      mods.push_back(modId);
+    } else {
+      mods.insert(std::lower_bound(mods.begin(), mods.end(), modId), modId);
+    }
+  }
+  if (!pathIds.empty()) {
+    modPaths_[modId] = std::move(pathIds);
+  }
+}
+
+void AssetIndex::removeMod(int modId) {
+  const auto it = modPaths_.find(modId);
+  if (it == modPaths_.end()) {
+    return;
+  }
+  for (const PathId id : it->second) {
+    auto& mods = pathMods_[id];
+    const auto pos = std::lower_bound(mods.begin(), mods.end(), modId);
+    if (pos != mods.end() && *pos == modId) {
+      mods.erase(pos);
+    }
+  }
+  modPaths_.erase(it);
+}
+
+const std::vector<int>& AssetIndex::modsForPath(PathId id) const {
+  return id < pathMods_.size() ? pathMods_[id] : kNoMods;
+}
+
+const std::vector<AssetIndex::PathId>& AssetIndex::pathsForMod(int modId) const {
+  const auto it = modPaths_.find(modId);
+  return it == modPaths_.end() ? kNoPaths : it->second;
+}
+
+void AssetIndex::accumulate(std::unordered_map<std::uint64_t, PairAccumulator>& pairs, int a, int b,
+                            PathId id) const {
+  PairAccumulator& acc = pairs[pairKey(a, b)];
+  if (acc.shared == 0 || pathRank_[id] < pathRank_[acc.best] ||
+      (pathRank_[id] == pathRank_[acc.best] && paths_[id] < paths_[acc.best])) {
+    acc.best = id;
+  }
+  ++acc.shared;
+}
+
+std::vector<AssetConflict> AssetIndex::finish(const std::unordered_map<std::uint64_t, PairAccumulator>& pairs) const {
+  std::vector<AssetConflict> result;
+  result.reserve(pairs.size());
+  for (const auto& [key, acc] : pairs) {
+    AssetConflict conflict;
+    conflict.a_mod_id = static_cast<int>(key >> 32);
+    conflict.b_mod_id = static_cast<int>(key & 0xFFFFFFFFu);
+    conflict.shared_paths = acc.shared;
+    conflict.sample_path = paths_[acc.best];
+    conflict.slot_key = assetSlotKey(conflict.sample_path);
+    result.push_back(std::move(conflict));
+  }
+  std::sort(result.begin(), result.end(), [](const AssetConflict& lhs, const AssetConflict& rhs) {
+    return lhs.a_mod_id != rhs.a_mod_id ? lhs.a_mod_id < rhs.a_mod_id : lhs.b_mod_id < rhs.b_mod_id;
+  });
+  return result;
+}
+
+std::vector<AssetConflict> AssetIndex::conflicts(std::size_t maxModsPerPath) const {
+  // 只遍历被多个 MOD 覆盖的路径，配对数与真实冲突数同阶，而不是 MOD 数的平方
+  std::unordered_map<std::uint64_t, PairAccumulator> pairs;
+  for (PathId id = 0; id < pathMods_.size(); ++id) {
+    const auto& mods = pathMods_[id];
+    if (mods.size() < 2 || mods.size() > maxModsPerPath) {
+      continue;
+    }
+    for (std::size_t i = 0; i < mods.size(); ++i) {
+      for (std::size_t j = i + 1; j < mods.size(); ++j) {
+        accumulate(pairs, mods[i], mods[j], id);
+      }
+    }
+  }
+  return finish(pairs);
+}
+
+std::vector<AssetConflict> AssetIndex::conflictsFor(int modId, std::size_t maxModsPerPath) const {
+  std::unordered_map<std::uint64_t, PairAccumulator> pairs;
+  for (const PathId id : pathsForMod(modId)) {
+    const auto& mods = pathMods_[id];
+    if (mods.size() < 2 || mods.size() > maxModsPerPath) {
+      continue;
+    }
+    for (const int other : mods) {
+      if (other != modId) {
+        accumulate(pairs, std::min(modId, other), std::max(modId, other), id);
+      }
+    }
+  }
+  return finish(pairs);
+}
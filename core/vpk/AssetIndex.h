@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+class VpkArchive;
+
+/**
+ * @file AssetIndex.h
+ * @brief MOD 资源路径的驻留表与“路径 -> MOD”倒排索引，用于自动发现文件级冲突。
+ * @details L4D2 中两个附加组件覆盖同一资源路径（models/survivors/...、sound/... 等）时只有一个生效，
+ *          这类 MOD 即为真实冲突。路径统一规范化为小写、'/' 分隔后驻留为 32 位 ID，
+ *          每个 MOD 只保存排序后的 ID 列表；倒排索引随单个 MOD 的增删增量维护。
+ */
+
+/**
+ * @brief 规范化资源路径：转为小写、统一使用 '/' 并去掉开头的分隔符。
+ */
+std::string normalizeAssetPath(std::string_view path);
+
+/**
+ * @brief 判断路径是否参与冲突检测。
+ * @details addoninfo.txt 与 addonimage.* 等每个附加组件都会携带的元数据文件不算冲突。
+ * @param normalizedPath 已规范化的路径。
+ */
+bool isConflictRelevantAsset(std::string_view normalizedPath);
+
+/**
+ * @brief 资源路径所属的槽位键，用于给冲突关系填写 slot_key。
+ * @details 模型按不含扩展名的文件路径归并（.mdl/.vvd/.dx90.vtx 属于同一槽位），
+ *          其它资源按所在目录归并，例如 "sound/weapons/rifle"。
+ * @param normalizedPath 已规范化的路径。
+ */
+std::string assetSlotKey(std::string_view normalizedPath);
+
+/**
+ * @brief 列出 VPK 中参与冲突检测的资源路径（已规范化、排序且去重）。
+ */
+std::vector<std::string> conflictAssetPaths(const VpkArchive& archive);
+
+/**
+ * @brief 打开 VPK 并列出参与冲突检测的资源路径。
+ * @param ec 打开或解析失败的原因。
+ * @return 失败时返回 std::nullopt。
+ */
+std::optional<std::vector<std::string>> readConflictAssetPaths(const std::filesystem::path& vpkPath,
+                                                               std::error_code& ec);
+
+/**
+ * @brief 由资源重叠推断出的一对冲突 MOD（a_mod_id < b_mod_id）。
+ */
+struct AssetConflict {
+  int a_mod_id{0};
+  int b_mod_id{0};
+  std::uint32_t shared_paths{0}; ///< 两者共同覆盖的资源数
+  std::string sample_path;       ///< 最具代表性的共同路径（优先模型，其次声音、脚本、材质）
+  std::string slot_key;          ///< sample_path 对应的槽位键
+};
+
+/**
+ * @brief 资源路径驻留表 + 倒排索引。非线程安全，由调用方串行访问。
+ */
+class AssetIndex {
+public:
+  using PathId = std::uint32_t;
+
+  /// 驻留路径（调用方负责规范化），返回稳定的 ID。
+  PathId intern(std::string_view normalizedPath);
+
+  /// 查找已驻留的路径。
+  std::optional<PathId> find(std::string_view normalizedPath) const;
+
+  /// ID 对应的路径。
+  const std::string& path(PathId id) const { return paths_[id]; }
+
+  std::size_t pathCount() const { return paths_.size(); }
+  std::size_t modCount() const { return modPaths_.size(); }
+
+  /**
+   * @brief 设置（替换）一个 MOD 的资源路径，并增量更新倒排索引。
+   * @param pathIds 路径 ID，无需排序或去重。
+   */
+  void setModPaths(int modId, std::vector<PathId> pathIds);
+
+  /// 从索引中移除 MOD。
+  void removeMod(int modId);
+
+  /// 覆盖指定路径的 MOD（升序）。
+  const std::vector<int>& modsForPath(PathId id) const;
+
+  /// MOD 的路径 ID（升序），未索引时为空。
+  const std::vector<PathId>& pathsForMod(int modId) const;
+
+  /**
+   * @brief 计算全部冲突 MOD 对，按 (a_mod_id, b_mod_id) 排序。
+   * @param maxModsPerPath 被超过该数量的 MOD 同时覆盖的路径视为公共资源，不参与配对，
+   *                       避免单个路径产生平方级的配对数量。
+   */
+  std::vector<AssetConflict> conflicts(std::size_t maxModsPerPath = kDefaultMaxModsPerPath) const;
+
+  /// 只计算与 modId 冲突的 MOD，供导入或同步后增量检查。
+  std::vector<AssetConflict> conflictsFor(int modId, std::size_t maxModsPerPath = kDefaultMaxModsPerPath) const;
+
+  static constexpr std::size_t kDefaultMaxModsPerPath = 512;
+
+private:
+  struct PairAccumulator {
+    std::uint32_t shared{0};
+    PathId best{0};
+  };
+
+  void accumulate(std::unordered_map<std::uint64_t, PairAccumulator>& pairs, int a, int b, PathId id) const;
+  std::vector<AssetConflict> finish(const std::unordered_map<std::uint64_t, PairAccumulator>& pairs) const;
+
+  std::deque<std::string> paths_;                         ///< ID -> 路径，deque 保证驻留字符串地址稳定
+  std::unordered_map<std::string_view, PathId> pathIds_;  ///< 路径 -> ID，键引用 paths_
+  std::vector<int> pathRank_;                             ///< ID -> 代表性排序（越小越有代表性）
+  std::vector<std::vector<int>> pathMods_;                ///< ID -> 升序 MOD 列表（倒排索引）
+  std::unordered_map<int, std::vector<PathId>> modPaths_; ///< MOD -> 升序路径 ID
+};
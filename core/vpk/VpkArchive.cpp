@@ -0,0 +1,279 @@
+#include "core/vpk/VpkArchive.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+/**
+ * @file VpkArchive.cpp
+ * @brief VPK 目录树解析与条目读取的实现。
+ */
+
+namespace {
+
+constexpr std::size_t kHeaderSizeV1 = 12;
+constexpr std::size_t kHeaderSizeV2 = 28;
+constexpr std::uint16_t kEntryTerminator = 0xFFFF;
+
+inline std::uint16_t readU16(const std::uint8_t* p) {
+  return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline std::uint32_t readU32(const std::uint8_t* p) {
+  return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline std::error_code malformed() {
+  return std::make_error_code(std::errc::illegal_byte_sequence);
+}
+
+/// 在 [pos, end) 中读取以 '\0' 结尾的字符串。
+bool readString(const std::uint8_t* data, std::size_t end, std::size_t& pos, std::string_view& out) {
+  if (pos >= end) {
+    return false;
+  }
+  const auto* begin = data + pos;
+  const auto* terminator = static_cast<const std::uint8_t*>(std::memchr(begin, 0, end - pos));
+  if (!terminator) {
+    return false;
+  }
+  out = std::string_view(reinterpret_cast<const char*>(begin), static_cast<std::size_t>(terminator - begin));
+  pos += out.size() + 1;
+  return true;
+}
+
+/// VPK 用单个空格表示空的扩展名或根目录。
+inline std::string_view blankToEmpty(std::string_view text) {
+  return text == " " ? std::string_view() : text;
+}
+
+inline char foldChar(char ch) {
+  if (ch == '\\') {
+    return '/';
+  }
+  return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+bool equalsFolded(std::string_view a, std::string_view b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (foldChar(a[i]) != foldChar(b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+std::string VpkEntry::path() const {
+  std::string result;
+  result.reserve(directory.size() + name.size() + extension.size() + 2);
+  if (!directory.empty()) {
+    result.append(directory);
+    result.push_back('/');
+  }
+  result.append(name);
+  if (!extension.empty()) {
+    result.push_back('.');
+    result.append(extension);
+  }
+  return result;
+}
+
+bool VpkArchive::open(const std::filesystem::path& path, std::error_code& ec) {
+  entries_.clear();
+  if (!file_.open(path, ec)) {
+    return false;
+  }
+  path_ = path;
+  data_ = file_.data();
+  size_ = file_.size();
+  return parseTree(ec);
+}
+
+bool VpkArchive::parse(const std::uint8_t* data, std::size_t size, std::error_code& ec) {
+  file_.close();
+  path_.clear();
+  data_ = data;
+  size_ = size;
+  return parseTree(ec);
+}
+
+bool VpkArchive::parseTree(std::error_code& ec) {
+  ec.clear();
+  entries_.clear();
+  version_ = 0;
+  if (!data_ || size_ < kHeaderSizeV1 || readU32(data_) != kSignature) {
+    ec = malformed();
+    return false;
+  }
+  version_ = readU32(data_ + 4);
+  std::size_t headerSize = 0;
+  if (version_ == 1) {
+    headerSize = kHeaderSizeV1;
+  } else if (version_ == 2) {
+    headerSize = kHeaderSizeV2;
+  } else {
+    ec = std::make_error_code(std::errc::not_supported);
+    return false;
+  }
+  const std::uint32_t treeSize = readU32(data_ + 8);
+  if (size_ < headerSize || treeSize > size_ - headerSize) {
+    ec = malformed();
+    return false;
+  }
+  const std::size_t end = headerSize + treeSize;
+  dataOffset_ = end;
+
+  // 目录树为三层嵌套：扩展名 -> 目录 -> 文件名，每层以空字符串结束
+  std::size_t pos = headerSize;
+  const auto fail = [&]() {
+    ec = malformed();
+    entries_.clear();
+    return false;
+  };
+  std::string_view extension;
+  while (true) {
+    if (!readString(data_, end, pos, extension)) {
+      return fail();
+    }
+    if (extension.empty()) {
+      return true;
+    }
+    std::string_view directory;
+    while (true) {
+      if (!readString(data_, end, pos, directory)) {
+        return fail();
+      }
+      if (directory.empty()) {
+        break;
+      }
+      std::string_view name;
+      while (true) {
+        if (!readString(data_, end, pos, name)) {
+          return fail();
+        }
+        if (name.empty()) {
+          break;
+        }
+        if (end - pos < 18) {
+          return fail();
+        }
+        VpkEntry entry;
+        entry.extension = blankToEmpty(extension);
+        entry.directory = blankToEmpty(directory);
+        entry.name = blankToEmpty(name);
+        entry.crc = readU32(data_ + pos);
+        entry.preload_size = readU16(data_ + pos + 4);
+        entry.archive_index = readU16(data_ + pos + 6);
+        entry.offset = readU32(data_ + pos + 8);
+        entry.length = readU32(data_ + pos + 12);
+        const std::uint16_t terminator = readU16(data_ + pos + 16);
+        pos += 18;
+        if (terminator != kEntryTerminator || entry.preload_size > end - pos) {
+          return fail();
+        }
+        entry.preload = entry.preload_size > 0 ? data_ + pos : nullptr;
+        pos += entry.preload_size;
+        entries_.push_back(entry);
+      }
+    }
+  }
+}
+
+const VpkEntry* VpkArchive::find(std::string_view path) const {
+  while (!path.empty() && (path.front() == '/' || path.front() == '\\')) {
+    path.remove_prefix(1);
+  }
+  const auto slash = path.find_last_of("/\\");
+  const std::string_view directory = slash == std::string_view::npos ? std::string_view() : path.substr(0, slash);
+  std::string_view fileName = slash == std::string_view::npos ? path : path.substr(slash + 1);
+  const auto dot = fileName.rfind('.');
+  const std::string_view extension = dot == std::string_view::npos ? std::string_view() : fileName.substr(dot + 1);
+  if (dot != std::string_view::npos) {
+    fileName = fileName.substr(0, dot);
+  }
+  for (const VpkEntry& entry : entries_) {
+    if (equalsFolded(entry.name, fileName) && equalsFolded(entry.extension, extension) &&
+        equalsFolded(entry.directory, directory)) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+std::optional<std::string_view> VpkArchive::view(const VpkEntry& entry) const {
+  if (entry.length == 0) {
+    return std::string_view(reinterpret_cast<const char*>(entry.preload), entry.preload_size);
+  }
+  if (entry.preload_size > 0 || entry.archive_index != kEmbeddedArchive) {
+    return std::nullopt;
+  }
+  const std::uint64_t begin = static_cast<std::uint64_t>(dataOffset_) + entry.offset;
+  if (begin > size_ || entry.length > size_ - begin) {
+    return std::nullopt;
+  }
+  return std::string_view(reinterpret_cast<const char*>(data_ + begin), entry.length);
+}
+
+bool VpkArchive::read(const VpkEntry& entry, std::string& out, std::error_code& ec, std::uint64_t maxBytes) const {
+  ec.clear();
+  out.clear();
+  if (entry.size() > maxBytes) {
+    ec = std::make_error_code(std::errc::file_too_large);
+    return false;
+  }
+  out.reserve(static_cast<std::size_t>(entry.size()));
+  if (entry.preload_size > 0) {
+    out.append(reinterpret_cast<const char*>(entry.preload), entry.preload_size);
+  }
+  if (entry.length == 0) {
+    return true;
+  }
+
+  if (entry.archive_index == kEmbeddedArchive) {
+    const std::uint64_t begin = static_cast<std::uint64_t>(dataOffset_) + entry.offset;
+    if (begin > size_ || entry.length > size_ - begin) {
+      ec = malformed();
+      out.clear();
+      return false;
+    }
+    out.append(reinterpret_cast<const char*>(data_ + begin), entry.length);
+    return true;
+  }
+
+  // 多分卷归档：foo_dir.vpk 的数据位于 foo_000.vpk、foo_001.vpk ...
+  // 使用原生字符串拼接，避免 Windows 上非 ASCII 路径的编码转换
+  const auto stem = path_.stem().native();
+  const auto dirSuffix = std::filesystem::path("_dir").native();
+  if (path_.empty() || stem.size() < dirSuffix.size() ||
+      stem.compare(stem.size() - dirSuffix.size(), dirSuffix.size(), dirSuffix) != 0) {
+    ec = std::make_error_code(std::errc::no_such_file_or_directory);
+    out.clear();
+    return false;
+  }
+  char suffix[16];
+  std::snprintf(suffix, sizeof(suffix), "_%03u.vpk", static_cast<unsigned>(entry.archive_index));
+  auto archivePath = path_.parent_path() / std::filesystem::path(stem.substr(0, stem.size() - dirSuffix.size()));
+  archivePath += suffix;
+  std::ifstream in(archivePath, std::ios::binary);
+  if (!in) {
+    ec = std::make_error_code(std::errc::no_such_file_or_directory);
+    out.clear();
+    return false;
+  }
+  const std::size_t preloadSize = out.size();
+  out.resize(preloadSize + entry.length);
+  in.seekg(static_cast<std::streamoff>(entry.offset));
+  in.read(out.data() + preloadSize, static_cast<std::streamsize>(entry.length));
+  if (in.gcount() != static_cast<std::streamsize>(entry.length)) {
+    ec = malformed();
+    out.clear();
+    return false;
+  }
+  return true;
+}
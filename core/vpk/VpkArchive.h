@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "core/io/MappedFile.h"
+
+/**
+ * @file VpkArchive.h
+ * @brief Valve VPK（v1/v2）目录树的只读解析器。
+ * @details 直接在内存映射上解析目录树，不解包任何文件；条目中的字符串与预载数据均指向映射内存，
+ *          解析只需一次线性扫描，可在导入流水线的多个线程中各自打开不同的文件。
+ *          所有偏移与长度均经过边界检查，损坏或被截断的文件只会让 open()/parse() 返回 false。
+ */
+
+/**
+ * @brief VPK 目录树中的单个文件条目。
+ * @note 字符串与 preload 指向所属 VpkArchive 的内存，不能在归档对象销毁后使用。
+ */
+struct VpkEntry {
+  std::string_view extension;  ///< 扩展名（不含点），无扩展名时为空
+  std::string_view directory;  ///< 所在目录，使用 '/' 分隔，根目录为空
+  std::string_view name;       ///< 不含扩展名的文件名
+  std::uint32_t crc{0};        ///< 文件内容的 CRC32
+  std::uint16_t archive_index{0}; ///< 数据所在的分卷编号，kEmbeddedArchive 表示位于目录文件内
+  std::uint32_t offset{0};     ///< 数据在分卷（或目录文件数据区）中的偏移
+  std::uint32_t length{0};     ///< 预载数据之外的数据长度
+  const std::uint8_t* preload{nullptr}; ///< 紧跟在目录树条目后的预载数据
+  std::uint16_t preload_size{0};        ///< 预载数据长度
+
+  /// 文件完整大小（预载数据 + 分卷数据）。
+  std::uint64_t size() const { return static_cast<std::uint64_t>(preload_size) + length; }
+
+  /// 归档内的完整路径，例如 "materials/vgui/addonimage.jpg"。
+  std::string path() const;
+};
+
+/**
+ * @brief VPK 归档（单文件 VPK 或多分卷归档的 _dir.vpk）。
+ */
+class VpkArchive {
+public:
+  static constexpr std::uint32_t kSignature = 0x55AA1234;  ///< 文件头签名
+  static constexpr std::uint16_t kEmbeddedArchive = 0x7FFF; ///< 数据位于目录文件本身
+
+  VpkArchive() = default;
+  VpkArchive(const VpkArchive&) = delete;
+  VpkArchive& operator=(const VpkArchive&) = delete;
+  VpkArchive(VpkArchive&&) noexcept = default;
+  VpkArchive& operator=(VpkArchive&&) noexcept = default;
+
+  /**
+   * @brief 映射并解析 VPK 文件。
+   * @param ec 失败原因；格式错误时为 std::errc::illegal_byte_sequence。
+   */
+  bool open(const std::filesystem::path& path, std::error_code& ec);
+
+  /**
+   * @brief 解析调用方持有的内存（例如测试数据），不复制也不接管所有权。
+   * @note 解析出的条目引用 data，调用方需保证其生命周期长于本对象。
+   */
+  bool parse(const std::uint8_t* data, std::size_t size, std::error_code& ec);
+
+  std::uint32_t version() const { return version_; }
+  const std::vector<VpkEntry>& entries() const { return entries_; }
+
+  /**
+   * @brief 按路径查找条目（不区分大小写，接受 '/' 或 '\\' 分隔）。
+   * @return 未找到时返回 nullptr。
+   */
+  const VpkEntry* find(std::string_view path) const;
+
+  /**
+   * @brief 读取条目的完整内容。
+   * @details 目录文件内的数据直接从映射内存复制；分卷数据从同目录的 <名称>_NNN.vpk 读取。
+   * @param maxBytes 内容超过该长度时失败（std::errc::file_too_large），用于防御损坏的条目。
+   */
+  bool read(const VpkEntry& entry, std::string& out, std::error_code& ec,
+            std::uint64_t maxBytes = 64ull * 1024 * 1024) const;
+
+  /**
+   * @brief 零拷贝访问条目内容：仅当数据完整位于目录文件的映射内（无预载数据或只有预载数据）时可用。
+   * @details 只有实际访问到的页才会从磁盘读入，适合只需要条目一部分内容的场景（如只解码 VTF 的某一级 mip）。
+   * @return 不可零拷贝访问或越界时返回 std::nullopt，调用方应退回 read()。
+   */
+  std::optional<std::string_view> view(const VpkEntry& entry) const;
+
+private:
+  bool parseTree(std::error_code& ec);
+
+  MappedFile file_;
+  std::filesystem::path path_;
+  const std::uint8_t* data_{nullptr};
+  std::size_t size_{0};
+  std::uint32_t version_{0};
+  std::size_t dataOffset_{0}; ///< 目录文件中嵌入数据区的起始偏移（文件头 + 目录树之后）
+  std::vector<VpkEntry> entries_;
+};
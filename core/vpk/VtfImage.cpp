@@ -0,0 +1,363 @@
+#include "core/vpk/VtfImage.h"
+
+#include <algorithm>
+#include <array>
+
+/**
+ * @file VtfImage.cpp
+ * @brief VTF 文件头、资源表与像素格式解码的实现。
+ */
+
+namespace {
+
+constexpr std::size_t kMinHeaderSize = 64;     ///< 7.0 文件头长度（至 lowResImageHeight 为止）
+constexpr std::size_t kResourceTableOffset = 80; ///< 7.3+ 资源表起始偏移
+constexpr std::uint32_t kResourceHighRes = 0x30; ///< 高分辨率图像数据的资源标签 {0x30, 0, 0}
+constexpr std::uint32_t kFlagEnvmap = 0x4000;
+constexpr int kMaxDimension = 16384;
+constexpr std::uint32_t kMaxResources = 32;
+
+/// VTF 图像格式编号（IMAGE_FORMAT_*），只列出支持解码的格式。
+enum VtfFormat : std::int32_t {
+  RGBA8888 = 0,
+  ABGR8888 = 1,
+  RGB888 = 2,
+  BGR888 = 3,
+  RGB565 = 4,
+  I8 = 5,
+  IA88 = 6,
+  A8 = 8,
+  RGB888_BLUESCREEN = 9,
+  BGR888_BLUESCREEN = 10,
+  ARGB8888 = 11,
+  BGRA8888 = 12,
+  DXT1 = 13,
+  DXT3 = 14,
+  DXT5 = 15,
+  BGRX8888 = 16,
+  BGR565 = 17,
+  BGRX5551 = 18,
+  BGRA4444 = 19,
+  DXT1_ONEBITALPHA = 20,
+  BGRA5551 = 21,
+};
+
+inline std::uint16_t readU16(const std::uint8_t* p) {
+  return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline std::uint32_t readU32(const std::uint8_t* p) {
+  return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+         (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+/// 每像素字节数；块压缩格式返回 0，不支持的格式返回 -1。
+int bytesPerPixel(std::int32_t format) {
+  switch (format) {
+    case RGBA8888: case ABGR8888: case ARGB8888: case BGRA8888: case BGRX8888:
+      return 4;
+    case RGB888: case BGR888: case RGB888_BLUESCREEN: case BGR888_BLUESCREEN:
+      return 3;
+    case RGB565: case BGR565: case IA88: case BGRX5551: case BGRA4444: case BGRA5551:
+      return 2;
+    case I8: case A8:
+      return 1;
+    case DXT1: case DXT1_ONEBITALPHA: case DXT3: case DXT5:
+      return 0;
+    default:
+      return -1;
+  }
+}
+
+/// 单个 mip 的字节数；不支持的格式返回 0。
+std::uint64_t imageBytes(std::int32_t format, int width, int height) {
+  const int bpp = bytesPerPixel(format);
+  if (bpp < 0) {
+    return 0;
+  }
+  if (bpp > 0) {
+    return static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height) * static_cast<std::uint64_t>(bpp);
+  }
+  const std::uint64_t blocks =
+      static_cast<std::uint64_t>((width + 3) / 4) * static_cast<std::uint64_t>((height + 3) / 4);
+  return blocks * ((format == DXT1 || format == DXT1_ONEBITALPHA) ? 8u : 16u);
+}
+
+inline int mipExtent(int extent, int level) {
+  return std::max(1, extent >> level);
+}
+
+inline std::array<std::uint8_t, 4> expand565(std::uint16_t c) {
+  const int r = (c >> 11) & 0x1F;
+  const int g = (c >> 5) & 0x3F;
+  const int b = c & 0x1F;
+  return {static_cast<std::uint8_t>((r << 3) | (r >> 2)), static_cast<std::uint8_t>((g << 2) | (g >> 4)),
+          static_cast<std::uint8_t>((b << 3) | (b >> 2)), 255};
+}
+
+/// 解码 DXT 颜色块的四个调色板颜色；allowThreeColor 为 true 时按 DXT1 规则允许三色 + 透明模式。
+void dxtPalette(const std::uint8_t* block, bool allowThreeColor, std::array<std::array<std::uint8_t, 4>, 4>& palette) {
+  const std::uint16_t c0 = readU16(block);
+  const std::uint16_t c1 = readU16(block + 2);
+  palette[0] = expand565(c0);
+  palette[1] = expand565(c1);
+  if (c0 > c1 || !allowThreeColor) {
+    for (int i = 0; i < 3; ++i) {
+      palette[2][i] = static_cast<std::uint8_t>((2 * palette[0][i] + palette[1][i]) / 3);
+      palette[3][i] = static_cast<std::uint8_t>((palette[0][i] + 2 * palette[1][i]) / 3);
+    }
+    palette[2][3] = palette[3][3] = 255;
+  } else {
+    for (int i = 0; i < 3; ++i) {
+      palette[2][i] = static_cast<std::uint8_t>((palette[0][i] + palette[1][i]) / 2);
+    }
+    palette[2][3] = 255;
+    palette[3] = {0, 0, 0, 0};
+  }
+}
+
+void decodeDxt(std::int32_t format, const std::uint8_t* src, RgbaImage& image) {
+  const bool dxt1 = format == DXT1 || format == DXT1_ONEBITALPHA;
+  const int blockBytes = dxt1 ? 8 : 16;
+  const int blocksWide = (image.width + 3) / 4;
+  const int blocksHigh = (image.height + 3) / 4;
+  std::array<std::array<std::uint8_t, 4>, 4> palette{};
+  std::array<std::uint8_t, 16> alpha{};
+
+  for (int by = 0; by < blocksHigh; ++by) {
+    for (int bx = 0; bx < blocksWide; ++bx) {
+      const std::uint8_t* block = src + (static_cast<std::size_t>(by) * blocksWide + bx) * blockBytes;
+      const std::uint8_t* colorBlock = dxt1 ? block : block + 8;
+      alpha.fill(255);
+      if (format == DXT3) {
+        for (int i = 0; i < 16; ++i) {
+          const int nibble = (block[i / 2] >> ((i % 2) * 4)) & 0x0F;
+          alpha[i] = static_cast<std::uint8_t>(nibble * 17);
+        }
+      } else if (format == DXT5) {
+        std::array<std::uint8_t, 8> levels{};
+        levels[0] = block[0];
+        levels[1] = block[1];
+        if (levels[0] > levels[1]) {
+          for (int i = 1; i < 7; ++i) {
+            levels[i + 1] = static_cast<std::uint8_t>(((7 - i) * levels[0] + i * levels[1]) / 7);
+          }
+        } else {
+          for (int i = 1; i < 5; ++i) {
+            levels[i + 1] = static_cast<std::uint8_t>(((5 - i) * levels[0] + i * levels[1]) / 5);
+          }
+          levels[6] = 0;
+          levels[7] = 255;
+        }
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 6; ++i) {
+          bits |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+        }
+        for (int i = 0; i < 16; ++i) {
+          alpha[i] = levels[(bits >> (3 * i)) & 0x7];
+        }
+      }
+
+      dxtPalette(colorBlock, dxt1, palette);
+      const std::uint32_t indices = readU32(colorBlock + 4);
+      for (int py = 0; py < 4; ++py) {
+        const int y = by * 4 + py;
+        if (y >= image.height) {
+          break;
+        }
+        for (int px = 0; px < 4; ++px) {
+          const int x = bx * 4 + px;
+          if (x >= image.width) {
+            break;
+          }
+          const int i = py * 4 + px;
+          const auto& color = palette[(indices >> (2 * i)) & 0x3];
+          std::uint8_t* dst = image.pixels.data() + (static_cast<std::size_t>(y) * image.width + x) * 4;
+          dst[0] = color[0];
+          dst[1] = color[1];
+          dst[2] = color[2];
+          dst[3] = dxt1 ? color[3] : alpha[i];
+        }
+      }
+    }
+  }
+}
+
+void decodeLinear(std::int32_t format, const std::uint8_t* src, RgbaImage& image) {
+  const std::size_t count = static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height);
+  const int bpp = bytesPerPixel(format);
+  std::uint8_t* dst = image.pixels.data();
+  for (std::size_t i = 0; i < count; ++i, src += bpp, dst += 4) {
+    switch (format) {
+      case RGBA8888:
+        dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+        break;
+      case ABGR8888:
+        dst[0] = src[3]; dst[1] = src[2]; dst[2] = src[1]; dst[3] = src[0];
+        break;
+      case ARGB8888:
+        dst[0] = src[1]; dst[1] = src[2]; dst[2] = src[3]; dst[3] = src[0];
+        break;
+      case BGRA8888:
+        dst[0] = src[2]; dst[1] = src[1]; dst[2] = src[0]; dst[3] = src[3];
+        break;
+      case BGRX8888:
+        dst[0] = src[2]; dst[1] = src[1]; dst[2] = src[0]; dst[3] = 255;
+        break;
+      case RGB888:
+      case RGB888_BLUESCREEN:
+        dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2];
+        dst[3] = (format == RGB888_BLUESCREEN && src[0] == 0 && src[1] == 0 && src[2] == 255) ? 0 : 255;
+        break;
+      case BGR888:
+      case BGR888_BLUESCREEN:
+        dst[0] = src[2]; dst[1] = src[1]; dst[2] = src[0];
+        dst[3] = (format == BGR888_BLUESCREEN && src[0] == 255 && src[1] == 0 && src[2] == 0) ? 0 : 255;
+        break;
+      case RGB565: {
+        const auto c = expand565(readU16(src));
+        dst[0] = c[0]; dst[1] = c[1]; dst[2] = c[2]; dst[3] = 255;
+        break;
+      }
+      case BGR565: {
+        const auto c = expand565(readU16(src));
+        dst[0] = c[2]; dst[1] = c[1]; dst[2] = c[0]; dst[3] = 255;
+        break;
+      }
+      case BGRX5551:
+      case BGRA5551: {
+        const std::uint16_t c = readU16(src);
+        const int b = c & 0x1F;
+        const int g = (c >> 5) & 0x1F;
+        const int r = (c >> 10) & 0x1F;
+        dst[0] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+        dst[1] = static_cast<std::uint8_t>((g << 3) | (g >> 2));
+        dst[2] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+        dst[3] = (format == BGRX5551 || (c & 0x8000)) ? 255 : 0;
+        break;
+      }
+      case BGRA4444: {
+        const std::uint16_t c = readU16(src);
+        dst[0] = static_cast<std::uint8_t>(((c >> 8) & 0x0F) * 17);
+        dst[1] = static_cast<std::uint8_t>(((c >> 4) & 0x0F) * 17);
+        dst[2] = static_cast<std::uint8_t>((c & 0x0F) * 17);
+        dst[3] = static_cast<std::uint8_t>(((c >> 12) & 0x0F) * 17);
+        break;
+      }
+      case I8:
+        dst[0] = dst[1] = dst[2] = src[0]; dst[3] = 255;
+        break;
+      case IA88:
+        dst[0] = dst[1] = dst[2] = src[0]; dst[3] = src[1];
+        break;
+      case A8:
+        dst[0] = dst[1] = dst[2] = 0; dst[3] = src[0];
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+} // namespace
+
+std::optional<RgbaImage> decodeVtf(const std::uint8_t* data, std::size_t size, int minEdge) {
+  if (!data || size < kMinHeaderSize || data[0] != 'V' || data[1] != 'T' || data[2] != 'F' || data[3] != 0) {
+    return std::nullopt;
+  }
+  const std::uint32_t major = readU32(data + 4);
+  const std::uint32_t minor = readU32(data + 8);
+  const std::uint32_t headerSize = readU32(data + 12);
+  if (major != 7 || minor > 5 || headerSize < kMinHeaderSize || headerSize > size) {
+    return std::nullopt;
+  }
+
+  const int width = readU16(data + 16);
+  const int height = readU16(data + 18);
+  const std::uint32_t flags = readU32(data + 20);
+  const int frames = std::max<int>(1, readU16(data + 24));
+  const std::uint16_t firstFrame = readU16(data + 26);
+  const auto format = static_cast<std::int32_t>(readU32(data + 52));
+  const int mipCount = data[56];
+  const auto lowResFormat = static_cast<std::int32_t>(readU32(data + 57));
+  const int lowResWidth = data[61];
+  const int lowResHeight = data[62];
+  const int depth = (minor >= 2 && headerSize >= 65) ? std::max<int>(1, readU16(data + 63)) : 1;
+
+  if (width <= 0 || height <= 0 || width > kMaxDimension || height > kMaxDimension || mipCount <= 0 ||
+      bytesPerPixel(format) < 0) {
+    return std::nullopt;
+  }
+  // 7.5 之前的环境贴图在六个面之外还带一张球面贴图（firstFrame 为 0xFFFF 的旧文件除外）
+  int faces = 1;
+  if (flags & kFlagEnvmap) {
+    faces = (minor < 5 && firstFrame != 0xFFFF) ? 7 : 6;
+  }
+
+  // 高分辨率数据的起点：7.3+ 查资源表，更早的版本紧跟在缩略图之后
+  std::uint64_t highResOffset = 0;
+  if (minor >= 3) {
+    if (headerSize < kResourceTableOffset) {
+      return std::nullopt;
+    }
+    const std::uint32_t resources = readU32(data + 68);
+    if (resources > kMaxResources || kResourceTableOffset + resources * 8ull > headerSize) {
+      return std::nullopt;
+    }
+    bool found = false;
+    for (std::uint32_t i = 0; i < resources; ++i) {
+      const std::uint8_t* entry = data + kResourceTableOffset + i * 8;
+      const std::uint32_t tag = entry[0] | (entry[1] << 8) | (entry[2] << 16);
+      if (tag == kResourceHighRes) {
+        highResOffset = readU32(entry + 4);
+        found = true;
+        break;
+      }
+    }
+    if (!found) {
+      return std::nullopt;
+    }
+  } else {
+    highResOffset = headerSize;
+    if (lowResFormat >= 0 && lowResWidth > 0 && lowResHeight > 0) {
+      if (bytesPerPixel(lowResFormat) < 0) {
+        return std::nullopt;
+      }
+      highResOffset += imageBytes(lowResFormat, lowResWidth, lowResHeight);
+    }
+  }
+
+  // 选择最长边不小于 minEdge 的最小 mip
+  int level = 0;
+  if (minEdge > 0) {
+    while (level + 1 < mipCount &&
+           std::max(mipExtent(width, level + 1), mipExtent(height, level + 1)) >= minEdge) {
+      ++level;
+    }
+  }
+
+  // mip 从最小级别开始存放，每级依次为 帧 × 面 × 切片
+  std::uint64_t offset = highResOffset;
+  for (int i = mipCount - 1; i > level; --i) {
+    const std::uint64_t perImage = imageBytes(format, mipExtent(width, i), mipExtent(height, i));
+    offset += perImage * static_cast<std::uint64_t>(frames) * faces * mipExtent(depth, i);
+    if (offset > size) {
+      return std::nullopt;
+    }
+  }
+
+  RgbaImage image;
+  image.width = mipExtent(width, level);
+  image.height = mipExtent(height, level);
+  const std::uint64_t bytes = imageBytes(format, image.width, image.height);
+  if (offset > size || bytes > size - offset) {
+    return std::nullopt;
+  }
+  image.pixels.assign(static_cast<std::size_t>(image.width) * image.height * 4, 0);
+  if (bytesPerPixel(format) == 0) {
+    decodeDxt(format, data + offset, image);
+  } else {
+    decodeLinear(format, data + offset, image);
+  }
+  return image;
+}
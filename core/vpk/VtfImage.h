@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @file VtfImage.h
+ * @brief Valve 纹理格式（VTF 7.0–7.5）的最小解码器，用于生成 MOD 预览缩略图。
+ * @details 只解码高分辨率图像的一个 mip 级别（第一帧、第一面、第一层切片），
+ *          按目标尺寸选择足够大的最小 mip，因此在映射内存上解码时只会访问该级别的数据页。
+ *          支持常见的非压缩 8/16/24/32 位格式与 DXT1/DXT3/DXT5；所有偏移均经过边界检查。
+ */
+
+/**
+ * @brief 解码后的 RGBA8888 图像，像素按行优先、无行填充存放。
+ */
+struct RgbaImage {
+  int width{0};
+  int height{0};
+  std::vector<std::uint8_t> pixels; ///< width * height * 4 字节
+
+  bool empty() const { return width <= 0 || height <= 0; }
+};
+
+/**
+ * @brief 解码 VTF 中的一个 mip 级别。
+ * @param minEdge 期望的最长边像素数：选择最长边不小于该值的最小 mip；<= 0 时解码完整分辨率。
+ * @return 数据损坏、被截断或格式不受支持时返回 std::nullopt。
+ */
+std::optional<RgbaImage> decodeVtf(const std::uint8_t* data, std::size_t size, int minEdge = 0);
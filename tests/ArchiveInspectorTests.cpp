@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/archive/ArchiveInspector.h"
+#include "tests/TestFiles.h"
+
+namespace {
+
+struct ZipFile {
+  std::string name;
+  std::uint64_t size{0}; ///< 解压后大小；内容按“存储”方式写入 min(size, 16) 个字节
+};
+
+void putU16(std::string& out, std::uint16_t value) {
+  out.push_back(static_cast<char>(value & 0xFF));
+  out.push_back(static_cast<char>(value >> 8));
+}
+
+void putU32(std::string& out, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void putU64(std::string& out, std::uint64_t value) {
+  putU32(out, static_cast<std::uint32_t>(value));
+  putU32(out, static_cast<std::uint32_t>(value >> 32));
+}
+
+/// 构造 ZIP；zip64 为 true 时所有条目的大小与目录位置都写入 Zip64 扩展字段。
+std::string buildZip(const std::vector<ZipFile>& files, bool zip64, const std::string& prefix = {}) {
+  std::string body;
+  std::string central;
+  for (const auto& file : files) {
+    const std::uint32_t offset = static_cast<std::uint32_t>(body.size());
+    const std::string content(static_cast<std::size_t>(std::min<std::uint64_t>(file.size, 16)), 'x');
+    putU32(body, 0x04034b50);
+    body.append(22, '\0');
+    putU16(body, static_cast<std::uint16_t>(file.name.size()));
+    putU16(body, 0);
+    body += file.name + content;
+
+    putU32(central, 0x02014b50);
+    putU16(central, 45);
+    putU16(central, 45);
+    putU16(central, 0);
+    putU16(central, 0);
+    putU32(central, 0);
+    putU32(central, 0);
+    putU32(central, zip64 ? 0xFFFFFFFFu : static_cast<std::uint32_t>(content.size()));
+    putU32(central, zip64 ? 0xFFFFFFFFu : static_cast<std::uint32_t>(file.size));
+    putU16(central, static_cast<std::uint16_t>(file.name.size()));
+    putU16(central, zip64 ? 20 : 0);
+    putU16(central, 0);
+    putU16(central, 0);
+    putU16(central, 0);
+    putU32(central, 0);
+    putU32(central, offset);
+    central += file.name;
+    if (zip64) {
+      putU16(central, 0x0001);
+      putU16(central, 16);
+      putU64(central, file.size);
+      putU64(central, content.size());
+    }
+  }
+
+  std::string out = body + central;
+  const std::uint64_t centralOffset = body.size();
+  if (zip64) {
+    const std::uint64_t zip64End = out.size();
+    putU32(out, 0x06064b50);
+    putU64(out, 44);
+    putU16(out, 45);
+    putU16(out, 45);
+    putU32(out, 0);
+    putU32(out, 0);
+    putU64(out, files.size());
+    putU64(out, files.size());
+    putU64(out, central.size());
+    putU64(out, centralOffset);
+    putU32(out, 0x07064b50);
+    putU32(out, 0);
+    putU64(out, zip64End);
+    putU32(out, 1);
+  }
+  putU32(out, 0x06054b50);
+  putU16(out, 0);
+  putU16(out, 0);
+  putU16(out, zip64 ? 0xFFFF : static_cast<std::uint16_t>(files.size()));
+  putU16(out, zip64 ? 0xFFFF : static_cast<std::uint16_t>(files.size()));
+  putU32(out, zip64 ? 0xFFFFFFFFu : static_cast<std::uint32_t>(central.size()));
+  putU32(out, zip64 ? 0xFFFFFFFFu : static_cast<std::uint32_t>(centralOffset));
+  putU16(out, 5);
+  out += "hello";
+  return prefix + out;
+}
+
+/// 7z 变长整数编码。
+void putNumber(std::string& out, std::uint64_t value) {
+  int extra = 0;
+  while (extra < 8 && value >= (1ull << (7 * (extra + 1)))) {
+    ++extra;
+  }
+  const std::uint8_t prefix = static_cast<std::uint8_t>(0xFF00u >> extra);
+  const std::uint8_t high = extra < 8 ? static_cast<std::uint8_t>(value >> (8 * extra)) : 0;
+  out.push_back(static_cast<char>(prefix | high));
+  for (int i = 0; i < extra; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void putUtf16Name(std::string& out, const std::u16string& name) {
+  for (const char16_t ch : name) {
+    putU16(out, static_cast<std::uint16_t>(ch));
+  }
+  putU16(out, 0);
+}
+
+/// 构造头部未压缩的 7z：一个“复制”编码的文件夹包含 a.vpk 与 sub/b.vpk，另有一个目录条目。
+std::string buildSevenZip(std::uint64_t sizeA, std::uint64_t sizeB, bool encodedHeader = false) {
+  const std::string packed(16, 'p');
+  std::string header;
+  if (encodedHeader) {
+    header.push_back(0x17);
+  } else {
+    header.push_back(0x01);                         // Header
+    header.push_back(0x04);                         // MainStreamsInfo
+    header.push_back(0x06);                         // PackInfo
+    putNumber(header, 0);
+    putNumber(header, 1);
+    header.push_back(0x09);
+    putNumber(header, packed.size());
+    header.push_back(0x00);
+    header.push_back(0x07);                         // UnPackInfo
+    header.push_back(0x0B);
+    putNumber(header, 1);
+    header.push_back(0x00);
+    putNumber(header, 1);                           // 1 个编码器
+    header.push_back(0x01);                         // id 长度 1，简单编码器
+    header.push_back(0x00);                         // Copy
+    header.push_back(0x0C);
+    putNumber(header, sizeA + sizeB);
+    header.push_back(0x0A);                         // 文件夹 CRC
+    header.push_back(0x01);
+    putU32(header, 0x12345678);
+    header.push_back(0x00);
+    header.push_back(0x08);                         // SubStreamsInfo
+    header.push_back(0x0D);
+    putNumber(header, 2);
+    header.push_back(0x09);
+    putNumber(header, sizeA);
+    header.push_back(0x0A);
+    header.push_back(0x01);
+    putU32(header, 1);
+    putU32(header, 2);
+    header.push_back(0x00);
+    header.push_back(0x00);                         // StreamsInfo 结束
+    header.push_back(0x05);                         // FilesInfo
+    putNumber(header, 3);
+    header.push_back(0x0E);                         // EmptyStream：第三个条目
+    putNumber(header, 1);
+    header.push_back(static_cast<char>(0x20));
+    std::string names(1, '\0');
+    putUtf16Name(names, u"a.vpk");
+    putUtf16Name(names, u"sub\\b.vpk");
+    putUtf16Name(names, u"目录");
+    header.push_back(0x11);
+    putNumber(header, names.size());
+    header += names;
+    header.push_back(0x00);
+    header.push_back(0x00);                         // Header 结束
+  }
+
+  std::string out = {'7', 'z', '\xBC', '\xAF', '\x27', '\x1C', 0, 4};
+  putU32(out, 0);
+  putU64(out, packed.size());
+  putU64(out, header.size());
+  putU32(out, 0);
+  return out + packed + header;
+}
+
+const std::uint8_t* bytes(const std::string& data) {
+  return reinterpret_cast<const std::uint8_t*>(data.data());
+}
+
+}  // namespace
+
+TEST(ArchiveInspectorTest, ListsZipCentralDirectory) {
+  const std::vector<ZipFile> files = {
+      {"addons/first.vpk", 120ull * 1024 * 1024},
+      {"addons/", 0},
+      {"Second.VPK", 5000},
+      {"__MACOSX/addons/._first.vpk", 100},
+      {"readme.txt", 10},
+  };
+  for (const bool zip64 : {false, true}) {
+    for (const std::string& prefix : {std::string(), std::string(300, 's')}) {
+      const std::string zip = buildZip(files, zip64, prefix);
+      EXPECT_EQ(detectArchiveFormat(bytes(zip) + prefix.size(), zip.size() - prefix.size()), ArchiveFormat::Zip);
+      std::error_code ec;
+      const auto listing = inspectZip(bytes(zip), zip.size(), ec);
+      ASSERT_TRUE(listing.has_value()) << ec.message() << " zip64=" << zip64;
+      ASSERT_EQ(listing->entries.size(), files.size());
+      EXPECT_TRUE(listing->entries[1].directory);
+      EXPECT_EQ(listing->entries[1].path, "addons");
+      EXPECT_EQ(listing->entries[0].uncompressed_size, 120ull * 1024 * 1024);
+
+      const auto vpks = listing->vpkEntries();
+      ASSERT_EQ(vpks.size(), 2u);
+      EXPECT_EQ(vpks[0]->path, "addons/first.vpk");
+      EXPECT_EQ(vpks[1]->path, "Second.VPK");
+      EXPECT_EQ(listing->vpkUncompressedBytes(), 120ull * 1024 * 1024 + 5000);
+    }
+  }
+
+  // 截断与随机损坏只能被拒绝或产出有限的列表
+  const std::string valid = buildZip(files, true);
+  std::error_code ec;
+  for (std::size_t length = 0; length < valid.size(); ++length) {
+    inspectZip(bytes(valid), length, ec);
+  }
+  std::mt19937 rng(42u);
+  for (int round = 0; round < 3000; ++round) {
+    std::string mutated = valid;
+    for (int i = 0; i < 4; ++i) {
+      mutated[rng() % mutated.size()] = static_cast<char>(rng() & 0xFF);
+    }
+    if (const auto listing = inspectZip(bytes(mutated), mutated.size(), ec)) {
+      EXPECT_LE(listing->entries.size(), mutated.size() / 46);
+    }
+  }
+}
+
+TEST(ArchiveInspectorTest, ListsUncompressedSevenZipHeaders) {
+  const std::string archive = buildSevenZip(300, 70000);
+  EXPECT_EQ(detectArchiveFormat(bytes(archive), archive.size()), ArchiveFormat::SevenZip);
+  std::error_code ec;
+  const auto listing = inspectSevenZip(bytes(archive), archive.size(), ec);
+  ASSERT_TRUE(listing.has_value()) << ec.message();
+  ASSERT_EQ(listing->entries.size(), 3u);
+  EXPECT_EQ(listing->entries[0].path, "a.vpk");
+  EXPECT_EQ(listing->entries[0].uncompressed_size, 300u);
+  EXPECT_EQ(listing->entries[1].path, "sub/b.vpk");
+  EXPECT_EQ(listing->entries[1].uncompressed_size, 70000u);
+  EXPECT_TRUE(listing->entries[2].directory);
+  EXPECT_EQ(listing->entries[2].path, "\xE7\x9B\xAE\xE5\xBD\x95");
+  EXPECT_EQ(listing->vpkUncompressedBytes(), 70300u);
+
+  const std::string encoded = buildSevenZip(1, 1, true);
+  EXPECT_FALSE(inspectSevenZip(bytes(encoded), encoded.size(), ec).has_value());
+  EXPECT_EQ(ec, std::errc::not_supported);
+
+  std::mt19937 rng(99u);
+  for (int round = 0; round < 3000; ++round) {
+    std::string mutated = archive;
+    const int flips = 1 + static_cast<int>(rng() % 4);
+    for (int i = 0; i < flips; ++i) {
+      const std::size_t pos = 32 + 16 + rng() % (archive.size() - 48);
+      mutated[pos] = static_cast<char>(rng() & 0xFF);
+    }
+    inspectSevenZip(bytes(mutated), mutated.size(), ec);
+  }
+  for (std::size_t length = 0; length < archive.size(); ++length) {
+    inspectSevenZip(bytes(archive), length, ec);
+  }
+}
+
+TEST(ArchiveInspectorTest, InspectsFilesBySignature) {
+  const auto dir = makeTestDir("l4d2_archive_test");
+  std::ofstream(dir / "pack.zip", std::ios::binary) << buildZip({{"one.vpk", 10}, {"two.vpk", 20}}, false);
+  std::ofstream(dir / "pack.7z", std::ios::binary) << buildSevenZip(5, 6);
+  std::ofstream(dir / "pack.rar", std::ios::binary) << std::string("Rar!\x1A\x07\x01\x00", 8);
+
+  std::error_code ec;
+  auto listing = inspectArchive(dir / "pack.zip", ec);
+  ASSERT_TRUE(listing.has_value()) << ec.message();
+  EXPECT_EQ(listing->format, ArchiveFormat::Zip);
+  EXPECT_EQ(listing->vpkEntries().size(), 2u);
+  listing = inspectArchive(dir / "pack.7z", ec);
+  ASSERT_TRUE(listing.has_value()) << ec.message();
+  EXPECT_EQ(listing->vpkUncompressedBytes(), 11u);
+  EXPECT_FALSE(inspectArchive(dir / "pack.rar", ec).has_value());
+  EXPECT_EQ(ec, std::errc::not_supported);
+  EXPECT_FALSE(inspectArchive(dir / "missing.zip", ec).has_value());
+  EXPECT_TRUE(ec);
+  std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/repo/RepositoryService.h"
+#include "core/vpk/AssetIndex.h"
+#include "tests/TestDb.h"
+
+namespace {
+
+std::vector<AssetIndex::PathId> internAll(AssetIndex& index, const std::vector<std::string>& paths) {
+  std::vector<AssetIndex::PathId> ids;
+  for (const auto& path : paths) {
+    ids.push_back(index.intern(normalizeAssetPath(path)));
+  }
+  return ids;
+}
+
+int insertMod(RepositoryService& service, const std::string& name) {
+  ModRow mod;
+  mod.name = name;
+  mod.file_hash = name + "-hash";
+  return service.createModsBatch({mod}).front();
+}
+
+}  // namespace
+
+TEST(AssetIndexTest, NormalizesPathsAndDerivesSlotKeys) {
+  EXPECT_EQ(normalizeAssetPath("\\Models\\Survivors//Survivor_Gambler.MDL"), "models/survivors/survivor_gambler.mdl");
+  EXPECT_FALSE(isConflictRelevantAsset("addoninfo.txt"));
+  EXPECT_FALSE(isConflictRelevantAsset("addonimage.jpg"));
+  EXPECT_TRUE(isConflictRelevantAsset("materials/vgui/addonimage.vtf"));
+  EXPECT_TRUE(isConflictRelevantAsset("sound/weapons/rifle/gunfire.wav"));
+
+  EXPECT_EQ(assetSlotKey("models/survivors/survivor_gambler.dx90.vtx"), "models/survivors/survivor_gambler");
+  EXPECT_EQ(assetSlotKey("models/survivors/survivor_gambler.mdl"), "models/survivors/survivor_gambler");
+  EXPECT_EQ(assetSlotKey("sound/weapons/rifle/gunfire.wav"), "sound/weapons/rifle");
+  EXPECT_EQ(assetSlotKey("particles.txt"), "particles.txt");
+}
+
+TEST(AssetIndexTest, PairsModsSharingPathsAndUpdatesIncrementally) {
+  AssetIndex index;
+  index.setModPaths(1, internAll(index, {"models/survivors/survivor_gambler.mdl", "materials/models/nick.vtf",
+                                         "sound/player/nick.wav"}));
+  index.setModPaths(2, internAll(index, {"materials/models/nick.vtf", "models/survivors/survivor_gambler.mdl"}));
+  index.setModPaths(3, internAll(index, {"sound/player/nick.wav", "sound/player/nick.wav"}));
+  index.setModPaths(4, internAll(index, {"scripts/weapon_rifle.txt"}));
+
+  auto conflicts = index.conflicts();
+  ASSERT_EQ(conflicts.size(), 2u);
+  EXPECT_EQ(conflicts[0].a_mod_id, 1);
+  EXPECT_EQ(conflicts[0].b_mod_id, 2);
+  EXPECT_EQ(conflicts[0].shared_paths, 2u);
+  EXPECT_EQ(conflicts[0].sample_path, "models/survivors/survivor_gambler.mdl"); // 模型优先于材质
+  EXPECT_EQ(conflicts[0].slot_key, "models/survivors/survivor_gambler");
+  EXPECT_EQ(conflicts[1].a_mod_id, 1);
+  EXPECT_EQ(conflicts[1].b_mod_id, 3);
+  EXPECT_EQ(conflicts[1].shared_paths, 1u);
+
+  const auto forThree = index.conflictsFor(3);
+  ASSERT_EQ(forThree.size(), 1u);
+  EXPECT_EQ(forThree[0].a_mod_id, 1);
+
+  // 替换与移除只影响相关的倒排列表
+  index.setModPaths(3, internAll(index, {"scripts/weapon_rifle.txt"}));
+  index.removeMod(2);
+  conflicts = index.conflicts();
+  ASSERT_EQ(conflicts.size(), 1u);
+  EXPECT_EQ(conflicts[0].a_mod_id, 3);
+  EXPECT_EQ(conflicts[0].b_mod_id, 4);
+  EXPECT_TRUE(index.conflictsFor(1).empty());
+  const auto nick = index.find("sound/player/nick.wav");
+  ASSERT_TRUE(nick.has_value());
+  EXPECT_EQ(index.modsForPath(*nick), std::vector<int>({1}));
+
+  // 被过多 MOD 覆盖的公共路径不参与配对
+  EXPECT_TRUE(index.conflicts(1).empty());
+}
+
+TEST(AssetIndexTest, ScalesToLargeRepositories) {
+  AssetIndex index;
+  constexpr int kMods = 10000;
+  for (int mod = 1; mod <= kMods; ++mod) {
+    std::vector<AssetIndex::PathId> ids;
+    for (int i = 0; i < 10; ++i) {
+      ids.push_back(index.intern("materials/mod" + std::to_string(mod) + "/texture" + std::to_string(i) + ".vtf"));
+    }
+    // 每 50 个 MOD 替换同一个幸存者模型
+    ids.push_back(index.intern("models/survivors/survivor_" + std::to_string(mod % 200) + ".mdl"));
+    index.setModPaths(mod, std::move(ids));
+  }
+  EXPECT_EQ(index.modCount(), static_cast<std::size_t>(kMods));
+  const auto conflicts = index.conflicts();
+  EXPECT_EQ(conflicts.size(), 200u * (50u * 49u / 2u));
+}
+
+TEST(AssetIndexTest, PersistsIndexAndSuggestsOnlyUnrelatedPairs) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+  const int a = insertMod(service, "a");
+  const int b = insertMod(service, "b");
+  const int c = insertMod(service, "c");
+
+  service.indexModAssets({{a, "a-hash", {"models/weapons/v_rifle.mdl", "sound/weapons/rifle/fire.wav"}},
+                          {b, "b-hash", {"models/weapons/v_rifle.mdl"}},
+                          {c, "c-hash", {"sound/weapons/rifle/fire.wav"}}});
+  const auto scans = service.listAssetScans();
+  ASSERT_EQ(scans.size(), 3u);
+  EXPECT_EQ(scans[0].path_count + scans[1].path_count + scans[2].path_count, 4);
+
+  AssetIndex index = service.loadAssetIndex();
+  EXPECT_EQ(index.pathCount(), 2u);
+  EXPECT_EQ(service.suggestConflicts(index).size(), 2u);
+
+  // 已有关系（这里是同源）的 MOD 对不再建议
+  ModRelationRow relation{};
+  relation.a_mod_id = c;
+  relation.b_mod_id = a;
+  relation.type = "homologous";
+  service.addRelation(relation);
+  auto suggestions = service.suggestConflicts(index);
+  ASSERT_EQ(suggestions.size(), 1u);
+  EXPECT_EQ(suggestions[0].b_mod_id, b);
+  EXPECT_EQ(suggestions[0].slot_key, "models/weapons/v_rifle");
+
+  EXPECT_EQ(service.addConflictRelations(suggestions), 1);
+  const auto relations = service.listRelationsForMod(b);
+  ASSERT_EQ(relations.size(), 1u);
+  EXPECT_EQ(relations[0].type, "conflicts");
+  EXPECT_EQ(relations[0].slot_key.value_or(""), "models/weapons/v_rifle");
+  EXPECT_TRUE(service.suggestConflicts(service.loadAssetIndex(), b).empty());
+
+  // 重新索引会替换旧路径
+  service.indexModAssets({{b, "b-hash2", {"scripts/weapon_rifle.txt"}}});
+  index = service.loadAssetIndex();
+  EXPECT_TRUE(index.conflictsFor(b).empty());
+}
@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/util/BoundedQueue.h"
+
+TEST(BoundedQueueTest, DeliversAllItemsAcrossProducersAndConsumers) {
+  BoundedQueue<int> queue(4);
+  constexpr int kProducers = 3;
+  constexpr int kItemsPerProducer = 500;
+  std::atomic<long long> sum{0};
+  std::atomic<int> count{0};
+
+  std::vector<std::thread> consumers;
+  for (int i = 0; i < 2; ++i) {
+    consumers.emplace_back([&]() {
+      while (auto value = queue.pop()) {
+        sum += *value;
+        ++count;
+      }
+    });
+  }
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&]() {
+      for (int i = 1; i <= kItemsPerProducer; ++i) {
+        ASSERT_TRUE(queue.push(i));
+      }
+    });
+  }
+  for (auto& t : producers) {
+    t.join();
+  }
+  queue.close();
+  for (auto& t : consumers) {
+    t.join();
+  }
+
+  EXPECT_EQ(count.load(), kProducers * kItemsPerProducer);
+  EXPECT_EQ(sum.load(), static_cast<long long>(kProducers) * kItemsPerProducer * (kItemsPerProducer + 1) / 2);
+}
+
+TEST(BoundedQueueTest, CloseDrainsRemainingItemsAndRejectsPush) {
+  BoundedQueue<int> queue(2);
+  ASSERT_TRUE(queue.push(1));
+  ASSERT_TRUE(queue.push(2));
+  queue.close();
+  EXPECT_FALSE(queue.push(3));
+  EXPECT_EQ(queue.pop(), 1);
+  EXPECT_EQ(queue.pop(), 2);
+  EXPECT_FALSE(queue.pop().has_value());
+}
+
+TEST(BoundedQueueTest, AbortUnblocksFullProducer) {
+  BoundedQueue<int> queue(1);
+  ASSERT_TRUE(queue.push(1));
+  std::atomic<bool> pushResult{true};
+  std::thread producer([&]() { pushResult = queue.push(2); });
+  queue.abort();
+  producer.join();
+  EXPECT_FALSE(pushResult.load());
+  EXPECT_FALSE(queue.tryPop().has_value());
+}
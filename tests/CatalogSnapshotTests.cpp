@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/db/Migrations.h"
+#include "core/repo/CatalogSnapshot.h"
+#include "core/repo/RepositoryService.h"
+#include "tests/TestDb.h"
+
+namespace {
+
+std::filesystem::path snapshotPath(const char* name) {
+  return std::filesystem::temp_directory_path() / name;
+}
+
+ModRow makeMod(int id, const std::string& name) {
+  ModRow mod;
+  mod.id = id;
+  mod.name = name;
+  mod.author = "author";
+  mod.rating = id % 5 + 1;
+  mod.category_id = 3;
+  mod.file_path = "mods/" + name + ".vpk";
+  mod.size_mb = 12.5;
+  return mod;
+}
+
+}  // namespace
+
+TEST(CatalogSnapshotTest, RoundTripsModsAndTags) {
+  const auto path = snapshotPath("l4d2_catalog_roundtrip.snapshot");
+  const CatalogSnapshotKey key{9, 42, "abcd"};
+  std::vector<ModRow> mods{makeMod(7, "rifle"), makeMod(3, "中文名称")};
+  mods[1].is_deleted = true;
+  mods[1].archive_member = "pack/b.vpk";
+  std::unordered_map<int, std::vector<TagWithGroupRow>> tags;
+  tags[3] = {{11, 2, "角色", 1, "比尔", 4}, {12, 2, "角色", 1, "佐伊", 5}};
+
+  std::error_code ec;
+  ASSERT_TRUE(CatalogSnapshot::write(path, key, mods, tags, ec)) << ec.message();
+
+  CatalogSnapshot snapshot;
+  ASSERT_TRUE(snapshot.open(path, key, ec)) << ec.message();
+  ASSERT_EQ(snapshot.modCount(), 2u);
+  const ModRow first = snapshot.mod(0);
+  EXPECT_EQ(first.id, 7);
+  EXPECT_EQ(first.file_path, "mods/rifle.vpk");
+  EXPECT_EQ(first.status, "最新");
+  EXPECT_DOUBLE_EQ(first.size_mb, 12.5);
+  EXPECT_TRUE(snapshot.tags(0).empty());
+
+  const ModRow second = snapshot.mod(1);
+  EXPECT_EQ(second.name, "中文名称");
+  EXPECT_TRUE(second.is_deleted);
+  EXPECT_EQ(second.archive_member, "pack/b.vpk");
+  const auto secondTags = snapshot.tags(1);
+  ASSERT_EQ(secondTags.size(), 2u);
+  EXPECT_EQ(secondTags[1].name, "佐伊");
+  EXPECT_EQ(secondTags[1].group_name, "角色");
+  EXPECT_EQ(secondTags[1].priority, 5);
+
+  snapshot.close();
+  std::filesystem::remove(path);
+}
+
+TEST(CatalogSnapshotTest, RejectsStaleOrCorruptedFiles) {
+  const auto path = snapshotPath("l4d2_catalog_stale.snapshot");
+  const CatalogSnapshotKey key{9, 5, "db-a"};
+  std::error_code ec;
+  ASSERT_TRUE(CatalogSnapshot::write(path, key, {makeMod(1, "a"), makeMod(2, "b")}, {}, ec));
+
+  CatalogSnapshot snapshot;
+  EXPECT_FALSE(snapshot.open(path, CatalogSnapshotKey{9, 6, "db-a"}, ec));
+  EXPECT_EQ(ec, std::errc::invalid_argument);
+  EXPECT_FALSE(snapshot.open(path, CatalogSnapshotKey{9, 5, "db-b"}, ec));
+  EXPECT_EQ(ec, std::errc::invalid_argument);
+
+  // 翻转正文中的一个字节，校验和不再匹配
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekg(70);
+    char byte = 0;
+    file.read(&byte, 1);
+    file.seekp(70);
+    byte = static_cast<char>(byte ^ 0x5A);
+    file.write(&byte, 1);
+  }
+  EXPECT_FALSE(snapshot.open(path, key, ec));
+  EXPECT_EQ(ec, std::errc::illegal_byte_sequence);
+  EXPECT_EQ(snapshot.modCount(), 0u);
+  std::filesystem::remove(path);
+}
+
+TEST(CatalogSnapshotTest, CatalogVersionAdvancesOnModAndTagWrites) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+
+  const CatalogSnapshotKey initial = service.catalogSnapshotKey();
+  EXPECT_EQ(initial.schema_version, migrations::currentSchemaVersion(*db));
+  EXPECT_EQ(initial.catalog_id.size(), 16u);
+
+  ModRow mod = makeMod(0, "versioned");
+  mod.file_hash = "versioned-hash";
+  const int modId = service.createModWithTags(mod, {{"类型", "武器"}});
+  const CatalogSnapshotKey afterCreate = service.catalogSnapshotKey();
+  EXPECT_GT(afterCreate.catalog_version, initial.catalog_version);
+  EXPECT_EQ(afterCreate.catalog_id, initial.catalog_id);
+
+  service.setModDeleted(modId, true);
+  EXPECT_GT(service.catalogSnapshotKey().catalog_version, afterCreate.catalog_version);
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/hash/DuplicateDetector.h"
+#include "core/hash/Xxh64.h"
+#include "tests/TestFiles.h"
+
+namespace {
+
+// 测试用全量哈希：统计调用次数，便于验证大小唯一的文件不会被读取
+struct CountingHasher {
+  std::atomic<int>* calls;
+  std::string operator()(const std::filesystem::path& path) const {
+    ++*calls;
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return std::to_string(Xxh64::hash(data.data(), data.size()));
+  }
+};
+
+}  // namespace
+
+TEST(DuplicateDetectorTest, ClassifiesBySizeFingerprintAndFullHash) {
+  std::atomic<int> calls{0};
+  const std::string repoContent(200 * 1024, 'r');
+  const auto repoFile = writeTempFile("l4d2_dup_repo.vpk", repoContent);
+
+  std::string sameSizeDifferentMiddle = repoContent;
+  sameSizeDifferentMiddle[100 * 1024] = 'm';
+  std::string sameSizeDifferentHead = repoContent;
+  sameSizeDifferentHead[0] = 'h';
+
+  std::vector<std::filesystem::path> paths = {
+      writeTempFile("l4d2_dup_unique.vpk", std::string(1234, 'u')),       // 大小唯一
+      writeTempFile("l4d2_dup_copy.vpk", repoContent),                    // 与仓库重复
+      writeTempFile("l4d2_dup_middle.vpk", sameSizeDifferentMiddle),      // 指纹相同但全量不同
+      writeTempFile("l4d2_dup_head.vpk", sameSizeDifferentHead),          // 指纹不同
+      writeTempFile("l4d2_dup_batch_a.vpk", std::string(4096, 'b')),      // 本批首个
+      writeTempFile("l4d2_dup_batch_b.vpk", std::string(4096, 'b')),      // 与上一项重复
+  };
+  std::vector<std::uint64_t> sizes;
+  for (const auto& path : paths) {
+    sizes.push_back(std::filesystem::file_size(path));
+  }
+
+  KnownFile known;
+  known.id = 42;
+  known.size_bytes = repoContent.size();
+  known.path = repoFile;
+  DuplicateDetector detector({known}, CountingHasher{&calls});
+  const auto decisions = detector.resolve(paths, sizes, 3);
+
+  ASSERT_EQ(decisions.size(), paths.size());
+  EXPECT_EQ(decisions[0].kind, DuplicateDecision::Kind::Unique);
+  EXPECT_FALSE(decisions[0].fingerprint.has_value());
+  EXPECT_EQ(decisions[1].kind, DuplicateDecision::Kind::DuplicateOfKnown);
+  EXPECT_EQ(decisions[1].known_id, 42);
+  EXPECT_EQ(decisions[2].kind, DuplicateDecision::Kind::Distinct);
+  EXPECT_FALSE(decisions[2].full_hash.empty());
+  EXPECT_EQ(decisions[3].kind, DuplicateDecision::Kind::Distinct);
+  EXPECT_TRUE(decisions[3].full_hash.empty());
+  EXPECT_EQ(decisions[4].kind, DuplicateDecision::Kind::Distinct);
+  EXPECT_EQ(decisions[5].kind, DuplicateDecision::Kind::DuplicateInBatch);
+  EXPECT_EQ(decisions[5].batch_index, 4u);
+  // 仓库文件 + 两个与之指纹相同的文件 + 本批两个同内容文件
+  EXPECT_EQ(calls.load(), 5);
+
+  std::filesystem::remove(repoFile);
+  for (const auto& path : paths) {
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(DuplicateDetectorTest, MatchesLegacyHashWithoutReadingRepositoryFile) {
+  std::atomic<int> currentCalls{0};
+  std::atomic<int> legacyCalls{0};
+  const std::string content(64 * 1024, 'l');
+  std::vector<std::filesystem::path> paths = {
+      writeTempFile("l4d2_dup_legacy_copy.vpk", content),
+      writeTempFile("l4d2_dup_legacy_other.vpk", std::string(content.size(), 'o')),
+  };
+  std::vector<std::uint64_t> sizes = {content.size(), content.size()};
+
+  // 仓库文件已丢失，只剩以早期算法记录的哈希与指纹
+  const auto fingerprint = computeFileFingerprint(paths[0]);
+  ASSERT_TRUE(fingerprint.has_value());
+  KnownFile known;
+  known.id = 7;
+  known.size_bytes = content.size();
+  known.head_tail_hash = fingerprint->head_tail_hash;
+  known.legacy_hash = CountingHasher{&legacyCalls}(paths[0]);
+  known.path = std::filesystem::temp_directory_path() / "l4d2_dup_legacy_missing.vpk";
+  legacyCalls = 0;
+
+  DuplicateDetector detector({known}, CountingHasher{&currentCalls}, CountingHasher{&legacyCalls});
+  const auto decisions = detector.resolve(paths, sizes, 2);
+
+  ASSERT_EQ(decisions.size(), 2u);
+  EXPECT_EQ(decisions[0].kind, DuplicateDecision::Kind::DuplicateOfKnown);
+  EXPECT_EQ(decisions[0].known_id, 7);
+  EXPECT_EQ(decisions[1].kind, DuplicateDecision::Kind::Distinct);
+  // 只有与仓库指纹相同的待导入文件按两种算法各计算一次
+  EXPECT_EQ(currentCalls.load(), 1);
+  EXPECT_EQ(legacyCalls.load(), 1);
+
+  for (const auto& path : paths) {
+    std::filesystem::remove(path);
+  }
+}
+
+TEST(DuplicateDetectorTest, MatchesLegacyHashWithinApproximateSize) {
+  std::atomic<int> currentCalls{0};
+  std::atomic<int> legacyCalls{0};
+  const std::string content(100 * 1024 + 17, 'a');
+  std::vector<std::filesystem::path> paths = {
+      writeTempFile("l4d2_dup_approx_copy.vpk", content),
+      writeTempFile("l4d2_dup_approx_other.vpk", std::string(content.size() + 1000, 'o')),
+      writeTempFile("l4d2_dup_approx_far.vpk", std::string(content.size() + 9000, 'f')),
+  };
+  std::vector<std::uint64_t> sizes;
+  for (const auto& path : paths) {
+    sizes.push_back(std::filesystem::file_size(path));
+  }
+
+  // 文件已丢失且没有指纹记录，只剩按两位小数保存的大小与早期算法的哈希
+  KnownFile known;
+  known.id = 9;
+  known.size_bytes = 100 * 1024 + 2000;
+  known.size_slack_bytes = 5243;
+  known.legacy_hash = CountingHasher{&legacyCalls}(paths[0]);
+  known.path = std::filesystem::temp_directory_path() / "l4d2_dup_approx_missing.vpk";
+  legacyCalls = 0;
+
+  DuplicateDetector detector({known}, CountingHasher{&currentCalls}, CountingHasher{&legacyCalls});
+  const auto decisions = detector.resolve(paths, sizes, 2);
+
+  ASSERT_EQ(decisions.size(), 3u);
+  EXPECT_EQ(decisions[0].kind, DuplicateDecision::Kind::DuplicateOfKnown);
+  EXPECT_EQ(decisions[0].known_id, 9);
+  EXPECT_EQ(decisions[1].kind, DuplicateDecision::Kind::Distinct);
+  EXPECT_EQ(decisions[2].kind, DuplicateDecision::Kind::Unique);
+  // 只有落在近似范围内的文件按早期算法计算，近似记录不参与全量哈希分组
+  EXPECT_EQ(legacyCalls.load(), 2);
+  EXPECT_EQ(currentCalls.load(), 0);
+
+  for (const auto& path : paths) {
+    std::filesystem::remove(path);
+  }
+}
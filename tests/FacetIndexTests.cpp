@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/index/FacetIndex.h"
+
+namespace {
+
+ModRow makeMod(int id, int categoryId, const std::string& author, int rating) {
+  ModRow mod;
+  mod.id = id;
+  mod.name = "mod" + std::to_string(id);
+  mod.category_id = categoryId;
+  mod.author = author;
+  mod.rating = rating;
+  return mod;
+}
+
+}  // namespace
+
+TEST(FacetIndexTest, ResolvesFacetsToSortedPostings) {
+  // 分类树：1 -> 2 -> 3，4 为另一棵顶级分类
+  const std::unordered_map<int, int> parents{{2, 1}, {3, 2}};
+  const std::vector<ModRow> mods{
+      makeMod(10, 3, "alice", 5),
+      makeMod(11, 0, "bob", 0),
+      makeMod(12, 2, "alice", 3),
+      makeMod(13, 4, "", 5),
+  };
+  const std::unordered_map<int, std::vector<int>> tags{{10, {7, 8}}, {12, {8, 8}}};
+
+  FacetIndex index;
+  index.build(mods, tags, parents);
+  ASSERT_EQ(index.size(), mods.size());
+
+  EXPECT_EQ(index.categorySubtree(1), (FacetIndex::Postings{0, 2}));
+  EXPECT_EQ(index.categorySubtree(3), (FacetIndex::Postings{0}));
+  EXPECT_EQ(index.categorySubtree(4), (FacetIndex::Postings{3}));
+  EXPECT_TRUE(index.categorySubtree(99).empty());
+  EXPECT_EQ(index.uncategorized(), (FacetIndex::Postings{1}));
+
+  EXPECT_EQ(index.tag(8), (FacetIndex::Postings{0, 2}));
+  EXPECT_EQ(index.tag(7), (FacetIndex::Postings{0}));
+  EXPECT_EQ(index.untagged(), (FacetIndex::Postings{1, 3}));
+
+  EXPECT_EQ(index.author("alice"), (FacetIndex::Postings{0, 2}));
+  EXPECT_TRUE(index.author("Alice").empty());
+
+  EXPECT_EQ(index.rating(5), (FacetIndex::Postings{0, 3}));
+  EXPECT_EQ(index.rating(-1), (FacetIndex::Postings{1}));
+}
+
+TEST(FacetIndexTest, ToleratesCategoryCycles) {
+  const std::unordered_map<int, int> parents{{1, 2}, {2, 1}};
+  FacetIndex index;
+  index.build({makeMod(1, 1, "", 0)}, {}, parents);
+  EXPECT_EQ(index.categorySubtree(1), (FacetIndex::Postings{0}));
+  EXPECT_EQ(index.categorySubtree(2), (FacetIndex::Postings{0}));
+}
+
+TEST(FacetIndexTest, UpdatesAndErasesSingleIndices) {
+  const std::unordered_map<int, int> parents{{2, 1}};
+  FacetIndex index;
+  index.build({makeMod(10, 2, "alice", 5), makeMod(11, 0, "bob", 0)}, {{10, {7}}}, parents);
+
+  // 修改分类、作者、评分与标签后，旧值的倒排表不再包含该下标
+  index.update(0, makeMod(10, 0, "carol", 3), {}, parents);
+  EXPECT_TRUE(index.categorySubtree(1).empty());
+  EXPECT_EQ(index.uncategorized(), (FacetIndex::Postings{0, 1}));
+  EXPECT_TRUE(index.author("alice").empty());
+  EXPECT_EQ(index.author("carol"), (FacetIndex::Postings{0}));
+  EXPECT_TRUE(index.rating(5).empty());
+  EXPECT_TRUE(index.tag(7).empty());
+  EXPECT_EQ(index.untagged(), (FacetIndex::Postings{0, 1}));
+
+  // 追加新下标，再移除一个已有下标
+  index.update(2, makeMod(12, 2, "bob", 0), {7}, parents);
+  ASSERT_EQ(index.size(), 3u);
+  EXPECT_EQ(index.categorySubtree(1), (FacetIndex::Postings{2}));
+  EXPECT_EQ(index.author("bob"), (FacetIndex::Postings{1, 2}));
+  index.erase(1);
+  EXPECT_EQ(index.author("bob"), (FacetIndex::Postings{2}));
+  EXPECT_EQ(index.rating(0), (FacetIndex::Postings{2}));
+  EXPECT_EQ(index.size(), 3u);
+}
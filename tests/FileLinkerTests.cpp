@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "core/io/FileLinker.h"
+#include "core/repo/RepositoryService.h"
+#include "tests/TestDb.h"
+#include "tests/TestFiles.h"
+
+TEST(FileLinkerTest, LinksWithoutCopyingOnSameDevice) {
+  const auto dir = makeTestDir("l4d2_linker_test");
+  const auto src = dir / "source.vpk";
+  writeFile(src, "linked content");
+
+  std::error_code ec;
+  const auto method = linkFile(src, dir / "linked.vpk", ec);
+  ASSERT_TRUE(method.has_value()) << ec.message();
+  // 同一目录下 reflink 或硬链接总有一个可用
+  EXPECT_TRUE(*method == StorageMethod::Reflink || *method == StorageMethod::Hardlink);
+  EXPECT_EQ(readAll(dir / "linked.vpk"), "linked content");
+
+  // 目标已存在时所有方式都应失败，且不破坏已有文件
+  EXPECT_FALSE(linkFile(src, dir / "linked.vpk", ec).has_value());
+  EXPECT_TRUE(ec);
+  EXPECT_EQ(readAll(dir / "linked.vpk"), "linked content");
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(FileLinkerTest, ReflinkKeepsSourcePermissions) {
+  const auto dir = makeTestDir("l4d2_linker_reflink_test");
+  const auto src = dir / "source.vpk";
+  writeFile(src, "cloned content");
+  const auto perms = std::filesystem::perms::owner_read | std::filesystem::perms::owner_exec |
+                     std::filesystem::perms::group_read;
+  std::filesystem::permissions(src, perms);
+
+  std::error_code ec;
+  if (!reflinkFile(src, dir / "clone.vpk", ec)) {
+    std::filesystem::remove_all(dir);
+    GTEST_SKIP() << "reflink not supported here: " << ec.message();
+  }
+  EXPECT_EQ(std::filesystem::status(dir / "clone.vpk").permissions(), perms);
+  EXPECT_EQ(readAll(dir / "clone.vpk"), "cloned content");
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(FileLinkerTest, StorageMethodNamesRoundTrip) {
+  for (StorageMethod method : {StorageMethod::Move, StorageMethod::Copy, StorageMethod::Reflink,
+                               StorageMethod::Hardlink, StorageMethod::Symlink}) {
+    EXPECT_EQ(storageMethodFromName(storageMethodName(method)), method);
+  }
+  EXPECT_FALSE(storageMethodFromName("teleport").has_value());
+}
+
+TEST(FileLinkerTest, StorageMethodIsPersistedWithMod) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+
+  ModRow mod;
+  mod.name = "Linked";
+  mod.storage_method = "hardlink";
+  const int modId = service.createModWithTags(mod, {});
+  EXPECT_EQ(service.findMod(modId)->storage_method, "hardlink");
+  ASSERT_EQ(service.listVisible().size(), 1u);
+  EXPECT_EQ(service.listVisible().front().storage_method, "hardlink");
+
+  // 文件元数据更新时未指定方式则保留原值
+  ModFileMetadataRow metadata;
+  metadata.mod_id = modId;
+  metadata.file_path = "moved.vpk";
+  service.updateModFileMetadata({metadata});
+  EXPECT_EQ(service.findMod(modId)->storage_method, "hardlink");
+  metadata.storage_method = "copy";
+  service.updateModFileMetadata({metadata});
+  EXPECT_EQ(service.findMod(modId)->storage_method, "copy");
+}
@@ -0,0 +1,34 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "core/index/FilterBitset.h"
+
+TEST(FilterBitsetTest, KeepsOrderAndAnswersMembership) {
+  // 名称搜索按相关度给出的顺序，含一个重复与一个越界下标
+  const FilterBitset result(130, {129, 3, 64, 3, 200, -1});
+  EXPECT_EQ(result.ordered(), (std::vector<int>{129, 3, 64}));
+  EXPECT_EQ(result.count(), 3u);
+  EXPECT_FALSE(result.matchesAll());
+
+  EXPECT_TRUE(result.test(3));
+  EXPECT_TRUE(result.test(64));
+  EXPECT_TRUE(result.test(129));
+  EXPECT_FALSE(result.test(63));
+  EXPECT_FALSE(result.test(130));
+  EXPECT_FALSE(result.test(-1));
+}
+
+TEST(FilterBitsetTest, AllMatchesEveryIndexInUniverse) {
+  const FilterBitset result = FilterBitset::all(5);
+  EXPECT_TRUE(result.matchesAll());
+  EXPECT_EQ(result.count(), 5u);
+  EXPECT_TRUE(result.ordered().empty());
+  EXPECT_TRUE(result.test(0));
+  EXPECT_TRUE(result.test(4));
+  EXPECT_FALSE(result.test(5));
+
+  const FilterBitset empty;
+  EXPECT_EQ(empty.count(), 0u);
+  EXPECT_FALSE(empty.test(0));
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/hash/Fingerprint.h"
+#include "core/hash/Xxh64.h"
+#include "core/repo/RepositoryDao.h"
+#include "core/repo/RepositoryService.h"
+#include "tests/TestDb.h"
+#include "tests/TestFiles.h"
+
+TEST(Xxh64Test, MatchesReferenceVectors) {
+  EXPECT_EQ(Xxh64::hash("", 0), 0xEF46DB3751D8E999ULL);
+  EXPECT_EQ(Xxh64::hash("a", 1), 0xD24EC4F1A98C6E5BULL);
+  EXPECT_EQ(Xxh64::hash("abc", 3), 0x44BC2CF5AD770999ULL);
+}
+
+TEST(Xxh64Test, StreamingMatchesOneShot) {
+  std::string data(1000, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 31 + 7);
+  }
+  Xxh64 hasher(42);
+  hasher.update(data.data(), 5);
+  hasher.update(data.data() + 5, 60);
+  hasher.update(data.data() + 65, data.size() - 65);
+  EXPECT_EQ(hasher.digest(), Xxh64::hash(data.data(), data.size(), 42));
+}
+
+TEST(FingerprintTest, IgnoresMiddleButTracksHeadTailAndSize) {
+  std::string content(300 * 1024, 'x');
+  const auto original = writeTempFile("l4d2_fp_original.vpk", content);
+  std::string middleChanged = content;
+  middleChanged[150 * 1024] = 'y';
+  const auto middle = writeTempFile("l4d2_fp_middle.vpk", middleChanged);
+  std::string tailChanged = content;
+  tailChanged.back() = 'z';
+  const auto tail = writeTempFile("l4d2_fp_tail.vpk", tailChanged);
+
+  const auto fpOriginal = computeFileFingerprint(original);
+  const auto fpMiddle = computeFileFingerprint(middle);
+  const auto fpTail = computeFileFingerprint(tail);
+  ASSERT_TRUE(fpOriginal && fpMiddle && fpTail);
+  EXPECT_EQ(fpOriginal->size_bytes, content.size());
+  EXPECT_EQ(*fpOriginal, *fpMiddle);
+  EXPECT_NE(*fpOriginal, *fpTail);
+  EXPECT_FALSE(computeFileFingerprint(std::filesystem::temp_directory_path() / "l4d2_fp_missing.vpk"));
+
+  std::filesystem::remove(original);
+  std::filesystem::remove(middle);
+  std::filesystem::remove(tail);
+}
+
+TEST(ModFingerprintDaoTest, UpsertAndCascadeOnModDelete) {
+  auto db = createTestDb();
+  RepositoryDao repo(db);
+  RepositoryService service(db);
+
+  ModRow mod;
+  mod.name = "Fingerprinted";
+  mod.size_mb = 1.0;
+  const int modId = repo.insertMod(mod);
+
+  service.upsertModFingerprints({{modId, 1024, 0xFFFFFFFFFFFFFFF0ULL}});
+  service.upsertModFingerprints({{modId, 2048, 0x8000000000000001ULL}});
+  auto rows = service.listModFingerprints();
+  ASSERT_EQ(rows.size(), 1u);
+  EXPECT_EQ(rows[0].mod_id, modId);
+  EXPECT_EQ(rows[0].size_bytes, 2048u);
+  EXPECT_EQ(rows[0].head_tail_hash, 0x8000000000000001ULL);
+
+  db->exec("DELETE FROM mods WHERE id = " + std::to_string(modId) + ";");
+  EXPECT_TRUE(service.listModFingerprints().empty());
+}
+
+TEST(ModFileStemTest, MatchesTitledAddonsByFileName) {
+  // 名称取自 addoninfo.txt 的标题时，游戏目录扫描仍按仓库文件名匹配
+  ModRow titled;
+  titled.name = "Big Tank Skin";
+  titled.file_path = "D:\\L4D2\\mods\\tank_skin.v2.vpk";
+  titled.file_hash = "0123abcd";
+  EXPECT_EQ(modFileStem(titled), "tank_skin.v2");
+
+  ModRow member = titled;
+  member.file_path = "/repo/mods/pack.zip";
+  member.archive_member = "addons/witch.vpk";
+  EXPECT_EQ(modFileStem(member), "witch");
+
+  // 按内容寻址存放的对象文件名只是哈希，不能用来匹配
+  ModRow object = titled;
+  object.file_path = "/repo/objects/01/0123ABCD.vpk";
+  EXPECT_TRUE(modFileStem(object).empty());
+
+  ModRow unnamed;
+  EXPECT_TRUE(modFileStem(unnamed).empty());
+}
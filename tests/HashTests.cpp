@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/hash/Blake3.h"
+#include "core/hash/FileHasher.h"
+#include "core/hash/Sha256.h"
+#include "core/repo/RepositoryDao.h"
+#include "core/repo/RepositoryService.h"
+#include "tests/TestDb.h"
+#include "tests/TestFiles.h"
+
+namespace {
+
+// 官方测试向量使用的输入：第 i 个字节为 i % 251
+std::string patternInput(std::size_t length) {
+  std::string data(length, '\0');
+  for (std::size_t i = 0; i < length; ++i) {
+    data[i] = static_cast<char>(i % 251);
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(Blake3Test, MatchesReferenceVectors) {
+  const std::vector<std::pair<std::size_t, std::string>> vectors = {
+      {0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+      {1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"},
+      {1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11"},
+      {1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+      {1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+      {3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3"},
+      {8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"},
+      {31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47"},
+  };
+  for (const auto& [length, expected] : vectors) {
+    const std::string data = patternInput(length);
+    EXPECT_EQ(hashBytes(data.data(), data.size(), HashAlgorithm::Blake3, 1), expected) << "length " << length;
+  }
+}
+
+TEST(Blake3Test, StreamingAndParallelMatchOneShot) {
+  const std::string data = patternInput(5 * 1024 * 1024 + 123);
+  const auto expected = Blake3::hash(data.data(), data.size());
+
+  Blake3 hasher;
+  std::size_t offset = 0;
+  for (std::size_t step : {1u, 63u, 64u, 1000u, 4096u}) {
+    hasher.update(data.data() + offset, step);
+    offset += step;
+  }
+  hasher.update(data.data() + offset, data.size() - offset);
+  EXPECT_EQ(hasher.digest(), expected);
+
+  EXPECT_EQ(Blake3::hashParallel(data.data(), data.size(), 4), expected);
+  // 恰好落在并行子树边界上的长度
+  EXPECT_EQ(Blake3::hashParallel(data.data(), 3 * 1024 * 1024, 3), Blake3::hash(data.data(), 3 * 1024 * 1024));
+}
+
+TEST(Sha256Test, MatchesReferenceVectors) {
+  EXPECT_EQ(hashBytes("", 0, HashAlgorithm::Sha256),
+            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(hashBytes("abc", 3, HashAlgorithm::Sha256),
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  const std::string million(1000000, 'a');
+  EXPECT_EQ(hashBytes(million.data(), million.size(), HashAlgorithm::Sha256),
+            "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(FileHasherTest, HashesFilesWithEitherAlgorithm) {
+  const std::string data = patternInput(102400);
+  const auto path = writeTempFile("l4d2_file_hasher_test.bin", data);
+  EXPECT_EQ(hashFile(path, HashAlgorithm::Blake3),
+            "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085");
+  EXPECT_EQ(hashFile(path, HashAlgorithm::Sha256), hashBytes(data.data(), data.size(), HashAlgorithm::Sha256));
+  EXPECT_TRUE(hashFile(path.string() + ".missing", HashAlgorithm::Blake3).empty());
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(hashAlgorithmFromName(""), HashAlgorithm::Sha256);
+  EXPECT_EQ(hashAlgorithmFromName("blake3"), HashAlgorithm::Blake3);
+  EXPECT_FALSE(hashAlgorithmFromName("md5").has_value());
+}
+
+TEST(FileHasherTest, HashAlgorithmIsStoredPerMod) {
+  auto db = createTestDb();
+  RepositoryDao repo(db);
+
+  ModRow legacy;
+  legacy.name = "Legacy";
+  legacy.file_hash = "legacy-sha256";
+  const int legacyId = repo.insertMod(legacy);
+
+  ModRow current;
+  current.name = "Current";
+  current.file_hash = "current-blake3";
+  current.hash_algo = "blake3";
+  const int currentId = repo.insertMod(current);
+
+  EXPECT_EQ(hashAlgorithmFromName(repo.findById(legacyId)->hash_algo), HashAlgorithm::Sha256);
+  EXPECT_EQ(repo.findById(currentId)->hash_algo, "blake3");
+
+  ModFileMetadataRow metadata;
+  metadata.mod_id = legacyId;
+  metadata.file_hash = "rehashed-blake3";
+  metadata.hash_algo = "blake3";
+  repo.updateFileMetadata({metadata});
+  const auto updated = repo.findById(legacyId);
+  ASSERT_TRUE(updated.has_value());
+  EXPECT_EQ(updated->file_hash, "rehashed-blake3");
+  EXPECT_EQ(updated->hash_algo, "blake3");
+}
+
+TEST(FileHasherTest, DuplicateLookupMatchesHashAlgorithm) {
+  auto db = createTestDb();
+  RepositoryDao repo(db);
+  RepositoryService service(db);
+
+  // 早期版本入库的记录：SHA-256，hash_algo 为空
+  ModRow legacy;
+  legacy.name = "Legacy";
+  legacy.file_hash = "same-digest";
+  const int legacyId = repo.insertMod(legacy);
+
+  ModRow sameAlgo;
+  sameAlgo.name = "SameAlgo";
+  sameAlgo.file_hash = "same-digest";
+  sameAlgo.hash_algo = "sha256";
+  ModRow other;
+  other.name = "Other";
+  other.file_hash = "other-blake3";
+  other.hash_algo = "blake3";
+
+  EXPECT_THROW(service.createModWithTags(sameAlgo, {}), DbError);
+  const auto ids = service.createModsBatch({sameAlgo, other});
+  ASSERT_EQ(ids.size(), 2u);
+  EXPECT_EQ(ids[0], 0);
+  EXPECT_GT(ids[1], 0);
+  EXPECT_EQ(service.listAll().size(), 2u);
+  EXPECT_EQ(repo.findByFileHash(legacy.file_hash, "sha256")->id, legacyId);
+  EXPECT_FALSE(repo.findByFileHash(legacy.file_hash, "blake3").has_value());
+}
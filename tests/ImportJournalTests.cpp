@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/io/TransferEngine.h"
+#include "core/repo/RepositoryService.h"
+#include "tests/TestDb.h"
+#include "tests/TestFiles.h"
+
+namespace {
+
+ImportJournalRow makeEntry(int jobId, const std::string& path, ImportStage stage) {
+  ImportJournalRow row;
+  row.job_id = jobId;
+  row.source_path = path;
+  row.size_bytes = 1024;
+  row.modified_at = 1700000000000;
+  row.stage = stage;
+  return row;
+}
+
+}  // namespace
+
+TEST(ImportJournalTest, RoundTripsCheckpointsAndResumesUnfinishedJobs) {
+  RepositoryService service(createTestDb());
+  EXPECT_FALSE(service.findResumableImportJob("/mods").has_value());
+
+  const int jobId = service.beginImportJob("/mods", true, "Copy");
+  ASSERT_GT(jobId, 0);
+
+  auto hashed = makeEntry(jobId, "/mods/a.vpk", ImportStage::Hashed);
+  hashed.file_hash = "hash-a";
+  hashed.hash_algo = "blake3";
+  hashed.head_tail_hash = 0x1234u;
+  auto transferred = makeEntry(jobId, "/mods/b.vpk", ImportStage::Transferred);
+  transferred.target_path = "/repo/b.vpk";
+  transferred.storage_method = "copy";
+  service.recordImportJournal({hashed, transferred});
+
+  // 同一文件再次记录时覆盖旧阶段
+  hashed.stage = ImportStage::Failed;
+  hashed.error = "locked";
+  service.recordImportJournal({hashed});
+
+  const auto entries = service.listImportJournal(jobId);
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries[0].source_path, "/mods/a.vpk");
+  EXPECT_EQ(entries[0].stage, ImportStage::Failed);
+  EXPECT_EQ(entries[0].error, "locked");
+  EXPECT_EQ(entries[0].file_hash, "hash-a");
+  ASSERT_TRUE(entries[0].head_tail_hash.has_value());
+  EXPECT_EQ(*entries[0].head_tail_hash, 0x1234u);
+  EXPECT_EQ(entries[1].stage, ImportStage::Transferred);
+  EXPECT_EQ(entries[1].target_path, "/repo/b.vpk");
+  EXPECT_FALSE(entries[1].head_tail_hash.has_value());
+
+  service.finishImportJob(jobId, false);
+  const auto resumable = service.findResumableImportJob("/mods");
+  ASSERT_TRUE(resumable.has_value());
+  EXPECT_EQ(resumable->id, jobId);
+  EXPECT_EQ(resumable->status, kImportJobInterrupted);
+  EXPECT_EQ(resumable->action, "Copy");
+  EXPECT_TRUE(resumable->recursive);
+
+  service.finishImportJob(jobId, true);
+  EXPECT_FALSE(service.findResumableImportJob("/mods").has_value());
+  EXPECT_TRUE(service.listImportJournal(jobId).empty());
+}
+
+TEST(ImportJournalTest, BatchInsertMarksJournalInSameTransaction) {
+  RepositoryService service(createTestDb());
+  ModRow existing;
+  existing.name = "Existing";
+  existing.file_hash = "dup-hash";
+  service.createModsBatch({existing});
+
+  const int jobId = service.beginImportJob("/mods", false, "Cut");
+  ModRow fresh;
+  fresh.name = "Fresh";
+  fresh.file_hash = "fresh-hash";
+  std::vector<ImportJournalRow> journal = {makeEntry(jobId, "/mods/fresh.vpk", ImportStage::Transferred),
+                                           makeEntry(jobId, "/mods/dup.vpk", ImportStage::Transferred)};
+  const auto ids = service.createModsBatch({fresh, existing}, &journal);
+  ASSERT_EQ(ids.size(), 2u);
+  EXPECT_GT(ids[0], 0);
+  EXPECT_EQ(ids[1], 0);
+
+  const auto entries = service.listImportJournal(jobId);
+  ASSERT_EQ(entries.size(), 2u);
+  EXPECT_EQ(entries[0].source_path, "/mods/dup.vpk");
+  EXPECT_EQ(entries[0].stage, ImportStage::Duplicate);
+  EXPECT_EQ(entries[1].stage, ImportStage::Inserted);
+  EXPECT_EQ(entries[1].mod_id, ids[0]);
+}
+
+TEST(ImportJournalTest, CopiesLeaveNoPartialFilesAndStalePartialsAreSwept) {
+  const auto dir = makeTestDir("l4d2_import_journal_test");
+  {
+    std::ofstream(dir / "src.vpk", std::ios::binary) << std::string(64 * 1024, 'x');
+    std::ofstream(dir / (std::string("stale.vpk") + TransferEngine::kPartialSuffix), std::ios::binary) << "half";
+    // 对象存储中断的复制留在分片子目录中
+    std::filesystem::create_directories(dir / "objects" / "ab");
+    std::ofstream(dir / "objects" / "ab" / (std::string("abcd.vpk") + TransferEngine::kPartialSuffix),
+                  std::ios::binary) << "half";
+  }
+
+  EXPECT_EQ(TransferEngine::removeStalePartials(dir), 2u);
+  EXPECT_FALSE(std::filesystem::exists(dir / (std::string("stale.vpk") + TransferEngine::kPartialSuffix)));
+  EXPECT_FALSE(std::filesystem::exists(dir / "objects" / "ab" / (std::string("abcd.vpk") + TransferEngine::kPartialSuffix)));
+  EXPECT_TRUE(std::filesystem::is_directory(dir / "objects" / "ab"));
+
+  TransferEngine engine;
+  const auto results = engine.run({{dir / "src.vpk", dir / "dst.vpk", TransferJob::Mode::Copy}});
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_TRUE(results[0].ok());
+  EXPECT_EQ(std::filesystem::file_size(dir / "dst.vpk"), 64u * 1024u);
+  EXPECT_FALSE(std::filesystem::exists(dir / (std::string("dst.vpk") + TransferEngine::kPartialSuffix)));
+  EXPECT_EQ(TransferEngine::removeStalePartials(dir), 0u);
+  std::filesystem::remove_all(dir);
+}
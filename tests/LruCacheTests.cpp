@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "core/util/LruCache.h"
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsedByCost) {
+  LruCache<std::string, int> cache(10);
+  EXPECT_TRUE(cache.insert("a", 1, 4));
+  EXPECT_TRUE(cache.insert("b", 2, 4));
+  // 访问 a 之后，b 成为最久未使用的元素
+  ASSERT_NE(cache.find("a"), nullptr);
+  EXPECT_TRUE(cache.insert("c", 3, 4));
+
+  EXPECT_EQ(cache.find("b"), nullptr);
+  ASSERT_NE(cache.find("a"), nullptr);
+  EXPECT_EQ(*cache.find("c"), 3);
+  EXPECT_EQ(cache.totalCost(), 8u);
+
+  cache.setCapacity(4);
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_TRUE(cache.contains("c"));
+}
+
+TEST(LruCacheTest, ReplacesAndRejectsOversizedItems) {
+  LruCache<int, std::string> cache(8);
+  EXPECT_TRUE(cache.insert(1, "one", 3));
+  EXPECT_TRUE(cache.insert(1, "uno", 5));
+  EXPECT_EQ(*cache.find(1), "uno");
+  EXPECT_EQ(cache.totalCost(), 5u);
+
+  EXPECT_FALSE(cache.insert(1, "huge", 9));
+  EXPECT_FALSE(cache.contains(1));
+  EXPECT_EQ(cache.totalCost(), 0u);
+
+  cache.insert(2, "two", 2);
+  cache.erase(2);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+}
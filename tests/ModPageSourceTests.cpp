@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/db/Stmt.h"
+#include "core/repo/ModPageSource.h"
+#include "core/repo/RepositoryService.h"
+#include "tests/TestDb.h"
+
+namespace {
+
+ModRow makeMod(const std::string& name, std::optional<int> categoryId, int rating, const std::string& author) {
+  ModRow mod;
+  mod.name = name;
+  mod.author = author;
+  mod.rating = rating;
+  mod.category_id = categoryId.value_or(0);
+  mod.file_path = "mods/" + name + ".vpk";
+  mod.file_hash = "hash-" + name;
+  return mod;
+}
+
+std::vector<std::string> namesOf(ModPageSource& source) {
+  std::vector<std::string> names;
+  for (std::size_t i = 0; i < source.count(); ++i) {
+    const ModRow* row = source.rowAt(i);
+    names.push_back(row ? row->name : std::string("<null>"));
+  }
+  return names;
+}
+
+}  // namespace
+
+TEST(ModPageSourceTest, PushesFiltersIntoQueries) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+
+  const int weapons = service.createCategory("武器", std::nullopt);
+  const int rifles = service.createCategory("步枪", weapons);
+  const int survivors = service.createCategory("人物", std::nullopt);
+
+  service.createModWithTags(makeMod("ak47", rifles, 5, "alice"), {{"类型", "高清"}});
+  service.createModWithTags(makeMod("axe", weapons, 3, "bob"), {});
+  const int bill = service.createModWithTags(makeMod("bill", survivors, 0, "alice"), {{"类型", "高清"}});
+  service.createModWithTags(makeMod("m16", rifles, 0, "carol"), {});
+  const int removed = service.createModWithTags(makeMod("ammo", std::nullopt, 4, "bob"), {});
+  service.setModDeleted(removed, true);
+
+  const int hd = service.listTagsForMod(bill).front().id;
+  const auto names = [&service](ModPageFilter filter) {
+    ModPageSource source(service, std::move(filter), 2, 2);
+    return namesOf(source);
+  };
+
+  EXPECT_EQ(names({}), (std::vector<std::string>{"ak47", "axe", "bill", "m16"}));
+  ModPageFilter withDeleted;
+  withDeleted.include_deleted = true;
+  EXPECT_EQ(names(withDeleted), (std::vector<std::string>{"ak47", "ammo", "axe", "bill", "m16"}));
+
+  ModPageFilter subtree;
+  subtree.category_id = weapons;
+  EXPECT_EQ(names(subtree), (std::vector<std::string>{"ak47", "axe", "m16"}));
+  ModPageFilter uncategorized;
+  uncategorized.category_id = 0;
+  uncategorized.include_deleted = true;
+  EXPECT_EQ(names(uncategorized), (std::vector<std::string>{"ammo"}));
+
+  ModPageFilter tagged;
+  tagged.tag_id = hd;
+  EXPECT_EQ(names(tagged), (std::vector<std::string>{"ak47", "bill"}));
+  ModPageFilter untagged;
+  untagged.tag_id = 0;
+  EXPECT_EQ(names(untagged), (std::vector<std::string>{"axe", "m16"}));
+
+  ModPageFilter byAuthor;
+  byAuthor.author = "alice";
+  byAuthor.category_id = weapons;
+  EXPECT_EQ(names(byAuthor), (std::vector<std::string>{"ak47"}));
+
+  ModPageFilter unrated;
+  unrated.rating = 0;
+  EXPECT_EQ(names(unrated), (std::vector<std::string>{"bill", "m16"}));
+  ModPageFilter rated;
+  rated.rating = 3;
+  EXPECT_EQ(names(rated), (std::vector<std::string>{"axe"}));
+
+  ModPageFilter prefix;
+  prefix.name_prefix = "a";
+  EXPECT_EQ(names(prefix), (std::vector<std::string>{"ak47", "axe"}));
+  ModPageFilter upperPrefix;
+  upperPrefix.name_prefix = "BI";
+  EXPECT_EQ(names(upperPrefix), (std::vector<std::string>{"bill"}));
+
+  EXPECT_EQ(service.listAuthors(), (std::vector<std::string>{"alice", "bob", "carol"}));
+}
+
+TEST(ModPageSourceTest, RandomAccessKeepsOnlyRecentPages) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+
+  // 名称重复的 MOD 由 id 决定顺序，分页边界落在重复名称之间时也不能漏行或重行
+  constexpr int kMods = 1000;
+  std::vector<std::string> expected;
+  for (int i = 0; i < kMods; ++i) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "mod%03d", i / 2);
+    ModRow mod = makeMod(name, std::nullopt, 0, "author");
+    mod.file_hash = "hash-" + std::to_string(i);
+    service.createModWithTags(mod, {});
+    expected.push_back(name);
+  }
+
+  ModPageSource source(service, {}, 7, 3);
+  ASSERT_EQ(source.count(), static_cast<std::size_t>(kMods));
+
+  const std::vector<std::size_t> probes{999, 0, 500, 501, 13, 14, 998, 250, 6, 7};
+  for (const std::size_t index : probes) {
+    const ModRow* row = source.rowAt(index);
+    ASSERT_NE(row, nullptr) << index;
+    EXPECT_EQ(row->name, expected[index]) << index;
+    EXPECT_LE(source.cachedPageCount(), 3u);
+  }
+  EXPECT_EQ(source.rowAt(kMods), nullptr);
+
+  std::vector<int> ids;
+  for (std::size_t i = 0; i < source.count(); ++i) {
+    ids.push_back(source.rowAt(i)->id);
+  }
+  std::sort(ids.begin(), ids.end());
+  EXPECT_EQ(std::unique(ids.begin(), ids.end()), ids.end());
+  EXPECT_EQ(ids.size(), static_cast<std::size_t>(kMods));
+}
+
+TEST(ModPageSourceTest, IndexOfRanksRowsWithinFilter) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+
+  const int beta = service.createModWithTags(makeMod("beta", std::nullopt, 2, "x"), {});
+  const int alpha = service.createModWithTags(makeMod("alpha", std::nullopt, 0, "x"), {});
+  const int gamma = service.createModWithTags(makeMod("gamma", std::nullopt, 2, "x"), {});
+
+  ModPageFilter rated;
+  rated.rating = 2;
+  ModPageSource source(service, rated, 1, 2);
+  EXPECT_EQ(source.indexOf(*service.findMod(beta)), 0);
+  EXPECT_EQ(source.indexOf(*service.findMod(gamma)), 1);
+  EXPECT_EQ(source.indexOf(*service.findMod(alpha)), -1);
+
+  service.setModDeleted(beta, true);
+  source.invalidate();
+  EXPECT_EQ(source.count(), 1u);
+  EXPECT_EQ(source.indexOf(gamma), 0);
+  EXPECT_EQ(source.indexOf(9999), -1);
+}
+
+TEST(ModPageSourceTest, PageQueriesReadOnlyIndexes) {
+  auto db = createTestDb();
+  // 与 RepositoryDao 中计数、OFFSET 定位与前缀筛选的语句一致，查询规划应只读索引、不回表
+  const auto planOf = [&db](const std::string& sql) {
+    Stmt stmt(*db, "EXPLAIN QUERY PLAN " + sql);
+    std::string plan;
+    while (stmt.step()) {
+      plan += stmt.getText(3) + "\n";
+    }
+    return plan;
+  };
+  EXPECT_NE(planOf("SELECT COUNT(*) FROM mods WHERE is_deleted = 0;").find("COVERING INDEX idx_mods_"),
+            std::string::npos);
+  EXPECT_NE(planOf("SELECT name, id FROM mods WHERE is_deleted = 0 ORDER BY name COLLATE NOCASE, id LIMIT 1 OFFSET 100;")
+                .find("COVERING INDEX idx_mods_name"),
+            std::string::npos);
+  EXPECT_NE(planOf("SELECT COUNT(*) FROM mods WHERE is_deleted = 0 AND author = 'alice';")
+                .find("COVERING INDEX idx_mods_author"),
+            std::string::npos);
+  const std::string prefixPlan = planOf(
+      "SELECT name, id FROM mods WHERE is_deleted = 0 AND name >= 'bi' COLLATE NOCASE AND name < 'bj' COLLATE NOCASE "
+      "ORDER BY name COLLATE NOCASE, id;");
+  EXPECT_NE(prefixPlan.find("SEARCH mods USING COVERING INDEX idx_mods_name"), std::string::npos);
+  EXPECT_EQ(prefixPlan.find("TEMP B-TREE"), std::string::npos);
+}
+
+TEST(ModPageSourceTest, PagesMixedCaseNamesInOneOrder) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+  for (const char* name : {"bravo", "Alpha", "alpha", "Charlie", "BRAVO2"}) {
+    service.createModWithTags(makeMod(name, std::nullopt, 0, "x"), {});
+  }
+  // 页大小为 2，跨页的键比较与排序须使用同一排序规则
+  ModPageSource source(service, ModPageFilter{}, 2, 2);
+  EXPECT_EQ(namesOf(source), (std::vector<std::string>{"Alpha", "alpha", "bravo", "BRAVO2", "Charlie"}));
+}
+
+TEST(ModPageSourceTest, FiltersGivenIdsInSql) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+
+  const int weapons = service.createCategory("武器", std::nullopt);
+  const int ak47 = service.createModWithTags(makeMod("ak47", weapons, 5, "alice"), {});
+  const int axe = service.createModWithTags(makeMod("axe", weapons, 3, "bob"), {});
+  const int bill = service.createModWithTags(makeMod("bill", std::nullopt, 0, "alice"), {});
+  const int removed = service.createModWithTags(makeMod("ammo", weapons, 4, "bob"), {});
+  service.setModDeleted(removed, true);
+
+  ModPageFilter inWeapons;
+  inWeapons.category_id = weapons;
+  EXPECT_EQ(service.filterModIds(inWeapons, {bill, axe, removed, 9999}), (std::vector<int>{axe}));
+  inWeapons.include_deleted = true;
+  EXPECT_EQ(service.filterModIds(inWeapons, {bill, axe, removed}), (std::vector<int>{axe, removed}));
+
+  ModPageFilter byAuthor;
+  byAuthor.author = "alice";
+  EXPECT_EQ(service.filterModIds(byAuthor, {ak47, axe, bill}), (std::vector<int>{ak47, bill}));
+  EXPECT_TRUE(service.filterModIds(byAuthor, {}).empty());
+
+  // 超过旧版 SQLite 999 个参数上限的列表分批查询后合并
+  std::vector<int> manyIds(2500);
+  for (std::size_t i = 0; i < manyIds.size(); ++i) {
+    manyIds[i] = static_cast<int>(i) + 10000;
+  }
+  manyIds.push_back(bill);
+  manyIds.insert(manyIds.begin(), ak47);
+  EXPECT_EQ(service.filterModIds(byAuthor, manyIds), (std::vector<int>{ak47, bill}));
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "core/index/NameSearchIndex.h"
+
+namespace {
+
+std::vector<int> ids(const std::vector<NameSearchIndex::Match>& matches) {
+  std::vector<int> result;
+  for (const auto& match : matches) {
+    result.push_back(match.id);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(NameSearchIndexTest, NormalizesCaseWidthAndSeparators) {
+  EXPECT_EQ(NameSearchIndex::normalize("Tank_Skin (HD)"), U"tankskinhd");
+  EXPECT_EQ(NameSearchIndex::normalize("ＴＡＮＫ　皮肤"), U"tank皮肤");
+  EXPECT_EQ(NameSearchIndex::boundedSubstringDistance(U"tank", U"bigtankskin", 2), 0);
+  EXPECT_EQ(NameSearchIndex::boundedSubstringDistance(U"tnak", U"bigtankskin", 2), 1);
+  EXPECT_EQ(NameSearchIndex::boundedSubstringDistance(U"zzzz", U"bigtankskin", 1), 2);
+}
+
+TEST(NameSearchIndexTest, RanksExactPrefixAndTypoMatches) {
+  NameSearchIndex index;
+  index.upsert(1, "Big Tank Skin", "alice");
+  index.upsert(2, "Tank Skin", "bob");
+  index.upsert(3, "Witch Model", "tankmaker");
+  index.upsert(4, "Smoker Voice", "carol");
+  index.upsert(5, "丧尸 坦克 皮肤", "");
+
+  // 前缀匹配优先于中间匹配，名称优先于作者
+  EXPECT_EQ(ids(index.search("tank")), (std::vector<int>{2, 1, 3}));
+  // 相邻交换与单字替换都计为一次编辑
+  EXPECT_EQ(ids(index.search("tnak skin")), (std::vector<int>{2, 1}));
+  EXPECT_EQ(ids(index.search("smokr voice")), (std::vector<int>{4}));
+  // 不足三个码点的查询走子串扫描
+  EXPECT_EQ(ids(index.search("坦克")), (std::vector<int>{5}));
+  EXPECT_EQ(ids(index.search("tank", 1)), (std::vector<int>{2}));
+
+  index.remove(2);
+  index.upsert(1, "Hunter Skin", "alice");
+  EXPECT_EQ(ids(index.search("tank")), (std::vector<int>{3}));
+  EXPECT_EQ(index.size(), 4u);
+  index.upsert(6, "Tank Skin v2", "");
+  EXPECT_EQ(ids(index.search("tank skin")), (std::vector<int>{6}));
+}
+
+TEST(NameSearchIndexTest, FindsTranspositionsInShortQueries) {
+  NameSearchIndex index;
+  index.upsert(1, "abcdef", "");
+  index.upsert(2, "abcde", "");
+  index.upsert(3, "tankskinpack", "");
+
+  // 中间的相邻换位破坏全部三元组，由二元组兜底召回
+  EXPECT_EQ(ids(index.search("abdcef")), (std::vector<int>{1}));
+  EXPECT_EQ(ids(index.search("acbde")), (std::vector<int>{2, 1}));
+  // 两次换位时三元组与二元组都无法排除条目，退化为全量校验
+  EXPECT_EQ(ids(index.search("atnksikn")), (std::vector<int>{3}));
+}
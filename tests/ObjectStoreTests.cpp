@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "core/io/TransferEngine.h"
+#include "core/store/ObjectStore.h"
+#include "tests/TestFiles.h"
+
+TEST(ObjectStoreTest, DeduplicatesIdenticalPayloads) {
+  const auto dir = std::filesystem::temp_directory_path() / "l4d2_object_store_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir / "downloads");
+  const ObjectStore store(dir / "repo");
+  const std::string hash = "ABCDEF0123456789";
+
+  const auto object = store.objectPath(hash, ".VPK");
+  EXPECT_EQ(object, dir / "repo" / "objects" / "ab" / "cdef0123456789.vpk");
+  EXPECT_TRUE(store.isObjectPath(object));
+  EXPECT_FALSE(store.isObjectPath(dir / "repo" / "cdef.vpk"));
+  EXPECT_FALSE(ObjectStore::isValidHash("../../etc"));
+
+  writeFile(dir / "downloads" / "tank.vpk", "payload");
+  writeFile(dir / "downloads" / "tank (1).vpk", "payload");
+
+  std::error_code ec;
+  const auto first = store.put(dir / "downloads" / "tank.vpk", hash, ObjectStore::PutMode::Copy, ec);
+  ASSERT_TRUE(first.has_value()) << ec.message();
+  EXPECT_FALSE(first->deduplicated);
+  EXPECT_EQ(first->method, StorageMethod::Copy);
+  EXPECT_EQ(readAll(object), "payload");
+
+  // 同一内容换了文件名再次剪切导入：不再写入数据，只删除源文件
+  const auto second = store.put(dir / "downloads" / "tank (1).vpk", hash, ObjectStore::PutMode::Move, ec);
+  ASSERT_TRUE(second.has_value()) << ec.message();
+  EXPECT_TRUE(second->deduplicated);
+  EXPECT_EQ(second->object, object);
+  EXPECT_FALSE(std::filesystem::exists(dir / "downloads" / "tank (1).vpk"));
+  EXPECT_TRUE(std::filesystem::exists(dir / "downloads" / "tank.vpk"));
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(ObjectStoreTest, IndexesNamesAndDeploysByLink) {
+  const auto dir = makeTestDir("l4d2_object_store_index_test");
+  const ObjectStore store(dir / "repo");
+
+  writeFile(dir / "a.vpk", "first");
+  writeFile(dir / "b.vpk", "second");
+  std::error_code ec;
+  const auto a = store.put(dir / "a.vpk", "11111111", ObjectStore::PutMode::Move, ec);
+  const auto b = store.put(dir / "b.vpk", "22222222", ObjectStore::PutMode::Move, ec);
+  ASSERT_TRUE(a && b) << ec.message();
+
+  const auto nameA = store.linkName(a->object, "weapon.vpk", ec);
+  ASSERT_TRUE(nameA.has_value()) << ec.message();
+  EXPECT_EQ(*nameA, store.namesDir() / "weapon.vpk");
+  // 同一对象重复建立索引时复用已有条目，不同对象同名时追加后缀
+  EXPECT_EQ(store.linkName(a->object, "weapon.vpk", ec), nameA);
+  const auto nameB = store.linkName(b->object, "weapon.vpk", ec);
+  ASSERT_TRUE(nameB.has_value()) << ec.message();
+  EXPECT_EQ(*nameB, store.namesDir() / "weapon_1.vpk");
+  EXPECT_EQ(readAll(*nameB), "second");
+
+  // 部署替换游戏目录中的旧文件；同一设备上为硬链接
+  const auto target = dir / "addons" / "weapon.vpk";
+  std::filesystem::create_directories(target.parent_path());
+  writeFile(target, "stale");
+  const auto method = ObjectStore::deploy(a->object, target, ec);
+  ASSERT_TRUE(method.has_value()) << ec.message();
+  EXPECT_EQ(*method, StorageMethod::Hardlink);
+  EXPECT_TRUE(std::filesystem::equivalent(target, a->object));
+  EXPECT_EQ(readAll(target), "first");
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(ObjectStoreTest, FailedMoveKeepsTheSourceFile) {
+  const auto dir = makeTestDir("l4d2_object_store_move_test");
+  const ObjectStore store(dir / "repo");
+  const std::string hash = "33333333";
+
+  // 对象路径被目录占据：源文件已改名为临时文件，最终改名会失败
+  const auto object = store.objectPath(hash, ".vpk");
+  std::filesystem::create_directories(object / "occupied");
+  writeFile(dir / "mod.vpk", "only copy");
+
+  std::error_code ec;
+  EXPECT_FALSE(store.put(dir / "mod.vpk", hash, ObjectStore::PutMode::Move, ec).has_value());
+  EXPECT_TRUE(ec);
+  EXPECT_EQ(readAll(dir / "mod.vpk"), "only copy");
+  std::filesystem::path partial = object;
+  partial += TransferEngine::kPartialSuffix;
+  EXPECT_FALSE(std::filesystem::exists(partial));
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(ObjectStoreTest, ReleaseMovesNameEntriesToTheReplacement) {
+  const auto dir = makeTestDir("l4d2_object_store_release_test");
+  const ObjectStore store(dir / "repo");
+
+  writeFile(dir / "old.vpk", "old payload");
+  writeFile(dir / "new.vpk", "new payload");
+  std::error_code ec;
+  const auto previous = store.put(dir / "old.vpk", "44444444", ObjectStore::PutMode::Move, ec);
+  const auto current = store.put(dir / "new.vpk", "55555555", ObjectStore::PutMode::Move, ec);
+  ASSERT_TRUE(previous && current) << ec.message();
+  ASSERT_TRUE(store.linkName(previous->object, "123456.vpk", ec).has_value()) << ec.message();
+  ASSERT_TRUE(store.linkName(previous->object, "alias.vpk", ec).has_value()) << ec.message();
+
+  // 旧对象被删除，原有条目改为指向新对象，之后按同名建立索引不会再追加后缀
+  EXPECT_TRUE(store.release(previous->object, current->object, ec)) << ec.message();
+  EXPECT_FALSE(std::filesystem::exists(previous->object));
+  EXPECT_EQ(readAll(store.namesDir() / "123456.vpk"), "new payload");
+  EXPECT_EQ(readAll(store.namesDir() / "alias.vpk"), "new payload");
+  EXPECT_EQ(store.linkName(current->object, "123456.vpk", ec), store.namesDir() / "123456.vpk");
+  EXPECT_FALSE(std::filesystem::exists(store.namesDir() / "123456_1.vpk"));
+
+  // 没有替代对象时一并删除条目；对象已不存在视为成功，对象库之外的路径不会被删除
+  EXPECT_TRUE(store.release(current->object, {}, ec)) << ec.message();
+  EXPECT_FALSE(std::filesystem::exists(current->object));
+  EXPECT_FALSE(std::filesystem::exists(std::filesystem::symlink_status(store.namesDir() / "123456.vpk")));
+  EXPECT_TRUE(store.release(current->object, {}, ec));
+  writeFile(dir / "outside.vpk", "keep");
+  EXPECT_FALSE(store.release(dir / "outside.vpk", {}, ec));
+  EXPECT_TRUE(std::filesystem::exists(dir / "outside.vpk"));
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(ObjectStoreTest, LinkNeverSharesAnInodeWithTheSource) {
+  const auto dir = makeTestDir("l4d2_object_store_link_test");
+  const ObjectStore store(dir / "repo");
+  writeFile(dir / "external.vpk", "original");
+
+  std::error_code ec;
+  const auto put = store.put(dir / "external.vpk", "66666666", ObjectStore::PutMode::Link, ec);
+  ASSERT_TRUE(put.has_value()) << ec.message();
+  ASSERT_TRUE(put->method.has_value());
+  EXPECT_TRUE(*put->method == StorageMethod::Reflink || *put->method == StorageMethod::Copy);
+  EXPECT_FALSE(std::filesystem::equivalent(dir / "external.vpk", put->object));
+
+  // 仓库外的源文件被原地修改后，对象内容保持不变
+  {
+    std::ofstream out(dir / "external.vpk", std::ios::binary | std::ios::in | std::ios::out);
+    out << "modified";
+  }
+  EXPECT_EQ(readAll(put->object), "original");
+
+  std::filesystem::remove_all(dir);
+}
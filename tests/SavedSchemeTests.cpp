@@ -6,21 +6,14 @@
 #include <string>
 #include <vector>
 
-#include "core/db/Db.h"
-#include "core/db/Migrations.h"
 #include "core/repo/FixedBundleDao.h"
 #include "core/repo/RepositoryDao.h"
 #include "core/repo/RepositoryService.h"
 #include "core/repo/SavedSchemeDao.h"
+#include "tests/TestDb.h"
 
 namespace {
 
-std::shared_ptr<Db> createTestDb() {
-  auto db = std::make_shared<Db>(":memory:");
-  runMigrations(*db);
-  return db;
-}
-
 int insertTestMod(RepositoryDao& repo, const std::string& name, const std::string& hash) {
   ModRow mod;
   mod.name = name;
@@ -165,3 +158,65 @@ TEST(RepositoryServiceTest, CreateBundlesAndSchemes) {
       std::find_if(schemes.begin(), schemes.end(), [schemeId](const auto& row) { return row.id == schemeId; });
   EXPECT_EQ(deletedIt, schemes.end());
 }
+
+TEST(RepositoryServiceTest, UpdateFileMetadataKeepsOtherColumnsAndTags) {
+  auto db = createTestDb();
+  RepositoryService service(db);
+
+  ModRow mod;
+  mod.name = "Synced";
+  mod.author = "Author";
+  mod.rating = 4;
+  mod.note = "keep me";
+  mod.file_path = "old.vpk";
+  mod.size_mb = 1.0;
+  const int modId = service.createModWithTags(mod, {{"Anime", "VRC"}});
+
+  ModFileMetadataRow metadata;
+  metadata.mod_id = modId;
+  metadata.file_path = "new.vpk";
+  metadata.file_hash = "abc123";
+  metadata.size_mb = 2.5;
+  metadata.last_published_at = "2024-05-01";
+  metadata.last_saved_at = "2024-05-01";
+  metadata.cover_path = "new.jpg";
+  service.updateModFileMetadata({metadata});
+
+  const auto updated = service.findMod(modId);
+  ASSERT_TRUE(updated.has_value());
+  EXPECT_EQ(updated->file_path, "new.vpk");
+  EXPECT_EQ(updated->file_hash, "abc123");
+  EXPECT_DOUBLE_EQ(updated->size_mb, 2.5);
+  EXPECT_EQ(updated->cover_path, "new.jpg");
+  EXPECT_EQ(updated->last_saved_at, "2024-05-01");
+  EXPECT_EQ(updated->author, "Author");
+  EXPECT_EQ(updated->note, "keep me");
+  EXPECT_EQ(updated->rating, 4);
+  EXPECT_EQ(service.listTagsForMod(modId).size(), 1u);
+
+  metadata.mod_id = 0;
+  EXPECT_THROW(service.updateModFileMetadata({metadata}), DbError);
+}
+
+TEST(RepositoryServiceTest, CreateModsBatchSkipsKnownHashes) {
+  auto db = createTestDb();
+  RepositoryDao repo(db);
+  RepositoryService service(db);
+  insertTestMod(repo, "Existing", "hash-existing");
+
+  ModRow fresh;
+  fresh.name = "Fresh";
+  fresh.file_hash = "hash-fresh";
+  ModRow duplicate;
+  duplicate.name = "Duplicate";
+  duplicate.file_hash = "hash-existing";
+  ModRow unhashed;
+  unhashed.name = "Unhashed";
+
+  const auto ids = service.createModsBatch({fresh, duplicate, unhashed});
+  ASSERT_EQ(ids.size(), 3u);
+  EXPECT_GT(ids[0], 0);
+  EXPECT_EQ(ids[1], 0);
+  EXPECT_GT(ids[2], 0);
+  EXPECT_EQ(service.listAll().size(), 3u);
+}
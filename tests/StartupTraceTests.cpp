@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "core/util/StartupTrace.h"
+
+TEST(StartupTraceTest, RecordsOverlappingPhasesInOrder) {
+  StartupTrace trace;
+  const auto load = trace.begin("mods");
+  const auto ui = trace.begin("ui");
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  trace.end(ui);
+  trace.end(load);
+  trace.end(load); // 重复结束不改变已记录的耗时
+  trace.mark("interactive");
+
+  const auto& phases = trace.phases();
+  ASSERT_EQ(phases.size(), 3u);
+  EXPECT_EQ(phases[0].name, "mods");
+  EXPECT_EQ(phases[1].name, "ui");
+  EXPECT_TRUE(phases[0].finished);
+  EXPECT_GE(phases[1].duration, std::chrono::milliseconds(2));
+  EXPECT_GE(phases[0].duration, phases[1].duration);
+  EXPECT_LE(phases[0].start, phases[1].start);
+  EXPECT_EQ(phases[2].duration.count(), 0);
+  EXPECT_GE(phases[2].start, phases[1].start + phases[1].duration);
+}
+
+TEST(StartupTraceTest, SummaryListsRunningPhasesAndMilestones) {
+  StartupTrace trace;
+  trace.end(trace.begin("settings"));
+  trace.begin("scan");
+  trace.mark("interactive");
+  trace.end(42); // 无效句柄被忽略
+
+  const std::string summary = trace.summary();
+  EXPECT_NE(summary.find("settings +"), std::string::npos);
+  EXPECT_NE(summary.find("scan +"), std::string::npos);
+  EXPECT_NE(summary.find("(running)"), std::string::npos);
+  EXPECT_NE(summary.find("interactive @"), std::string::npos);
+  // 瞬间结束的阶段仍按阶段输出，不当作里程碑
+  EXPECT_EQ(summary.find("settings @"), std::string::npos);
+  EXPECT_TRUE(trace.phases()[2].milestone);
+  EXPECT_FALSE(trace.phases()[0].milestone);
+}
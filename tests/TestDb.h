@@ -0,0 +1,18 @@
+#pragma once
+
+#include <memory>
+
+#include "core/db/Db.h"
+#include "core/db/Migrations.h"
+
+/**
+ * @file TestDb.h
+ * @brief 测试共用的数据库夹具。
+ */
+
+/// 打开内存数据库并执行全部迁移。
+inline std::shared_ptr<Db> createTestDb() {
+  auto db = std::make_shared<Db>(":memory:");
+  runMigrations(*db);
+  return db;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+/**
+ * @file TestFiles.h
+ * @brief 测试共用的临时文件工具。
+ */
+
+/// 在系统临时目录下创建名为 name 的空目录（已存在时先清空）。
+inline std::filesystem::path makeTestDir(const std::string& name) {
+  const auto dir = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+  return dir;
+}
+
+/// 以二进制方式写入（覆盖）文件。
+inline void writeFile(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  out.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+/// 在系统临时目录下写入名为 name 的文件并返回其路径。
+inline std::filesystem::path writeTempFile(const std::string& name, const std::string& content) {
+  const auto path = std::filesystem::temp_directory_path() / name;
+  writeFile(path, content);
+  return path;
+}
+
+/// 以二进制方式读取整个文件，打不开时返回空串。
+inline std::string readAll(const std::filesystem::path& path) {
+  std::ifstream in(path, std::ios::binary);
+  return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "core/io/TransferEngine.h"
+#include "tests/TestFiles.h"
+
+TEST(TransferEngineTest, CopiesAndMovesFilesWithPerFileResults) {
+  const auto dir = makeTestDir("l4d2_transfer_test");
+  std::vector<TransferJob> jobs;
+  std::vector<std::string> contents;
+  for (int i = 0; i < 6; ++i) {
+    std::string content(100 * 1024 + i * 777, static_cast<char>('a' + i));
+    const auto src = dir / ("src" + std::to_string(i) + ".vpk");
+    writeFile(src, content);
+    contents.push_back(content);
+    TransferJob job;
+    job.source = src;
+    job.destination = dir / ("dst" + std::to_string(i) + ".vpk");
+    job.mode = (i % 2 == 0) ? TransferJob::Mode::Copy : TransferJob::Mode::Move;
+    jobs.push_back(job);
+  }
+  // 目标已存在与源文件缺失的任务应单独失败，不影响其它任务
+  writeFile(dir / "occupied.vpk", "keep");
+  jobs.push_back({dir / "src0.vpk", dir / "occupied.vpk", TransferJob::Mode::Copy});
+  jobs.push_back({dir / "missing.vpk", dir / "never.vpk", TransferJob::Mode::Copy});
+
+  std::atomic<int> filesDone{0};
+  std::atomic<std::uint64_t> lastProgress{0};
+  TransferOptions options;
+  options.queueDepth = 3;
+  options.bufferSize = 64 * 1024;
+  options.onFileDone = [&](std::size_t, const TransferResult&) { ++filesDone; };
+  options.onProgress = [&](std::uint64_t done, std::uint64_t) {
+    std::uint64_t previous = lastProgress.load();
+    while (done > previous && !lastProgress.compare_exchange_weak(previous, done)) {
+    }
+  };
+  TransferEngine engine(options);
+  const auto results = engine.run(jobs);
+
+  ASSERT_EQ(results.size(), jobs.size());
+  std::uint64_t expectedBytes = 0;
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_TRUE(results[i].ok()) << results[i].error.message();
+    EXPECT_EQ(readAll(jobs[i].destination), contents[i]);
+    EXPECT_EQ(std::filesystem::exists(jobs[i].source), jobs[i].mode == TransferJob::Mode::Copy);
+    expectedBytes += contents[i].size();
+  }
+  EXPECT_EQ(results[6].error, std::make_error_code(std::errc::file_exists));
+  EXPECT_EQ(readAll(dir / "occupied.vpk"), "keep");
+  EXPECT_FALSE(results[7].ok());
+  EXPECT_FALSE(std::filesystem::exists(dir / "never.vpk"));
+  EXPECT_EQ(filesDone.load(), static_cast<int>(jobs.size()));
+  EXPECT_GE(lastProgress.load(), expectedBytes);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(TransferEngineTest, NeverReplacesDestinationCreatedDuringCopy) {
+  const auto dir = makeTestDir("l4d2_transfer_race_test");
+  writeFile(dir / "src.vpk", std::string(512 * 1024, 'x'));
+
+  // 复制途中另一个任务抢先写出同名目标：收尾改名必须失败而不是覆盖它
+  std::atomic<bool> raced{false};
+  TransferOptions options;
+  options.queueDepth = 1;
+  options.bufferSize = 64 * 1024;
+  options.onProgress = [&](std::uint64_t, std::uint64_t) {
+    if (!raced.exchange(true)) {
+      writeFile(dir / "dst.vpk", "other");
+    }
+  };
+  TransferEngine engine(options);
+  const auto results = engine.run({{dir / "src.vpk", dir / "dst.vpk", TransferJob::Mode::Copy}});
+
+  ASSERT_EQ(results.size(), 1u);
+  EXPECT_TRUE(raced.load());
+  EXPECT_EQ(results[0].error, std::make_error_code(std::errc::file_exists));
+  EXPECT_EQ(readAll(dir / "dst.vpk"), "other");
+  EXPECT_EQ(TransferEngine::removeStalePartials(dir), 0u);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(TransferEngineTest, ThrottleCapsThroughput) {
+  const auto dir = makeTestDir("l4d2_transfer_throttle_test");
+  writeFile(dir / "src.vpk", std::string(512 * 1024, 'x'));
+
+  TransferOptions options;
+  options.bufferSize = 64 * 1024;
+  options.maxBytesPerSecond = 4 * 1024 * 1024;
+  TransferEngine engine(options);
+  const auto start = std::chrono::steady_clock::now();
+  const auto results = engine.run({{dir / "src.vpk", dir / "dst.vpk", TransferJob::Mode::Copy}});
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  ASSERT_TRUE(results[0].ok());
+  // 512 KiB / 4 MiB/s = 125 ms，每个数据块传输后等待其时间片
+  EXPECT_GE(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 90);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST(TransferEngineTest, CancelInterruptsThrottleWait) {
+  const auto dir = makeTestDir("l4d2_transfer_throttle_cancel_test");
+  writeFile(dir / "src.vpk", std::string(1024 * 1024, 'x'));
+
+  std::atomic<bool> cancelled{false};
+  TransferOptions options;
+  options.bufferSize = 1024 * 1024;
+  options.maxBytesPerSecond = 64 * 1024; // 传完 1 MiB 后需等待约 16 秒
+  options.cancelled = &cancelled;
+  options.onProgress = [&cancelled](std::uint64_t, std::uint64_t) { cancelled = true; };
+  TransferEngine engine(options);
+  const auto start = std::chrono::steady_clock::now();
+  const auto results = engine.run({{dir / "src.vpk", dir / "dst.vpk", TransferJob::Mode::Copy}});
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(results[0].error, std::errc::operation_canceled);
+  EXPECT_FALSE(std::filesystem::exists(dir / "dst.vpk"));
+  EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), 2000);
+
+  std::filesystem::remove_all(dir);
+}
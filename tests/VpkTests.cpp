@@ -0,0 +1,365 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/vpk/AddonInfo.h"
+#include "core/vpk/VpkArchive.h"
+#include "core/vpk/VtfImage.h"
+#include "tests/TestFiles.h"
+
+namespace {
+
+struct FileSpec {
+  std::string directory; ///< 空表示根目录
+  std::string name;
+  std::string extension;
+  std::string content;
+  std::size_t preload{0};       ///< 放入目录树的预载字节数
+  std::uint16_t archive{VpkArchive::kEmbeddedArchive};
+};
+
+void putU16(std::string& out, std::uint16_t value) {
+  out.push_back(static_cast<char>(value & 0xFF));
+  out.push_back(static_cast<char>(value >> 8));
+}
+
+void putU32(std::string& out, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+  }
+}
+
+void putString(std::string& out, const std::string& text) {
+  out.append(text.empty() ? std::string(" ") : text);
+  out.push_back('\0');
+}
+
+/// 按 扩展名 -> 目录 -> 文件名 组织目录树；分卷数据写入 archives[编号]。
+std::string buildVpk(const std::vector<FileSpec>& files, std::uint32_t version,
+                     std::map<std::uint16_t, std::string>* archives = nullptr) {
+  std::map<std::string, std::map<std::string, std::vector<const FileSpec*>>> tree;
+  for (const auto& file : files) {
+    tree[file.extension][file.directory].push_back(&file);
+  }
+  std::string treeBytes;
+  std::string embedded;
+  for (const auto& [extension, directories] : tree) {
+    putString(treeBytes, extension);
+    for (const auto& [directory, entries] : directories) {
+      putString(treeBytes, directory);
+      for (const FileSpec* file : entries) {
+        putString(treeBytes, file->name);
+        const std::string preload = file->content.substr(0, file->preload);
+        const std::string rest = file->content.substr(preload.size());
+        std::string& target = file->archive == VpkArchive::kEmbeddedArchive ? embedded : (*archives)[file->archive];
+        putU32(treeBytes, 0); // CRC 不参与解析
+        putU16(treeBytes, static_cast<std::uint16_t>(preload.size()));
+        putU16(treeBytes, file->archive);
+        putU32(treeBytes, static_cast<std::uint32_t>(target.size()));
+        putU32(treeBytes, static_cast<std::uint32_t>(rest.size()));
+        putU16(treeBytes, 0xFFFF);
+        treeBytes.append(preload);
+        target.append(rest);
+      }
+      treeBytes.push_back('\0');
+    }
+    treeBytes.push_back('\0');
+  }
+  treeBytes.push_back('\0');
+
+  std::string out;
+  putU32(out, VpkArchive::kSignature);
+  putU32(out, version);
+  putU32(out, static_cast<std::uint32_t>(treeBytes.size()));
+  if (version == 2) {
+    putU32(out, static_cast<std::uint32_t>(embedded.size()));
+    putU32(out, 0);
+    putU32(out, 0);
+    putU32(out, 0);
+  }
+  return out + treeBytes + embedded;
+}
+
+const char* kAddonInfo = R"(// generated by VPK tool
+"AddonInfo"
+{
+    addonSteamAppID  550
+    AddonTitle       "Better \"Rifle\" Sounds"
+    addonversion     1.2
+    addonauthor      "Ellis"
+    addonDescription "Line one\nLine two"
+    addonContent_Sound 1
+}
+)";
+
+std::vector<FileSpec> sampleFiles() {
+  return {
+      {"", "addoninfo", "txt", kAddonInfo, 16},
+      {"materials/vgui", "addonimage", "jpg", std::string(300, '\xAB')},
+      {"sound/weapons/rifle", "gunfire", "wav", std::string(5000, 'w'), 4},
+      {"scripts", "readme", "", "no extension"},
+  };
+}
+
+const std::uint8_t* bytes(const std::string& data) {
+  return reinterpret_cast<const std::uint8_t*>(data.data());
+}
+
+/// 构造 RGBA8888 的 VTF：第 level 级 mip 的每个像素为 (level, x, y, 255)。
+std::string buildVtf(std::uint32_t minor, int width, int height, int mipCount) {
+  std::string mips;
+  for (int level = mipCount - 1; level >= 0; --level) {
+    const int w = std::max(1, width >> level);
+    const int h = std::max(1, height >> level);
+    for (int y = 0; y < h; ++y) {
+      for (int x = 0; x < w; ++x) {
+        mips += {static_cast<char>(level), static_cast<char>(x), static_cast<char>(y), static_cast<char>(255)};
+      }
+    }
+  }
+  const std::uint32_t headerSize = minor >= 3 ? 96 : 80;
+  std::string out = std::string("VTF", 4);
+  putU32(out, 7);
+  putU32(out, minor);
+  putU32(out, headerSize);
+  putU16(out, static_cast<std::uint16_t>(width));
+  putU16(out, static_cast<std::uint16_t>(height));
+  putU32(out, 0);                   // flags
+  putU16(out, 1);                   // frames
+  putU16(out, 0);                   // firstFrame
+  out.append(24, '\0');             // padding + reflectivity + padding + bumpmapScale
+  putU32(out, 0);                   // highResImageFormat = RGBA8888
+  out.push_back(static_cast<char>(mipCount));
+  putU32(out, 0xFFFFFFFFu);         // 无低分辨率缩略图
+  out.append(2, '\0');
+  putU16(out, 1);                   // depth
+  out.append(3, '\0');
+  putU32(out, minor >= 3 ? 1 : 0);  // numResources
+  out.resize(80, '\0');
+  if (minor >= 3) {
+    out += {'\x30', '\0', '\0', '\0'};
+    putU32(out, headerSize);
+  }
+  out.resize(headerSize, '\0');
+  return out + mips;
+}
+
+}  // namespace
+
+TEST(VpkArchiveTest, ParsesDirectoryTreeOfBothVersions) {
+  for (std::uint32_t version : {1u, 2u}) {
+    const auto files = sampleFiles();
+    const std::string data = buildVpk(files, version);
+    VpkArchive archive;
+    std::error_code ec;
+    ASSERT_TRUE(archive.parse(bytes(data), data.size(), ec)) << ec.message();
+    EXPECT_EQ(archive.version(), version);
+    ASSERT_EQ(archive.entries().size(), files.size());
+
+    for (const auto& file : files) {
+      std::string path = file.directory.empty() ? file.name : file.directory + "/" + file.name;
+      if (!file.extension.empty()) {
+        path += "." + file.extension;
+      }
+      const VpkEntry* entry = archive.find(path);
+      ASSERT_NE(entry, nullptr) << path;
+      EXPECT_EQ(entry->path(), path);
+      EXPECT_EQ(entry->size(), file.content.size());
+      std::string content;
+      ASSERT_TRUE(archive.read(*entry, content, ec)) << ec.message();
+      EXPECT_EQ(content, file.content);
+    }
+    // 查找不区分大小写并接受反斜杠
+    EXPECT_NE(archive.find("Materials\\VGUI\\AddonImage.JPG"), nullptr);
+    EXPECT_EQ(archive.find("materials/vgui/addonimage.vtf"), nullptr);
+  }
+}
+
+TEST(VpkArchiveTest, ReadsAddonInfoFromFileAndSplitArchives) {
+  const auto dir = makeTestDir("l4d2_vpk_test");
+
+  auto files = sampleFiles();
+  files[0].archive = 0; // addoninfo.txt 的剩余数据放在 pak01_000.vpk
+  files[2].archive = 1;
+  std::map<std::uint16_t, std::string> archives;
+  const std::string dirData = buildVpk(files, 2, &archives);
+  std::ofstream(dir / "pak01_dir.vpk", std::ios::binary) << dirData;
+  for (const auto& [index, content] : archives) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "pak01_%03u.vpk", static_cast<unsigned>(index));
+    std::ofstream(dir / name, std::ios::binary) << content;
+  }
+  std::ofstream(dir / "single.vpk", std::ios::binary) << buildVpk(sampleFiles(), 1);
+  std::ofstream(dir / "empty.vpk", std::ios::binary) << buildVpk({{"", "other", "txt", "x"}}, 1);
+
+  for (const char* name : {"pak01_dir.vpk", "single.vpk"}) {
+    std::error_code ec;
+    const auto info = readAddonInfo(dir / name, ec);
+    ASSERT_TRUE(info.has_value()) << name << " " << ec.message();
+    EXPECT_EQ(info->title, "Better \"Rifle\" Sounds");
+    EXPECT_EQ(info->author, "Ellis");
+    EXPECT_EQ(info->version, "1.2");
+    EXPECT_EQ(info->description, "Line one\nLine two");
+  }
+
+  std::error_code ec;
+  EXPECT_FALSE(readAddonInfo(dir / "empty.vpk", ec).has_value());
+  EXPECT_FALSE(ec);
+  EXPECT_FALSE(readAddonInfo(dir / "missing.vpk", ec).has_value());
+  EXPECT_TRUE(ec);
+  std::filesystem::remove_all(dir);
+}
+
+TEST(VpkArchiveTest, RejectsMalformedArchivesWithoutCrashing) {
+  const std::string valid = buildVpk(sampleFiles(), 2);
+  std::mt19937 rng(20240611u);
+  VpkArchive archive;
+  std::error_code ec;
+
+  // 每个截断位置都必须被拒绝或只产出可安全读取的条目
+  for (std::size_t length = 0; length < valid.size(); ++length) {
+    const std::string truncated = valid.substr(0, length);
+    if (archive.parse(bytes(truncated), truncated.size(), ec)) {
+      std::string content;
+      for (const auto& entry : archive.entries()) {
+        archive.read(entry, content, ec);
+      }
+    }
+  }
+
+  // 随机翻转字节，覆盖长度、偏移与终止符被破坏的情况
+  int accepted = 0;
+  for (int round = 0; round < 5000; ++round) {
+    std::string mutated = valid;
+    const int flips = 1 + static_cast<int>(rng() % 8);
+    for (int i = 0; i < flips; ++i) {
+      mutated[rng() % mutated.size()] = static_cast<char>(rng() & 0xFF);
+    }
+    if (archive.parse(bytes(mutated), mutated.size(), ec)) {
+      ++accepted;
+      std::string content;
+      for (const auto& entry : archive.entries()) {
+        if (archive.read(entry, content, ec)) {
+          EXPECT_EQ(content.size(), entry.size());
+        }
+        parseAddonInfo(content);
+      }
+    } else {
+      EXPECT_TRUE(ec);
+      EXPECT_TRUE(archive.entries().empty());
+    }
+  }
+  EXPECT_GT(accepted, 0);
+
+  // 完全随机的数据（带正确签名）
+  for (int round = 0; round < 2000; ++round) {
+    std::string noise = buildVpk({}, 1 + (round % 2)).substr(0, 8);
+    const std::size_t length = rng() % 256;
+    for (std::size_t i = 0; i < length; ++i) {
+      noise.push_back(static_cast<char>(rng() & 0xFF));
+    }
+    archive.parse(bytes(noise), noise.size(), ec);
+  }
+}
+
+TEST(AddonInfoTest, ParsesKeyValuesLeniently) {
+  const auto info = parseAddonInfo("\xEF\xBB\xBF\"AddonInfo\" { \"addonTitle\" \"  Spaced  \" // comment\n"
+                                   "ADDONAUTHOR Coach addonURL0 \"https://example.com\" "
+                                   "nested { addontitle ignored } addontagline \"unterminated");
+  ASSERT_TRUE(info.has_value());
+  EXPECT_EQ(info->title, "Spaced");
+  EXPECT_EQ(info->author, "Coach");
+  EXPECT_EQ(info->url, "https://example.com");
+  EXPECT_EQ(info->tagline, "unterminated");
+
+  EXPECT_FALSE(parseAddonInfo("").has_value());
+  EXPECT_FALSE(parseAddonInfo("\"AddonInfo\" { addonSteamAppID 550 }").has_value());
+
+  std::mt19937 rng(7u);
+  const std::string alphabet = "\"{}/\\ \n\tabn";
+  for (int round = 0; round < 2000; ++round) {
+    std::string text;
+    const std::size_t length = rng() % 64;
+    for (std::size_t i = 0; i < length; ++i) {
+      text.push_back(alphabet[rng() % alphabet.size()]);
+    }
+    parseAddonInfo(text);
+  }
+}
+
+TEST(VtfImageTest, DecodesSmallestSufficientMipLevel) {
+  for (std::uint32_t minor : {2u, 3u}) {
+    const std::string vtf = buildVtf(minor, 64, 32, 7);
+    const auto full = decodeVtf(bytes(vtf), vtf.size());
+    ASSERT_TRUE(full.has_value()) << minor;
+    EXPECT_EQ(full->width, 64);
+    EXPECT_EQ(full->height, 32);
+    EXPECT_EQ(full->pixels[0], 0);
+
+    // 最长边不小于 16 的最小级别是第 2 级（16x8）
+    const auto thumb = decodeVtf(bytes(vtf), vtf.size(), 16);
+    ASSERT_TRUE(thumb.has_value());
+    EXPECT_EQ(thumb->width, 16);
+    EXPECT_EQ(thumb->height, 8);
+    const std::size_t last = (static_cast<std::size_t>(7) * 16 + 15) * 4;
+    EXPECT_EQ(thumb->pixels[last], 2);
+    EXPECT_EQ(thumb->pixels[last + 1], 15);
+    EXPECT_EQ(thumb->pixels[last + 2], 7);
+    EXPECT_EQ(thumb->pixels[last + 3], 255);
+
+    // 截断到所选级别之前的数据必须被拒绝
+    EXPECT_FALSE(decodeVtf(bytes(vtf), vtf.size() - 64 * 32 * 4 - 1, 64).has_value());
+    for (std::size_t length = 0; length < 128; ++length) {
+      decodeVtf(bytes(vtf), length, 16);
+    }
+  }
+
+  // DXT1：单个 4x4 块，颜色 0 为纯红、颜色 1 为纯蓝，索引全部指向颜色 1
+  std::string dxt = buildVtf(2, 4, 4, 1).substr(0, 80);
+  dxt[52] = 13;
+  dxt += {'\x00', '\xF8', '\x1F', '\x00', '\x55', '\x55', '\x55', '\x55'};
+  const auto block = decodeVtf(bytes(dxt), dxt.size());
+  ASSERT_TRUE(block.has_value());
+  EXPECT_EQ(block->pixels[0], 0);
+  EXPECT_EQ(block->pixels[2], 255);
+  EXPECT_EQ(block->pixels[3], 255);
+}
+
+TEST(VtfImageTest, FindsEmbeddedAddonImageWithoutCopying) {
+  const std::string vtf = buildVtf(2, 8, 8, 1);
+  const std::string data = buildVpk({{"materials/vgui", "addonimage", "vtf", vtf},
+                                     {"", "addonimage", "jpg", std::string(100, '\xFF'), 10}},
+                                    2);
+  VpkArchive archive;
+  std::error_code ec;
+  ASSERT_TRUE(archive.parse(bytes(data), data.size(), ec));
+
+  // 根目录的 JPEG 优先，但它带预载数据，只能复制读取
+  const VpkEntry* image = findAddonImage(archive);
+  ASSERT_NE(image, nullptr);
+  EXPECT_EQ(image->path(), "addonimage.jpg");
+  EXPECT_FALSE(archive.view(*image).has_value());
+
+  const VpkEntry* texture = archive.find("materials/vgui/addonimage.vtf");
+  ASSERT_NE(texture, nullptr);
+  const auto view = archive.view(*texture);
+  ASSERT_TRUE(view.has_value());
+  EXPECT_EQ(*view, vtf);
+  EXPECT_GE(reinterpret_cast<const char*>(view->data()), data.data());
+  EXPECT_LT(reinterpret_cast<const char*>(view->data()), data.data() + data.size());
+  const auto decoded = decodeVtf(reinterpret_cast<const std::uint8_t*>(view->data()), view->size(), 4);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->width, 8);
+
+  const std::string none = buildVpk({{"", "addoninfo", "txt", kAddonInfo}}, 1);
+  ASSERT_TRUE(archive.parse(bytes(none), none.size(), ec));
+  EXPECT_EQ(findAddonImage(archive), nullptr);
+}